@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * Bench.h
+ *
+ * Entry points of the benchmarks in snappyodbcBench.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace io {
+namespace snappydata {
+namespace bench {
+
+  /** number of heap allocations done by the process so far */
+  extern std::atomic<size_t> g_numAllocations;
+
+  /** the measurements of a benchmark across all of its runs */
+  struct BenchResult {
+    std::string m_name;
+    /** median of m_runs */
+    double m_nsPerOp;
+    /** negative when the allocations were not counted */
+    double m_allocsPerOp;
+    /** ns_per_op of each run */
+    std::vector<double> m_runs;
+  };
+
+  /**
+   * Record a measurement for the JSON output and the baseline check.
+   * The name should be unique across all the benchmarks; measurements
+   * with the same name are taken as further runs of that benchmark.
+   */
+  void record(const std::string& name, double nsPerOp,
+      double allocsPerOp = -1.0);
+
+  /** the measurements recorded so far, one per benchmark name */
+  const std::vector<BenchResult>& recordedResults();
+
+  /** write the recorded measurements as JSON; false on an I/O error */
+  bool writeResults(const std::string& path);
+
+  /**
+   * Compare the recorded measurements with those in the given JSON file
+   * as written by writeResults. Returns the number of benchmarks slower
+   * than the baseline by more than the given fraction.
+   */
+  int compareBaseline(const std::string& path, double tolerance);
+
+  /** [payload size] [runs] */
+  int transcodeBench(int argc, const char* argv[]);
+
+  /** [rows] [columns] [string length] */
+  int parameterArenaBench(int argc, const char* argv[]);
+
+  /** [cells] */
+  int textFormatBench(int argc, const char* argv[]);
+
+  /** [rows] -- SQLFetch/SQLFetchScroll against a MockServer */
+  int fetchBench(int argc, const char* argv[]);
+
+  /** [rows] -- SQLExecute with arrays of parameters against a MockServer */
+  int executeBench(int argc, const char* argv[]);
+
+  /** [rows] [length] -- SQLGetData on wide strings against a MockServer */
+  int getDataBench(int argc, const char* argv[]);
+
+} /* namespace bench */
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * BenchMain.cpp
+ *
+ * Runs the benchmark given as the first argument passing it the
+ * remaining arguments. Also counts the heap allocations so that the
+ * benchmarks can report allocations per operation. The results can be
+ * written as JSON with --json and checked against an earlier JSON output
+ * with --baseline, failing when any benchmark is slower by more than
+ * --tolerance (10% by default). Each benchmark is run --runs times (5 by
+ * default) and the median of its runs is reported.
+ */
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+using namespace io::snappydata::bench;
+
+std::atomic<size_t> io::snappydata::bench::g_numAllocations(0);
+
+void* operator new(size_t size) {
+  g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = ::malloc(size > 0 ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  ::free(p);
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete[](void* p) noexcept {
+  ::free(p);
+}
+
+static int runBenchmark(int argc, const char* argv[]) {
+  if (::strcmp(argv[0], "transcode") == 0) {
+    return transcodeBench(argc, argv);
+  } else if (::strcmp(argv[0], "paramarena") == 0) {
+    return parameterArenaBench(argc, argv);
+  } else if (::strcmp(argv[0], "format") == 0) {
+    return textFormatBench(argc, argv);
+  } else if (::strcmp(argv[0], "fetch") == 0) {
+    return fetchBench(argc, argv);
+  } else if (::strcmp(argv[0], "execute") == 0) {
+    return executeBench(argc, argv);
+  } else if (::strcmp(argv[0], "getdata") == 0) {
+    return getDataBench(argc, argv);
+  } else if (::strcmp(argv[0], "all") == 0) {
+    // all with their default arguments
+    static const char* const names[] = { "transcode", "paramarena",
+        "format", "fetch", "execute", "getdata" };
+    for (const char* name : names) {
+      const char* args[] = { name };
+      const int result = runBenchmark(1, args);
+      if (result != 0) {
+        return result;
+      }
+    }
+    return 0;
+  } else {
+    return -1;
+  }
+}
+
+int main(int argc, const char* argv[]) {
+  const char* jsonFile = nullptr;
+  const char* baselineFile = nullptr;
+  double tolerance = 0.1;
+  int numRuns = 5;
+  int argIndex = 1;
+  for (; argIndex + 1 < argc && ::strncmp(argv[argIndex], "--", 2) == 0;
+      argIndex += 2) {
+    if (::strcmp(argv[argIndex], "--json") == 0) {
+      jsonFile = argv[argIndex + 1];
+    } else if (::strcmp(argv[argIndex], "--baseline") == 0) {
+      baselineFile = argv[argIndex + 1];
+    } else if (::strcmp(argv[argIndex], "--tolerance") == 0) {
+      tolerance = std::strtod(argv[argIndex + 1], nullptr);
+    } else if (::strcmp(argv[argIndex], "--runs") == 0) {
+      numRuns = std::max(1, std::atoi(argv[argIndex + 1]));
+    } else {
+      break;
+    }
+  }
+
+  int result = argIndex < argc ? 0 : -1;
+  for (int run = 0; run < numRuns && result == 0; run++) {
+    result = runBenchmark(argc - argIndex, argv + argIndex);
+  }
+  if (result == -1) {
+    std::cerr << "Usage: " << argv[0]
+        << " [--json <file>] [--baseline <file>] [--tolerance <fraction>]"
+        << " [--runs <count>]"
+        << " (transcode [size] [runs] | paramarena [rows] [columns] [length]"
+        << " | format [cells] | fetch [rows] | execute [rows]"
+        << " | getdata [rows] [length] | all)"
+        << std::endl;
+    return 1;
+  } else if (result != 0) {
+    return result;
+  }
+
+  if (jsonFile && !writeResults(jsonFile)) {
+    std::cerr << "Failed to write " << jsonFile << std::endl;
+    return 1;
+  }
+  if (baselineFile) {
+    const int numRegressions = compareBaseline(baselineFile, tolerance);
+    if (numRegressions != 0) {
+      std::cerr << (numRegressions > 0 ? numRegressions : 0)
+          << " benchmark(s) slower than " << baselineFile << " by more than "
+          << (tolerance * 100.0) << "%" << std::endl;
+      return 2;
+    }
+  }
+  return 0;
+}
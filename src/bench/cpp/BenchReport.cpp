@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * BenchReport.cpp
+ *
+ * Collects the measurements of the benchmarks, writes them as JSON and
+ * checks them against a baseline written by an earlier run. A benchmark
+ * run several times is reported and compared by the median of its runs
+ * so that a single noisy run does not fail the baseline check.
+ */
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+using namespace io::snappydata::bench;
+
+static std::vector<BenchResult> s_results;
+
+static std::string quote(const std::string& str) {
+  std::string result;
+  result.reserve(str.size() + 2);
+  result.push_back('"');
+  for (char c : str) {
+    if (c == '"' || c == '\\') result.push_back('\\');
+    result.push_back(c);
+  }
+  result.push_back('"');
+  return result;
+}
+
+/**
+ * Read the name to ns_per_op mapping from a file written by
+ * writeResults. This is not a general JSON parser and depends on the
+ * one benchmark per line layout written below.
+ */
+static bool readBaseline(const std::string& path,
+    std::unordered_map<std::string, double>& baseline) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  static const std::string nameKey = "\"name\": \"";
+  static const std::string nsKey = "\"ns_per_op\": ";
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t namePos = line.find(nameKey);
+    size_t nsPos = line.find(nsKey);
+    if (namePos == std::string::npos || nsPos == std::string::npos) {
+      continue;
+    }
+    namePos += nameKey.size();
+    std::string name;
+    for (size_t i = namePos; i < line.size() && line[i] != '"'; i++) {
+      if (line[i] == '\\' && i + 1 < line.size()) i++;
+      name.push_back(line[i]);
+    }
+    baseline[name] = std::strtod(line.c_str() + nsPos + nsKey.size(),
+        nullptr);
+  }
+  return true;
+}
+
+static double median(std::vector<double> values) {
+  const size_t mid = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + mid, values.end());
+  if (values.size() % 2 != 0) {
+    return values[mid];
+  }
+  const double upper = values[mid];
+  return (upper + *std::max_element(values.begin(),
+      values.begin() + mid)) / 2.0;
+}
+
+void io::snappydata::bench::record(const std::string& name, double nsPerOp,
+    double allocsPerOp) {
+  for (BenchResult& r : s_results) {
+    if (r.m_name == name) {
+      // another run of the same benchmark
+      r.m_runs.push_back(nsPerOp);
+      r.m_nsPerOp = median(r.m_runs);
+      if (allocsPerOp >= 0.0 && (r.m_allocsPerOp < 0.0 ||
+          allocsPerOp < r.m_allocsPerOp)) {
+        r.m_allocsPerOp = allocsPerOp;
+      }
+      return;
+    }
+  }
+  s_results.push_back(BenchResult { name, nsPerOp, allocsPerOp,
+      std::vector<double>(1, nsPerOp) });
+}
+
+const std::vector<BenchResult>& io::snappydata::bench::recordedResults() {
+  return s_results;
+}
+
+bool io::snappydata::bench::writeResults(const std::string& path) {
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+  out << "{\n  \"benchmarks\": [\n";
+  for (size_t i = 0; i < s_results.size(); i++) {
+    const BenchResult& r = s_results[i];
+    out << "    { \"name\": " << quote(r.m_name) << ", \"ns_per_op\": "
+        << r.m_nsPerOp;
+    if (r.m_allocsPerOp >= 0.0) {
+      out << ", \"allocs_per_op\": " << r.m_allocsPerOp;
+    }
+    out << ", \"runs\": " << r.m_runs.size();
+    out << " }" << (i + 1 < s_results.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+int io::snappydata::bench::compareBaseline(const std::string& path,
+    double tolerance) {
+  std::unordered_map<std::string, double> baseline;
+  if (!readBaseline(path, baseline)) {
+    std::cerr << "Could not read the baseline " << path << std::endl;
+    return -1;
+  }
+  int numRegressions = 0;
+  for (const BenchResult& r : s_results) {
+    auto b = baseline.find(r.m_name);
+    if (b == baseline.end() || b->second <= 0.0) {
+      std::cout << "NEW " << r.m_name << ": " << r.m_nsPerOp << " ns/op"
+          << std::endl;
+      continue;
+    }
+    const double change = (r.m_nsPerOp - b->second) / b->second;
+    const bool regressed = change > tolerance;
+    if (regressed) numRegressions++;
+    std::cout << (regressed ? "SLOWER " : "OK ") << r.m_name << ": "
+        << r.m_nsPerOp << " ns/op vs " << b->second << " ns/op ("
+        << (change >= 0.0 ? "+" : "") << (change * 100.0) << "%, median of "
+        << r.m_runs.size() << " runs)" << std::endl;
+  }
+  return numRegressions;
+}
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * DriverBench.cpp
+ *
+ * Benchmarks of the fetch, execute and SQLGetData paths through the ODBC
+ * API of the driver linked into this executable against an in-process
+ * MockServer. The server side work is part of the measurement but it is
+ * the same for any two builds of the driver being compared.
+ */
+
+#include "Bench.h"
+#include "../../mock/cpp/MockServer.h"
+
+extern "C" {
+#include <sqltypes.h>
+#include <sql.h>
+#include <sqlext.h>
+}
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace io::snappydata;
+using namespace io::snappydata::bench;
+using namespace io::snappydata::mock;
+
+namespace {
+
+  /** a C type bound for the benchmarks and the column type served */
+  struct CTypeSpec {
+    const char* m_name;
+    SQLSMALLINT m_ctype;
+    SQLSMALLINT m_sqlType;
+    SQLLEN m_size;
+    thrift::SnappyType::type m_columnType;
+    int32_t m_width;
+  };
+
+  const CTypeSpec s_ctypes[] = {
+    { "LONG", SQL_C_LONG, SQL_INTEGER, sizeof(SQLINTEGER),
+        thrift::SnappyType::INTEGER, 0 },
+    { "SBIGINT", SQL_C_SBIGINT, SQL_BIGINT, sizeof(SQLBIGINT),
+        thrift::SnappyType::BIGINT, 0 },
+    { "DOUBLE", SQL_C_DOUBLE, SQL_DOUBLE, sizeof(SQLDOUBLE),
+        thrift::SnappyType::DOUBLE, 0 },
+    { "NUMERIC", SQL_C_NUMERIC, SQL_DECIMAL, sizeof(SQL_NUMERIC_STRUCT),
+        thrift::SnappyType::DECIMAL, 12 },
+    { "CHAR", SQL_C_CHAR, SQL_VARCHAR, 41, thrift::SnappyType::VARCHAR, 40 },
+    { "WCHAR", SQL_C_WCHAR, SQL_VARCHAR, 41 * sizeof(SQLWCHAR),
+        thrift::SnappyType::VARCHAR, 40 },
+    { "TIMESTAMP", SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP,
+        sizeof(SQL_TIMESTAMP_STRUCT), thrift::SnappyType::TIMESTAMP, 0 },
+  };
+
+  const SQLULEN s_arraySizes[] = { 1, 100, 10000 };
+
+  const int NUM_COLUMNS = 4;
+
+  bool check(SQLRETURN rc, SQLSMALLINT handleType, SQLHANDLE handle,
+      const char* op) {
+    if (SQL_SUCCEEDED(rc)) {
+      return true;
+    }
+    SQLCHAR sqlState[6] = { 0 };
+    SQLINTEGER errorCode = 0;
+    SQLCHAR message[1024] = { 0 };
+    SQLSMALLINT messageLen;
+    ::SQLGetDiagRec(handleType, handle, 1, sqlState, &errorCode, message,
+        sizeof(message), &messageLen);
+    std::cerr << op << " failed with SQLState=" << sqlState
+        << ", ErrorCode=" << errorCode << ": " << message << std::endl;
+    return false;
+  }
+
+  /** an environment, connection and statement on a MockServer */
+  class MockConnection {
+  public:
+    SQLHENV m_env;
+    SQLHDBC m_conn;
+    SQLHSTMT m_stmt;
+
+    explicit MockConnection(const MockServer& server) :
+        m_env(SQL_NULL_HENV), m_conn(SQL_NULL_HDBC),
+        m_stmt(SQL_NULL_HSTMT) {
+      ::SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &m_env);
+      ::SQLSetEnvAttr(m_env, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3,
+          0);
+      ::SQLAllocHandle(SQL_HANDLE_DBC, m_env, &m_conn);
+      const std::string connStr = server.getConnectionString();
+      if (check(::SQLDriverConnect(m_conn, nullptr,
+          (SQLCHAR*)connStr.c_str(), SQL_NTS, nullptr, 0, nullptr,
+          SQL_DRIVER_NOPROMPT), SQL_HANDLE_DBC, m_conn, "SQLDriverConnect")) {
+        ::SQLAllocHandle(SQL_HANDLE_STMT, m_conn, &m_stmt);
+      }
+    }
+
+    ~MockConnection() {
+      if (m_stmt != SQL_NULL_HSTMT) {
+        ::SQLFreeHandle(SQL_HANDLE_STMT, m_stmt);
+        ::SQLDisconnect(m_conn);
+      }
+      ::SQLFreeHandle(SQL_HANDLE_DBC, m_conn);
+      ::SQLFreeHandle(SQL_HANDLE_ENV, m_env);
+    }
+
+    bool isOpen() const noexcept {
+      return m_stmt != SQL_NULL_HSTMT;
+    }
+  };
+
+  double elapsedNanos(std::chrono::high_resolution_clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<
+        std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now()
+            - start).count());
+  }
+
+  void printResult(const std::string& name, double nanos, size_t numOps,
+      const char* unit) {
+    record(name, nanos / numOps);
+    std::cout << name << ": " << (nanos / numOps) << " ns/" << unit
+        << std::endl;
+  }
+
+} /* anonymous namespace */
+
+int io::snappydata::bench::fetchBench(int argc, const char* argv[]) {
+  const int64_t numRows = argc > 1 ? std::stoll(argv[1]) : 100000;
+  MockServerOptions options;
+  options.m_batchSize = 10000;
+  MockServer server(options);
+  server.start();
+  MockConnection conn(server);
+  if (!conn.isOpen()) return 1;
+
+  for (const CTypeSpec& spec : s_ctypes) {
+    const std::string sql = std::string("SELECT * FROM FETCH_") + spec.m_name;
+    server.setResult(sql, ResultShape(std::vector<ColumnSpec>(NUM_COLUMNS,
+        ColumnSpec(spec.m_columnType, spec.m_width)), numRows));
+
+    for (SQLULEN arraySize : s_arraySizes) {
+      std::vector<char> buffer(spec.m_size * arraySize * NUM_COLUMNS);
+      std::vector<SQLLEN> indicators(arraySize * NUM_COLUMNS);
+      SQLULEN numFetched = 0;
+      size_t checksum = 0;
+      SQLHSTMT stmt = conn.m_stmt;
+
+      ::SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)arraySize,
+          0);
+      ::SQLSetStmtAttr(stmt, SQL_ATTR_ROWS_FETCHED_PTR, &numFetched, 0);
+      for (int c = 0; c < NUM_COLUMNS; c++) {
+        ::SQLBindCol(stmt, c + 1, spec.m_ctype,
+            &buffer[spec.m_size * arraySize * c], spec.m_size,
+            &indicators[arraySize * c]);
+      }
+
+      auto start = std::chrono::high_resolution_clock::now();
+      if (!check(::SQLExecDirect(stmt, (SQLCHAR*)sql.c_str(), SQL_NTS),
+          SQL_HANDLE_STMT, stmt, "SQLExecDirect")) {
+        return 1;
+      }
+      SQLRETURN rc;
+      int64_t rowsSeen = 0;
+      while (true) {
+        rc = arraySize == 1 ? ::SQLFetch(stmt)
+            : ::SQLFetchScroll(stmt, SQL_FETCH_NEXT, 0);
+        if (rc == SQL_NO_DATA) break;
+        if (!check(rc, SQL_HANDLE_STMT, stmt, "SQLFetch")) return 1;
+        rowsSeen += numFetched;
+        checksum += static_cast<size_t>(indicators[0]);
+      }
+      const double nanos = elapsedNanos(start);
+      ::SQLCloseCursor(stmt);
+      ::SQLFreeStmt(stmt, SQL_UNBIND);
+      ::SQLSetStmtAttr(stmt, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+
+      if (rowsSeen != numRows) {
+        std::cerr << "ERROR: fetched " << rowsSeen << " rows instead of "
+            << numRows << std::endl;
+        return 1;
+      }
+      printResult(std::string(arraySize == 1 ? "SQLFetch/"
+          : "SQLFetchScroll/") + spec.m_name + "/rows="
+          + std::to_string(arraySize), nanos, numRows, "row");
+      std::cout << "  (checksum " << checksum << ")" << std::endl;
+    }
+  }
+  return 0;
+}
+
+int io::snappydata::bench::executeBench(int argc, const char* argv[]) {
+  const size_t numRows = argc > 1 ? std::stoul(argv[1]) : 100000;
+  MockServer server;
+  server.start();
+  MockConnection conn(server);
+  if (!conn.isOpen()) return 1;
+
+  for (const CTypeSpec& spec : s_ctypes) {
+    const std::string sql = std::string("INSERT INTO EXECUTE_")
+        + spec.m_name + " VALUES (?, ?, ?, ?)";
+    for (SQLULEN arraySize : s_arraySizes) {
+      SQLHSTMT stmt = conn.m_stmt;
+      std::vector<char> buffer(spec.m_size * arraySize * NUM_COLUMNS);
+      std::vector<SQLLEN> indicators(arraySize * NUM_COLUMNS);
+      // fill in some values of the type
+      for (SQLULEN i = 0; i < arraySize * NUM_COLUMNS; i++) {
+        char* value = &buffer[spec.m_size * i];
+        switch (spec.m_ctype) {
+          case SQL_C_CHAR:
+            indicators[i] = ::snprintf(value, spec.m_size,
+                "value-%lu-abcdefghijklmnopqrstuvwxyz", (unsigned long)i);
+            break;
+          case SQL_C_WCHAR: {
+            SQLWCHAR* wvalue = (SQLWCHAR*)value;
+            const size_t len = 20 + (i % 20);
+            for (size_t j = 0; j < len; j++) {
+              wvalue[j] = (SQLWCHAR)('a' + ((i + j) % 26));
+            }
+            indicators[i] = len * sizeof(SQLWCHAR);
+            break;
+          }
+          case SQL_C_NUMERIC: {
+            SQL_NUMERIC_STRUCT* num = (SQL_NUMERIC_STRUCT*)value;
+            num->precision = 12;
+            num->scale = 2;
+            num->sign = 1;
+            ::memcpy(num->val, &i, sizeof(i) < SQL_MAX_NUMERIC_LEN
+                ? sizeof(i) : SQL_MAX_NUMERIC_LEN);
+            indicators[i] = sizeof(SQL_NUMERIC_STRUCT);
+            break;
+          }
+          case SQL_C_TYPE_TIMESTAMP: {
+            SQL_TIMESTAMP_STRUCT* ts = (SQL_TIMESTAMP_STRUCT*)value;
+            ts->year = 2000 + (i % 30);
+            ts->month = 1 + (i % 12);
+            ts->day = 1 + (i % 28);
+            ts->hour = i % 24;
+            ts->minute = i % 60;
+            ts->second = i % 60;
+            ts->fraction = 0;
+            indicators[i] = sizeof(SQL_TIMESTAMP_STRUCT);
+            break;
+          }
+          case SQL_C_LONG:
+            *(SQLINTEGER*)value = static_cast<SQLINTEGER>(i);
+            indicators[i] = spec.m_size;
+            break;
+          case SQL_C_SBIGINT:
+            *(SQLBIGINT*)value = static_cast<SQLBIGINT>(i) * 1000003;
+            indicators[i] = spec.m_size;
+            break;
+          default:
+            *(SQLDOUBLE*)value = static_cast<SQLDOUBLE>(i) * 1.5;
+            indicators[i] = spec.m_size;
+            break;
+        }
+      }
+
+      if (!check(::SQLPrepare(stmt, (SQLCHAR*)sql.c_str(), SQL_NTS),
+          SQL_HANDLE_STMT, stmt, "SQLPrepare")) {
+        return 1;
+      }
+      ::SQLSetStmtAttr(stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)arraySize,
+          0);
+      for (int c = 0; c < NUM_COLUMNS; c++) {
+        ::SQLBindParameter(stmt, c + 1, SQL_PARAM_INPUT, spec.m_ctype,
+            spec.m_sqlType, spec.m_width, 0,
+            &buffer[spec.m_size * arraySize * c], spec.m_size,
+            &indicators[arraySize * c]);
+      }
+
+      const size_t numExecutes = (numRows + arraySize - 1) / arraySize;
+      auto start = std::chrono::high_resolution_clock::now();
+      for (size_t n = 0; n < numExecutes; n++) {
+        if (!check(::SQLExecute(stmt), SQL_HANDLE_STMT, stmt,
+            "SQLExecute")) {
+          return 1;
+        }
+      }
+      const double nanos = elapsedNanos(start);
+      ::SQLFreeStmt(stmt, SQL_RESET_PARAMS);
+      ::SQLSetStmtAttr(stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+
+      printResult(std::string("SQLExecute/") + spec.m_name + "/params="
+          + std::to_string(arraySize), nanos, numExecutes * arraySize,
+          "row");
+    }
+  }
+  return 0;
+}
+
+int io::snappydata::bench::getDataBench(int argc, const char* argv[]) {
+  const int64_t numRows = argc > 1 ? std::stoll(argv[1]) : 1000;
+  const int32_t length = argc > 2 ? std::stoi(argv[2]) : 65536;
+  MockServer server;
+  server.setResult("SELECT * FROM GETDATA", ResultShape({ ColumnSpec(
+      thrift::SnappyType::LONGVARCHAR, length) }, numRows));
+  server.start();
+  MockConnection conn(server);
+  if (!conn.isOpen()) return 1;
+  SQLHSTMT stmt = conn.m_stmt;
+
+  // whole values and pieces of 8K characters
+  const SQLLEN pieceSizes[] = { length + 1, 8192 };
+  std::vector<SQLWCHAR> buffer(length + 1);
+  for (SQLLEN pieceSize : pieceSizes) {
+    size_t numChars = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    if (!check(::SQLExecDirect(stmt, (SQLCHAR*)"SELECT * FROM GETDATA",
+        SQL_NTS), SQL_HANDLE_STMT, stmt, "SQLExecDirect")) {
+      return 1;
+    }
+    SQLRETURN rc;
+    while ((rc = ::SQLFetch(stmt)) != SQL_NO_DATA) {
+      if (!check(rc, SQL_HANDLE_STMT, stmt, "SQLFetch")) return 1;
+      SQLLEN ind;
+      while ((rc = ::SQLGetData(stmt, 1, SQL_C_WCHAR, buffer.data(),
+          pieceSize * sizeof(SQLWCHAR), &ind)) != SQL_NO_DATA) {
+        if (!SQL_SUCCEEDED(rc)) {
+          check(rc, SQL_HANDLE_STMT, stmt, "SQLGetData");
+          return 1;
+        }
+        if (rc == SQL_SUCCESS) {
+          numChars += ind / sizeof(SQLWCHAR);
+          break;
+        }
+        numChars += pieceSize - 1;
+      }
+    }
+    const double nanos = elapsedNanos(start);
+    ::SQLCloseCursor(stmt);
+
+    printResult("SQLGetData/WCHAR/piece=" + std::to_string(pieceSize),
+        nanos, numRows, "row");
+    std::cout << "  " << (numChars * 1000.0 / nanos) << " Mchars/s"
+        << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * ParameterArenaBench.cpp
+ *
+ * Compares the heap allocations per parameter set when binding arrays of
+ * SQL_C_WCHAR parameters, with the conversion to UTF-8 going through a
+ * temporary std::string for every value as before, against the one going
+ * through a ParameterArena as done by SnappyStatement::bindArrayOfParameters.
+ * The Parameters rows and the batch are mimicked by vectors of strings.
+ */
+
+#include "Bench.h"
+#include "../../driver/cpp/ParameterArena.h"
+#include "../../driver/cpp/StringFunctions.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace io::snappydata;
+using namespace io::snappydata::bench;
+
+typedef std::vector<std::string> ParamsRow;
+
+static std::vector<SQLWCHAR> toWide(const std::string& utf8,
+    const size_t len) {
+  std::string str;
+  while (str.size() < len) {
+    str.append(utf8);
+  }
+  std::vector<SQLWCHAR> wchars(str.size() + 1);
+  SQLLEN wlen = 0;
+  StringFunctions::copyString((const SQLCHAR*)str.data(), str.size(),
+      wchars.data(), wchars.size(), &wlen);
+  wchars.resize(wlen);
+  return wchars;
+}
+
+static void printResult(const char* name, const char* payload,
+    size_t numRows, size_t numAllocs,
+    std::chrono::high_resolution_clock::time_point start) {
+  auto end = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start);
+  record(std::string("paramarena/") + name + "/" + payload,
+      static_cast<double>(duration.count()) / numRows,
+      static_cast<double>(numAllocs) / numRows);
+  std::cout << name << " [" << payload << "]: "
+      << (static_cast<double>(numAllocs) / numRows) << " allocs/row, "
+      << (static_cast<double>(duration.count()) / numRows) << " ns/row"
+      << std::endl;
+}
+
+static void runBenchmark(const char* payload,
+    const std::vector<SQLWCHAR>& wchars, size_t numRows, size_t numCols) {
+  const SQLLEN len = static_cast<SQLLEN>(wchars.size());
+  std::vector<ParamsRow> batch;
+  ParamsRow params;
+  size_t checksum = 0;
+
+  // before: a temporary std::string for every value moved into the row
+  batch.reserve(numRows);
+  size_t allocs = g_numAllocations.load();
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < numRows; i++) {
+    params.resize(numCols);
+    for (size_t c = 0; c < numCols; c++) {
+      params[c] = StringFunctions::toString(wchars.data(), len);
+    }
+    batch.push_back(std::move(params));
+    params.clear();
+  }
+  printResult("toString", payload, numRows,
+      g_numAllocations.load() - allocs, start);
+  checksum += batch.back().back().size();
+  batch.clear();
+
+  // after: transcode into the arena and copy into the row
+  batch.reserve(numRows);
+  allocs = g_numAllocations.load();
+  start = std::chrono::high_resolution_clock::now();
+  {
+    ParameterArena arena;
+    for (size_t i = 0; i < numRows; i++) {
+      params.resize(numCols);
+      for (size_t c = 0; c < numCols; c++) {
+        const SQLLEN maxLen = len * 3 + 1;
+        SQLCHAR* chars = (SQLCHAR*)arena.allocate(maxLen);
+        SQLLEN outLen = 0;
+        StringFunctions::copyString(wchars.data(), len, chars, maxLen,
+            &outLen);
+        params[c].assign((const char*)chars, static_cast<size_t>(outLen));
+      }
+      batch.push_back(std::move(params));
+      params.clear();
+      arena.rewind();
+    }
+    // the arena blocks are not counted by the global operator new
+    allocs -= arena.numBlocks();
+  }
+  printResult("ParameterArena", payload, numRows,
+      g_numAllocations.load() - allocs, start);
+  checksum += batch.back().back().size();
+  batch.clear();
+
+  // print the checksum to avoid the loops from being optimized away
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+int io::snappydata::bench::parameterArenaBench(int argc,
+    const char* argv[]) {
+  const size_t numRows = argc > 1 ? std::stoul(argv[1]) : 50000;
+  const size_t numCols = argc > 2 ? std::stoul(argv[2]) : 8;
+  const size_t len = argc > 3 ? std::stoul(argv[3]) : 40;
+
+  runBenchmark("ASCII", toWide(
+      "The quick brown fox jumps over the lazy dog 0123456789. ", len),
+      numRows, numCols);
+  runBenchmark("Latin-1", toWide(
+      "Größenwahn café déjà vu naïve façade señor smörgåsbord. ", len),
+      numRows, numCols);
+  return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * TextFormatBench.cpp
+ *
+ * Compares formatting numeric and temporal cells for SQL_C_CHAR output
+ * through a heap allocated std::string per cell, as with Row::getString,
+ * against the TextConversions formatters into a stack buffer as done by
+ * SnappyStatement::fillOutput.
+ */
+
+#include "Bench.h"
+#include "../../driver/cpp/TextConversions.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace io::snappydata;
+using namespace io::snappydata::bench;
+
+static void printResult(const char* name, const char* type, size_t numCells,
+    size_t numAllocs, std::chrono::high_resolution_clock::time_point start) {
+  auto end = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start);
+  record(std::string("format/") + name + "/" + type,
+      static_cast<double>(duration.count()) / numCells,
+      static_cast<double>(numAllocs) / numCells);
+  std::cout << name << " [" << type << "]: "
+      << (static_cast<double>(numAllocs) / numCells) << " allocs/cell, "
+      << (static_cast<double>(duration.count()) / numCells) << " ns/cell"
+      << std::endl;
+}
+
+int io::snappydata::bench::textFormatBench(int argc, const char* argv[]) {
+  const size_t numCells = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  std::vector<int64_t> longs(numCells);
+  std::vector<double> doubles(numCells);
+  char out[TextConversions::MAX_FORMAT_LEN];
+  size_t checksum = 0;
+
+  uint64_t seed = 0x9e3779b97f4a7c15ULL;
+  for (size_t i = 0; i < numCells; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    longs[i] = static_cast<int64_t>(seed >> (seed & 63));
+    // amounts with two decimals as typical for numeric fact tables
+    doubles[i] = static_cast<double>(static_cast<int64_t>(seed >> 40)) / 100.0;
+  }
+
+  // BIGINT
+  size_t allocs = g_numAllocations.load();
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < numCells; i++) {
+    std::unique_ptr<std::string> str(new std::string(
+        std::to_string(longs[i])));
+    checksum += str->size();
+  }
+  printResult("to_string", "BIGINT", numCells,
+      g_numAllocations.load() - allocs, start);
+  allocs = g_numAllocations.load();
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < numCells; i++) {
+    checksum += TextConversions::formatInt64(longs[i], out);
+  }
+  printResult("TextConversions", "BIGINT", numCells,
+      g_numAllocations.load() - allocs, start);
+
+  // DOUBLE
+  allocs = g_numAllocations.load();
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < numCells; i++) {
+    std::ostringstream os;
+    os.precision(17);
+    os << doubles[i];
+    std::unique_ptr<std::string> str(new std::string(os.str()));
+    checksum += str->size();
+  }
+  printResult("ostringstream", "DOUBLE", numCells,
+      g_numAllocations.load() - allocs, start);
+  allocs = g_numAllocations.load();
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < numCells; i++) {
+    checksum += TextConversions::formatDouble(doubles[i], out);
+  }
+  printResult("TextConversions", "DOUBLE", numCells,
+      g_numAllocations.load() - allocs, start);
+
+  // TIMESTAMP
+  allocs = g_numAllocations.load();
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < numCells; i++) {
+    char buf[64];
+    const int n = ::snprintf(buf, sizeof(buf), "%04d-%02d-%02d "
+        "%02d:%02d:%02d.%09d", 2000 + int(i % 30), 1 + int(i % 12),
+        1 + int(i % 28), int(i % 24), int(i % 60), int(i % 59),
+        int(i % 1000) * 1000000);
+    std::unique_ptr<std::string> str(new std::string(buf, n));
+    checksum += str->size();
+  }
+  printResult("snprintf", "TIMESTAMP", numCells,
+      g_numAllocations.load() - allocs, start);
+  allocs = g_numAllocations.load();
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < numCells; i++) {
+    checksum += TextConversions::formatTimestamp(2000 + int(i % 30),
+        1 + int(i % 12), 1 + int(i % 28), int(i % 24), int(i % 60),
+        int(i % 59), static_cast<uint32_t>(i % 1000) * 1000000, out);
+  }
+  printResult("TextConversions", "TIMESTAMP", numCells,
+      g_numAllocations.load() - allocs, start);
+
+  // print the checksum to avoid the loops from being optimized away
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+  return 0;
+}
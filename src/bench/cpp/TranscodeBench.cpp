@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * TranscodeBench.cpp
+ *
+ * Micro-benchmark for the UTF-8 <=> UTF-16 conversions used for the
+ * wide-character APIs and SQL_C_WCHAR bindings.
+ */
+
+#include "Bench.h"
+#include "../../driver/cpp/StringFunctions.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace io::snappydata;
+
+static std::string repeatToSize(const std::string& str, size_t size) {
+  std::string result;
+  result.reserve(size + str.size());
+  while (result.size() < size) {
+    result.append(str);
+  }
+  return result;
+}
+
+static void printResult(const char* name, const char* payload,
+    size_t numBytes, int numRuns,
+    std::chrono::high_resolution_clock::time_point start) {
+  auto end = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start);
+  const double nanos = static_cast<double>(duration.count());
+  bench::record(std::string("transcode/") + name + "/" + payload,
+      nanos / numRuns);
+  std::cout << name << " [" << payload << "]: " << (nanos / numRuns)
+      << " ns/op, " << ((numBytes * 1000.0 * numRuns) / nanos) << " MB/s"
+      << std::endl;
+}
+
+static void runBenchmark(const char* payload, const std::string& utf8,
+    int numRuns) {
+  std::vector<SQLWCHAR> wbuf(utf8.size() + 1);
+  std::vector<SQLCHAR> buf(utf8.size() + 1);
+  SQLLEN wlen = 0, len = 0;
+  size_t checksum = 0;
+
+  // warmup and also get the UTF-16 input for the reverse conversions
+  StringFunctions::copyString((const SQLCHAR*)utf8.data(), utf8.size(),
+      wbuf.data(), wbuf.size(), &wlen);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < numRuns; i++) {
+    StringFunctions::copyString((const SQLCHAR*)utf8.data(), utf8.size(),
+        wbuf.data(), wbuf.size(), &wlen);
+    checksum += wbuf[i % wlen];
+  }
+  printResult("UTF-8 to UTF-16 copyString", payload, utf8.size(), numRuns,
+      start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < numRuns; i++) {
+    StringFunctions::copyString(wbuf.data(), wlen, buf.data(), buf.size(),
+        &len);
+    checksum += buf[i % len];
+  }
+  printResult("UTF-16 to UTF-8 copyString", payload, utf8.size(), numRuns,
+      start);
+
+  std::vector<SQLCHAR> copyBuf(buf.size());
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < numRuns; i++) {
+    StringFunctions::copyString(buf.data(), len, copyBuf.data(),
+        copyBuf.size(), &len);
+    checksum += copyBuf[i % len];
+  }
+  printResult("UTF-8 to UTF-8 copyString", payload, utf8.size(), numRuns,
+      start);
+
+  std::vector<SQLWCHAR> wcopyBuf(wbuf.size());
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < numRuns; i++) {
+    StringFunctions::copyString(wbuf.data(), wlen, wcopyBuf.data(),
+        wcopyBuf.size(), &wlen);
+    checksum += wcopyBuf[i % wlen];
+  }
+  printResult("UTF-16 to UTF-16 copyString", payload, utf8.size(), numRuns,
+      start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < numRuns; i++) {
+    std::string str = StringFunctions::toString(wbuf.data(), wlen);
+    checksum += str.size();
+  }
+  printResult("UTF-16 to UTF-8 toString", payload, utf8.size(), numRuns,
+      start);
+
+  if (std::string((const char*)buf.data(), len) != utf8) {
+    std::cerr << "ERROR: round trip mismatch for " << payload << std::endl;
+  }
+  // print the checksum to avoid the loops from being optimized away
+  std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+int io::snappydata::bench::transcodeBench(int argc, const char* argv[]) {
+  const size_t size = argc > 1 ? std::stoul(argv[1]) : 256;
+  const int numRuns = argc > 2 ? std::stoi(argv[2]) : 1000000;
+
+  runBenchmark("ASCII", repeatToSize(
+      "The quick brown fox jumps over the lazy dog 0123456789. ", size),
+      numRuns);
+  runBenchmark("Latin-1", repeatToSize(
+      "Größenwahn café déjà vu naïve façade señor smörgåsbord. ", size),
+      numRuns);
+  runBenchmark("CJK", repeatToSize(
+      "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe3\x83\x86"
+      "\xe3\x82\xad\xe3\x82\xb9\xe3\x83\x88\xe4\xb8\xad\xe6\x96\x87"
+      "\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4", size), numRuns);
+  return 0;
+}
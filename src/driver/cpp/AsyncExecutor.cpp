@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * AsyncExecutor.cpp
+ */
+
+#include "AsyncExecutor.h"
+#include "SnappyDefaults.h"
+
+using namespace io::snappydata;
+
+AsyncExecutor::AsyncExecutor(const size_t maxWorkers) :
+    m_lock(), m_cond(), m_tasks(), m_workers(),
+    m_maxWorkers(maxWorkers > 0 ? maxWorkers : 1), m_idleWorkers(0),
+    m_shutdown(false) {
+}
+
+AsyncExecutor& AsyncExecutor::instance() {
+  static AsyncExecutor s_executor(static_cast<size_t>(
+      SnappyDefaults::DEFAULT_ASYNC_MAX_THREADS));
+  return s_executor;
+}
+
+void AsyncExecutor::run() {
+  std::unique_lock<std::mutex> sync(m_lock);
+  while (true) {
+    if (!m_tasks.empty()) {
+      Task task(std::move(m_tasks.front()));
+      m_tasks.pop_front();
+      sync.unlock();
+      task();
+      sync.lock();
+    } else if (m_shutdown) {
+      return;
+    } else {
+      m_idleWorkers++;
+      m_cond.wait(sync);
+      m_idleWorkers--;
+    }
+  }
+}
+
+void AsyncExecutor::submit(Task&& task) {
+  std::lock_guard<std::mutex> sync(m_lock);
+  m_tasks.push_back(std::move(task));
+  if (m_idleWorkers >= m_tasks.size() || m_workers.size() >= m_maxWorkers) {
+    m_cond.notify_one();
+  } else {
+    try {
+      m_workers.emplace_back(&AsyncExecutor::run, this);
+    } catch (...) {
+      // fail the submit only if there is no thread to run the task
+      if (m_workers.empty()) {
+        m_tasks.pop_back();
+        throw;
+      }
+      m_cond.notify_one();
+    }
+  }
+}
+
+void AsyncExecutor::shutdown() noexcept {
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard<std::mutex> sync(m_lock);
+    m_shutdown = true;
+    workers.swap(m_workers);
+    m_cond.notify_all();
+  }
+  for (auto& worker : workers) {
+    if (worker.joinable()) {
+      if (worker.get_id() == std::this_thread::get_id()) {
+        worker.detach();
+      } else {
+        worker.join();
+      }
+    }
+  }
+  std::lock_guard<std::mutex> sync(m_lock);
+  m_shutdown = false;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * AsyncExecutor.h
+ *
+ * Pool of driver owned threads used to run the operations of statements
+ * having SQL_ATTR_ASYNC_ENABLE turned on.
+ */
+
+#ifndef ASYNCEXECUTOR_H_
+#define ASYNCEXECUTOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * A simple thread pool that starts threads on demand up to a maximum
+   * and queues the tasks when all of them are busy. The threads are
+   * stopped by {@link #shutdown} when the last environment is freed.
+   */
+  class AsyncExecutor final {
+  public:
+    typedef std::function<void()> Task;
+
+  private:
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+    std::deque<Task> m_tasks;
+    std::vector<std::thread> m_workers;
+    const size_t m_maxWorkers;
+    /** number of threads waiting for a task */
+    size_t m_idleWorkers;
+    bool m_shutdown;
+
+    void run();
+
+  public:
+    explicit AsyncExecutor(const size_t maxWorkers);
+
+    ~AsyncExecutor() {
+      shutdown();
+    }
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    /** the executor shared by all the statements of the driver */
+    static AsyncExecutor& instance();
+
+    /**
+     * Queue a task for execution, starting a new thread if none is idle
+     * and the maximum has not been reached.
+     */
+    void submit(Task&& task);
+
+    /**
+     * Run all the queued tasks and stop the threads. A later submit will
+     * start new threads.
+     */
+    void shutdown() noexcept;
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* ASYNCEXECUTOR_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * CatalogCache.cpp
+ */
+
+#include "CatalogCache.h"
+
+#include <cctype>
+
+using namespace io::snappydata;
+
+CatalogCache::Key& CatalogCache::Key::add(const std::string* arg) {
+  // length prefix keeps the key unambiguous for any argument values
+  if (arg) {
+    m_key.append(1, '\n').append(std::to_string(arg->size())).append(1, ':')
+        .append(*arg);
+  } else {
+    m_key.append("\n-");
+  }
+  return *this;
+}
+
+CatalogCache::Key& CatalogCache::Key::add(
+    const std::vector<std::string>& args) {
+  add(static_cast<int>(args.size()));
+  for (const std::string& arg : args) {
+    add(&arg);
+  }
+  return *this;
+}
+
+CatalogCache::Key& CatalogCache::Key::add(const int arg) {
+  m_key.append(1, '\n').append(std::to_string(arg));
+  return *this;
+}
+
+void CatalogCache::setTimeToLive(const std::chrono::seconds ttl) {
+  std::lock_guard<std::mutex> sync(m_lock);
+  m_ttl = ttl.count() > 0 ? ttl : std::chrono::seconds(0);
+  m_entries.clear();
+}
+
+std::shared_ptr<const CatalogResult> CatalogCache::get(const Key& key) {
+  std::lock_guard<std::mutex> sync(m_lock);
+  auto search = m_entries.find(key.str());
+  if (search != m_entries.end()) {
+    if (search->second.m_expiry > std::chrono::steady_clock::now()) {
+      return search->second.m_result;
+    }
+    m_entries.erase(search);
+  }
+  return nullptr;
+}
+
+void CatalogCache::put(const Key& key,
+    const std::shared_ptr<const CatalogResult>& result) {
+  if (result->m_rows.size() > MAX_ROWS) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> sync(m_lock);
+  if (m_ttl.count() <= 0) {
+    return;
+  }
+  if (m_entries.size() >= MAX_ENTRIES) {
+    for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+      if (iter->second.m_expiry <= now) {
+        iter = m_entries.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    if (m_entries.size() >= MAX_ENTRIES) {
+      m_entries.clear();
+    }
+  }
+  Entry& entry = m_entries[key.str()];
+  entry.m_result = result;
+  entry.m_expiry = now + m_ttl;
+}
+
+void CatalogCache::clear() noexcept {
+  std::lock_guard<std::mutex> sync(m_lock);
+  m_entries.clear();
+}
+
+bool CatalogCache::isDDL(const std::string& sqlText) noexcept {
+  static const char* s_ddlKeywords[] = { "CREATE", "ALTER", "DROP",
+      "TRUNCATE", "RENAME", "GRANT", "REVOKE", "DEPLOY", "UNDEPLOY" };
+
+  const size_t len = sqlText.size();
+  size_t pos = 0;
+  // skip leading whitespace and comments
+  while (pos < len) {
+    if (std::isspace(static_cast<unsigned char>(sqlText[pos]))) {
+      pos++;
+    } else if (sqlText.compare(pos, 2, "--") == 0) {
+      pos = sqlText.find('\n', pos);
+      if (pos == std::string::npos) return false;
+    } else if (sqlText.compare(pos, 2, "/*") == 0) {
+      // bracketed comments can be nested
+      int depth = 1;
+      pos += 2;
+      while (depth > 0) {
+        if (pos + 1 >= len) return false;
+        if (sqlText.compare(pos, 2, "*/") == 0) {
+          depth--;
+          pos += 2;
+        } else if (sqlText.compare(pos, 2, "/*") == 0) {
+          depth++;
+          pos += 2;
+        } else {
+          pos++;
+        }
+      }
+    } else {
+      break;
+    }
+  }
+  // the first word ends at a character that cannot be in an identifier
+  size_t end = pos;
+  while (end < len && (std::isalnum(static_cast<unsigned char>(
+      sqlText[end])) || sqlText[end] == '_')) {
+    end++;
+  }
+  const size_t wordLen = end - pos;
+  for (const char* keyword : s_ddlKeywords) {
+    if (std::char_traits<char>::length(keyword) == wordLen) {
+      size_t i = 0;
+      while (i < wordLen && std::toupper(static_cast<unsigned char>(
+          sqlText[pos + i])) == keyword[i]) {
+        i++;
+      }
+      if (i == wordLen) return true;
+    }
+  }
+  return false;
+}
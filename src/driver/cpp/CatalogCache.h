@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * CatalogCache.h
+ *
+ * Client-side cache of the results of the catalog functions.
+ */
+
+#ifndef CATALOGCACHE_H_
+#define CATALOGCACHE_H_
+
+#include <ResultSet.h>
+
+#include "SnappyDescriptor.h"
+#include "StringFunctions.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * The rows and metadata of a catalog function result read fully from
+   * the server. It is never modified once cached and is shared by all the
+   * statements that have it as their current cursor, each of which reads
+   * the rows using its own cursor.
+   */
+  struct CatalogResult final {
+    /** the records of the IRD for the result */
+    std::vector<DescriptorRecord> m_records;
+    /** all the rows of the result */
+    std::vector<client::Row> m_rows;
+  };
+
+  /**
+   * Results of catalog functions (SQLTables, SQLColumns etc.) of a
+   * connection keyed by the DatabaseMetaDataCall and its arguments. The
+   * entries expire after a configured time and all of them are dropped
+   * when the connection executes a DDL statement.
+   */
+  class CatalogCache final {
+  public:
+    /** Builds the key for a catalog call and its arguments. */
+    class Key final {
+    private:
+      std::string m_key;
+
+    public:
+      explicit Key(const char* call) : m_key(call) {
+      }
+
+      /** add a string argument; a null argument is distinct from empty */
+      Key& add(const std::string* arg);
+
+      Key& add(const std::string& arg) {
+        return add(&arg);
+      }
+
+      Key& add(std::nullptr_t) {
+        return add(static_cast<const std::string*>(nullptr));
+      }
+
+      /** add a string argument of an ODBC catalog function */
+      template<typename CHAR_TYPE>
+      Key& add(const CHAR_TYPE* arg, const SQLSMALLINT len) {
+        if (arg) {
+          const std::string sarg(StringFunctions::toString(arg, len));
+          return add(&sarg);
+        } else {
+          return add(nullptr);
+        }
+      }
+
+      Key& add(const std::vector<std::string>& args);
+
+      Key& add(const int arg);
+
+      const std::string& str() const noexcept {
+        return m_key;
+      }
+    };
+
+  private:
+    struct Entry {
+      std::shared_ptr<const CatalogResult> m_result;
+      std::chrono::steady_clock::time_point m_expiry;
+    };
+
+    std::mutex m_lock;
+    std::unordered_map<std::string, Entry> m_entries;
+    /** time for which an entry is valid; zero when disabled */
+    std::chrono::seconds m_ttl;
+
+    /** maximum number of entries in a cache */
+    static const size_t MAX_ENTRIES = 1024;
+
+  public:
+    /** results with more rows than this are not cached */
+    static const size_t MAX_ROWS = 10000;
+
+    CatalogCache() : m_lock(), m_entries(), m_ttl(0) {
+    }
+
+    CatalogCache(const CatalogCache&) = delete;
+    CatalogCache& operator=(const CatalogCache&) = delete;
+
+    /** Set the time to live of new entries; zero disables the cache. */
+    void setTimeToLive(const std::chrono::seconds ttl);
+
+    inline bool isEnabled() const noexcept {
+      return m_ttl.count() > 0;
+    }
+
+    /** Get the result cached for given key, or null if none. */
+    std::shared_ptr<const CatalogResult> get(const Key& key);
+
+    /** Cache the result for given key. */
+    void put(const Key& key,
+        const std::shared_ptr<const CatalogResult>& result);
+
+    /** Drop all the cached results. */
+    void clear() noexcept;
+
+    /**
+     * Returns true if the given SQL text is a DDL statement that can
+     * change the results of catalog functions. The leading whitespace and
+     * comments, including nested bracketed comments, are skipped.
+     */
+    static bool isDDL(const std::string& sqlText) noexcept;
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* CATALOGCACHE_H_ */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * ConnectionPool.cpp
+ */
+
+#include <ClientAttribute.h>
+
+#include "ConnectionPool.h"
+
+#include <boost/algorithm/string.hpp>
+
+using namespace io::snappydata;
+
+/**
+ * check that all the properties, other than the default schema which is
+ * set afresh on a checked out connection, are the same
+ */
+static bool matchesIgnoringSchema(const Properties& props1,
+    const Properties& props2) {
+  size_t numProps1 = 0;
+  for (const auto& prop : props1) {
+    if (prop.first != ClientAttribute::DEFAULT_SCHEMA) {
+      auto search = props2.find(prop.first);
+      if (search == props2.end() || search->second != prop.second) {
+        return false;
+      }
+      numProps1++;
+    }
+  }
+  return numProps1 == props2.size()
+      - props2.count(ClientAttribute::DEFAULT_SCHEMA);
+}
+
+bool ConnectionPool::matches(const PooledConnection& pooled,
+    const std::string& server, const int port, const Properties& props,
+    const bool strictMatch) {
+  if (pooled.m_port != port || !boost::iequals(pooled.m_server, server)) {
+    return false;
+  }
+  if (strictMatch) {
+    return pooled.m_props == props;
+  } else {
+    // relaxed match allows a different default schema which is reset
+    // by the checkout, while security, SSL, load balancing etc. of the
+    // underlying connection must be the same
+    return matchesIgnoringSchema(pooled.m_props, props);
+  }
+}
+
+void ConnectionPool::closeAll(std::list<PooledConnection>& conns) noexcept {
+  for (auto& pooled : conns) {
+    try {
+      pooled.m_conn->close();
+    } catch (std::exception&) {
+      // ignore failures in closing idle connections
+    }
+  }
+  conns.clear();
+}
+
+void ConnectionPool::removeExpired(std::list<PooledConnection>& expired) {
+  const auto now = std::chrono::steady_clock::now();
+  // the ones at the end have been idle the longest
+  auto iter = m_idle.end();
+  while (iter != m_idle.begin()) {
+    --iter;
+    if (iter->m_expiry <= now) {
+      auto next = std::next(iter);
+      expired.splice(expired.end(), m_idle, iter);
+      iter = next;
+    }
+  }
+}
+
+bool ConnectionPool::checkout(const std::string& server, const int port,
+    const Properties& props, const bool strictMatch,
+    PooledConnection& result) {
+  std::list<PooledConnection> expired;
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> sync(m_lock);
+    removeExpired(expired);
+    for (auto iter = m_idle.begin(); iter != m_idle.end(); ++iter) {
+      if (matches(*iter, server, port, props, strictMatch)) {
+        result = std::move(*iter);
+        m_idle.erase(iter);
+        found = true;
+        break;
+      }
+    }
+  }
+  closeAll(expired);
+  return found;
+}
+
+void ConnectionPool::checkin(PooledConnection&& pooled,
+    const std::chrono::seconds idleTimeout) {
+  std::list<PooledConnection> expired;
+  pooled.m_expiry = std::chrono::steady_clock::now() + idleTimeout;
+  {
+    std::lock_guard<std::mutex> sync(m_lock);
+    m_idle.push_front(std::move(pooled));
+    removeExpired(expired);
+  }
+  closeAll(expired);
+}
+
+void ConnectionPool::clear() noexcept {
+  std::list<PooledConnection> idle;
+  try {
+    std::lock_guard<std::mutex> sync(m_lock);
+    idle.swap(m_idle);
+  } catch (std::exception&) {
+    // ignore lock failure
+  }
+  closeAll(idle);
+}
+
+size_t ConnectionPool::size() {
+  std::lock_guard<std::mutex> sync(m_lock);
+  return m_idle.size();
+}
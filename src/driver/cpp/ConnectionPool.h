@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * ConnectionPool.h
+ *
+ * Pool of idle native connections used for the driver level connection
+ * pooling enabled by SQL_ATTR_CONNECTION_POOLING.
+ */
+
+#ifndef CONNECTIONPOOL_H_
+#define CONNECTIONPOOL_H_
+
+#include <Connection.h>
+
+#include "SnappyDefaults.h"
+
+#include <chrono>
+#include <list>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * Holds the native connections parked by SQLDisconnect for reuse by a
+   * later connect to the same server with matching properties.
+   */
+  class ConnectionPool final {
+  public:
+    /** an idle connection in the pool */
+    struct PooledConnection {
+      std::unique_ptr<Connection> m_conn;
+      std::string m_server;
+      int m_port;
+      /** properties with which the connection was opened */
+      Properties m_props;
+      /** the isolation level when the connection was opened */
+      IsolationLevel m_isolation;
+      /** the connection is closed if it stays idle till this time */
+      std::chrono::steady_clock::time_point m_expiry;
+    };
+
+  private:
+    std::mutex m_lock;
+    /** idle connections with the most recently parked at front */
+    std::list<PooledConnection> m_idle;
+
+    /** move out the connections that have expired into the given list */
+    void removeExpired(std::list<PooledConnection>& expired);
+
+    static bool matches(const PooledConnection& pooled,
+        const std::string& server, const int port, const Properties& props,
+        const bool strictMatch);
+
+    static void closeAll(std::list<PooledConnection>& conns) noexcept;
+
+  public:
+    ConnectionPool() : m_lock(), m_idle() {
+    }
+
+    ~ConnectionPool() {
+      clear();
+    }
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /**
+     * Remove and return an idle connection matching the given server, port
+     * and properties. With strictMatch as false the default schema in the
+     * properties may differ, which the caller has to set on the returned
+     * connection.
+     *
+     * @return true if a matching connection was found
+     */
+    bool checkout(const std::string& server, const int port,
+        const Properties& props, const bool strictMatch,
+        PooledConnection& result);
+
+    /**
+     * Park a connection in the pool for the given idle timeout.
+     */
+    void checkin(PooledConnection&& pooled,
+        const std::chrono::seconds idleTimeout);
+
+    /** Close and remove all the idle connections. */
+    void clear() noexcept;
+
+    /** Returns the number of idle connections in the pool. */
+    size_t size();
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* CONNECTIONPOOL_H_ */
@@ -39,12 +39,207 @@
 
 #include "DriverBase.h"
 
+#include <algorithm>
+#include <deque>
 #include <typeinfo>
 
 using namespace io::snappydata;
 
-// define the last global exception (during initialization etc)
-std::atomic<SQLException*> SnappyHandleBase::s_globalError;
+std::atomic<bool> FunctionSampler::s_enabled(false);
+
+namespace {
+  std::mutex g_samplerLock;
+  std::vector<std::shared_ptr<FunctionSampler::Ring> > g_samplerRings;
+
+  struct SampleValue final {
+    const char* m_function;
+    int64_t m_startTime;
+    int64_t m_endTime;
+  };
+
+  /** the samples retained from a thread that has exited */
+  struct ExitedThread final {
+    std::thread::id m_threadId;
+    uint64_t m_count;
+    std::vector<SampleValue> m_samples;
+  };
+
+  /**
+   * Maximum number of samples retained from the threads that have exited
+   * beyond which those of the oldest threads are dropped.
+   */
+  const size_t MAX_EXITED_SAMPLES = 16 * FunctionSampler::RING_SIZE;
+  std::deque<ExitedThread> g_exitedThreads;
+  size_t g_numExitedSamples = 0;
+
+  /** registers the ring of a thread and retires it when thread exits */
+  struct ThreadRing final {
+    std::shared_ptr<FunctionSampler::Ring> m_ring;
+
+    ThreadRing() : m_ring(std::make_shared<FunctionSampler::Ring>()) {
+      std::lock_guard<std::mutex> sync(g_samplerLock);
+      g_samplerRings.push_back(m_ring);
+    }
+
+    ~ThreadRing() {
+      try {
+        std::lock_guard<std::mutex> sync(g_samplerLock);
+        for (auto iter = g_samplerRings.begin();
+            iter != g_samplerRings.end(); ++iter) {
+          if (*iter == m_ring) {
+            g_samplerRings.erase(iter);
+            break;
+          }
+        }
+        // no more samples can be recorded since this thread is exiting
+        const FunctionSampler::Ring& ring = *m_ring;
+        const uint64_t count = ring.m_count.load(std::memory_order_relaxed);
+        // skip the samples already written by a dump
+        if (count == ring.m_dumpedCount) return;
+        const uint64_t start = std::max<uint64_t>(ring.m_dumpedCount,
+            count > FunctionSampler::RING_SIZE
+                ? (count - FunctionSampler::RING_SIZE) : 0);
+        ExitedThread exited{ ring.m_threadId, count,
+          std::vector<SampleValue>() };
+        exited.m_samples.reserve(static_cast<size_t>(count - start));
+        for (uint64_t i = start; i < count; i++) {
+          const FunctionSampler::Sample& sample = ring.m_samples[
+              i & (FunctionSampler::RING_SIZE - 1)];
+          exited.m_samples.push_back(SampleValue{
+            sample.m_function.load(std::memory_order_relaxed),
+            sample.m_startTime.load(std::memory_order_relaxed),
+            sample.m_endTime.load(std::memory_order_relaxed) });
+        }
+        g_numExitedSamples += exited.m_samples.size();
+        g_exitedThreads.push_back(std::move(exited));
+        while (g_numExitedSamples > MAX_EXITED_SAMPLES) {
+          g_numExitedSamples -= g_exitedThreads.front().m_samples.size();
+          g_exitedThreads.pop_front();
+        }
+      } catch (...) {
+        // ignore failure to retain the samples
+      }
+    }
+  };
+}
+
+void FunctionSampler::record(const char* function, int64_t startTime,
+    int64_t endTime) noexcept {
+  try {
+    static thread_local ThreadRing t_ring;
+    Ring& ring = *t_ring.m_ring;
+    const uint64_t count = ring.m_count.load(std::memory_order_relaxed);
+    Sample& sample = ring.m_samples[count & (RING_SIZE - 1)];
+    sample.m_function.store(function, std::memory_order_relaxed);
+    sample.m_startTime.store(startTime, std::memory_order_relaxed);
+    sample.m_endTime.store(endTime, std::memory_order_relaxed);
+    ring.m_count.store(count + 1, std::memory_order_release);
+  } catch (...) {
+    // ignore failure to allocate the ring
+  }
+}
+
+std::vector<std::shared_ptr<FunctionSampler::Ring> > FunctionSampler::rings() {
+  std::lock_guard<std::mutex> sync(g_samplerLock);
+  return g_samplerRings;
+}
+
+void FunctionSampler::dump(std::ostream& out) {
+  // held throughout so that the samples of a thread exiting concurrently
+  // are written exactly once
+  std::lock_guard<std::mutex> sync(g_samplerLock);
+  for (const auto& ring : g_samplerRings) {
+    const uint64_t count = ring->m_count.load(std::memory_order_acquire);
+    if (count == ring->m_dumpedCount) continue;
+    const uint64_t start = std::max<uint64_t>(ring->m_dumpedCount,
+        count > RING_SIZE ? (count - RING_SIZE) : 0);
+    ring->m_dumpedCount = count;
+    out << "THREAD " << ring->m_threadId << " CALLS " << count << '\n';
+    for (uint64_t i = start; i < count; i++) {
+      const Sample& sample = ring->m_samples[i & (RING_SIZE - 1)];
+      const int64_t startTime = sample.m_startTime.load(
+          std::memory_order_relaxed);
+      out << '\t' << sample.m_function.load(std::memory_order_relaxed)
+          << ' ' << startTime << ' '
+          << (sample.m_endTime.load(std::memory_order_relaxed) - startTime)
+          << '\n';
+    }
+  }
+  for (const auto& exited : g_exitedThreads) {
+    out << "THREAD " << exited.m_threadId << " CALLS " << exited.m_count
+        << " (exited)\n";
+    for (const auto& sample : exited.m_samples) {
+      out << '\t' << sample.m_function << ' ' << sample.m_startTime << ' '
+          << (sample.m_endTime - sample.m_startTime) << '\n';
+    }
+  }
+  g_exitedThreads.clear();
+  g_numExitedSamples = 0;
+  out.flush();
+}
+
+DiagRecords::DiagRecords(SQLException* error) : m_error(error),
+    m_records() {
+  m_error->fillRecords("[" ODBC_PRODUCT_NAME "] ", MAX_RECORD_SIZE,
+      LogWriter::fineEnabled());
+  const auto& records = m_error->getRecords();
+  m_records.reserve(records.size());
+  for (const auto& record : records) {
+    m_records.push_back(Record{ record.first->getSQLState(),
+        static_cast<SQLINTEGER>(record.first->getSeverity()),
+        record.second });
+  }
+}
+
+namespace {
+  /**
+   * The last global exception (during initialization etc) of the current
+   * thread, so that threads failing concurrently neither contend on it
+   * nor read the diagnostics of another thread.
+   */
+  std::unique_ptr<const DiagRecords>& globalError() {
+    static thread_local std::unique_ptr<const DiagRecords> t_globalError;
+    return t_globalError;
+  }
+
+  /** the innermost DeferredDiagnostics in scope in the current thread */
+  SnappyHandleBase::DeferredDiagnostics*& deferredDiagnostics() noexcept {
+    static thread_local SnappyHandleBase::DeferredDiagnostics* t_deferred =
+        nullptr;
+    return t_deferred;
+  }
+}
+
+SnappyHandleBase::DeferredDiagnostics::DeferredDiagnostics(
+    const SnappyHandleBase* handle) noexcept : m_handle(handle),
+    m_previous(deferredDiagnostics()), m_records() {
+  deferredDiagnostics() = this;
+}
+
+SnappyHandleBase::DeferredDiagnostics::~DeferredDiagnostics() {
+  deferredDiagnostics() = m_previous;
+}
+
+std::shared_ptr<const DiagRecords>& SnappyHandleBase::diagnostics()
+    noexcept {
+  for (DeferredDiagnostics* deferred = deferredDiagnostics(); deferred;
+      deferred = deferred->m_previous) {
+    if (deferred->m_handle == this) {
+      return deferred->m_records;
+    }
+  }
+  return m_lastError;
+}
+
+const std::shared_ptr<const DiagRecords>& SnappyHandleBase::diagnostics()
+    const noexcept {
+  return const_cast<SnappyHandleBase*>(this)->diagnostics();
+}
+
+void SnappyHandleBase::setDiagnostics(
+    std::shared_ptr<const DiagRecords> records) noexcept {
+  std::atomic_store(&diagnostics(), std::move(records));
+}
 
 SQLException* SnappyHandleBase::getUnknownException(const char* file,
     int line, std::exception& ex) {
@@ -66,7 +261,7 @@ SQLException* SnappyHandleBase::getUnknownException(const char* file,
 }
 
 void SnappyHandleBase::setGlobalException(SQLException* ex) {
-  delete s_globalError.exchange(ex, std::memory_order_acquire);
+  globalError().reset(new DiagRecords(ex));
 }
 
 void SnappyHandleBase::setGlobalException(SQLException& ex) {
@@ -83,41 +278,70 @@ void SnappyHandleBase::setGlobalException(const char* file, int line,
 }
 
 SQLException* SnappyHandleBase::lastGlobalError() noexcept {
-  return s_globalError.load(std::memory_order_acquire);
+  const DiagRecords* records = globalError().get();
+  return records ? records->getError() : nullptr;
+}
+
+const DiagRecords* SnappyHandleBase::lastGlobalDiagRecords() noexcept {
+  return globalError().get();
 }
 
 void SnappyHandleBase::clearLastGlobalError() noexcept {
-  delete s_globalError.exchange(nullptr, std::memory_order_acquire);
+  std::unique_ptr<const DiagRecords>& records = globalError();
+  if (records) {
+    records.reset();
+  }
 }
 
 void SnappyHandleBase::setException(SQLException& ex) {
-  m_lastError.reset(ex.clone(true));
+  setDiagnostics(std::make_shared<const DiagRecords>(ex.clone(true)));
 }
 
 void SnappyHandleBase::setException(SQLException&& ex) {
-  m_lastError.reset(ex.clone(true));
+  setDiagnostics(std::make_shared<const DiagRecords>(ex.clone(true)));
 }
 
 void SnappyHandleBase::setException(const char* file, int line,
     std::exception& ex) {
-  m_lastError.reset(getUnknownException(file, line, ex));
+  setDiagnostics(std::make_shared<const DiagRecords>(
+      getUnknownException(file, line, ex)));
 }
 
 void SnappyHandleBase::setSQLWarning(SQLWarning& warning) {
-  m_lastError.reset(warning.clone(true));
+  setDiagnostics(std::make_shared<const DiagRecords>(warning.clone(true)));
 }
 
 SQLException* SnappyHandleBase::lastError() const noexcept {
-  return m_lastError.get();
+  // only used by the thread that sets the diagnostics of the handle
+  const DiagRecords* records = lastDiagRecords();
+  return records ? records->getError() : nullptr;
+}
+
+const DiagRecords* SnappyHandleBase::lastDiagRecords() const noexcept {
+  return std::atomic_load(&diagnostics()).get();
+}
+
+std::shared_ptr<const DiagRecords> SnappyHandleBase::diagRecords()
+    const noexcept {
+  return std::atomic_load(&diagnostics());
 }
 
 void SnappyHandleBase::clearLastError() noexcept {
-  if (m_lastError) {
-    m_lastError = nullptr;
+  if (lastDiagRecords()) {
+    setDiagnostics(nullptr);
   }
   clearLastGlobalError();
 }
 
+void SnappyHandleBase::setLastError(const SnappyHandleBase& handle) noexcept {
+  setDiagnostics(handle.diagRecords());
+}
+
+void SnappyHandleBase::setDiagRecords(
+    const std::shared_ptr<const DiagRecords>& records) noexcept {
+  setDiagnostics(records);
+}
+
 SQLRETURN SnappyHandleBase::errorNullHandle(SQLSMALLINT handleType) {
   SnappyHandleBase::setGlobalException(
       GET_SQLEXCEPTION2(SQLStateMessage::NULL_HANDLE_MSG, handleType));
@@ -55,11 +55,15 @@ extern "C" {
 #include <ClientBase.h>
 
 #include <atomic>
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "StringFunctions.h"
+#include "TraceEvents.h"
 
 using namespace io::snappydata::client;
 
@@ -90,47 +94,110 @@ using namespace io::snappydata::client;
 
 #define SQL_PRODUCT_NAME         50001
 
+/**
+ * driver specific connection attributes (read-only SQLUBIGINT counters);
+ * SQL_ATTR_STMT_CACHE_HITS is also one of the performance counters below
+ */
+#define SQL_ATTR_STMT_CACHE_HITS    50101
+#define SQL_ATTR_STMT_CACHE_MISSES  50102
+
+/**
+ * driver specific statement attributes: the number of rows of forward-only
+ * cursors read ahead in background (SQLULEN, zero to disable)
+ */
+#define SQL_ATTR_READ_AHEAD_ROWS    50201
+
+/**
+ * driver specific performance counters (read-only SQLUBIGINT) of a
+ * statement with SQLGetStmtAttr, of all the statements of a connection
+ * with SQLGetConnectAttr, and of all the connections of an environment
+ * with SQLGetEnvAttr (see PerfCounters); the statement cache hits are
+ * read with SQL_ATTR_STMT_CACHE_HITS in the same way
+ */
+#define SQL_ATTR_PERF_ROUND_TRIPS       50301
+#define SQL_ATTR_PERF_ROWS_FETCHED      50302
+#define SQL_ATTR_PERF_BATCHES_FETCHED   50303
+#define SQL_ATTR_PERF_PREPARES          50304
+#define SQL_ATTR_PERF_EXECUTES          50305
+#define SQL_ATTR_PERF_NETWORK_NANOS     50306
+#define SQL_ATTR_PERF_CONVERSION_NANOS  50307
+
+/**
+ * ODBC 3.8 asynchronous notification support used by the driver manager,
+ * defined here since the driver itself is compiled against ODBC 3.52
+ */
+#ifndef SQL_ATTR_ASYNC_STMT_EVENT
+#define SQL_ATTR_ASYNC_STMT_EVENT   29
+#endif
+#ifndef SQL_ATTR_ASYNC_STMT_PCALLBACK
+#define SQL_ATTR_ASYNC_STMT_PCALLBACK  10012
+#define SQL_ATTR_ASYNC_STMT_PCONTEXT   10013
+#endif
+#ifndef SQL_ASYNC_NOTIFICATION
+#define SQL_ASYNC_NOTIFICATION               10025
+#define SQL_ASYNC_NOTIFICATION_NOT_CAPABLE   0x00000000L
+#define SQL_ASYNC_NOTIFICATION_CAPABLE       0x00000001L
+#endif
+
 #define SNAPPY_GLOBAL_ERROR io::snappydata::SnappyHandleBase::lastGlobalError()
 
+/**
+ * Compile-time level of the API function tracing:
+ *
+ * 0 - no tracing; FUNCTION_ENTER is empty and FUNCTION_RETURN is a plain return
+ * 1 - only sampled entry/exit timestamps when enabled (see FunctionSampler)
+ * 2 - sampling as well as full tracing of arguments when debug logging is on
+ *
+ * The arguments to the tracing macros are never evaluated unless the full
+ * tracing is enabled at runtime.
+ */
+#ifndef SNAPPY_TRACE_LEVEL
+#define SNAPPY_TRACE_LEVEL 2
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SNAPPY_LIKELY(x) __builtin_expect(!!(x), 1)
+#define SNAPPY_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define SNAPPY_LIKELY(x) (x)
+#define SNAPPY_UNLIKELY(x) (x)
+#endif
+
+#if SNAPPY_TRACE_LEVEL >= 2
+#define SNAPPY_TRACE_ENABLED() \
+  SNAPPY_UNLIKELY(io::snappydata::client::LogWriter::debugEnabled())
+#else
+#define SNAPPY_TRACE_ENABLED() false
+#endif
+
+#if SNAPPY_TRACE_LEVEL >= 1
+#define FUNCTION_SAMPLE() \
+  io::snappydata::FunctionSampler::Scope snappyFunctionScope_(__func__)
+#else
+#define FUNCTION_SAMPLE() (void)0
+#endif
+
 #ifdef _WINDOWS
 #define FUNCTION_LOG(tag, ...) \
   io::snappydata::FunctionTracer::trace(tag, __FILE__, __LINE__, __FUNCSIG__, __VA_ARGS__)
-#define FUNCTION_ENTER(...) FUNCTION_LOG("ENTER", ##__VA_ARGS__)
-#define FUNCTION_RETURN(r, ...) \
-  if (io::snappydata::client::LogWriter::debugEnabled()) { \
-    if (SQL_SUCCEEDED(r)) { \
-      io::snappydata::FunctionTracer::traceExit("EXIT", __FILE__, __LINE__, __FUNCSIG__, \
-          r, __VA_ARGS__); \
-    } else if (SNAPPY_GLOBAL_ERROR) { \
-      FUNCTION_LOG("EXIT", "ERROR", SNAPPY_GLOBAL_ERROR->toString(), "Result", r); \
-    } else { \
-      FUNCTION_LOG("EXIT", "Result", r); \
-    } \
-  } \
-  return r
-#define FUNCTION_RETURN_HANDLE(h, r, ...) \
-  if (io::snappydata::client::LogWriter::debugEnabled()) { \
-    if (SQL_SUCCEEDED(r)) { \
-      io::snappydata::FunctionTracer::traceExit("EXIT", __FILE__, __LINE__, __FUNCSIG__, \
-          r, __VA_ARGS__); \
-    } else if (h && ((SnappyHandleBase*)h)->lastError()) { \
-      FUNCTION_LOG("EXIT", "ERROR", ((SnappyHandleBase*)h)->lastError()->toString(), "Result", r); \
-    } else if (SNAPPY_GLOBAL_ERROR) { \
-      FUNCTION_LOG("EXIT", "ERROR", SNAPPY_GLOBAL_ERROR->toString(), "Result", r); \
-    } else { \
-      FUNCTION_LOG("EXIT", "Result", r); \
-    } \
-  } \
-  return r
+#define FUNCTION_LOG_EXIT(r, ...) \
+  io::snappydata::FunctionTracer::traceExit("EXIT", __FILE__, __LINE__, __FUNCSIG__, \
+      r, __VA_ARGS__)
 #else
 #define FUNCTION_LOG(tag, ...) \
   io::snappydata::FunctionTracer::trace(tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, ##__VA_ARGS__)
-#define FUNCTION_ENTER(...) FUNCTION_LOG("ENTER", ##__VA_ARGS__)
+#define FUNCTION_LOG_EXIT(r, ...) \
+  io::snappydata::FunctionTracer::traceExit("EXIT", __FILE__, __LINE__, __PRETTY_FUNCTION__, \
+      r, ##__VA_ARGS__)
+#endif
+
+#define FUNCTION_ENTER(...) \
+  FUNCTION_SAMPLE(); \
+  if (!SNAPPY_TRACE_ENABLED()) {} else FUNCTION_LOG("ENTER", ##__VA_ARGS__)
 #define FUNCTION_RETURN(r, ...) \
-  if (io::snappydata::client::LogWriter::debugEnabled()) { \
+  if (SNAPPY_TRACE_ENABLED()) { \
     if (SQL_SUCCEEDED(r)) { \
-      io::snappydata::FunctionTracer::traceExit("EXIT", __FILE__, __LINE__, __PRETTY_FUNCTION__, \
-          r, ##__VA_ARGS__); \
+      FUNCTION_LOG_EXIT(r, ##__VA_ARGS__); \
     } else if (SNAPPY_GLOBAL_ERROR) { \
       FUNCTION_LOG("EXIT", "ERROR", SNAPPY_GLOBAL_ERROR->toString(), "Result", r); \
     } else { \
@@ -139,10 +206,9 @@ using namespace io::snappydata::client;
   } \
   return r
 #define FUNCTION_RETURN_HANDLE(h, r, ...) \
-  if (io::snappydata::client::LogWriter::debugEnabled()) { \
+  if (SNAPPY_TRACE_ENABLED()) { \
     if (SQL_SUCCEEDED(r)) { \
-      io::snappydata::FunctionTracer::traceExit("EXIT", __FILE__, __LINE__, __PRETTY_FUNCTION__, \
-          r, ##__VA_ARGS__); \
+      FUNCTION_LOG_EXIT(r, ##__VA_ARGS__); \
     } else if (h && ((SnappyHandleBase*)h)->lastError()) { \
       FUNCTION_LOG("EXIT", "ERROR", ((SnappyHandleBase*)h)->lastError()->toString(), "Result", r); \
     } else if (SNAPPY_GLOBAL_ERROR) { \
@@ -152,7 +218,6 @@ using namespace io::snappydata::client;
     } \
   } \
   return r
-#endif
 
 namespace io {
 namespace snappydata {
@@ -255,11 +320,172 @@ namespace snappydata {
     }
   };
 
+  /**
+   * Cheap sampling of API function calls that only records the entry and
+   * exit timestamps of each call into a fixed size per-thread ring buffer.
+   * Enabled by setting SNAPPY_ODBC_TRACE_SAMPLES environment variable to
+   * the file where the samples are appended when the last environment is
+   * freed. The samples of a thread are retained after it exits.
+   * The calls are also recorded as TraceEvents when those are enabled.
+   */
+  class FunctionSampler final {
+  public:
+    /** number of calls retained per thread (must be a power of two) */
+    static const size_t RING_SIZE = 4096;
+
+    struct Sample {
+      std::atomic<const char*> m_function;
+      /** nanoseconds since steady_clock epoch */
+      std::atomic<int64_t> m_startTime;
+      std::atomic<int64_t> m_endTime;
+    };
+
+    struct Ring {
+      const std::thread::id m_threadId;
+      std::atomic<uint64_t> m_count;
+      /** the calls already written by dump; guarded by the sampler lock */
+      uint64_t m_dumpedCount;
+      Sample m_samples[RING_SIZE];
+
+      Ring() : m_threadId(std::this_thread::get_id()), m_count(0),
+          m_dumpedCount(0) {
+      }
+    };
+
+    class Scope final {
+    private:
+      const char* const m_function;
+      const int64_t m_startTime;
+
+    public:
+      explicit Scope(const char* function) noexcept : m_function(function),
+          m_startTime(SNAPPY_UNLIKELY(isEnabled() ||
+              TraceEvents::isEnabled()) ? currentTime() : 0) {
+      }
+
+      ~Scope() {
+        if (SNAPPY_UNLIKELY(m_startTime != 0)) {
+          const int64_t endTime = currentTime();
+          if (isEnabled()) {
+            record(m_function, m_startTime, endTime);
+          }
+          if (TraceEvents::isEnabled()) {
+            TraceEvents::record(TraceEvents::API, m_function, m_startTime,
+                endTime);
+          }
+        }
+      }
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+    };
+
+  private:
+    static std::atomic<bool> s_enabled;
+
+    FunctionSampler() = delete;
+
+  public:
+    static bool isEnabled() noexcept {
+      return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enabled) noexcept {
+      s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    static int64_t currentTime() noexcept {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void record(const char* function, int64_t startTime,
+        int64_t endTime) noexcept;
+
+    /**
+     * Get the rings of all the live threads. The samples may be
+     * concurrently overwritten by their threads while being read.
+     */
+    static std::vector<std::shared_ptr<Ring> > rings();
+
+    /**
+     * Write the samples of all live threads followed by those of the
+     * threads that have exited, oldest first per thread. Only the samples
+     * recorded after the previous dump are written, and those of the
+     * exited threads are dropped once written.
+     */
+    static void dump(std::ostream& out);
+  };
+
+  /**
+   * The diagnostic records of an error or warning set on a handle. These
+   * are formatted once when created and never modified after that, so
+   * SQLGetDiagRec and SQLGetDiagField can read them without any locking.
+   */
+  class DiagRecords final {
+  public:
+    struct Record final {
+      std::string m_sqlState;
+      SQLINTEGER m_nativeError;
+      std::string m_message;
+    };
+
+    /**
+     * Maximum size of the formatted message of a record which is the
+     * largest buffer that can be passed to SQLGetDiagRec.
+     */
+    static const SQLUINTEGER MAX_RECORD_SIZE = 32766;
+
+  private:
+    const std::unique_ptr<SQLException> m_error;
+    std::vector<Record> m_records;
+
+  public:
+    /** Format the records of given error taking over its ownership. */
+    explicit DiagRecords(SQLException* error);
+
+    DiagRecords(const DiagRecords&) = delete;
+    DiagRecords& operator=(const DiagRecords&) = delete;
+
+    inline SQLException* getError() const noexcept {
+      return m_error.get();
+    }
+
+    inline size_t size() const noexcept {
+      return m_records.size();
+    }
+
+    /** Get the record at given 1-based position or null if out of range. */
+    inline const Record* get(SQLSMALLINT recNumber) const noexcept {
+      return recNumber > 0 && static_cast<size_t>(recNumber)
+          <= m_records.size() ? &m_records[recNumber - 1] : nullptr;
+    }
+  };
+
+  /**
+   * Whether given exception signals the end of a cursor which is checked
+   * on its SQLState since the message may be localized or parameterized.
+   */
+  inline bool isEndOfCursor(const SQLException& sqle) {
+    return std::string(sqle.getSQLState()) ==
+        client::SQLState::NO_CURRENT_ROW.getSQLState();
+  }
+
   class SnappyHandleBase {
   private:
-    static std::atomic<SQLException*> s_globalError;
+    /**
+     * The records of last error or warning; immutable so can be shared
+     * with other handles like the implicit descriptors of a statement.
+     * Always accessed with the atomic shared_ptr functions since
+     * SQLGetDiagRec/Field can read it while another thread sets it.
+     */
+    std::shared_ptr<const DiagRecords> m_lastError;
+
+    /** the diagnostics of this handle as seen by the current thread */
+    std::shared_ptr<const DiagRecords>& diagnostics() noexcept;
+    const std::shared_ptr<const DiagRecords>& diagnostics() const noexcept;
 
-    std::unique_ptr<SQLException> m_lastError;
+    void setDiagnostics(std::shared_ptr<const DiagRecords> records) noexcept;
 
     static SQLException* getUnknownException(const char* file, int line,
         std::exception& ex);
@@ -279,13 +505,45 @@ namespace snappydata {
     friend class SnappyEnvironment;
 
   public:
+    /**
+     * Collects the diagnostics set on a handle by the current thread while
+     * in scope instead of setting them on the handle. This lets an
+     * asynchronous operation publish its diagnostics only with its final
+     * result so the application never reads them while they are written.
+     */
+    class DeferredDiagnostics final {
+    private:
+      const SnappyHandleBase* const m_handle;
+      DeferredDiagnostics* const m_previous;
+      std::shared_ptr<const DiagRecords> m_records;
+
+      friend class SnappyHandleBase;
+
+    public:
+      explicit DeferredDiagnostics(const SnappyHandleBase* handle) noexcept;
+      ~DeferredDiagnostics();
+
+      DeferredDiagnostics(const DeferredDiagnostics&) = delete;
+      DeferredDiagnostics& operator=(const DeferredDiagnostics&) = delete;
+
+      inline const std::shared_ptr<const DiagRecords>& records()
+          const noexcept {
+        return m_records;
+      }
+    };
+
     static void setGlobalException(SQLException& ex);
     static void setGlobalException(SQLException&& ex);
 
     static void setGlobalException(const char* file, int line,
         std::exception& ex);
 
+    /**
+     * The last error that could not be set on a handle. This is kept per
+     * thread which is the one that will read it after the failed call.
+     */
     static SQLException* lastGlobalError() noexcept;
+    static const DiagRecords* lastGlobalDiagRecords() noexcept;
     static void clearLastGlobalError() noexcept;
 
     void setException(SQLException& ex);
@@ -295,8 +553,22 @@ namespace snappydata {
     void setSQLWarning(SQLWarning& warning);
 
     SQLException* lastError() const noexcept;
+    const DiagRecords* lastDiagRecords() const noexcept;
+    /**
+     * The records of the last error or warning, if any, that remain valid
+     * for the caller even if the handle's diagnostics are concurrently
+     * replaced.
+     */
+    std::shared_ptr<const DiagRecords> diagRecords() const noexcept;
     void clearLastError() noexcept;
 
+    /** Set the last error or warning of given handle on this handle. */
+    void setLastError(const SnappyHandleBase& handle) noexcept;
+
+    /** Set the given records, possibly null, as the last error or warning. */
+    void setDiagRecords(
+        const std::shared_ptr<const DiagRecords>& records) noexcept;
+
     /** Common utility to handle a nullptr passed in handle. */
     static SQLRETURN errorNullHandle(SQLSMALLINT handleType);
     /** Common utility to handle a nullptr passed in handle. */
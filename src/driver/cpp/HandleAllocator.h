@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * HandleAllocator.h
+ *
+ * Free list allocator for the handles allocated and freed at a high rate.
+ */
+
+#ifndef HANDLEALLOCATOR_H_
+#define HANDLEALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * Allocates the memory of objects of type T, to be used by its class
+   * specific operator new and delete. The freed blocks are kept in a free
+   * list of the freeing thread, up to MAX_FREE of them, and reused by the
+   * next allocations on that thread so that handles that are churned by
+   * the application neither go to the system allocator every time nor
+   * contend on any lock.
+   */
+  template<typename T, size_t MAX_FREE = 256>
+  class HandleAllocator final {
+  private:
+    struct FreeBlock final {
+      FreeBlock* m_next;
+    };
+
+    struct FreeList final {
+      FreeBlock* m_head;
+      size_t m_size;
+
+      FreeList() noexcept : m_head(nullptr), m_size(0) {
+      }
+
+      ~FreeList() {
+        while (m_head) {
+          FreeBlock* block = m_head;
+          m_head = block->m_next;
+          ::operator delete(block);
+        }
+        m_size = 0;
+        destroyed() = true;
+      }
+    };
+
+    /**
+     * Set when the free list of current thread has been destroyed at
+     * thread exit after which the blocks go to the system allocator.
+     */
+    static bool& destroyed() noexcept {
+      static thread_local bool t_destroyed = false;
+      return t_destroyed;
+    }
+
+    static FreeList* freeList() noexcept {
+      if (destroyed()) {
+        return nullptr;
+      }
+      static thread_local FreeList t_freeList;
+      return &t_freeList;
+    }
+
+  public:
+    static void* allocate(const size_t size) {
+      static_assert(sizeof(T) >= sizeof(FreeBlock),
+          "handle smaller than a free list link");
+      FreeList* list;
+      if (size == sizeof(T) && (list = freeList()) && list->m_head) {
+        FreeBlock* block = list->m_head;
+        list->m_head = block->m_next;
+        list->m_size--;
+        return block;
+      } else {
+        return ::operator new(size);
+      }
+    }
+
+    static void deallocate(void* p, const size_t size) noexcept {
+      FreeList* list;
+      if (p && size == sizeof(T) && (list = freeList()) &&
+          list->m_size < MAX_FREE) {
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->m_next = list->m_head;
+        list->m_head = block;
+        list->m_size++;
+      } else {
+        ::operator delete(p);
+      }
+    }
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* HANDLEALLOCATOR_H_ */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * InfoTable.cpp
+ */
+
+#include <ClientAttribute.h>
+
+#include "InfoTable.h"
+
+using namespace io::snappydata;
+
+void InfoValue::setString(const char* value, const SQLLEN len,
+    const char* name) {
+  if (len == SQL_NTS) {
+    m_string.assign(value);
+  } else {
+    m_string.assign(value, static_cast<size_t>(len));
+  }
+  m_name = name;
+  m_size = 0;
+}
+
+const InfoValue* InfoTable::get(const SQLUSMALLINT infoType) {
+  const int index = slotIndex(infoType);
+  if (index >= 0) {
+    return m_slots[index].load(std::memory_order_acquire);
+  }
+  std::lock_guard<std::mutex> sync(m_lock);
+  auto search = m_values.find(infoType);
+  return search != m_values.end() ? &search->second : nullptr;
+}
+
+const InfoValue* InfoTable::put(const SQLUSMALLINT infoType,
+    InfoValue&& value) {
+  std::lock_guard<std::mutex> sync(m_lock);
+  // elements of the map are never moved so the slot can point into it
+  const InfoValue* stored =
+      &m_values.emplace(infoType, std::move(value)).first->second;
+  const int index = slotIndex(infoType);
+  if (index >= 0) {
+    m_slots[index].store(stored, std::memory_order_release);
+  }
+  return stored;
+}
+
+std::shared_ptr<InfoTable> InfoTable::forServer(const std::string& server,
+    const int port, const Properties& props) {
+  // never destroyed so that it can be used by handles freed at exit
+  static std::mutex* s_lock = new std::mutex();
+  static auto* s_tables =
+      new std::unordered_map<std::string, std::shared_ptr<InfoTable> >();
+
+  std::string key(server);
+  key.append(1, ':').append(std::to_string(port));
+  for (const auto& prop : props) {
+    if (prop.first != ClientAttribute::USERNAME &&
+        prop.first != ClientAttribute::PASSWORD) {
+      key.append(1, '\n').append(prop.first).append(1, '=')
+          .append(prop.second);
+    }
+  }
+  std::lock_guard<std::mutex> sync(*s_lock);
+  std::shared_ptr<InfoTable>& table = (*s_tables)[key];
+  if (!table) {
+    table.reset(new InfoTable());
+  }
+  return table;
+}
+
+bool InfoTable::isConnectionInfo(const SQLUSMALLINT infoType) noexcept {
+  switch (infoType) {
+    case SQL_SERVER_NAME:
+    case SQL_USER_NAME:
+    case SQL_DATA_SOURCE_NAME:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const SQLUSMALLINT* InfoTable::allInfoTypes() noexcept {
+  static const SQLUSMALLINT s_infoTypes[] = {
+      SQL_DRIVER_NAME, SQL_PRODUCT_NAME, SQL_DRIVER_VER, SQL_DRIVER_ODBC_VER,
+      SQL_ODBC_VER, SQL_DATABASE_NAME, SQL_DBMS_NAME, SQL_DBMS_VER,
+      SQL_ODBC_INTERFACE_CONFORMANCE, SQL_ODBC_API_CONFORMANCE,
+      SQL_SQL_CONFORMANCE, SQL_ODBC_SQL_CONFORMANCE,
+      SQL_STANDARD_CLI_CONFORMANCE, SQL_XOPEN_CLI_YEAR, SQL_MAX_IDENTIFIER_LEN,
+      SQL_MAX_DRIVER_CONNECTIONS, SQL_MAX_CONCURRENT_ACTIVITIES,
+      SQL_ACTIVE_ENVIRONMENTS, SQL_SCROLL_OPTIONS, SQL_SCROLL_CONCURRENCY,
+      SQL_STATIC_SENSITIVITY, SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1,
+      SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2, SQL_DYNAMIC_CURSOR_ATTRIBUTES1,
+      SQL_DYNAMIC_CURSOR_ATTRIBUTES2, SQL_STATIC_CURSOR_ATTRIBUTES1,
+      SQL_STATIC_CURSOR_ATTRIBUTES2, SQL_BATCH_SUPPORT, SQL_BATCH_ROW_COUNT,
+      SQL_PARAM_ARRAY_ROW_COUNTS, SQL_CURSOR_COMMIT_BEHAVIOR,
+      SQL_CURSOR_ROLLBACK_BEHAVIOR, SQL_CURSOR_SENSITIVITY,
+      SQL_EXPRESSIONS_IN_ORDERBY, SQL_OJ_CAPABILITIES, SQL_GETDATA_EXTENSIONS,
+      SQL_TXN_CAPABLE, SQL_CATALOG_USAGE, SQL_CATALOG_TERM, SQL_SCHEMA_TERM,
+      SQL_SCHEMA_USAGE, SQL_TABLE_TERM, SQL_COLUMN_ALIAS,
+      SQL_IDENTIFIER_QUOTE_CHAR, SQL_CATALOG_NAME, SQL_CATALOG_NAME_SEPARATOR,
+      SQL_SPECIAL_CHARACTERS, SQL_QUOTED_IDENTIFIER_CASE,
+      SQL_AGGREGATE_FUNCTIONS, SQL_NUMERIC_FUNCTIONS, SQL_STRING_FUNCTIONS,
+      SQL_TIMEDATE_FUNCTIONS, SQL_TIMEDATE_ADD_INTERVALS,
+      SQL_TIMEDATE_DIFF_INTERVALS, SQL_DATETIME_LITERALS, SQL_SYSTEM_FUNCTIONS,
+      SQL_CONVERT_FUNCTIONS, SQL_CONVERT_BIGINT, SQL_CONVERT_BINARY,
+      SQL_CONVERT_BIT, SQL_CONVERT_CHAR, SQL_CONVERT_DATE, SQL_CONVERT_DECIMAL,
+      SQL_CONVERT_DOUBLE, SQL_CONVERT_FLOAT, SQL_CONVERT_GUID,
+      SQL_CONVERT_INTEGER, SQL_CONVERT_INTERVAL_DAY_TIME,
+      SQL_CONVERT_INTERVAL_YEAR_MONTH, SQL_CONVERT_LONGVARBINARY,
+      SQL_CONVERT_LONGVARCHAR, SQL_CONVERT_NUMERIC, SQL_CONVERT_REAL,
+      SQL_CONVERT_SMALLINT, SQL_CONVERT_TIME, SQL_CONVERT_TIMESTAMP,
+      SQL_CONVERT_TINYINT, SQL_CONVERT_VARBINARY, SQL_CONVERT_VARCHAR,
+      SQL_CONVERT_WCHAR, SQL_CONVERT_WLONGVARCHAR, SQL_CONVERT_WVARCHAR,
+      SQL_SQL92_VALUE_EXPRESSIONS, SQL_SQL92_NUMERIC_VALUE_FUNCTIONS,
+      SQL_SQL92_STRING_FUNCTIONS, SQL_SQL92_DATETIME_FUNCTIONS,
+      SQL_SQL92_RELATIONAL_JOIN_OPERATORS, SQL_SQL92_PREDICATES,
+      SQL_SQL92_GRANT, SQL_SQL92_REVOKE, SQL_SQL92_ROW_VALUE_CONSTRUCTOR,
+      SQL_KEYWORDS, SQL_FILE_USAGE, SQL_ROW_UPDATES, SQL_SEARCH_PATTERN_ESCAPE,
+      SQL_PROCEDURES, SQL_ACCESSIBLE_PROCEDURES, SQL_PROCEDURE_TERM,
+      SQL_MAX_PROCEDURE_NAME_LEN, SQL_ACCESSIBLE_TABLES,
+      SQL_CONCAT_NULL_BEHAVIOR, SQL_DATA_SOURCE_READ_ONLY,
+      SQL_DEFAULT_TXN_ISOLATION, SQL_TXN_ISOLATION_OPTION, SQL_MULT_RESULT_SETS,
+      SQL_MULTIPLE_ACTIVE_TXN, SQL_NEED_LONG_DATA_LEN, SQL_NULL_COLLATION,
+      SQL_COLLATION_SEQ, SQL_CREATE_SCHEMA, SQL_DROP_SCHEMA, SQL_CREATE_TABLE,
+      SQL_DROP_TABLE, SQL_CREATE_VIEW, SQL_DROP_VIEW, SQL_DDL_INDEX,
+      SQL_DESCRIBE_PARAMETER, SQL_INDEX_KEYWORDS, SQL_INSERT_STATEMENT,
+      SQL_PARAM_ARRAY_SELECTS, SQL_ASYNC_MODE, SQL_ASYNC_NOTIFICATION,
+      SQL_ALTER_DOMAIN, SQL_BOOKMARK_PERSISTENCE, SQL_CREATE_ASSERTION,
+      SQL_CREATE_CHARACTER_SET, SQL_CREATE_COLLATION, SQL_CREATE_DOMAIN,
+      SQL_CREATE_TRANSLATION, SQL_DROP_ASSERTION, SQL_DROP_CHARACTER_SET,
+      SQL_DROP_COLLATION, SQL_DROP_DOMAIN, SQL_DROP_TRANSLATION,
+      SQL_INFO_SCHEMA_VIEWS, SQL_MAX_ASYNC_CONCURRENT_STATEMENTS, 0
+  };
+  return s_infoTypes;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * InfoTable.h
+ *
+ * Results of SQLGetInfo shared by the connections to the same server.
+ */
+
+#ifndef INFOTABLE_H_
+#define INFOTABLE_H_
+
+#include "SnappyDefaults.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace io {
+namespace snappydata {
+
+  /** The result of SQLGetInfo for an info type. */
+  struct InfoValue final {
+    /** the value for info types that return a string */
+    std::string m_string;
+    /** name of the info type used in the message when truncated */
+    const char* m_name;
+    /** the value for info types that return a number */
+    SQLUINTEGER m_number;
+    /** size of the number in bytes, or zero for a string */
+    uint8_t m_size;
+
+    InfoValue() : m_string(), m_name(nullptr), m_number(0), m_size(0) {
+    }
+
+    /** set the numeric value with the given ODBC integer type */
+    template<typename T>
+    inline void set(const T value) noexcept {
+      m_number = static_cast<SQLUINTEGER>(value);
+      m_size = sizeof(T);
+    }
+
+    /** set the string value with length as SQL_NTS if null terminated */
+    void setString(const char* value, const SQLLEN len, const char* name);
+  };
+
+  /**
+   * Lazily filled table of the SQLGetInfo results that depend only on the
+   * server and are shared by all the connections to it having the same
+   * properties. The info types of {@link #isConnectionInfo} are never
+   * stored here. Entries are never removed, so the pointers returned by
+   * get and put stay valid for the lifetime of the table.
+   *
+   * The values are owned by a map updated under a lock, while those of
+   * the standard ranges of info types are also published in an array of
+   * atomic slots so that get is lock-free for them.
+   */
+  class InfoTable final {
+  private:
+    /** info types below this are in the slots at their own index */
+    static const SQLUSMALLINT NUM_LOW_SLOTS = 256;
+    /** start of the range of info types added by ODBC 3.x and later */
+    static const SQLUSMALLINT HIGH_SLOTS_START = 10000;
+    static const SQLUSMALLINT NUM_HIGH_SLOTS = 64;
+
+    std::mutex m_lock;
+    std::unordered_map<SQLUSMALLINT, InfoValue> m_values;
+    std::atomic<const InfoValue*> m_slots[NUM_LOW_SLOTS + NUM_HIGH_SLOTS];
+    /** true when all the info types have been read */
+    std::atomic<bool> m_complete;
+
+    /** index in m_slots for given info type or -1 if it has none */
+    static int slotIndex(const SQLUSMALLINT infoType) noexcept {
+      if (infoType < NUM_LOW_SLOTS) {
+        return infoType;
+      } else if (infoType >= HIGH_SLOTS_START
+          && infoType < HIGH_SLOTS_START + NUM_HIGH_SLOTS) {
+        return NUM_LOW_SLOTS + (infoType - HIGH_SLOTS_START);
+      } else {
+        return -1;
+      }
+    }
+
+  public:
+    InfoTable() : m_lock(), m_values(), m_complete(false) {
+      for (auto& slot : m_slots) {
+        slot.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    InfoTable(const InfoTable&) = delete;
+    InfoTable& operator=(const InfoTable&) = delete;
+
+    /**
+     * Get the result for given info type, or null if not present. This is
+     * lock-free for the info types that have a slot.
+     */
+    const InfoValue* get(const SQLUSMALLINT infoType);
+
+    /**
+     * Store the result for given info type returning the stored one which
+     * is the existing one if added concurrently by another connection.
+     */
+    const InfoValue* put(const SQLUSMALLINT infoType, InfoValue&& value);
+
+    inline bool isComplete() const noexcept {
+      return m_complete.load(std::memory_order_acquire);
+    }
+
+    inline void setComplete() noexcept {
+      m_complete.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Get the table shared by connections to the given server and port
+     * opened with given properties, excluding the credentials.
+     */
+    static std::shared_ptr<InfoTable> forServer(const std::string& server,
+        const int port, const Properties& props);
+
+    /**
+     * Returns true if the result for the info type is specific to a
+     * connection, like the user or data source name.
+     */
+    static bool isConnectionInfo(const SQLUSMALLINT infoType) noexcept;
+
+    /**
+     * The info types supported by SQLGetInfo that are read when the table
+     * is pre-warmed, terminated by a zero.
+     */
+    static const SQLUSMALLINT* allInfoTypes() noexcept;
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* INFOTABLE_H_ */
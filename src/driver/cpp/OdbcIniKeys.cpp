@@ -87,6 +87,13 @@ const std::string OdbcIniKeys::ROUTE_QUERY = "RouteQuery";
 const std::string OdbcIniKeys::USE_BINARY_PROTOCOL = "BinaryProtocol";
 const std::string OdbcIniKeys::USE_FRAMED_TRANSPORT = "FramedTransport";
 const std::string OdbcIniKeys::SERVER_GROUPS = "ServerGroups";
+const std::string OdbcIniKeys::STATEMENT_CACHE_SIZE = "StatementCacheSize";
+const std::string OdbcIniKeys::POOL_IDLE_TIMEOUT = "PoolIdleTimeout";
+const std::string OdbcIniKeys::READ_AHEAD_ROWS = "ReadAheadRows";
+const std::string OdbcIniKeys::PUT_DATA_SPILL_SIZE = "PutDataSpillSize";
+const std::string OdbcIniKeys::CATALOG_CACHE_TTL = "CatalogCacheTTL";
+const std::string OdbcIniKeys::PREWARM_INFO = "PrewarmInfo";
+const std::string OdbcIniKeys::TRACE_EVENTS_FILE = "TraceEventsFile";
 
 const std::string OdbcIniKeys::AQP_ERROR = "spark.sql.aqp.error";
 const std::string OdbcIniKeys::AQP_CONFIDENCE = "spark.sql.aqp.confidence";
@@ -217,6 +224,30 @@ SQLRETURN OdbcIniKeys::init() {
     insertKey(ROUTE_QUERY, getIniKeyMappingAndCheck(
         ClientAttribute::ROUTE_QUERY, allConnProps));
 
+    // ODBC driver properties
+    insertKey(STATEMENT_CACHE_SIZE, ConnectionProperty(STATEMENT_CACHE_SIZE,
+        "Maximum number of prepared statements cached per connection "
+        "(0 to disable)", nullptr, "0", 0));
+    insertKey(POOL_IDLE_TIMEOUT, ConnectionProperty(POOL_IDLE_TIMEOUT,
+        "Seconds for which a pooled connection is kept idle before closing",
+        nullptr, "60", 0));
+    insertKey(READ_AHEAD_ROWS, ConnectionProperty(READ_AHEAD_ROWS,
+        "Number of rows of forward-only cursors read ahead in background "
+        "(0 to disable)", nullptr, "0", 0));
+    insertKey(PUT_DATA_SPILL_SIZE, ConnectionProperty(PUT_DATA_SPILL_SIZE,
+        "Size in bytes beyond which a value sent by SQLPutData is kept in a "
+        "temporary file (0 to disable)", nullptr, "16777216", 0));
+    insertKey(CATALOG_CACHE_TTL, ConnectionProperty(CATALOG_CACHE_TTL,
+        "Seconds for which the results of catalog functions are cached "
+        "(0 to disable)", nullptr, "0", 0));
+    insertKey(PREWARM_INFO, ConnectionProperty(PREWARM_INFO,
+        "Read the SQLGetInfo results in background after connect "
+        "(0 to disable)", nullptr, "0", 0));
+    insertKey(TRACE_EVENTS_FILE, ConnectionProperty(TRACE_EVENTS_FILE,
+        "File to write a timeline of the driver operations for "
+        "chrome://tracing or Perfetto", nullptr, nullptr,
+        ConnectionProperty::F_IS_UTF8));
+
     // AQP properties
     insertKey(AQP_ERROR, ConnectionProperty(ClientAttribute::AQP_ERROR,
         "Maximum relative error for AQP", nullptr, nullptr, 0));
@@ -176,6 +176,44 @@ namespace snappydata {
     /** attribute to restrict server-groups for client connection */
     static const std::string SERVER_GROUPS;
 
+    /**
+     * maximum number of prepared statements cached per connection for reuse
+     * by later prepares of the same SQL; interpreted by the ODBC layer
+     */
+    static const std::string STATEMENT_CACHE_SIZE;
+    /**
+     * seconds for which a pooled connection is kept idle before closing
+     * when connection pooling is enabled; interpreted by the ODBC layer
+     */
+    static const std::string POOL_IDLE_TIMEOUT;
+    /**
+     * number of rows of forward-only cursors to read ahead in background
+     * while the application fetches the current ones; interpreted by the
+     * ODBC layer
+     */
+    static const std::string READ_AHEAD_ROWS;
+    /**
+     * size in bytes beyond which a parameter value sent by SQLPutData is
+     * spilled to a temporary file; interpreted by the ODBC layer
+     */
+    static const std::string PUT_DATA_SPILL_SIZE;
+    /**
+     * seconds for which the results of catalog functions are cached by the
+     * connection; interpreted by the ODBC layer
+     */
+    static const std::string CATALOG_CACHE_TTL;
+    /**
+     * if non-zero then the SQLGetInfo results are read in background right
+     * after connect; interpreted by the ODBC layer
+     */
+    static const std::string PREWARM_INFO;
+    /**
+     * file to which a timeline of the API calls, server operations and
+     * conversions of all connections is written in Chrome trace-event
+     * format; interpreted by the ODBC layer
+     */
+    static const std::string TRACE_EVENTS_FILE;
+
     // AQP properties
     static const std::string AQP_ERROR;
     static const std::string AQP_CONFIDENCE;
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * ParameterArena.cpp
+ */
+
+#include "ParameterArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+using namespace io::snappydata;
+
+ParameterArena::~ParameterArena() {
+  Block* block = m_head;
+  while (block) {
+    Block* next = block->m_next;
+    ::free(block);
+    block = next;
+  }
+}
+
+char* ParameterArena::allocateSlow(const size_t size) {
+  // look for a block with enough space in the ones retained after a rewind
+  Block* prev = m_current;
+  Block* block = m_current ? m_current->m_next : m_head;
+  while (block) {
+    if (block->m_size >= size) {
+      m_current = block;
+      m_offset = size;
+      return data(block);
+    }
+    prev = block;
+    block = block->m_next;
+  }
+  // allocate a new block at the end of the chain doubling the size
+  const size_t blockSize = std::max(m_nextBlockSize, size);
+  block = static_cast<Block*>(::malloc(sizeof(Block) + blockSize));
+  if (!block) {
+    throw std::bad_alloc();
+  }
+  block->m_next = nullptr;
+  block->m_size = blockSize;
+  if (prev) {
+    prev->m_next = block;
+  } else {
+    m_head = block;
+  }
+  m_numBlocks++;
+  m_nextBlockSize = blockSize * 2;
+  m_current = block;
+  m_offset = size;
+  return data(block);
+}
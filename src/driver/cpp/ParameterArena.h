@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * ParameterArena.h
+ *
+ * Bump allocator for the temporary buffers needed while binding the
+ * parameter sets of an array of parameters.
+ */
+
+#ifndef PARAMETERARENA_H_
+#define PARAMETERARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * Carves allocations out of a chain of large blocks. Individual
+   * allocations are never freed; instead {@link #rewind} makes all the
+   * blocks available again, and all of them are released together when
+   * the arena is destroyed. An arena is scoped to the binding of one
+   * array of parameters and is not thread-safe.
+   */
+  class ParameterArena final {
+  private:
+    struct Block {
+      Block* m_next;
+      size_t m_size;
+      // followed by m_size bytes of data
+    };
+
+    /** the first block in the chain */
+    Block* m_head;
+    /** the block being allocated from currently */
+    Block* m_current;
+    /** offset of the next free byte in m_current */
+    size_t m_offset;
+    /** size of the next block to be allocated */
+    size_t m_nextBlockSize;
+    /** total number of blocks allocated from the heap */
+    size_t m_numBlocks;
+
+    static inline char* data(Block* block) noexcept {
+      return reinterpret_cast<char*>(block + 1);
+    }
+
+    char* allocateSlow(const size_t size);
+
+  public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit ParameterArena(
+        const size_t initialBlockSize = DEFAULT_BLOCK_SIZE) noexcept :
+        m_head(nullptr), m_current(nullptr), m_offset(0),
+        m_nextBlockSize(initialBlockSize > 0 ? initialBlockSize : 1),
+        m_numBlocks(0) {
+    }
+
+    ~ParameterArena();
+
+    ParameterArena(const ParameterArena&) = delete;
+    ParameterArena& operator=(const ParameterArena&) = delete;
+
+    /**
+     * Allocate the given number of bytes aligned to pointer size.
+     * The memory is valid till the next {@link #rewind} or destruction
+     * of the arena.
+     */
+    inline char* allocate(size_t size) {
+      size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+      if (m_current && (m_current->m_size - m_offset) >= size) {
+        char* result = data(m_current) + m_offset;
+        m_offset += size;
+        return result;
+      } else {
+        return allocateSlow(size);
+      }
+    }
+
+    /** Make all the blocks available for allocation again. */
+    inline void rewind() noexcept {
+      m_current = m_head;
+      m_offset = 0;
+    }
+
+    /** Number of blocks allocated from the heap so far. */
+    size_t numBlocks() const noexcept {
+      return m_numBlocks;
+    }
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* PARAMETERARENA_H_ */
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * PerfCounters.h
+ *
+ * Cumulative performance counters of the statements, connections and
+ * environments read with the SQL_ATTR_PERF_* attributes.
+ */
+
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+#include "DriverBase.h"
+
+#include <ResultSet.h>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * The counters of a statement or connection. Every update is a single
+   * relaxed atomic add to this object only. A statement registers its
+   * counters with those of its connection, the parent, which adds up the
+   * counters of its live children when read and absorbs those of a child
+   * when it is destroyed. Likewise an environment sums up the counters of
+   * its connections only when read.
+   *
+   * The time spent in the native client waiting for the server is
+   * separated from the time spent in converting the values between the
+   * application buffers and the native client, to tell a slow server
+   * from a slow client.
+   */
+  class PerfCounters final {
+  public:
+    /**
+     * the counters in the order of SQL_ATTR_PERF_* attributes followed by
+     * that of SQL_ATTR_STMT_CACHE_HITS
+     */
+    enum Counter {
+      /** requests to the server for an operation or a batch of rows */
+      ROUND_TRIPS,
+      /** rows read from the server */
+      ROWS_FETCHED,
+      /** batches of rows read from the server */
+      BATCHES_FETCHED,
+      /** statements prepared on the server */
+      PREPARES,
+      /** executions of statements including arrays of parameters */
+      EXECUTES,
+      /** nanoseconds spent in the native client on server operations */
+      NETWORK_NANOS,
+      /** nanoseconds spent in converting parameters and output values */
+      CONVERSION_NANOS,
+      /** prepares satisfied by the statement cache of the connection */
+      STMT_CACHE_HITS,
+      NUM_COUNTERS
+    };
+
+  private:
+    PerfCounters* const m_parent;
+    std::atomic<uint64_t> m_values[NUM_COUNTERS];
+    /** protects m_children and absorbing the counters of a child */
+    mutable std::mutex m_childLock;
+    std::unordered_set<const PerfCounters*> m_children;
+
+    inline uint64_t getOwn(const Counter counter) const noexcept {
+      return m_values[counter].load(std::memory_order_relaxed);
+    }
+
+  public:
+    explicit PerfCounters(PerfCounters* parent = nullptr) :
+        m_parent(parent), m_childLock(), m_children() {
+      for (auto& value : m_values) {
+        value.store(0, std::memory_order_relaxed);
+      }
+      if (parent) {
+        std::lock_guard<std::mutex> sync(parent->m_childLock);
+        parent->m_children.insert(this);
+      }
+    }
+
+    ~PerfCounters() {
+      if (m_parent) {
+        // add to the parent under its lock so that a concurrent read of
+        // the parent neither misses nor counts twice the values
+        std::lock_guard<std::mutex> sync(m_parent->m_childLock);
+        m_parent->m_children.erase(this);
+        for (int counter = 0; counter < NUM_COUNTERS; counter++) {
+          const Counter c = static_cast<Counter>(counter);
+          m_parent->add(c, get(c));
+        }
+      }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    inline void add(const Counter counter, const uint64_t delta) noexcept {
+      m_values[counter].fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /** the counter of this object including that of its live children */
+    uint64_t get(const Counter counter) const {
+      std::lock_guard<std::mutex> sync(m_childLock);
+      uint64_t total = getOwn(counter);
+      for (const PerfCounters* child : m_children) {
+        total += child->get(counter);
+      }
+      return total;
+    }
+
+    /** add all the counters of another object to this one */
+    void addAll(const PerfCounters& other) {
+      for (int counter = 0; counter < NUM_COUNTERS; counter++) {
+        add(static_cast<Counter>(counter),
+            other.get(static_cast<Counter>(counter)));
+      }
+    }
+
+    /**
+     * Get the counter for given SQL_ATTR_PERF_* attribute, or
+     * NUM_COUNTERS if the attribute is not one of those.
+     */
+    static Counter forAttribute(const SQLINTEGER attribute) noexcept {
+      if (attribute == SQL_ATTR_STMT_CACHE_HITS) {
+        return STMT_CACHE_HITS;
+      }
+      return (attribute >= SQL_ATTR_PERF_ROUND_TRIPS &&
+          attribute < SQL_ATTR_PERF_ROUND_TRIPS + STMT_CACHE_HITS)
+          ? static_cast<Counter>(attribute - SQL_ATTR_PERF_ROUND_TRIPS)
+          : NUM_COUNTERS;
+    }
+
+    /**
+     * Adds the nanoseconds elapsed in its scope to a counter, and records
+     * the scope as a TraceEvents event of the matching category when
+     * those are enabled. A Timer nested in another one, like a fetch from
+     * the server in the middle of the conversions of a rowset, can pass
+     * the outer Timer so that its time is not counted twice.
+     */
+    class Timer final {
+    private:
+      PerfCounters& m_counters;
+      const Counter m_counter;
+      Timer* const m_outer;
+      const int64_t m_startTime;
+      /** time of the nested Timers to be excluded from this one */
+      int64_t m_excluded;
+
+    public:
+      Timer(PerfCounters& counters, const Counter counter,
+          Timer* outer = nullptr) noexcept : m_counters(counters),
+          m_counter(counter), m_outer(outer),
+          m_startTime(FunctionSampler::currentTime()), m_excluded(0) {
+      }
+
+      ~Timer() {
+        const int64_t endTime = FunctionSampler::currentTime();
+        const int64_t elapsed = endTime - m_startTime;
+        m_counters.add(m_counter, static_cast<uint64_t>(
+            elapsed - m_excluded));
+        if (m_outer) {
+          m_outer->m_excluded += elapsed;
+        }
+        if (SNAPPY_UNLIKELY(TraceEvents::isEnabled())) {
+          if (m_counter == CONVERSION_NANOS) {
+            TraceEvents::record(TraceEvents::CONVERSION, "conversion",
+                m_startTime, endTime);
+          } else {
+            TraceEvents::record(TraceEvents::NETWORK, "server",
+                m_startTime, endTime);
+          }
+        }
+      }
+
+      Timer(const Timer&) = delete;
+      Timer& operator=(const Timer&) = delete;
+    };
+
+    /**
+     * Counts the rows read from a ResultSet iterator and the batches in
+     * which they were received. The rows of a batch are held contiguously
+     * by the native client so a row that does not follow the previous one
+     * starts a new batch, and every batch after the first one, that comes
+     * with the result of the execution, needed a round trip of its own.
+     * The counts are accumulated locally by {@link #track} and published
+     * by {@link #flush} once for a rowset or chunk of rows.
+     *
+     * The size of the last batch also tells when the iterator is expected
+     * to reach the end of the current batch, so that only the moves which
+     * may fetch the next batch from the server need to be timed.
+     */
+    class RowTracker final {
+    private:
+      const client::Row* m_next;
+      uint64_t m_numRows;
+      uint64_t m_numBatches;
+      /** rows seen so far in the current batch */
+      uint64_t m_batchRows;
+      /** rows in the previous batch or zero if there was none */
+      uint64_t m_lastBatchRows;
+      bool m_firstBatchDone;
+
+    public:
+      RowTracker() noexcept : m_next(nullptr), m_numRows(0),
+          m_numBatches(0), m_batchRows(0), m_lastBatchRows(0),
+          m_firstBatchDone(false) {
+      }
+
+      /** start tracking the rows of a new result */
+      inline void reset() noexcept {
+        m_next = nullptr;
+        m_numRows = 0;
+        m_numBatches = 0;
+        m_batchRows = 0;
+        m_lastBatchRows = 0;
+        m_firstBatchDone = false;
+      }
+
+      /** record a row read from the iterator */
+      inline void track(const client::Row* row) noexcept {
+        if (row != m_next) {
+          m_numBatches++;
+          if (m_batchRows != 0) {
+            m_lastBatchRows = m_batchRows;
+          }
+          m_batchRows = 0;
+        }
+        m_next = row + 1;
+        m_numRows++;
+        m_batchRows++;
+      }
+
+      /**
+       * Return true if moving past the last tracked row may fetch a new
+       * batch from the server, which is every move till the size of the
+       * batches is known and then the moves at the end of a batch. A batch
+       * shorter than the previous one can make the fetch of the next one
+       * go untimed, while a longer one only times a few more moves.
+       */
+      inline bool mayFetch() const noexcept {
+        return m_lastBatchRows == 0 || m_batchRows >= m_lastBatchRows;
+      }
+
+      void flush(PerfCounters& counters) noexcept {
+        if (m_numRows != 0) {
+          counters.add(ROWS_FETCHED, m_numRows);
+          m_numRows = 0;
+        }
+        if (m_numBatches != 0) {
+          counters.add(BATCHES_FETCHED, m_numBatches);
+          const uint64_t roundTrips = m_firstBatchDone ? m_numBatches
+              : (m_numBatches - 1);
+          if (roundTrips != 0) {
+            counters.add(ROUND_TRIPS, roundTrips);
+          }
+          m_numBatches = 0;
+          m_firstBatchDone = true;
+        }
+      }
+    };
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* PERFCOUNTERS_H_ */
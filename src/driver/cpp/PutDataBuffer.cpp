@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * PutDataBuffer.cpp
+ */
+
+#include "PutDataBuffer.h"
+#include "StringFunctions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace io::snappydata;
+
+const size_t PutDataBuffer::CHUNK_SIZE;
+
+/** number of wide characters converted at a time */
+static const size_t CONVERT_CHARS = 16 * 1024;
+
+static inline bool isHighSurrogate(const SQLWCHAR c) noexcept {
+  return c >= 0xD800 && c <= 0xDBFF;
+}
+
+PutDataBuffer::~PutDataBuffer() {
+  if (m_spillFile) {
+    ::fclose(m_spillFile);
+  }
+}
+
+void PutDataBuffer::appendToChunks(const char* data, size_t len) {
+  while (len > 0) {
+    if (m_chunks.empty() || m_lastChunkSize == CHUNK_SIZE) {
+      m_chunks.emplace_back(new char[CHUNK_SIZE]);
+      m_lastChunkSize = 0;
+    }
+    const size_t copyLen = std::min(len, CHUNK_SIZE - m_lastChunkSize);
+    ::memcpy(m_chunks.back().get() + m_lastChunkSize, data, copyLen);
+    m_lastChunkSize += copyLen;
+    data += copyLen;
+    len -= copyLen;
+  }
+}
+
+bool PutDataBuffer::spill() {
+  FILE* file = ::tmpfile();
+  if (!file) {
+    m_spillFailed = true;
+    return false;
+  }
+  size_t remaining = m_size;
+  for (const auto& chunk : m_chunks) {
+    const size_t len = std::min(remaining, CHUNK_SIZE);
+    if (::fwrite(chunk.get(), 1, len, file) != len) {
+      ::fclose(file);
+      m_spillFailed = true;
+      return false;
+    }
+    remaining -= len;
+  }
+  m_spillFile = file;
+  m_chunks.clear();
+  m_lastChunkSize = 0;
+  return true;
+}
+
+void PutDataBuffer::append(const void* data, const size_t len) {
+  if (len == 0) return;
+
+  if (!m_spillFile && !m_spillFailed && m_spillSize > 0 &&
+      (m_size + len) > m_spillSize) {
+    // keep in memory if the temporary file could not be created
+    spill();
+  }
+  if (m_spillFile) {
+    if (::fwrite(data, 1, len, m_spillFile) != len) {
+      throw std::runtime_error("failed to write SQLPutData value to "
+          "temporary file");
+    }
+  } else {
+    appendToChunks(static_cast<const char*>(data), len);
+  }
+  m_size += len;
+}
+
+void PutDataBuffer::appendConverted(const SQLWCHAR* chars, size_t len) {
+  if (!m_convertBuffer) {
+    // UTF-8 needs at most three bytes for every UTF-16 code unit
+    m_convertBuffer.reset(new SQLCHAR[CONVERT_CHARS * 3 + 1]);
+  }
+  while (len > 0) {
+    size_t convertLen = std::min(len, CONVERT_CHARS);
+    // don't split a surrogate pair across the conversions
+    if (convertLen < len && isHighSurrogate(chars[convertLen - 1])) {
+      convertLen--;
+    }
+    SQLLEN outLen = 0;
+    StringFunctions::copyString(chars, convertLen, m_convertBuffer.get(),
+        CONVERT_CHARS * 3 + 1, &outLen);
+    append(m_convertBuffer.get(), static_cast<size_t>(outLen));
+    chars += convertLen;
+    len -= convertLen;
+  }
+}
+
+void PutDataBuffer::appendWide(const SQLWCHAR* chars, size_t len) {
+  if (len == 0) return;
+
+  if (m_highSurrogate) {
+    // complete the pair (or invalid sequence) from the previous piece
+    SQLWCHAR pair[2] = { m_highSurrogate, chars[0] };
+    m_highSurrogate = 0;
+    if (pair[1] >= 0xDC00 && pair[1] <= 0xDFFF) {
+      appendConverted(pair, 2);
+      chars++;
+      len--;
+    } else {
+      appendConverted(pair, 1);
+    }
+  }
+  if (len > 0 && isHighSurrogate(chars[len - 1])) {
+    m_highSurrogate = chars[--len];
+  }
+  appendConverted(chars, len);
+}
+
+void PutDataBuffer::moveTo(std::string& result) {
+  if (m_highSurrogate) {
+    // dangling high surrogate at the end of value
+    const SQLWCHAR c = m_highSurrogate;
+    m_highSurrogate = 0;
+    appendConverted(&c, 1);
+  }
+  std::string value;
+  value.resize(m_size);
+  if (m_spillFile) {
+    ::rewind(m_spillFile);
+    const size_t readLen = m_size > 0 ? ::fread(&value[0], 1, m_size,
+        m_spillFile) : 0;
+    ::fclose(m_spillFile);
+    m_spillFile = nullptr;
+    if (readLen != m_size) {
+      m_size = 0;
+      throw std::runtime_error("failed to read SQLPutData value from "
+          "temporary file");
+    }
+  } else {
+    // release the chunks as they are copied to limit the peak memory
+    size_t offset = 0;
+    for (auto& chunk : m_chunks) {
+      const size_t len = std::min(m_size - offset, CHUNK_SIZE);
+      ::memcpy(&value[offset], chunk.get(), len);
+      chunk.reset();
+      offset += len;
+    }
+    m_chunks.clear();
+    m_lastChunkSize = 0;
+  }
+  m_size = 0;
+  result.swap(value);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * PutDataBuffer.h
+ *
+ * Accumulates the pieces of a data-at-execution parameter sent by
+ * SQLPutData.
+ */
+
+#ifndef PUTDATABUFFER_H_
+#define PUTDATABUFFER_H_
+
+#include "OdbcBase.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * Holds the pieces of a character or binary parameter value sent by
+   * SQLPutData in a list of fixed size chunks so that the value is never
+   * copied while growing. Beyond a configured size the value is spilled
+   * to a temporary file instead. Wide character pieces are converted to
+   * UTF-8 as they arrive keeping any high surrogate at the end of a piece
+   * for the next one.
+   */
+  class PutDataBuffer final {
+  private:
+    static const size_t CHUNK_SIZE = 256 * 1024;
+
+    /** the chunks of the value when held in memory */
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+    /** number of bytes used in the last chunk */
+    size_t m_lastChunkSize;
+    /** total number of bytes appended */
+    size_t m_size;
+    /** size beyond which the value is spilled to a file; zero to disable */
+    const size_t m_spillSize;
+    /** the temporary file holding the value once spilled */
+    FILE* m_spillFile;
+    /**
+     * set if the temporary file could not be created or written so that
+     * the value stays in memory without retrying on every piece
+     */
+    bool m_spillFailed;
+    /** high surrogate at the end of the last wide character piece */
+    SQLWCHAR m_highSurrogate;
+    /** buffer for conversion of wide character pieces */
+    std::unique_ptr<SQLCHAR[]> m_convertBuffer;
+
+    void appendToChunks(const char* data, size_t len);
+
+    /** move the chunks to a temporary file; false if it cannot be created */
+    bool spill();
+
+    /** convert a piece having no dangling high surrogate and append */
+    void appendConverted(const SQLWCHAR* chars, size_t len);
+
+  public:
+    explicit PutDataBuffer(const size_t spillSize) noexcept :
+        m_chunks(), m_lastChunkSize(0), m_size(0), m_spillSize(spillSize),
+        m_spillFile(nullptr), m_spillFailed(false), m_highSurrogate(0),
+        m_convertBuffer() {
+    }
+
+    ~PutDataBuffer();
+
+    PutDataBuffer(const PutDataBuffer&) = delete;
+    PutDataBuffer& operator=(const PutDataBuffer&) = delete;
+
+    /** append the given bytes */
+    void append(const void* data, const size_t len);
+
+    /** append the given wide characters converted to UTF-8 */
+    void appendWide(const SQLWCHAR* chars, size_t len);
+
+    /** the number of bytes appended so far */
+    size_t size() const noexcept {
+      return m_size;
+    }
+
+    /** true if the value has been spilled to a temporary file */
+    bool isSpilled() const noexcept {
+      return m_spillFile != nullptr;
+    }
+
+    /**
+     * Move the full value into the given string allocated with the exact
+     * size and release the chunks or temporary file.
+     */
+    void moveTo(std::string& result);
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* PUTDATABUFFER_H_ */
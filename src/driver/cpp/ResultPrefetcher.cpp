@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * ResultPrefetcher.cpp
+ */
+
+#include "ResultPrefetcher.h"
+#include "AsyncExecutor.h"
+#include "DriverBase.h"
+
+using namespace io::snappydata;
+
+ResultPrefetcher::ResultPrefetcher(ResultSet::iterator& cursor,
+    const size_t chunkRows, std::recursive_mutex& execLock,
+    PerfCounters& perfCounters) :
+    m_cursor(cursor), m_chunkRows(chunkRows > 0 ? chunkRows : 1),
+    m_execLock(execLock), m_perfCounters(&perfCounters), m_rowTracker(),
+    m_rows(), m_position(0), m_nextRows(), m_started(false),
+    m_pending(false), m_exhausted(false), m_error(), m_lock(), m_cond() {
+}
+
+ResultPrefetcher::ResultPrefetcher(std::vector<Row>&& rows,
+    ResultSet::iterator& cursor, std::recursive_mutex& execLock) :
+    m_cursor(cursor), m_chunkRows(1), m_execLock(execLock),
+    m_perfCounters(nullptr), m_rowTracker(), m_rows(), m_position(0),
+    m_nextRows(std::move(rows)), m_started(true), m_pending(false),
+    m_exhausted(true), m_error(), m_lock(), m_cond() {
+  // the first next() will swap the rows into m_rows
+}
+
+void ResultPrefetcher::fill(std::vector<Row>& rows) {
+  rows.clear();
+  rows.reserve(m_chunkRows);
+  std::lock_guard<std::recursive_mutex> sync(m_execLock);
+  try {
+    while (rows.size() < m_chunkRows) {
+      if (!m_cursor.next()) {
+        m_exhausted = true;
+        break;
+      }
+      Row* row = m_cursor.get();
+      m_rowTracker.track(row);
+      rows.push_back(std::move(*row));
+    }
+  } catch (SQLException& sqle) {
+    // end of the cursor is also signalled by this exception
+    if (!isEndOfCursor(sqle)) {
+      flushCounters();
+      throw;
+    }
+    m_exhausted = true;
+  }
+  flushCounters();
+}
+
+void ResultPrefetcher::startNext() {
+  m_pending = true;
+  try {
+    AsyncExecutor::instance().submit([this]() {
+      std::exception_ptr error;
+      try {
+        fill(m_nextRows);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> sync(m_lock);
+        if (error) {
+          m_error = error;
+          m_exhausted = true;
+        }
+        m_pending = false;
+      }
+      m_cond.notify_all();
+    });
+  } catch (...) {
+    // the next chunk will be read by the application thread instead
+    m_pending = false;
+  }
+}
+
+void ResultPrefetcher::awaitNext() noexcept {
+  std::unique_lock<std::mutex> sync(m_lock);
+  while (m_pending) {
+    m_cond.wait(sync);
+  }
+}
+
+Row* ResultPrefetcher::next() {
+  if (++m_position < m_rows.size()) {
+    return &m_rows[m_position];
+  }
+  if (!m_started) {
+    m_started = true;
+    fill(m_rows);
+  } else {
+    awaitNext();
+    if (m_error) {
+      std::exception_ptr error(std::move(m_error));
+      m_error = nullptr;
+      m_rows.clear();
+      std::rethrow_exception(error);
+    }
+    if (m_nextRows.empty() && !m_exhausted) {
+      // background read could not be submitted
+      fill(m_nextRows);
+    }
+    m_rows.swap(m_nextRows);
+    m_nextRows.clear();
+  }
+  m_position = 0;
+  if (!m_exhausted) {
+    startNext();
+  }
+  return m_rows.empty() ? nullptr : &m_rows[0];
+}
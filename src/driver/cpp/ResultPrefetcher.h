@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * ResultPrefetcher.h
+ *
+ * Read-ahead of the rows of a forward-only cursor on the driver threads.
+ */
+
+#ifndef RESULTPREFETCHER_H_
+#define RESULTPREFETCHER_H_
+
+#include "PerfCounters.h"
+
+#include <ResultSet.h>
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * Double buffers the rows of a forward-only, read-only cursor. When the
+   * application moves to a new chunk of rows the next chunk is read from
+   * the underlying ResultSet iterator by a task on the AsyncExecutor, so
+   * that the round trip to the server for the next batch overlaps with the
+   * processing of the current one by the application.
+   *
+   * The rows are moved out of the iterator which is never used by the
+   * caller while this object is alive.
+   */
+  class ResultPrefetcher final {
+  private:
+    client::ResultSet::iterator& m_cursor;
+    /** the maximum number of rows in a chunk */
+    const size_t m_chunkRows;
+    /** held while reading from the iterator */
+    std::recursive_mutex& m_execLock;
+    /** counters of the statement for the rows read, if any */
+    PerfCounters* const m_perfCounters;
+    /** counts the rows and batches read from the iterator */
+    PerfCounters::RowTracker m_rowTracker;
+
+    /** the rows being returned to the application */
+    std::vector<client::Row> m_rows;
+    /** position of the current row in m_rows */
+    size_t m_position;
+    /** the rows being read in the background */
+    std::vector<client::Row> m_nextRows;
+    /** true after the first chunk has been read */
+    bool m_started;
+    /** true if a background read of m_nextRows is in progress */
+    bool m_pending;
+    /** true if the iterator has no more rows */
+    bool m_exhausted;
+    /** failure in the background read to be thrown to the application */
+    std::exception_ptr m_error;
+
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+
+    /** read the next chunk from the iterator into the given vector */
+    void fill(std::vector<client::Row>& rows);
+
+    /** publish the rows read so far to the counters of the statement */
+    inline void flushCounters() noexcept {
+      if (m_perfCounters) {
+        m_rowTracker.flush(*m_perfCounters);
+      }
+    }
+
+    /** start a background read of the next chunk into m_nextRows */
+    void startNext();
+
+    /** wait for any background read in progress */
+    void awaitNext() noexcept;
+
+  public:
+    ResultPrefetcher(client::ResultSet::iterator& cursor,
+        const size_t chunkRows, std::recursive_mutex& execLock,
+        PerfCounters& perfCounters);
+
+    /**
+     * Return the given rows held in memory without reading from the
+     * iterator, which is only kept for uniformity.
+     */
+    ResultPrefetcher(std::vector<client::Row>&& rows,
+        client::ResultSet::iterator& cursor,
+        std::recursive_mutex& execLock);
+
+    ~ResultPrefetcher() {
+      awaitNext();
+    }
+
+    ResultPrefetcher(const ResultPrefetcher&) = delete;
+    ResultPrefetcher& operator=(const ResultPrefetcher&) = delete;
+
+    /**
+     * Move to the next row returning a pointer to it, or nullptr if there
+     * are no more rows. Throws any failure in reading the rows.
+     */
+    client::Row* next();
+
+    /**
+     * Return true if the next call to next() moves to a new chunk of rows
+     * so may have to wait for it to be read.
+     */
+    inline bool atChunkEnd() const noexcept {
+      return m_position + 1 >= m_rows.size();
+    }
+
+    /** Get the current row, or nullptr if there is none. */
+    inline client::Row* get() noexcept {
+      return m_position < m_rows.size() ? &m_rows[m_position] : nullptr;
+    }
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* RESULTPREFETCHER_H_ */
@@ -39,16 +39,20 @@
  *  Contains implementation of setup and connection ODBC API.
  */
 
+#include <ClientAttribute.h>
 #include <ClientProperty.h>
 
 #include "SnappyEnvironment.h"
 #include "SnappyConnection.h"
+#include "AsyncExecutor.h"
 #include "StringFunctions.h"
 #include "ArrayIterator.h"
 #include "Library.h"
 #include "ConnStringPropertyReader.h"
 #include "OdbcIniKeys.h"
 
+#include <cerrno>
+
 using namespace io::snappydata;
 
 namespace io {
@@ -109,9 +113,21 @@ SQLRETURN SnappyConnection::freeConnection(SnappyConnection* conn) {
 }
 
 SnappyConnection::SnappyConnection(SnappyEnvironment* env):
-    m_conn(), m_env(env), m_attributes(), m_argsAsIdentifiers(false),
+    m_conn(new Connection()), m_env(env), m_server(), m_port(0),
+    m_connProps(), m_initialIsolation(IsolationLevel::NONE),
+    m_poolIdleTimeout(SnappyDefaults::DEFAULT_POOL_IDLE_TIMEOUT_SECS),
+    m_attributes(), m_argsAsIdentifiers(false),
     m_hwnd(nullptr), m_translateOption(0), m_translationLibrary(nullptr),
-    m_dataSourceToDriver(nullptr), m_driverToDataSource(nullptr) {
+    m_dataSourceToDriver(nullptr), m_driverToDataSource(nullptr),
+    m_stmtCache(), m_stmtCacheIndex(),
+    m_stmtCacheSize(SnappyDefaults::DEFAULT_STATEMENT_CACHE_SIZE),
+    m_stmtCacheMisses(0), m_perfCounters(),
+    m_asyncEnable(SQL_ASYNC_ENABLE_OFF), m_execLock(),
+    m_readAheadRows(SnappyDefaults::DEFAULT_READ_AHEAD_ROWS),
+    m_putDataSpillSize(SnappyDefaults::DEFAULT_PUT_DATA_SPILL_SIZE),
+    m_catalogCache(), m_infoTable(),
+    m_prewarmInfo(SnappyDefaults::DEFAULT_PREWARM_INFO != 0),
+    m_infoPrewarming(false), m_infoPrewarmCond() {
   env->addNewActiveConnection(this);
 }
 
@@ -135,8 +151,10 @@ SnappyConnection::~SnappyConnection() {
     m_translationLibrary = nullptr;
   }
   // destructor should never throw an exception
+  awaitInfoPrewarm();
   try {
-    m_conn.close();
+    clearStatementCache();
+    m_conn->close();
   } catch (SQLException& sqle) {
     SnappyHandleBase::setGlobalException(sqle);
   } catch (std::exception& se) {
@@ -177,8 +195,55 @@ SQLRETURN SnappyConnection::connectT(const std::string& server, const int port,
     const SQLINTEGER outConnStrLen, SQLSMALLINT* connStrLen) {
   clearLastError();
   SQLRETURN result = SQL_SUCCESS, result2;
-  if (!m_conn.isOpen()) {
-    m_conn.open(server, port, connProps);
+  if (!m_conn->isOpen()) {
+    // strip the properties interpreted by the ODBC layer
+    Properties nativeProps(connProps);
+    long cacheSize = SnappyDefaults::DEFAULT_STATEMENT_CACHE_SIZE;
+    long idleTimeout = SnappyDefaults::DEFAULT_POOL_IDLE_TIMEOUT_SECS;
+    long readAheadRows = SnappyDefaults::DEFAULT_READ_AHEAD_ROWS;
+    long spillSize = SnappyDefaults::DEFAULT_PUT_DATA_SPILL_SIZE;
+    long catalogCacheTTL = SnappyDefaults::DEFAULT_CATALOG_CACHE_TTL_SECS;
+    long prewarmInfo = SnappyDefaults::DEFAULT_PREWARM_INFO;
+    if (!stripIntProperty(nativeProps, OdbcIniKeys::STATEMENT_CACHE_SIZE,
+        cacheSize) || !stripIntProperty(nativeProps,
+        OdbcIniKeys::POOL_IDLE_TIMEOUT, idleTimeout) || !stripIntProperty(
+        nativeProps, OdbcIniKeys::READ_AHEAD_ROWS, readAheadRows) ||
+        !stripIntProperty(nativeProps, OdbcIniKeys::PUT_DATA_SPILL_SIZE,
+            spillSize) || !stripIntProperty(nativeProps,
+        OdbcIniKeys::CATALOG_CACHE_TTL, catalogCacheTTL) ||
+        !stripIntProperty(nativeProps, OdbcIniKeys::PREWARM_INFO,
+            prewarmInfo)) {
+      return SQL_ERROR;
+    }
+    m_stmtCacheSize = static_cast<size_t>(cacheSize);
+    m_poolIdleTimeout = std::chrono::seconds(idleTimeout);
+    m_readAheadRows = static_cast<SQLULEN>(readAheadRows);
+    m_putDataSpillSize = static_cast<size_t>(spillSize);
+    m_catalogCache.setTimeToLive(std::chrono::seconds(catalogCacheTTL));
+    m_prewarmInfo = prewarmInfo != 0;
+    // the trace covers all the connections so the first file set is used
+    auto traceFile = nativeProps.find(OdbcIniKeys::TRACE_EVENTS_FILE);
+    if (traceFile != nativeProps.end()) {
+      if (!traceFile->second.empty() &&
+          !TraceEvents::start(traceFile->second)) {
+        setException(GET_SQLEXCEPTION2(
+            SQLStateMessage::INVALID_CONNECTION_PROPERTY_VALUE_MSG,
+            traceFile->second.c_str(), OdbcIniKeys::TRACE_EVENTS_FILE.c_str()));
+        return SQL_ERROR;
+      }
+      nativeProps.erase(traceFile);
+    }
+
+    ConnectionPool* pool = m_env->getConnectionPool();
+    if (!pool || !checkoutPooledConnection(*pool, server, port,
+        nativeProps)) {
+      m_conn->open(server, port, nativeProps);
+      m_initialIsolation = m_conn->getCurrentIsolationLevel();
+    }
+    m_server = server;
+    m_port = port;
+    m_connProps = std::move(nativeProps);
+    m_infoTable = InfoTable::forServer(m_server, m_port, m_connProps);
 
     if (outConnStr) {
       std::string connStr;
@@ -220,6 +285,30 @@ SQLRETURN SnappyConnection::connectT(const std::string& server, const int port,
   }
 }
 
+bool SnappyConnection::stripIntProperty(Properties& props,
+    const std::string& name, long& result) {
+  auto search = props.find(name);
+  if (search != props.end()) {
+    char* endp = nullptr;
+    errno = 0;
+    const long value = ::strtol(search->second.c_str(), &endp, 10);
+    if (!endp || *endp != 0 || errno == ERANGE) {
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::INVALID_CONNECTION_PROPERTY_VALUE_MSG,
+          search->second.c_str(), name.c_str()));
+      return false;
+    } else if (value < 0) {
+      // sizes and counts are unsigned so must never wrap around
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, value, name.c_str()));
+      return false;
+    }
+    result = value;
+    props.erase(search);
+  }
+  return true;
+}
+
 SQLRETURN SnappyConnection::connect(const std::string& server, const int port,
     const Properties& connProps, const std::string& dsn, SQLCHAR* outConnStr,
     const SQLINTEGER outConnStrLen, SQLSMALLINT* connStrLen) {
@@ -236,6 +325,7 @@ SQLRETURN SnappyConnection::connect(const std::string& server, const int port,
   }
   if (result != SQL_ERROR) {
     m_dsn = dsn;
+    startInfoPrewarm();
     return result;
   } else {
     m_dsn.clear();
@@ -259,6 +349,7 @@ SQLRETURN SnappyConnection::connect(const std::string& server, const int port,
   }
   if (result != SQL_ERROR) {
     m_dsn = dsn;
+    startInfoPrewarm();
     return result;
   } else {
     m_dsn.clear();
@@ -266,11 +357,81 @@ SQLRETURN SnappyConnection::connect(const std::string& server, const int port,
   }
 }
 
+void SnappyConnection::startInfoPrewarm() noexcept {
+  if (!m_prewarmInfo || !m_infoTable || m_infoTable->isComplete()) {
+    return;
+  }
+  {
+    std::lock_guard<std::recursive_mutex> sync(m_execLock);
+    m_infoPrewarming = true;
+  }
+  try {
+    AsyncExecutor::instance().submit([this]() {
+      // the failures of this thread are not diagnostics of the application
+      DeferredDiagnostics diagnostics(this);
+      InfoTable& table = *m_infoTable;
+      for (const SQLUSMALLINT* infoType = InfoTable::allInfoTypes();
+          *infoType != 0; ++infoType) {
+        if (!table.get(*infoType)) {
+          InfoValue info;
+          try {
+            // other operations on the connection serialize with each read
+            // rather than waiting for the whole fill
+            std::lock_guard<std::recursive_mutex> sync(m_execLock);
+            if (readInfo(*infoType, info) == SQL_SUCCESS) {
+              table.put(*infoType, std::move(info));
+            }
+          } catch (std::exception&) {
+            // left to be read on demand
+          }
+        }
+      }
+      table.setComplete();
+      {
+        std::lock_guard<std::recursive_mutex> sync(m_execLock);
+        m_infoPrewarming = false;
+      }
+      m_infoPrewarmCond.notify_all();
+    });
+  } catch (...) {
+    // the results will be read on demand instead
+    std::lock_guard<std::recursive_mutex> sync(m_execLock);
+    m_infoPrewarming = false;
+  }
+}
+
+void SnappyConnection::awaitInfoPrewarm() noexcept {
+  std::unique_lock<std::recursive_mutex> sync(m_execLock);
+  while (m_infoPrewarming) {
+    m_infoPrewarmCond.wait(sync);
+  }
+}
+
 SQLRETURN SnappyConnection::disconnect() {
   clearLastError();
-  if (m_conn.isOpen()) {
+  if (m_conn->isOpen()) {
     try {
-      m_conn.close();
+      awaitInfoPrewarm();
+      clearStatementCache();
+      m_catalogCache.clear();
+      m_infoTable.reset();
+      ConnectionPool* pool = m_env->getConnectionPool();
+      if (pool && !rollbackForPool()) {
+        pool = nullptr;
+      }
+      if (pool) {
+        // park the native connection in the pool for reuse
+        ConnectionPool::PooledConnection pooled;
+        pooled.m_conn = std::move(m_conn);
+        pooled.m_server = std::move(m_server);
+        pooled.m_port = m_port;
+        pooled.m_props = std::move(m_connProps);
+        pooled.m_isolation = m_initialIsolation;
+        m_conn.reset(new Connection());
+        pool->checkin(std::move(pooled), m_poolIdleTimeout);
+      } else {
+        m_conn->close();
+      }
       return SQL_SUCCESS;
     } catch (SQLException& sqle) {
       setException(sqle);
@@ -286,18 +447,167 @@ SQLRETURN SnappyConnection::disconnect() {
   }
 }
 
+/**
+ * Append a schema name as a delimited identifier. A name that is not
+ * already delimited is case-normalized like a regular identifier and any
+ * double quotes in it are escaped.
+ */
+static void appendSchemaIdentifier(std::string& sql,
+    const std::string& schema) {
+  if (schema.size() >= 2 && schema.front() == '"' && schema.back() == '"') {
+    // already delimited; only the embedded quotes need to be doubled
+    sql.push_back('"');
+    for (size_t i = 1; i < schema.size() - 1; i++) {
+      const char c = schema[i];
+      if (c == '"') {
+        if (i + 1 < schema.size() - 1 && schema[i + 1] == '"') i++;
+        sql.append("\"\"");
+      } else {
+        sql.push_back(c);
+      }
+    }
+    sql.push_back('"');
+    return;
+  }
+  sql.push_back('"');
+  for (const char c : schema) {
+    if (c == '"') {
+      sql.append("\"\"");
+    } else if (c >= 'a' && c <= 'z') {
+      sql.push_back(static_cast<char>(c - 'a' + 'A'));
+    } else {
+      sql.push_back(c);
+    }
+  }
+  sql.push_back('"');
+}
+
+bool SnappyConnection::rollbackForPool() noexcept {
+  try {
+    // the changes of a transaction in progress are discarded so that these
+    // are never committed into the session of a later owner
+    if (!m_conn->getTransactionAttribute(TransactionAttribute::AUTOCOMMIT)) {
+      std::lock_guard<std::recursive_mutex> sync(m_execLock);
+      m_conn->rollbackTransaction(true);
+    }
+    return true;
+  } catch (std::exception&) {
+    // the connection is closed instead of being pooled
+    return false;
+  }
+}
+
+bool SnappyConnection::checkoutPooledConnection(ConnectionPool& pool,
+    const std::string& server, const int port,
+    const Properties& nativeProps) {
+  ConnectionPool::PooledConnection pooled;
+  while (pool.checkout(server, port, nativeProps, m_env->isStrictPoolMatch(),
+      pooled)) {
+    Connection& conn = *pooled.m_conn;
+    try {
+      // reset the session state to that of a newly opened connection
+      // which also verifies that the connection is still usable
+      conn.setTransactionAttribute(TransactionAttribute::READ_ONLY_CONNECTION,
+          false);
+      conn.setTransactionAttribute(TransactionAttribute::AUTOCOMMIT,
+          thrift::snappydataConstants::DEFAULT_AUTOCOMMIT);
+      if (conn.getCurrentIsolationLevel() != pooled.m_isolation) {
+        conn.beginTransaction(pooled.m_isolation);
+      }
+      // the default schema is that requested by this connection which can
+      // differ from that of the previous owner with relaxed matching
+      auto schemaProp = nativeProps.find(ClientAttribute::DEFAULT_SCHEMA);
+      if (schemaProp == nativeProps.end()) {
+        schemaProp = nativeProps.find(ClientAttribute::USERNAME);
+      }
+      std::string setSchema("SET SCHEMA ");
+      appendSchemaIdentifier(setSchema, schemaProp != nativeProps.end()
+          ? schemaProp->second : "APP");
+      StatementAttributes attrs;
+      conn.execute(setSchema, EMPTY_OUTPUT_PARAMS, attrs);
+
+      m_conn = std::move(pooled.m_conn);
+      m_initialIsolation = pooled.m_isolation;
+      return true;
+    } catch (std::exception&) {
+      // discard the stale connection and try the next one
+      try {
+        conn.close();
+      } catch (std::exception&) {
+      }
+    }
+  }
+  return false;
+}
+
+std::unique_ptr<PreparedStatement> SnappyConnection::takeCachedStatement(
+    const std::string& key) {
+  std::lock_guard<std::mutex> sync(m_stmtCacheLock);
+  auto search = m_stmtCacheIndex.find(key);
+  if (search != m_stmtCacheIndex.end()) {
+    std::unique_ptr<PreparedStatement> pstmt(std::move(search->second->second));
+    m_stmtCache.erase(search->second);
+    m_stmtCacheIndex.erase(search);
+    // the hits are counted by the PerfCounters of the statement
+    return pstmt;
+  } else {
+    m_stmtCacheMisses++;
+    return nullptr;
+  }
+}
+
+void SnappyConnection::cacheStatement(const std::string& key,
+    std::unique_ptr<PreparedStatement> pstmt) {
+  // statement to be closed outside the lock
+  std::unique_ptr<PreparedStatement> closeStmt;
+  {
+    std::lock_guard<std::mutex> sync(m_stmtCacheLock);
+    if (m_stmtCacheSize == 0 || !m_conn->isOpen()) {
+      closeStmt = std::move(pstmt);
+    } else if (m_stmtCacheIndex.find(key) != m_stmtCacheIndex.end()) {
+      // another handle already returned a statement for the same key
+      closeStmt = std::move(pstmt);
+    } else {
+      m_stmtCache.emplace_front(key, std::move(pstmt));
+      m_stmtCacheIndex.emplace(key, m_stmtCache.begin());
+      if (m_stmtCache.size() > m_stmtCacheSize) {
+        closeStmt = std::move(m_stmtCache.back().second);
+        m_stmtCacheIndex.erase(m_stmtCache.back().first);
+        m_stmtCache.pop_back();
+      }
+    }
+  }
+  if (closeStmt) {
+    closeStmt->close();
+  }
+}
+
+void SnappyConnection::clearStatementCache() {
+  StatementCacheList closeStmts;
+  {
+    std::lock_guard<std::mutex> sync(m_stmtCacheLock);
+    closeStmts.swap(m_stmtCache);
+    m_stmtCacheIndex.clear();
+  }
+  for (auto& entry : closeStmts) {
+    entry.second->close();
+  }
+}
+
 SQLRETURN SnappyConnection::setConnectionAttribute(SQLINTEGER attribute,
     const AttributeValue& attrValue) {
   clearLastError();
+  // serialize with the operations of statements on the connection
+  std::lock_guard<std::recursive_mutex> sync(m_execLock);
   switch (attribute) {
     case SQL_ATTR_ACCESS_MODE:
       switch (attrValue.m_val.m_intv) {
         case SQL_MODE_READ_ONLY:
-          m_conn.setTransactionAttribute(
+          m_conn->setTransactionAttribute(
               TransactionAttribute::READ_ONLY_CONNECTION, true);
           break;
         case SQL_MODE_READ_WRITE:
-          m_conn.setTransactionAttribute(
+          m_conn->setTransactionAttribute(
               TransactionAttribute::READ_ONLY_CONNECTION, false);
           break;
         default:
@@ -311,11 +621,11 @@ SQLRETURN SnappyConnection::setConnectionAttribute(SQLINTEGER attribute,
     case SQL_ATTR_AUTOCOMMIT:
       switch (attrValue.m_val.m_intv) {
         case SQL_AUTOCOMMIT_OFF:
-          m_conn.setTransactionAttribute(TransactionAttribute::AUTOCOMMIT,
+          m_conn->setTransactionAttribute(TransactionAttribute::AUTOCOMMIT,
               false);
           break;
         case SQL_AUTOCOMMIT_ON:
-          m_conn.setTransactionAttribute(TransactionAttribute::AUTOCOMMIT,
+          m_conn->setTransactionAttribute(TransactionAttribute::AUTOCOMMIT,
               true);
           break;
         default:
@@ -328,15 +638,15 @@ SQLRETURN SnappyConnection::setConnectionAttribute(SQLINTEGER attribute,
       break;
     case SQL_ATTR_CONNECTION_TIMEOUT:
       // setReceiveTimeout is in milliseconds
-      m_conn.setReceiveTimeout(attrValue.m_val.m_intv * 1000);
+      m_conn->setReceiveTimeout(attrValue.m_val.m_intv * 1000);
       break;
     case SQL_ATTR_LOGIN_TIMEOUT:
       // setConnectTimeout is in milliseconds
-      m_conn.setConnectTimeout(attrValue.m_val.m_intv * 1000);
+      m_conn->setConnectTimeout(attrValue.m_val.m_intv * 1000);
       break;
     case SQL_ATTR_CURRENT_CATALOG:
       // catalogs not relevant in SnappyData; silently ignore
-      m_conn.checkAndGetService();
+      m_conn->checkAndGetService();
       break;
     case SQL_ATTR_METADATA_ID:
       switch (attrValue.m_val.m_intv) {
@@ -355,7 +665,7 @@ SQLRETURN SnappyConnection::setConnectionAttribute(SQLINTEGER attribute,
       }
       break;
     case SQL_ATTR_PACKET_SIZE:
-      m_conn.setSendBufferSize(attrValue.m_val.m_intv);
+      m_conn->setSendBufferSize(attrValue.m_val.m_intv);
       break;
     case SQL_ATTR_QUIET_MODE:
       m_hwnd = attrValue.m_val.m_refv;
@@ -388,19 +698,19 @@ SQLRETURN SnappyConnection::setConnectionAttribute(SQLINTEGER attribute,
     case SQL_ATTR_TXN_ISOLATION:
       switch (attrValue.m_val.m_intv) {
         case SQL_TXN_READ_COMMITTED:
-          m_conn.beginTransaction(IsolationLevel::READ_COMMITTED);
+          m_conn->beginTransaction(IsolationLevel::READ_COMMITTED);
           break;
         case SQL_TXN_REPEATABLE_READ:
-          m_conn.beginTransaction(IsolationLevel::REPEATABLE_READ);
+          m_conn->beginTransaction(IsolationLevel::REPEATABLE_READ);
           break;
         case 0:
-          m_conn.beginTransaction(IsolationLevel::NONE);
+          m_conn->beginTransaction(IsolationLevel::NONE);
           break;
         case SQL_TXN_READ_UNCOMMITTED:
-          m_conn.beginTransaction(IsolationLevel::READ_UNCOMMITTED);
+          m_conn->beginTransaction(IsolationLevel::READ_UNCOMMITTED);
           break;
         case SQL_TXN_SERIALIZABLE:
-          m_conn.beginTransaction(IsolationLevel::SERIALIZABLE);
+          m_conn->beginTransaction(IsolationLevel::SERIALIZABLE);
           break;
         default:
           setException(GET_SQLEXCEPTION2(
@@ -438,7 +748,7 @@ SQLRETURN SnappyConnection::setAttribute(SQLINTEGER attribute, SQLPOINTER value,
       m_attributes[attribute] = attrValue;
       break;
     case SQL_ATTR_LOGIN_TIMEOUT:
-      if (m_conn.isOpen()) {
+      if (m_conn->isOpen()) {
         setException(GET_SQLEXCEPTION2(
             SQLStateMessage::ATTRIBUTE_CANNOT_BE_SET_NOW_MSG,
             "SQL_ATTR_LOGIN_TIMEOUT ", "Connection is open."));
@@ -495,12 +805,18 @@ SQLRETURN SnappyConnection::setAttribute(SQLINTEGER attribute, SQLPOINTER value,
       }
       break;
     }
-    case SQL_ATTR_ASYNC_ENABLE:
-      // TODO: async execution by just invoking send_* & recv_ in background?
-      setException(GET_SQLEXCEPTION2(
-          SQLStateMessage::FEATURE_NOT_IMPLEMENTED_MSG1,
-          "setAttribute(SQL_ATTR_ASYNC_ENABLE)"));
-      return SQL_ERROR;
+    case SQL_ATTR_ASYNC_ENABLE: {
+      // applies to the statements allocated after this
+      auto intv = (SQLULEN)value;
+      if (intv != SQL_ASYNC_ENABLE_OFF && intv != SQL_ASYNC_ENABLE_ON) {
+        setException(
+            GET_SQLEXCEPTION2(SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG,
+                intv, "setAttribute(SQL_ATTR_ASYNC_ENABLE)"));
+        return SQL_ERROR;
+      }
+      m_asyncEnable = intv;
+      break;
+    }
     case SQL_ATTR_AUTO_IPD:
       // TODO: descriptors not yet implemented
       setException(GET_SQLEXCEPTION2(
@@ -524,7 +840,7 @@ SQLRETURN SnappyConnection::setAttribute(SQLINTEGER attribute, SQLPOINTER value,
           SQLStateMessage::UNKNOWN_ATTRIBUTE_MSG, attribute));
       return SQL_ERROR;
   }
-  if (m_conn.isOpen()) {
+  if (m_conn->isOpen()) {
     if (attribute != SQL_ATTR_LOGIN_TIMEOUT) {
       try {
         return setConnectionAttribute(attribute, attrValue);
@@ -564,40 +880,40 @@ SQLRETURN SnappyConnection::getAttributeT(SQLINTEGER attribute,
     SQLPOINTER resultValue, SQLINTEGER bufferLength,
     SQLINTEGER* stringLengthPtr) {
   clearLastError();
-  if (m_conn.isOpen()) {
+  if (m_conn->isOpen()) {
     SQLUINTEGER intResult = SQL_NTS;
     switch (attribute) {
       case SQL_ATTR_CONNECTION_DEAD:
-        intResult = m_conn.isOpen() ? SQL_FALSE : SQL_TRUE;
+        intResult = m_conn->isOpen() ? SQL_FALSE : SQL_TRUE;
         break;
       case SQL_ATTR_ACCESS_MODE:
-        intResult = m_conn.getTransactionAttribute(
+        intResult = m_conn->getTransactionAttribute(
             TransactionAttribute::READ_ONLY_CONNECTION)
             ? SQL_MODE_READ_ONLY : SQL_MODE_READ_WRITE;
         break;
       case SQL_ATTR_AUTOCOMMIT:
-        intResult = m_conn.getTransactionAttribute(
+        intResult = m_conn->getTransactionAttribute(
             TransactionAttribute::AUTOCOMMIT)
             || thrift::snappydataConstants::DEFAULT_AUTOCOMMIT
             ? SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF;
         break;
       case SQL_ATTR_CONNECTION_TIMEOUT:
-        intResult = m_conn.getReceiveTimeout();
+        intResult = m_conn->getReceiveTimeout();
         break;
       case SQL_ATTR_METADATA_ID:
         intResult = m_argsAsIdentifiers ? SQL_TRUE : SQL_FALSE;
         break;
       case SQL_ATTR_PACKET_SIZE:
-        intResult = m_conn.getSendBufferSize();
+        intResult = m_conn->getSendBufferSize();
         break;
       case SQL_ATTR_TRANSLATE_OPTION:
         intResult = m_translateOption;
         break;
       case SQL_ATTR_LOGIN_TIMEOUT:
-        intResult = m_conn.getConnectTimeout();
+        intResult = m_conn->getConnectTimeout();
         break;
       case SQL_ATTR_TXN_ISOLATION: {
-        const auto isolation = m_conn.getCurrentIsolationLevel();
+        const auto isolation = m_conn->getCurrentIsolationLevel();
         const SQLINTEGER result = translateTransactionIsolation(isolation);
         if (result >= 0) {
           intResult = static_cast<SQLUINTEGER>(result);
@@ -646,14 +962,39 @@ SQLRETURN SnappyConnection::getAttributeT(SQLINTEGER attribute,
           return SQL_NO_DATA;
         }
       case SQL_ATTR_ASYNC_ENABLE:
-        // always off for now
-        getIntValue(SQL_ASYNC_ENABLE_OFF, resultValue, stringLengthPtr, true);
+        getIntValue(m_asyncEnable, resultValue, stringLengthPtr, true);
         return SQL_SUCCESS;
       case SQL_ATTR_ODBC_CURSORS:
         // driver manager should handle this but if it somehow reaches here
         // then this will always be DRIVER level
         getIntValue(SQL_CUR_USE_DRIVER, resultValue, stringLengthPtr, true);
         return SQL_SUCCESS;
+      case SQL_ATTR_STMT_CACHE_MISSES: {
+        SQLUBIGINT count;
+        {
+          std::lock_guard<std::mutex> sync(m_stmtCacheLock);
+          count = m_stmtCacheMisses;
+        }
+        if (resultValue) {
+          *((SQLUBIGINT*)resultValue) = count;
+          if (stringLengthPtr) *stringLengthPtr = sizeof(SQLUBIGINT);
+        }
+        return SQL_SUCCESS;
+      }
+      case SQL_ATTR_PERF_ROUND_TRIPS:
+      case SQL_ATTR_PERF_ROWS_FETCHED:
+      case SQL_ATTR_PERF_BATCHES_FETCHED:
+      case SQL_ATTR_PERF_PREPARES:
+      case SQL_ATTR_PERF_EXECUTES:
+      case SQL_ATTR_PERF_NETWORK_NANOS:
+      case SQL_ATTR_PERF_CONVERSION_NANOS:
+      case SQL_ATTR_STMT_CACHE_HITS:
+        if (resultValue) {
+          *((SQLUBIGINT*)resultValue) = m_perfCounters.get(
+              PerfCounters::forAttribute(attribute));
+          if (stringLengthPtr) *stringLengthPtr = sizeof(SQLUBIGINT);
+        }
+        return SQL_SUCCESS;
       // Below attributes are handled by the driver manager
       case SQL_ATTR_TRACE:
       case SQL_ATTR_TRACEFILE:
@@ -716,12 +1057,14 @@ SQLRETURN SnappyConnection::getAttributeT(SQLINTEGER attribute,
       case SQL_ATTR_CURRENT_CATALOG:
       case SQL_ATTR_TRANSLATE_LIB:
       case SQL_ATTR_TRANSLATE_OPTION:
-      // TODO: async execution?
-      case SQL_ATTR_ASYNC_ENABLE:
         setException(
             GET_SQLEXCEPTION2(SQLStateMessage::NO_CURRENT_CONNECTION_MSG1));
         return SQL_ERROR;
 
+      case SQL_ATTR_ASYNC_ENABLE:
+        getIntValue(m_asyncEnable, resultValue, stringLengthPtr, true);
+        return SQL_SUCCESS;
+
       case SQL_ATTR_QUIET_MODE:
         if (attrSearch != m_attributes.end()) {
           if (resultValue) {
@@ -756,6 +1099,21 @@ SQLRETURN SnappyConnection::getAttributeT(SQLINTEGER attribute,
           if (stringLengthPtr) *stringLengthPtr = sizeof(SQLULEN);
         }
         return SQL_SUCCESS;
+      case SQL_ATTR_PERF_ROUND_TRIPS:
+      case SQL_ATTR_PERF_ROWS_FETCHED:
+      case SQL_ATTR_PERF_BATCHES_FETCHED:
+      case SQL_ATTR_PERF_PREPARES:
+      case SQL_ATTR_PERF_EXECUTES:
+      case SQL_ATTR_PERF_NETWORK_NANOS:
+      case SQL_ATTR_PERF_CONVERSION_NANOS:
+      case SQL_ATTR_STMT_CACHE_HITS:
+        // the counters remain readable after a disconnect
+        if (resultValue) {
+          *((SQLUBIGINT*)resultValue) = m_perfCounters.get(
+              PerfCounters::forAttribute(attribute));
+          if (stringLengthPtr) *stringLengthPtr = sizeof(SQLUBIGINT);
+        }
+        return SQL_SUCCESS;
 
       // these attributes are handled by the Driver manager
       case SQL_ATTR_TRACE:
@@ -769,11 +1127,7 @@ SQLRETURN SnappyConnection::getAttributeT(SQLINTEGER attribute,
   }
 }
 
-template<typename CHAR_TYPE>
-SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue,
-    SQLSMALLINT bufferLength, SQLSMALLINT* stringLength) {
-  clearLastError();
-  SQLRETURN ret = SQL_SUCCESS;
+SQLRETURN SnappyConnection::readInfo(SQLUSMALLINT infoType, InfoValue& info) {
   const char* resStr = nullptr;
   const char* resInfo = nullptr;
   std::string resultString;
@@ -820,15 +1174,15 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       resInfo = "SQL_DBMS_VER";
       break;
     case SQL_ODBC_INTERFACE_CONFORMANCE:
-      *(SQLUINTEGER*)infoValue = SQL_OIC_LEVEL1;
+      info.set<SQLUINTEGER>(SQL_OIC_LEVEL1);
       break;
     case SQL_ODBC_API_CONFORMANCE:
       // ODBC 2.0 has the size as SQLSMALLINT
-      *(SQLSMALLINT*)infoValue = SQL_OAC_LEVEL1;
+      info.set<SQLSMALLINT>(SQL_OAC_LEVEL1);
       break;
     case SQL_SQL_CONFORMANCE: {
       SQLUINTEGER result = 0;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(
           DatabaseFeature::SQL_GRAMMAR_ANSI92_ENTRY)) {
         result |= SQL_SC_SQL92_ENTRY;
@@ -841,12 +1195,12 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
           DatabaseFeature::SQL_GRAMMAR_ANSI92_FULL)) {
         result |= SQL_SC_SQL92_FULL;
       }
-      *(SQLUINTEGER*)infoValue = result;
+      info.set<SQLUINTEGER>(result);
       break;
     }
     case SQL_ODBC_SQL_CONFORMANCE: {
       SQLSMALLINT result = 0;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(DatabaseFeature::SQL_GRAMMAR_MINIMUM)) {
         result |= SQL_OSC_MINIMUM;
       }
@@ -856,12 +1210,12 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       if (dbmd->isFeatureSupported(DatabaseFeature::SQL_GRAMMAR_EXTENDED)) {
         result |= SQL_OSC_EXTENDED;
       }
-      *(SQLSMALLINT*)infoValue = result;
+      info.set<SQLSMALLINT>(result);
       break;
     }
     case SQL_STANDARD_CLI_CONFORMANCE:
-      *(SQLUINTEGER*)infoValue =
-          SQL_SCC_XOPEN_CLI_VERSION1 | SQL_SCC_ISO92_CLI;
+      info.set<SQLUINTEGER>(
+          SQL_SCC_XOPEN_CLI_VERSION1 | SQL_SCC_ISO92_CLI);
       break;
     case SQL_XOPEN_CLI_YEAR:
       resStr = XOPEN_CLI_YEAR;
@@ -869,30 +1223,31 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       resInfo = "SQL_XOPEN_CLI_YEAR";
       break;
     case SQL_SERVER_NAME:
-      resStr = m_conn.getCurrentHostAddress().hostName.c_str();
+      resStr = m_conn->getCurrentHostAddress().hostName.c_str();
       resStrLen = SQL_NTS;
       resInfo = "SQL_SERVER_NAME";
       break;
     case SQL_USER_NAME:
-      resStr = m_conn.getConnectionArgs().userName.c_str();
+      resStr = m_conn->getConnectionArgs().userName.c_str();
       resStrLen = SQL_NTS;
       resInfo = "SQL_USER_NAME";
       break;
     case SQL_MAX_IDENTIFIER_LEN:
       // limit on identifier length is 128 (as per Apache Derby)
-      *(SQLUSMALLINT*)infoValue = 128;
+      info.set<SQLUSMALLINT>(128);
       break;
     case SQL_MAX_DRIVER_CONNECTIONS:
       // no specific limit
-      *(SQLUSMALLINT*)infoValue = 0;
+      info.set<SQLUSMALLINT>(0);
       break;
     case SQL_MAX_CONCURRENT_ACTIVITIES:
-      // no specific limit
-      *(SQLUSMALLINT*)infoValue = 0;
+      // no specific limit since the statements are multiplexed over the
+      // connection, see m_execLock
+      info.set<SQLUSMALLINT>(0);
       break;
     case SQL_ACTIVE_ENVIRONMENTS:
       // no specific limit
-      *(SQLUSMALLINT*)infoValue = 0;
+      info.set<SQLUSMALLINT>(0);
       break;
     case SQL_DATA_SOURCE_NAME:
       resStr = m_dsn.data();
@@ -902,7 +1257,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       break;
     case SQL_SCROLL_OPTIONS: {
       SQLUINTEGER flags = 0;
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(DatabaseFeature::RESULTSET_FORWARD_ONLY)) {
         flags |= SQL_SO_FORWARD_ONLY;
       }
@@ -914,7 +1269,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
           DatabaseFeature::RESULTSET_SCROLL_SENSITIVE)) {
         flags |= SQL_SO_DYNAMIC;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_SCROLL_CONCURRENCY: {
@@ -922,14 +1277,14 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // so use the "lowest" FORWARD_ONLY
       const ResultSetType dynamicCursorType = ResultSetType::FORWARD_ONLY;
       SQLINTEGER flags = 0;
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       if (dbmd->supportsResultSetReadOnly(dynamicCursorType)) {
         flags |= SQL_SCCO_READ_ONLY;
       }
       if (dbmd->supportsResultSetUpdatable(dynamicCursorType)) {
         flags |= SQL_SCCO_LOCK;
       }
-      *(SQLINTEGER*)infoValue = flags;
+      info.set<SQLINTEGER>(flags);
       break;
     }
     case SQL_STATIC_SENSITIVITY: {
@@ -937,7 +1292,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // so use the "lowest" FORWARD_ONLY
       const ResultSetType dynamicCursorType = ResultSetType::FORWARD_ONLY;
       SQLINTEGER flags = 0;
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       if (dbmd->ownInsertsVisible(dynamicCursorType)) {
         flags |= SQL_SS_ADDITIONS;
       }
@@ -947,13 +1302,13 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       if (dbmd->ownUpdatesVisible(dynamicCursorType)) {
         flags |= SQL_SS_UPDATES;
       }
-      *(SQLINTEGER*)infoValue = flags;
+      info.set<SQLINTEGER>(flags);
       break;
     }
     case SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1: {
       // no lock/unlock of current row
       SQLUINTEGER flags = SQL_CA1_LOCK_NO_CHANGE;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(DatabaseFeature::POSITIONED_UPDATE)) {
         flags |= SQL_CA1_POSITIONED_UPDATE;
       }
@@ -967,13 +1322,13 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
           DatabaseFeature::SQL_GRAMMAR_ANSI92_ENTRY)) {
         flags |= SQL_CA1_NEXT;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2: {
       // by default try to guarantee single row changes for positioned ops
       SQLUINTEGER flags = SQL_CA2_SIMULATE_TRY_UNIQUE;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       const ResultSetType dynamicCursorType = ResultSetType::FORWARD_ONLY;
       if (dbmd->supportsResultSetReadOnly(dynamicCursorType)) {
         flags |= SQL_CA2_READ_ONLY_CONCURRENCY;
@@ -987,7 +1342,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       if (dbmd->othersUpdatesVisible(dynamicCursorType)) {
         flags |= SQL_CA2_SENSITIVITY_UPDATES;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_DYNAMIC_CURSOR_ATTRIBUTES1: {
@@ -996,7 +1351,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // below are implemented in the driver
       flags |= SQL_CA1_POS_POSITION | SQL_CA1_POS_UPDATE | SQL_CA1_POS_DELETE
           | SQL_CA1_POS_REFRESH | SQL_CA1_BULK_ADD;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(DatabaseFeature::POSITIONED_UPDATE)) {
         flags |= SQL_CA1_POSITIONED_UPDATE;
       }
@@ -1010,13 +1365,13 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
           DatabaseFeature::SQL_GRAMMAR_ANSI92_ENTRY)) {
         flags |= SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_DYNAMIC_CURSOR_ATTRIBUTES2: {
       // by default try to guarantee single row changes for positioned ops
       SQLUINTEGER flags = SQL_CA2_SIMULATE_TRY_UNIQUE;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       const ResultSetType dynamicCursorType = ResultSetType::FORWARD_ONLY;
       if (dbmd->supportsResultSetReadOnly(dynamicCursorType)) {
         flags |= SQL_CA2_READ_ONLY_CONCURRENCY;
@@ -1030,7 +1385,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       if (dbmd->othersUpdatesVisible(dynamicCursorType)) {
         flags |= SQL_CA2_SENSITIVITY_UPDATES;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_STATIC_CURSOR_ATTRIBUTES1: {
@@ -1039,7 +1394,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // below are implemented in the driver
       flags |= SQL_CA1_POS_POSITION | SQL_CA1_POS_UPDATE | SQL_CA1_POS_DELETE
           | SQL_CA1_POS_REFRESH | SQL_CA1_BULK_ADD;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(DatabaseFeature::POSITIONED_UPDATE)) {
         flags |= SQL_CA1_POSITIONED_UPDATE;
       }
@@ -1053,13 +1408,13 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
           DatabaseFeature::SQL_GRAMMAR_ANSI92_ENTRY)) {
         flags |= SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_STATIC_CURSOR_ATTRIBUTES2: {
       // by default guarantee single row changes
       SQLUINTEGER flags = SQL_CA2_SIMULATE_TRY_UNIQUE;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       const ResultSetType staticCursorType = ResultSetType::INSENSITIVE;
       if (dbmd->supportsResultSetReadOnly(staticCursorType)) {
         flags |= SQL_CA2_READ_ONLY_CONCURRENCY;
@@ -1073,58 +1428,58 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       if (dbmd->othersUpdatesVisible(staticCursorType)) {
         flags |= SQL_CA2_SENSITIVITY_UPDATES;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_BATCH_SUPPORT: {
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       SQLUINTEGER flags = SQL_BS_SELECT_PROC | SQL_BS_ROW_COUNT_PROC;
       if (dbmd->isFeatureSupported(DatabaseFeature::BATCH_UPDATES)) {
         flags |= SQL_BS_ROW_COUNT_EXPLICIT;
       }
-      *(SQLUINTEGER*)infoValue = flags;
+      info.set<SQLUINTEGER>(flags);
       break;
     }
     case SQL_BATCH_ROW_COUNT:
-      *(SQLUINTEGER*)infoValue = SQL_BRC_EXPLICIT;
+      info.set<SQLUINTEGER>(SQL_BRC_EXPLICIT);
       break;
     case SQL_PARAM_ARRAY_ROW_COUNTS:
-      *(SQLUINTEGER*)infoValue = SQL_PARC_BATCH;
+      info.set<SQLUINTEGER>(SQL_PARC_BATCH);
       break;
     case SQL_CURSOR_COMMIT_BEHAVIOR: {
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
-      *(SQLUSMALLINT*)infoValue =
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
+      info.set<SQLUSMALLINT>(
           dbmd->isFeatureSupported(
               DatabaseFeature::OPEN_CURSORS_ACROSS_COMMIT)
               ? SQL_CB_PRESERVE : (dbmd->isFeatureSupported(
                   DatabaseFeature::OPEN_STATEMENTS_ACROSS_COMMIT)
-                  ? SQL_CB_CLOSE : SQL_CB_DELETE);
+                  ? SQL_CB_CLOSE : SQL_CB_DELETE));
       break;
     }
     case SQL_CURSOR_ROLLBACK_BEHAVIOR: {
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
-      *(SQLUSMALLINT*)infoValue =
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
+      info.set<SQLUSMALLINT>(
           dbmd->isFeatureSupported(
               DatabaseFeature::OPEN_CURSORS_ACROSS_ROLLBACK)
               ? SQL_CB_PRESERVE : (dbmd->isFeatureSupported(
                   DatabaseFeature::OPEN_STATEMENTS_ACROSS_ROLLBACK)
-                  ? SQL_CB_CLOSE : SQL_CB_DELETE);
+                  ? SQL_CB_CLOSE : SQL_CB_DELETE));
       break;
     }
     case SQL_CURSOR_SENSITIVITY: {
       SQLUINTEGER result = SQL_UNSPECIFIED;
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       if (dbmd->supportsResultSetType(ResultSetType::INSENSITIVE)) {
         result |= SQL_INSENSITIVE;
       }
       if (dbmd->supportsResultSetType(ResultSetType::SENSITIVE)) {
         result |= SQL_SENSITIVE;
       }
-      *(SQLUINTEGER*)infoValue = result;
+      info.set<SQLUINTEGER>(result);
       break;
     }
     case SQL_EXPRESSIONS_IN_ORDERBY: {
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       resStr = dbmd->isFeatureSupported(
           DatabaseFeature::ORDER_BY_EXPRESSIONS) ? "Y" : "N";
       resStrLen = 1;
@@ -1133,30 +1488,30 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
     }
     case SQL_OJ_CAPABILITIES: {
       SQLUINTEGER result = 0;
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(DatabaseFeature::OUTER_JOINS)) {
         result |= (SQL_OJ_LEFT | SQL_OJ_RIGHT);
       }
       if (dbmd->isFeatureSupported(DatabaseFeature::OUTER_JOINS_FULL)) {
         result |= SQL_OJ_FULL;
       }
-      *(SQLUINTEGER*)infoValue = result;
+      info.set<SQLUINTEGER>(result);
       break;
     }
     case SQL_GETDATA_EXTENSIONS:
       // TODO: support SQL_GD_OUTPUT_PARAMS to allow for output parameters
       // in SQLGetData (and thus chunked results for blobs/clobs)
-      *(SQLUINTEGER*)infoValue = SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER
-          | SQL_GD_BLOCK | SQL_GD_BOUND;
+      info.set<SQLUINTEGER>(SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER
+          | SQL_GD_BLOCK | SQL_GD_BOUND);
       break;
     case SQL_TXN_CAPABLE: {
       // TODO: Implement transactions for column tables.
-      *(SQLUSMALLINT*)infoValue = SQL_TC_DML;
+      info.set<SQLUSMALLINT>(SQL_TC_DML);
       break;
     }
     case SQL_CATALOG_USAGE: {
       // Catalogs are not supported (only schema and table)
-      *(SQLUINTEGER*)infoValue = 0;
+      info.set<SQLUINTEGER>(0);
       break;
     }
     case SQL_CATALOG_TERM: {
@@ -1176,9 +1531,9 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // All possible values:
       // SQL_OU_DML_STATEMENTS SQL_OU_INDEX_DEFINITION SQL_OU_PRIVILEGE_DEFINITION
       // SQL_OU_PROCEDURE_INVOCATION SQL_OU_TABLE_DEFINITION
-      *(SQLUINTEGER*)infoValue = SQL_SU_DML_STATEMENTS |
+      info.set<SQLUINTEGER>(SQL_SU_DML_STATEMENTS |
         SQL_SU_TABLE_DEFINITION | SQL_SU_INDEX_DEFINITION |
-        SQL_SU_PRIVILEGE_DEFINITION;
+        SQL_SU_PRIVILEGE_DEFINITION);
       break;
     }
     case SQL_TABLE_TERM: {
@@ -1223,24 +1578,24 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // Possible Values :
       // SQL_IC_MIXED         when connected to a server running a case-insensitive sort order.
       // SQL_IC_SENSITIVE     when connected to a server running a case-sensitive sort order.
-      *(SQLUSMALLINT*)infoValue = SQL_IC_SENSITIVE;
+      info.set<SQLUSMALLINT>(SQL_IC_SENSITIVE);
       break;
     }
     case SQL_AGGREGATE_FUNCTIONS: {
-      *(SQLUINTEGER*)infoValue = SQL_AF_ALL | SQL_AF_AVG | SQL_AF_COUNT |
-        SQL_AF_DISTINCT | SQL_AF_MAX | SQL_AF_MIN | SQL_AF_SUM;
+      info.set<SQLUINTEGER>(SQL_AF_ALL | SQL_AF_AVG | SQL_AF_COUNT |
+        SQL_AF_DISTINCT | SQL_AF_MAX | SQL_AF_MIN | SQL_AF_SUM);
       break;
     }
     case SQL_NUMERIC_FUNCTIONS: {
       // Removing below ones as did not find in spark sql numeric function list
       // SQL_FN_NUM_COT, SQL_FN_NUM_MOD (pmod is present), SQL_FN_NUM_TRUNCATE
-      *(SQLUINTEGER*)infoValue = SQL_FN_NUM_ABS | SQL_FN_NUM_ACOS |
+      info.set<SQLUINTEGER>(SQL_FN_NUM_ABS | SQL_FN_NUM_ACOS |
           SQL_FN_NUM_ASIN | SQL_FN_NUM_ATAN | SQL_FN_NUM_ATAN2 |
           SQL_FN_NUM_CEILING | SQL_FN_NUM_COS | SQL_FN_NUM_DEGREES |
           SQL_FN_NUM_EXP | SQL_FN_NUM_FLOOR | SQL_FN_NUM_LOG |
           SQL_FN_NUM_LOG10 | SQL_FN_NUM_PI | SQL_FN_NUM_POWER |
           SQL_FN_NUM_RADIANS | SQL_FN_NUM_RAND | SQL_FN_NUM_ROUND |
-          SQL_FN_NUM_SIGN | SQL_FN_NUM_SIN | SQL_FN_NUM_SQRT | SQL_FN_NUM_TAN;
+          SQL_FN_NUM_SIGN | SQL_FN_NUM_SIN | SQL_FN_NUM_SQRT | SQL_FN_NUM_TAN);
       break;
     }
     case SQL_STRING_FUNCTIONS: {
@@ -1250,11 +1605,11 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_FN_STR_LEFT, SQL_FN_STR_OCTET_LENGTH, SQL_FN_STR_POSITION,
       // SQL_FN_STR_REPLACE, SQL_FN_STR_RIGHT
 
-      *(SQLUINTEGER*)infoValue = SQL_FN_STR_ASCII | SQL_FN_STR_CONCAT |
+      info.set<SQLUINTEGER>(SQL_FN_STR_ASCII | SQL_FN_STR_CONCAT |
           SQL_FN_STR_LENGTH | SQL_FN_STR_LCASE | SQL_FN_STR_LOCATE |
           SQL_FN_STR_LTRIM | SQL_FN_STR_REPEAT | SQL_FN_STR_RTRIM |
           SQL_FN_STR_SOUNDEX | SQL_FN_STR_SPACE | SQL_FN_STR_SUBSTRING |
-          SQL_FN_STR_UCASE;
+          SQL_FN_STR_UCASE);
       break;
     }
     case SQL_TIMEDATE_FUNCTIONS: {
@@ -1264,11 +1619,11 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_FN_TD_MONTHNAME, SQL_FN_TD_TIMESTAMPADD, SQL_FN_TD_TIMESTAMPDIFF,
       // SQL_FN_TD_WEEK
 
-      *(SQLUINTEGER*)infoValue =  SQL_FN_TD_CURRENT_DATE |
+      info.set<SQLUINTEGER>(SQL_FN_TD_CURRENT_DATE |
           SQL_FN_TD_CURRENT_TIMESTAMP | SQL_FN_TD_DAYOFMONTH |
           SQL_FN_TD_DAYOFYEAR | SQL_FN_TD_HOUR | SQL_FN_TD_MINUTE |
           SQL_FN_TD_MONTH | SQL_FN_TD_NOW | SQL_FN_TD_QUARTER |
-          SQL_FN_TD_SECOND | SQL_FN_TD_YEAR;
+          SQL_FN_TD_SECOND | SQL_FN_TD_YEAR);
       break;
     }
     case SQL_TIMEDATE_ADD_INTERVALS: {
@@ -1278,7 +1633,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_FN_TSI_SECOND, SQL_FN_TSI_WEEK, SQL_FN_TSI_YEAR
 
       // TIMESTAMPADD is not supported
-      *(SQLUINTEGER*)infoValue = 0;
+      info.set<SQLUINTEGER>(0);
       break;
     }
     case SQL_TIMEDATE_DIFF_INTERVALS: {
@@ -1288,7 +1643,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_FN_TSI_SECOND, SQL_FN_TSI_WEEK, SQL_FN_TSI_YEAR
 
       // TIMESTAMPDIFF is not supported
-      *(SQLUINTEGER*)infoValue = 0;
+      info.set<SQLUINTEGER>(0);
       break;
     }
     case SQL_DATETIME_LITERALS: {
@@ -1296,21 +1651,21 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // and are separate from the datetime literal escape
       // clauses defined by ODBC.
       // SnappyData does not support these.
-      *(SQLUINTEGER*)infoValue = 0;
+      info.set<SQLUINTEGER>(0);
       break;
     }
     case SQL_SYSTEM_FUNCTIONS: {
       // Removing the ones below:
       // SQL_FN_SYS_DBNAME, SQL_FN_SYS_USERNAME
 
-      *(SQLUINTEGER*)infoValue = SQL_FN_SYS_IFNULL;
+      info.set<SQLUINTEGER>(SQL_FN_SYS_IFNULL);
       break;
     }
     case SQL_CONVERT_FUNCTIONS: {
       // Removing the ones below:
       // SQL_FN_CVT_CONVERT
 
-      *(SQLUINTEGER*)infoValue = SQL_FN_CVT_CAST;
+      info.set<SQLUINTEGER>(SQL_FN_CVT_CAST);
       break;
     }
     case SQL_CONVERT_BIGINT:
@@ -1340,12 +1695,12 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
     case SQL_CONVERT_WCHAR:
     case SQL_CONVERT_WLONGVARCHAR:
     case SQL_CONVERT_WVARCHAR:
-      *(SQLUINTEGER*)infoValue = 0;
+      info.set<SQLUINTEGER>(0);
       break;
 
     case SQL_SQL92_VALUE_EXPRESSIONS: {
-      *(SQLUINTEGER*)infoValue = SQL_SVE_CASE | SQL_SVE_CAST |
-          SQL_SVE_COALESCE | SQL_SVE_NULLIF;
+      info.set<SQLUINTEGER>(SQL_SVE_CASE | SQL_SVE_CAST |
+          SQL_SVE_COALESCE | SQL_SVE_NULLIF);
       break;
     }
     case SQL_SQL92_NUMERIC_VALUE_FUNCTIONS: {
@@ -1353,31 +1708,31 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_SNVF_BIT_LENGTH, SQL_SNVF_CHAR_LENGTH, SQL_SNVF_CHARACTER_LENGTH,
       // SQL_SNVF_EXTRACT, SQL_SNVF_OCTET_LENGTH, SQL_SNVF_POSITION
 
-      *(SQLUINTEGER*)infoValue = 0;
+      info.set<SQLUINTEGER>(0);
       break;
     }
     case SQL_SQL92_STRING_FUNCTIONS: {
       // Removed the ones below:
       // SQL_SSF_CONVERT, SQL_SSF_TRIM_BOTH, SQL_SSF_TRIM_LEADING, SQL_SSF_TRIM_TRAILING
 
-      *(SQLUINTEGER*)infoValue = SQL_SSF_LOWER | SQL_SSF_UPPER |
-          SQL_SSF_SUBSTRING | SQL_SSF_TRANSLATE;
+      info.set<SQLUINTEGER>(SQL_SSF_LOWER | SQL_SSF_UPPER |
+          SQL_SSF_SUBSTRING | SQL_SSF_TRANSLATE);
       break;
     }
     case SQL_SQL92_DATETIME_FUNCTIONS: {
       // Removed the ones below:
       // SQL_SDF_CURRENT_TIME
 
-      *(SQLUINTEGER*)infoValue = SQL_SDF_CURRENT_DATE | SQL_SDF_CURRENT_TIMESTAMP;
+      info.set<SQLUINTEGER>(SQL_SDF_CURRENT_DATE | SQL_SDF_CURRENT_TIMESTAMP);
       break;
     }
     case SQL_SQL92_RELATIONAL_JOIN_OPERATORS: {
       // Removed the ones below:
       // SQL_SRJO_CORRESPONDING_CLAUSE, SQL_SRJO_UNION_JOIN
 
-      *(SQLUINTEGER*)infoValue = SQL_SRJO_CROSS_JOIN | SQL_SRJO_EXCEPT_JOIN |
+      info.set<SQLUINTEGER>(SQL_SRJO_CROSS_JOIN | SQL_SRJO_EXCEPT_JOIN |
           SQL_SRJO_FULL_OUTER_JOIN | SQL_SRJO_INNER_JOIN | SQL_SRJO_INTERSECT_JOIN |
-          SQL_SRJO_LEFT_OUTER_JOIN | SQL_SRJO_NATURAL_JOIN | SQL_SRJO_RIGHT_OUTER_JOIN;
+          SQL_SRJO_LEFT_OUTER_JOIN | SQL_SRJO_NATURAL_JOIN | SQL_SRJO_RIGHT_OUTER_JOIN);
       break;
     }
     case SQL_SQL92_PREDICATES: {
@@ -1386,9 +1741,9 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_SP_MATCH_UNIQUE_PARTIAL, SQL_SP_OVERLAPS,
       // SQL_SP_QUANTIFIED_COMPARISON, SQL_SP_UNIQUE
 
-      *(SQLUINTEGER*)infoValue = SQL_SP_BETWEEN | SQL_SP_COMPARISON |
+      info.set<SQLUINTEGER>(SQL_SP_BETWEEN | SQL_SP_COMPARISON |
           SQL_SP_EXISTS | SQL_SP_ISNOTNULL | SQL_SP_ISNULL | SQL_SP_LIKE |
-          SQL_SP_IN;
+          SQL_SP_IN);
       break;
     }
     case SQL_SQL92_GRANT: {
@@ -1397,10 +1752,10 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_SG_USAGE_ON_CHARACTER_SET, SQL_SG_USAGE_ON_COLLATION,
       // SQL_SG_USAGE_ON_TRANSLATION
 
-      *(SQLUINTEGER*)infoValue = SQL_SG_DELETE_TABLE | SQL_SG_INSERT_TABLE |
+      info.set<SQLUINTEGER>(SQL_SG_DELETE_TABLE | SQL_SG_INSERT_TABLE |
           SQL_SG_REFERENCES_TABLE | SQL_SG_REFERENCES_COLUMN |
           SQL_SG_SELECT_TABLE | SQL_SG_UPDATE_COLUMN |
-          SQL_SG_UPDATE_TABLE | SQL_SG_WITH_GRANT_OPTION;
+          SQL_SG_UPDATE_TABLE | SQL_SG_WITH_GRANT_OPTION);
       break;
     }
     case SQL_SQL92_REVOKE: {
@@ -1409,21 +1764,21 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       // SQL_SR_RESTRICT, SQL_SR_USAGE_ON_DOMAIN, SQL_SR_USAGE_ON_CHARACTER_SET,
       // SQL_SR_USAGE_ON_COLLATION, SQL_SR_USAGE_ON_TRANSLATION
 
-      *(SQLUINTEGER*)infoValue = SQL_SR_DELETE_TABLE | SQL_SR_INSERT_TABLE |
+      info.set<SQLUINTEGER>(SQL_SR_DELETE_TABLE | SQL_SR_INSERT_TABLE |
           SQL_SR_REFERENCES_TABLE | SQL_SR_REFERENCES_COLUMN |
-          SQL_SR_SELECT_TABLE | SQL_SR_UPDATE_COLUMN | SQL_SR_UPDATE_TABLE;
+          SQL_SR_SELECT_TABLE | SQL_SR_UPDATE_COLUMN | SQL_SR_UPDATE_TABLE);
       break;
     }
     case SQL_SQL92_ROW_VALUE_CONSTRUCTOR: {
       // Removed the ones below:
       // SQL_SRVC_DEFAULT (supported by GemFireXD store but not by Spark)
 
-      *(SQLUINTEGER*)infoValue = SQL_SRVC_NULL | SQL_SRVC_VALUE_EXPRESSION |
-          SQL_SRVC_ROW_SUBQUERY;
+      info.set<SQLUINTEGER>(SQL_SRVC_NULL | SQL_SRVC_VALUE_EXPRESSION |
+          SQL_SRVC_ROW_SUBQUERY);
       break;
     }
     case SQL_KEYWORDS: {
-      const DatabaseMetaData* dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData* dbmd = m_conn->getServiceMetaData();
       auto keywords = dbmd->getSQLKeyWords();
       for (auto iter = keywords.cbegin(); iter != keywords.cend(); ++iter) {
         if (iter != keywords.cbegin()) resultString.append(",");
@@ -1436,7 +1791,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       break;
     }
     case SQL_FILE_USAGE:
-      *(SQLUSMALLINT*)infoValue = SQL_FILE_NOT_SUPPORTED;
+      info.set<SQLUSMALLINT>(SQL_FILE_NOT_SUPPORTED);
       break;
     case SQL_ROW_UPDATES:
       resStr = "N";
@@ -1464,10 +1819,10 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       resStrLen = 0;
       break;
     case SQL_MAX_PROCEDURE_NAME_LEN:
-      *(SQLUSMALLINT*)infoValue = 0; // procedures are not supported in Spark
+      info.set<SQLUSMALLINT>(0); // procedures are not supported in Spark
       break;
     case SQL_ACCESSIBLE_TABLES: {
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       resStr = dbmd->isFeatureSupported(DatabaseFeature::ALL_TABLES_SELECTABLE)
           ? "Y" : "N";
       resInfo = "SQL_ACCESSIBLE_TABLES";
@@ -1475,27 +1830,27 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       break;
     }
     case SQL_CONCAT_NULL_BEHAVIOR: {
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
-      *(SQLUSMALLINT*)infoValue = dbmd->isFeatureSupported(DatabaseFeature::
-          NULL_CONCAT_NON_NULL_IS_NULL) ? SQL_CB_NULL : SQL_CB_NON_NULL;
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
+      info.set<SQLUSMALLINT>(dbmd->isFeatureSupported(DatabaseFeature::
+          NULL_CONCAT_NON_NULL_IS_NULL) ? SQL_CB_NULL : SQL_CB_NON_NULL);
       break;
     }
     case SQL_DATA_SOURCE_READ_ONLY: {
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       resStr = dbmd->isReadOnly() ? "Y" : "N";
       resInfo = "SQL_DATA_SOURCE_READ_ONLY";
       resStrLen = 1;
       break;
     }
     case SQL_DEFAULT_TXN_ISOLATION: {
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
-      *(SQLUINTEGER*)infoValue = translateTransactionIsolation(
-          dbmd->defaultTransactionIsolation());
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
+      info.set<SQLUINTEGER>(translateTransactionIsolation(
+          dbmd->defaultTransactionIsolation()));
       break;
     }
     case SQL_TXN_ISOLATION_OPTION: {
       SQLUINTEGER levels = 0;
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       if (dbmd->supportsTransactionIsolationLevel(
           IsolationLevel::READ_UNCOMMITTED)) {
         levels |= SQL_TXN_READ_UNCOMMITTED;
@@ -1512,11 +1867,11 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
           IsolationLevel::SERIALIZABLE)) {
         levels |= SQL_TXN_SERIALIZABLE;
       }
-      *(SQLUINTEGER*)infoValue = levels;
+      info.set<SQLUINTEGER>(levels);
       break;
     }
     case SQL_MULT_RESULT_SETS: {
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       resStr = dbmd->isFeatureSupported(
           DatabaseFeature::MULTIPLE_RESULTSETS) ? "Y" : "N";
       resInfo = "SQL_MULT_RESULT_SETS";
@@ -1524,7 +1879,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       break;
     }
     case SQL_MULTIPLE_ACTIVE_TXN: {
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       resStr = dbmd->isFeatureSupported(
           DatabaseFeature::MULTIPLE_TRANSACTIONS) ? "Y" : "N";
       resInfo = "SQL_MULTIPLE_ACTIVE_TXN";
@@ -1538,7 +1893,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       break;
     case SQL_NULL_COLLATION: {
       SQLUSMALLINT nullsSorting = 0;
-      const DatabaseMetaData *dbmd = m_conn.getServiceMetaData();
+      const DatabaseMetaData *dbmd = m_conn->getServiceMetaData();
       if (dbmd->isFeatureSupported(DatabaseFeature::NULLS_SORTED_END)) {
         nullsSorting = SQL_NC_END;
       } else if (dbmd->isFeatureSupported(DatabaseFeature::NULLS_SORTED_HIGH)) {
@@ -1549,7 +1904,7 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
           DatabaseFeature::NULLS_SORTED_START)) {
         nullsSorting = SQL_NC_START;
       }
-      *(SQLUSMALLINT*)infoValue = nullsSorting;
+      info.set<SQLUSMALLINT>(nullsSorting);
       break;
     }
     case SQL_COLLATION_SEQ:
@@ -1558,28 +1913,28 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       resStrLen = SQL_NTS;
       break;
     case SQL_CREATE_SCHEMA:
-      *(SQLUINTEGER*)infoValue = SQL_CS_CREATE_SCHEMA | SQL_CS_AUTHORIZATION;
+      info.set<SQLUINTEGER>(SQL_CS_CREATE_SCHEMA | SQL_CS_AUTHORIZATION);
       break;
     case SQL_DROP_SCHEMA:
-      *(SQLUINTEGER*)infoValue = SQL_DS_DROP_SCHEMA | SQL_DS_CASCADE |
-          SQL_DS_RESTRICT;
+      info.set<SQLUINTEGER>(SQL_DS_DROP_SCHEMA | SQL_DS_CASCADE |
+          SQL_DS_RESTRICT);
       break;
     case SQL_CREATE_TABLE:
-      *(SQLUINTEGER*)infoValue = SQL_CT_CREATE_TABLE | SQL_CT_TABLE_CONSTRAINT |
+      info.set<SQLUINTEGER>(SQL_CT_CREATE_TABLE | SQL_CT_TABLE_CONSTRAINT |
           SQL_CT_CONSTRAINT_NAME_DEFINITION | SQL_CT_COLUMN_CONSTRAINT |
-          SQL_CT_COLUMN_DEFAULT | SQL_CT_COMMIT_DELETE;
+          SQL_CT_COLUMN_DEFAULT | SQL_CT_COMMIT_DELETE);
       break;
     case SQL_DROP_TABLE:
-      *(SQLUINTEGER*)infoValue = SQL_DT_DROP_TABLE;
+      info.set<SQLUINTEGER>(SQL_DT_DROP_TABLE);
       break;
     case SQL_CREATE_VIEW:
-      *(SQLUINTEGER*)infoValue = SQL_CV_CREATE_VIEW;
+      info.set<SQLUINTEGER>(SQL_CV_CREATE_VIEW);
       break;
     case SQL_DROP_VIEW:
-      *(SQLUINTEGER*)infoValue = SQL_DV_DROP_VIEW;
+      info.set<SQLUINTEGER>(SQL_DV_DROP_VIEW);
       break;
     case SQL_DDL_INDEX:
-      *(SQLUINTEGER*)infoValue = SQL_DI_CREATE_INDEX | SQL_DI_DROP_INDEX;
+      info.set<SQLUINTEGER>(SQL_DI_CREATE_INDEX | SQL_DI_DROP_INDEX);
       break;
     case SQL_DESCRIBE_PARAMETER:
       resStr = "N";
@@ -1587,17 +1942,20 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       resStrLen = 1;
       break;
     case SQL_INDEX_KEYWORDS:
-      *(SQLUINTEGER*)infoValue = SQL_IK_ASC | SQL_IK_DESC;
+      info.set<SQLUINTEGER>(SQL_IK_ASC | SQL_IK_DESC);
       break;
     case SQL_INSERT_STATEMENT:
-      *(SQLUINTEGER*)infoValue = SQL_IS_INSERT_LITERALS |
-          SQL_IS_INSERT_SEARCHED | SQL_IS_SELECT_INTO;
+      info.set<SQLUINTEGER>(SQL_IS_INSERT_LITERALS |
+          SQL_IS_INSERT_SEARCHED | SQL_IS_SELECT_INTO);
       break;
     case SQL_PARAM_ARRAY_SELECTS:
-      *(SQLUINTEGER*)infoValue = SQL_PAS_NO_SELECT;
+      info.set<SQLUINTEGER>(SQL_PAS_NO_SELECT);
       break;
     case SQL_ASYNC_MODE:
-      *(SQLUINTEGER*)infoValue = SQL_AM_NONE; // unsupported
+      info.set<SQLUINTEGER>(SQL_AM_STATEMENT);
+      break;
+    case SQL_ASYNC_NOTIFICATION:
+      info.set<SQLUINTEGER>(SQL_ASYNC_NOTIFICATION_CAPABLE);
       break;
     case SQL_ALTER_DOMAIN:
     case SQL_BOOKMARK_PERSISTENCE:
@@ -1612,8 +1970,10 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
     case SQL_DROP_DOMAIN:
     case SQL_DROP_TRANSLATION:
     case SQL_INFO_SCHEMA_VIEWS:
+      info.set<SQLUINTEGER>(0); // unsupported
+      break;
     case SQL_MAX_ASYNC_CONCURRENT_STATEMENTS:
-      *(SQLUINTEGER*)infoValue = 0; // unsupported
+      info.set<SQLUINTEGER>(0); // no limit
       break;
 
     default:
@@ -1625,15 +1985,47 @@ SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue
       return SQL_ERROR;
   }
   if (resStr) {
+    info.setString(resStr, resStrLen, resInfo);
+  }
+  return SQL_SUCCESS;
+}
+
+template<typename CHAR_TYPE>
+SQLRETURN SnappyConnection::getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue,
+    SQLSMALLINT bufferLength, SQLSMALLINT* stringLength) {
+  clearLastError();
+  const InfoValue* info = m_infoTable ? m_infoTable->get(infoType) : nullptr;
+  InfoValue connInfo;
+  if (!info) {
+    // wait for any operations running in background on the connection
+    std::lock_guard<std::recursive_mutex> sync(m_execLock);
+    const SQLRETURN ret = readInfo(infoType, connInfo);
+    if (ret != SQL_SUCCESS) {
+      return ret;
+    }
+    if (m_infoTable && !InfoTable::isConnectionInfo(infoType)) {
+      info = m_infoTable->put(infoType, std::move(connInfo));
+    } else {
+      info = &connInfo;
+    }
+  }
+  if (info->m_size == 0) {
     SQLINTEGER totalLen = 0;
-    ret = getStringValue((const SQLCHAR*)resStr, resStrLen,
-        (CHAR_TYPE*)infoValue, bufferLength, &totalLen, resInfo);
+    const SQLRETURN ret = getStringValue(
+        (const SQLCHAR*)info->m_string.data(),
+        StringFunctions::restrictLength<SQLLEN, size_t>(info->m_string.size()),
+        (CHAR_TYPE*)infoValue, bufferLength, &totalLen, info->m_name);
     if (stringLength) {
       *stringLength = StringFunctions::restrictLength<SQLSMALLINT, int64_t>(
           static_cast<int64_t>(totalLen) * sizeof(CHAR_TYPE));
     }
+    return ret;
+  } else if (info->m_size == sizeof(SQLUSMALLINT)) {
+    *(SQLUSMALLINT*)infoValue = static_cast<SQLUSMALLINT>(info->m_number);
+  } else {
+    *(SQLUINTEGER*)infoValue = info->m_number;
   }
-  return ret;
+  return SQL_SUCCESS;
 }
 
 SQLRETURN SnappyConnection::getAttribute(SQLINTEGER attribute,
@@ -1703,7 +2095,7 @@ SQLRETURN SnappyConnection::nativeSQLT(CHAR_TYPE* inStatementText,
         "outStatementText string length", this);
   }
   std::string stmt = StringFunctions::toString(inStatementText, textLength1);
-  std::string nativeSQL = m_conn.getNativeSQL(stmt);
+  std::string nativeSQL = m_conn->getNativeSQL(stmt);
   return getStringValue((const SQLCHAR*)nativeSQL.data(),
       static_cast<SQLINTEGER>(nativeSQL.size()), outStatementText,
       bufferLength, textLength2Ptr, "nativeSQL");
@@ -1726,7 +2118,11 @@ SQLRETURN SnappyConnection::nativeSQLW(SQLWCHAR* inStatementText,
 SQLRETURN SnappyConnection::commit() {
   clearLastError();
   try {
-    m_conn.commitTransaction(true);
+    // wait for any operations running in background on the connection
+    std::lock_guard<std::recursive_mutex> sync(m_execLock);
+    PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+    m_perfCounters.add(PerfCounters::ROUND_TRIPS, 1);
+    m_conn->commitTransaction(true);
     return SQL_SUCCESS;
   } catch (SQLException& sqle) {
     setException(sqle);
@@ -1740,7 +2136,11 @@ SQLRETURN SnappyConnection::commit() {
 SQLRETURN SnappyConnection::rollback() {
   clearLastError();
   try {
-    m_conn.rollbackTransaction(true);
+    // wait for any operations running in background on the connection
+    std::lock_guard<std::recursive_mutex> sync(m_execLock);
+    PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+    m_perfCounters.add(PerfCounters::ROUND_TRIPS, 1);
+    m_conn->rollbackTransaction(true);
     return SQL_SUCCESS;
   } catch (SQLException& sqle) {
     setException(sqle);
@@ -1754,7 +2154,7 @@ SQLRETURN SnappyConnection::rollback() {
 SQLRETURN SnappyConnection::cancelCurrentStatement() {
   clearLastError();
   try {
-    m_conn.cancelCurrentStatement();
+    m_conn->cancelCurrentStatement();
     return SQL_SUCCESS;
   } catch (SQLException& sqle) {
     setException(sqle);
@@ -44,10 +44,16 @@
 
 #include <Connection.h>
 
+#include "CatalogCache.h"
+#include "InfoTable.h"
+#include "PerfCounters.h"
 #include "SnappyEnvironment.h"
 #include "SnappyDefaults.h"
 #include "Library.h"
 
+#include <condition_variable>
+#include <list>
+
 namespace io {
 namespace snappydata {
 
@@ -61,7 +67,7 @@ namespace snappydata {
   class SnappyConnection final : public SnappyHandleBase {
   private:
     /** the underlying native connection */
-    Connection m_conn;
+    std::unique_ptr<Connection> m_conn;
 
     /** the current SnappyEnvironment */
     SnappyEnvironment* const m_env;
@@ -71,6 +77,15 @@ namespace snappydata {
     /** the DSN for this connection, if any */
     std::string m_dsn;
 
+    /** the server, port and properties used to open the connection */
+    std::string m_server;
+    int m_port;
+    Properties m_connProps;
+    /** the isolation level when the native connection was opened */
+    IsolationLevel m_initialIsolation;
+    /** idle timeout when this connection is parked in a ConnectionPool */
+    std::chrono::seconds m_poolIdleTimeout;
+
     /**
      * set of attributes set for this connection using
      * {@link #setAttribute}
@@ -111,6 +126,72 @@ namespace snappydata {
      */
     DriverToDataSource m_driverToDataSource;
 
+    typedef std::list<std::pair<std::string,
+        std::unique_ptr<PreparedStatement> > > StatementCacheList;
+
+    /**
+     * LRU cache of prepared statements released by closed statement handles
+     * keyed by the SQL text and statement attributes (most recent at front).
+     */
+    StatementCacheList m_stmtCache;
+    /** index into m_stmtCache by the key */
+    std::unordered_map<std::string, StatementCacheList::iterator>
+        m_stmtCacheIndex;
+    /** maximum size of m_stmtCache; zero when disabled */
+    size_t m_stmtCacheSize;
+    /** number of prepares that did not find a cached statement */
+    uint64_t m_stmtCacheMisses;
+    /** the lock to protect concurrent access to the statement cache */
+    std::mutex m_stmtCacheLock;
+
+    /**
+     * the performance counters of this connection that include those of
+     * all the statements on it
+     */
+    PerfCounters m_perfCounters;
+
+    /**
+     * the SQL_ATTR_ASYNC_ENABLE value inherited by new statements
+     * allocated on this connection
+     */
+    SQLULEN m_asyncEnable;
+    /**
+     * the lock held by the operations that use the transport of the native
+     * connection, which can execute only one operation at a time, so that
+     * the statements used concurrently by different application threads,
+     * by the driver threads running asynchronous operations, and by the
+     * read-ahead of rows, are multiplexed over the connection; it is
+     * re-entrant so that such operations can be nested
+     */
+    std::recursive_mutex m_execLock;
+
+    /**
+     * the number of rows read ahead for forward-only cursors, inherited by
+     * new statements; zero when disabled
+     */
+    SQLULEN m_readAheadRows;
+
+    /**
+     * size in bytes beyond which a value sent by SQLPutData is spilled to
+     * a temporary file; zero when disabled
+     */
+    size_t m_putDataSpillSize;
+
+    /** results of the catalog functions executed on this connection */
+    CatalogCache m_catalogCache;
+
+    /** SQLGetInfo results shared with other connections to the server */
+    std::shared_ptr<InfoTable> m_infoTable;
+    /** if true then m_infoTable is filled in background after connect */
+    bool m_prewarmInfo;
+    /**
+     * true while m_infoTable is being filled in background; protected
+     * by m_execLock
+     */
+    bool m_infoPrewarming;
+    /** signalled when the background fill of m_infoTable completes */
+    std::condition_variable_any m_infoPrewarmCond;
+
     /** SnappyEnvironment needs to access the private destructor */
     friend class SnappyEnvironment;
 
@@ -172,6 +253,23 @@ namespace snappydata {
     SQLRETURN getInfoT(SQLUSMALLINT infoType, SQLPOINTER infoValue,
         SQLSMALLINT bufferLength, SQLSMALLINT* stringLength);
 
+    /**
+     * Read the result of SQLGetInfo for given info type from the server
+     * or driver constants.
+     *
+     * @throws SQLException on error, so caller should handle
+     */
+    SQLRETURN readInfo(SQLUSMALLINT infoType, InfoValue& info);
+
+    /**
+     * Start filling m_infoTable in background if m_prewarmInfo is set and
+     * the table is not complete.
+     */
+    void startInfoPrewarm() noexcept;
+
+    /** wait for any background fill of m_infoTable started on this */
+    void awaitInfoPrewarm() noexcept;
+
     /**
      * Converts the given SQL statement into the system's native SQL grammar.
      */
@@ -180,6 +278,58 @@ namespace snappydata {
         CHAR_TYPE* outStatementText, SQLINTEGER bufferLength,
         SQLINTEGER* textLength2Ptr);
 
+    /**
+     * Roll back any transaction in progress before the native connection
+     * is parked in the pool. Returns false if that failed in which case
+     * the connection should be closed instead.
+     */
+    bool rollbackForPool() noexcept;
+
+    /**
+     * Get a matching connection from the ConnectionPool, if any, and reset
+     * its session state. Returns true if a pooled connection was obtained.
+     */
+    bool checkoutPooledConnection(ConnectionPool& pool,
+        const std::string& server, const int port,
+        const Properties& nativeProps);
+
+    /**
+     * Remove the given property interpreted by the ODBC layer and read it
+     * as a non-negative integer into result if present. Returns false if
+     * the value is malformed, or negative (HY024) which would otherwise
+     * wrap around as a size.
+     */
+    bool stripIntProperty(Properties& props, const std::string& name,
+        long& result);
+
+    /** Return true if prepared statements are cached by this connection. */
+    inline bool isStatementCacheEnabled() const noexcept {
+      return m_stmtCacheSize > 0;
+    }
+
+    /**
+     * Remove and return the cached prepared statement for given key, if any.
+     */
+    std::unique_ptr<PreparedStatement> takeCachedStatement(
+        const std::string& key);
+
+    /**
+     * Add a prepared statement to the cache for reuse by a later
+     * {@link #takeCachedStatement} else close it if caching is disabled.
+     * The least recently used statement is closed if cache is full.
+     *
+     * @throws SQLException on error, so caller should handle
+     */
+    void cacheStatement(const std::string& key,
+        std::unique_ptr<PreparedStatement> pstmt);
+
+    /**
+     * Close and remove all the cached prepared statements.
+     *
+     * @throws SQLException on error, so caller should handle
+     */
+    void clearStatementCache();
+
   public:
     static SQLRETURN newConnection(SnappyEnvironment *env,
         SnappyConnection*& connRef);
@@ -227,7 +377,7 @@ namespace snappydata {
      * Return true if this connection is currently active.
      */
     inline bool isActive() {
-      return m_conn.isOpen();
+      return m_conn->isOpen();
     }
 
     const std::string& getDSN() const noexcept {
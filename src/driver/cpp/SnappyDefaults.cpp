@@ -60,3 +60,15 @@ const char* SnappyDefaults::ODBCINST_INI = "ODBCINST.INI";
 
 // using the Snappy/Derby default client port
 const int SnappyDefaults::DEFAULT_SERVER_PORT = 1527;
+const int SnappyDefaults::DEFAULT_STATEMENT_CACHE_SIZE = 0;
+const int SnappyDefaults::DEFAULT_POOL_IDLE_TIMEOUT_SECS = 60;
+// maximum number of threads executing asynchronous statement operations
+const int SnappyDefaults::DEFAULT_ASYNC_MAX_THREADS = 64;
+// read-ahead of result rows is disabled by default
+const int SnappyDefaults::DEFAULT_READ_AHEAD_ROWS = 0;
+// SQLPutData values larger than 16MB are spilled to a temporary file
+const int SnappyDefaults::DEFAULT_PUT_DATA_SPILL_SIZE = 16 * 1024 * 1024;
+// caching of catalog function results is disabled by default
+const int SnappyDefaults::DEFAULT_CATALOG_CACHE_TTL_SECS = 0;
+// SQLGetInfo results are read on demand by default
+const int SnappyDefaults::DEFAULT_PREWARM_INFO = 0;
@@ -55,6 +55,13 @@ namespace snappydata {
     static const char* ODBCINST_INI;
 
     static const int DEFAULT_SERVER_PORT;
+    static const int DEFAULT_STATEMENT_CACHE_SIZE;
+    static const int DEFAULT_POOL_IDLE_TIMEOUT_SECS;
+    static const int DEFAULT_ASYNC_MAX_THREADS;
+    static const int DEFAULT_READ_AHEAD_ROWS;
+    static const int DEFAULT_PUT_DATA_SPILL_SIZE;
+    static const int DEFAULT_CATALOG_CACHE_TTL_SECS;
+    static const int DEFAULT_PREWARM_INFO;
   };
 
   /** typedef for SQLWCHAR strings like std::string */
@@ -102,6 +109,13 @@ namespace snappydata {
       SDWORD cbValueOutMax, SDWORD * pcbValueOut, UCHAR * szErrorMsg,
       SWORD cbErrorMsgMax, SWORD * pcbErrorMsg);
 
+  /**
+   * Function definition for the ODBC 3.8 asynchronous notification callback
+   * set by the driver manager using SQL_ATTR_ASYNC_STMT_PCALLBACK.
+   */
+  typedef SQLRETURN (SQL_API *AsyncNotificationCallback)(SQLPOINTER context,
+      BOOL last);
+
   /* Check if a paramater is a data-at-exec paramter.*/
   #define IS_DATA_AT_EXEC(X)((X) && \
                             (*(X) == SQL_DATA_AT_EXEC || \
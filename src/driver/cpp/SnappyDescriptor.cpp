@@ -38,15 +38,614 @@
  */
 
 #include "SnappyDescriptor.h"
+#include "SnappyStatement.h"
 
 using namespace io::snappydata;
 
-SnappyDescriptor::SnappyDescriptor(int descType) { //:
-//m_resultSetMetaData(nullptr), m_paramMetaData(nullptr)
-  m_descType = descType;
-  //m_resultSetMetaData = nullptr;
-  //m_paramMetaData = nullptr;
+/**
+ * Write a numeric descriptor field with the size as defined by ODBC for
+ * the field.
+ */
+static void putNumericField(const SQLSMALLINT fieldId, const SQLLEN value,
+    SQLPOINTER result, SQLINTEGER* stringLength) {
+  if (!result) return;
+  switch (fieldId) {
+    case SQL_DESC_AUTO_UNIQUE_VALUE:
+    case SQL_DESC_BIND_TYPE:
+    case SQL_DESC_CASE_SENSITIVE:
+    case SQL_DESC_DATETIME_INTERVAL_PRECISION:
+    case SQL_DESC_NUM_PREC_RADIX:
+      *(SQLINTEGER*)result = static_cast<SQLINTEGER>(value);
+      if (stringLength) *stringLength = sizeof(SQLINTEGER);
+      break;
+    case SQL_DESC_ARRAY_SIZE:
+    case SQL_DESC_DISPLAY_SIZE:
+    case SQL_DESC_LENGTH:
+    case SQL_DESC_OCTET_LENGTH:
+      *(SQLLEN*)result = value;
+      if (stringLength) *stringLength = sizeof(SQLLEN);
+      break;
+    default:
+      *(SQLSMALLINT*)result = static_cast<SQLSMALLINT>(value);
+      if (stringLength) *stringLength = sizeof(SQLSMALLINT);
+      break;
+  }
+}
+
+static void putPointerField(const SQLPOINTER value, SQLPOINTER result,
+    SQLINTEGER* stringLength) {
+  if (result) *(SQLPOINTER*)result = value;
+  if (stringLength) *stringLength = sizeof(SQLPOINTER);
+}
+
+static bool isStringField(const SQLSMALLINT fieldId) noexcept {
+  switch (fieldId) {
+    case SQL_DESC_BASE_COLUMN_NAME:
+    case SQL_DESC_BASE_TABLE_NAME:
+    case SQL_DESC_CATALOG_NAME:
+    case SQL_DESC_LABEL:
+    case SQL_DESC_LITERAL_PREFIX:
+    case SQL_DESC_LITERAL_SUFFIX:
+    case SQL_DESC_LOCAL_TYPE_NAME:
+    case SQL_DESC_NAME:
+    case SQL_DESC_SCHEMA_NAME:
+    case SQL_DESC_TABLE_NAME:
+    case SQL_DESC_TYPE_NAME:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Get the verbose type of SQL_DESC_TYPE for a concise SQL or C type and
+ * the subcode of SQL_DESC_DATETIME_INTERVAL_CODE for datetime and
+ * interval types (zero for others).
+ */
+static SQLSMALLINT getVerboseType(const SQLSMALLINT conciseType,
+    SQLSMALLINT& code) noexcept {
+  switch (conciseType) {
+    case SQL_TYPE_DATE:
+    case SQL_TYPE_TIME:
+    case SQL_TYPE_TIMESTAMP:
+      code = conciseType - SQL_TYPE_DATE + SQL_CODE_DATE;
+      return SQL_DATETIME;
+    default:
+      if (conciseType >= SQL_INTERVAL_YEAR
+          && conciseType <= SQL_INTERVAL_MINUTE_TO_SECOND) {
+        code = conciseType - SQL_INTERVAL_YEAR + SQL_CODE_YEAR;
+        return SQL_INTERVAL;
+      }
+      code = 0;
+      return conciseType;
+  }
+}
+
+/**
+ * Get the concise type for a verbose type and the datetime/interval
+ * subcode which is used only for SQL_DATETIME and SQL_INTERVAL.
+ */
+static SQLSMALLINT getConciseType(const SQLSMALLINT verboseType,
+    const SQLSMALLINT code) noexcept {
+  switch (verboseType) {
+    case SQL_DATETIME:
+      return code >= SQL_CODE_DATE && code <= SQL_CODE_TIMESTAMP
+          ? SQL_TYPE_DATE + code - SQL_CODE_DATE : SQL_TYPE_TIMESTAMP;
+    case SQL_INTERVAL:
+      return code >= SQL_CODE_YEAR && code <= SQL_CODE_MINUTE_TO_SECOND
+          ? SQL_INTERVAL_YEAR + code - SQL_CODE_YEAR
+          : SQL_INTERVAL_DAY_TO_SECOND;
+    default:
+      return verboseType;
+  }
+}
+
+SnappyDescriptor::SnappyDescriptor(SnappyStatement* stmt, int descType) :
+    m_stmt(stmt), m_descType(descType) {
 }
 
 SnappyDescriptor::~SnappyDescriptor() {
 }
+
+SQLRETURN SnappyDescriptor::withStatementError(SQLRETURN result) {
+  if (result != SQL_SUCCESS && m_stmt->lastDiagRecords()) {
+    setLastError(*m_stmt);
+  }
+  return result;
+}
+
+size_t SnappyDescriptor::getResultRecordCount() {
+  SnappyStatement& stmt = *m_stmt;
+  // IRD has no records when there is no open or prepared cursor
+  return stmt.hasOpenCursor() || stmt.isPrepared()
+      ? stmt.getResultRecords().size() : 0;
+}
+
+SQLRETURN SnappyDescriptor::getFieldT(SQLSMALLINT recNumber,
+    SQLSMALLINT fieldId, SQLPOINTER value, SQLINTEGER bufferLength,
+    SQLINTEGER* stringLength, const int sizeOfChar) {
+  clearLastError();
+  SnappyStatement& stmt = *m_stmt;
+  const bool isApp = (m_descType == SQL_ATTR_APP_ROW_DESC
+      || m_descType == SQL_ATTR_APP_PARAM_DESC);
+  const bool isRow = (m_descType == SQL_ATTR_APP_ROW_DESC
+      || m_descType == SQL_ATTR_IMP_ROW_DESC);
+  try {
+    switch (fieldId) {
+      // header fields
+      case SQL_DESC_ALLOC_TYPE:
+        // only the implicitly allocated descriptors are supported
+        putNumericField(fieldId, SQL_DESC_ALLOC_AUTO, value, stringLength);
+        return SQL_SUCCESS;
+      case SQL_DESC_COUNT: {
+        size_t count;
+        switch (m_descType) {
+          case SQL_ATTR_APP_ROW_DESC:
+            count = stmt.m_outputFields.size();
+            break;
+          case SQL_ATTR_APP_PARAM_DESC:
+            count = stmt.m_params.size();
+            break;
+          case SQL_ATTR_IMP_ROW_DESC:
+            count = getResultRecordCount();
+            break;
+          default:
+            count = stmt.getParamRecords().size();
+            break;
+        }
+        putNumericField(fieldId, static_cast<SQLLEN>(count), value,
+            stringLength);
+        return SQL_SUCCESS;
+      }
+      case SQL_DESC_ARRAY_SIZE:
+        if (!isApp) break;
+        putNumericField(fieldId, static_cast<SQLLEN>(isRow
+            ? stmt.m_bulkCursor.batchSize() : stmt.m_paramSetSize), value,
+            stringLength);
+        return SQL_SUCCESS;
+      case SQL_DESC_BIND_TYPE:
+        if (!isApp) break;
+        putNumericField(fieldId, static_cast<SQLLEN>(isRow
+            ? stmt.m_bindingOrientation : stmt.m_paramBindingOrientation),
+            value, stringLength);
+        return SQL_SUCCESS;
+      case SQL_DESC_BIND_OFFSET_PTR:
+        if (!isApp) break;
+        putPointerField(isRow ? stmt.m_bindOffsetPtr
+            : stmt.m_paramBindOffsetPtr, value, stringLength);
+        return SQL_SUCCESS;
+      case SQL_DESC_ARRAY_STATUS_PTR: {
+        SQLUSMALLINT* statusPtr;
+        switch (m_descType) {
+          case SQL_ATTR_APP_ROW_DESC:
+            statusPtr = stmt.m_rowOperationPtr;
+            break;
+          case SQL_ATTR_APP_PARAM_DESC:
+            statusPtr = stmt.m_paramOperationPtr;
+            break;
+          case SQL_ATTR_IMP_ROW_DESC:
+            statusPtr = stmt.m_rowStatusPtr;
+            break;
+          default:
+            statusPtr = stmt.m_paramStatusArr;
+            break;
+        }
+        putPointerField(statusPtr, value, stringLength);
+        return SQL_SUCCESS;
+      }
+      case SQL_DESC_ROWS_PROCESSED_PTR:
+        if (isApp) break;
+        putPointerField(isRow ? stmt.m_fetchedRowsPtr
+            : stmt.m_paramsProcessedPtr, value, stringLength);
+        return SQL_SUCCESS;
+
+      // record fields
+      default:
+        switch (m_descType) {
+          case SQL_ATTR_IMP_ROW_DESC: {
+            if (recNumber > 0 && static_cast<size_t>(recNumber)
+                > getResultRecordCount()) {
+              return SQL_NO_DATA;
+            }
+            // lookup in the IRD records is done by SQLColAttribute
+            SQLSMALLINT len = 0;
+            SQLLEN numericValue = 0;
+            SQLRETURN result;
+            if (isStringField(fieldId)) {
+              result = stmt.getColumnAttributeT(recNumber, fieldId, value,
+                  StringFunctions::restrictLength<SQLSMALLINT, SQLINTEGER>(
+                      bufferLength), &len, nullptr, sizeOfChar);
+              if (stringLength) *stringLength = len;
+            } else if (fieldId == SQL_DESC_DATETIME_INTERVAL_CODE) {
+              result = stmt.getColumnAttributeT(recNumber,
+                  SQL_DESC_CONCISE_TYPE, nullptr, 0, nullptr, &numericValue,
+                  sizeOfChar);
+              if (SQL_SUCCEEDED(result)) {
+                SQLSMALLINT code;
+                getVerboseType(static_cast<SQLSMALLINT>(numericValue), code);
+                putNumericField(fieldId, code, value, stringLength);
+              }
+            } else {
+              result = stmt.getColumnAttributeT(recNumber, fieldId, nullptr,
+                  0, nullptr, &numericValue, sizeOfChar);
+              if (SQL_SUCCEEDED(result)) {
+                putNumericField(fieldId, numericValue, value, stringLength);
+              }
+            }
+            return withStatementError(result);
+          }
+          case SQL_ATTR_IMP_PARAM_DESC:
+            return getParamRecordField(recNumber, fieldId, value);
+          default:
+            return getAppRecordField(recNumber, fieldId, value);
+        }
+    }
+    setException(GET_SQLEXCEPTION2(
+        SQLStateMessage::INVALID_DESCRIPTOR_FIELD_ID_MSG, fieldId));
+    return SQL_ERROR;
+  } catch (SQLException& sqle) {
+    setException(sqle);
+    return SQL_ERROR;
+  } catch (std::exception& se) {
+    setException(__FILE__, __LINE__, se);
+    return SQL_ERROR;
+  }
+}
+
+SQLRETURN SnappyDescriptor::getAppRecordField(SQLSMALLINT recNumber,
+    SQLSMALLINT fieldId, SQLPOINTER value) {
+  SnappyStatement& stmt = *m_stmt;
+  const bool isRow = (m_descType == SQL_ATTR_APP_ROW_DESC);
+  const size_t count = isRow ? stmt.m_outputFields.size()
+      : stmt.m_params.size();
+  if (recNumber <= 0) {
+    // bookmark columns are not supported
+    setException(GET_SQLEXCEPTION2(SQLStateMessage::COLUMN_NOT_FOUND_MSG1,
+        recNumber, static_cast<int>(count)));
+    return SQL_ERROR;
+  }
+  if (static_cast<size_t>(recNumber) > count) {
+    return SQL_NO_DATA;
+  }
+  SQLSMALLINT type;
+  SQLPOINTER dataPtr;
+  SQLLEN octetLength;
+  SQLLEN* octetLengthPtr;
+  SQLLEN* indicatorPtr;
+  if (isRow) {
+    const SnappyStatement::OutputField& field =
+        stmt.m_outputFields[recNumber - 1];
+    type = field.m_targetType;
+    dataPtr = field.m_targetValue;
+    octetLength = field.m_valueSize;
+    octetLengthPtr = field.m_lenOrIndPtr;
+    indicatorPtr = field.m_indicatorPtr;
+  } else {
+    const SnappyStatement::Parameter& param = stmt.m_params[recNumber - 1];
+    if (param.m_inputOutputType < 0) {
+      // a hole in the bound parameters
+      return SQL_NO_DATA;
+    }
+    type = param.m_o_valueType;
+    dataPtr = param.m_o_value;
+    octetLength = param.m_o_valueSize;
+    octetLengthPtr = param.m_o_lenOrIndp;
+    indicatorPtr = param.m_o_indicatorPtr;
+  }
+  SQLSMALLINT code;
+  switch (fieldId) {
+    case SQL_DESC_TYPE:
+      putNumericField(fieldId, getVerboseType(type, code), value, nullptr);
+      return SQL_SUCCESS;
+    case SQL_DESC_CONCISE_TYPE:
+      putNumericField(fieldId, type, value, nullptr);
+      return SQL_SUCCESS;
+    case SQL_DESC_DATETIME_INTERVAL_CODE:
+      getVerboseType(type, code);
+      putNumericField(fieldId, code, value, nullptr);
+      return SQL_SUCCESS;
+    case SQL_DESC_DATA_PTR:
+      putPointerField(dataPtr, value, nullptr);
+      return SQL_SUCCESS;
+    case SQL_DESC_OCTET_LENGTH:
+      putNumericField(fieldId, octetLength, value, nullptr);
+      return SQL_SUCCESS;
+    case SQL_DESC_INDICATOR_PTR:
+      putPointerField(indicatorPtr, value, nullptr);
+      return SQL_SUCCESS;
+    case SQL_DESC_OCTET_LENGTH_PTR:
+      putPointerField(octetLengthPtr, value, nullptr);
+      return SQL_SUCCESS;
+    default:
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::INVALID_DESCRIPTOR_FIELD_ID_MSG, fieldId));
+      return SQL_ERROR;
+  }
+}
+
+SQLRETURN SnappyDescriptor::getParamRecordField(SQLSMALLINT recNumber,
+    SQLSMALLINT fieldId, SQLPOINTER value) {
+  SnappyStatement& stmt = *m_stmt;
+  const std::vector<DescriptorRecord>& records = stmt.getParamRecords();
+  if (recNumber <= 0) {
+    setException(GET_SQLEXCEPTION2(SQLStateMessage::COLUMN_NOT_FOUND_MSG1,
+        recNumber, static_cast<int>(records.size())));
+    return SQL_ERROR;
+  }
+  if (static_cast<size_t>(recNumber) > records.size()) {
+    return SQL_NO_DATA;
+  }
+  const DescriptorRecord& record = records[recNumber - 1];
+  const SQLSMALLINT conciseType = SnappyStatement::convertSQLTypeToType(
+      record.m_sqlType);
+  SQLSMALLINT code;
+  SQLLEN result;
+  switch (fieldId) {
+    case SQL_DESC_TYPE:
+      result = getVerboseType(conciseType, code);
+      break;
+    case SQL_DESC_CONCISE_TYPE:
+      result = conciseType;
+      break;
+    case SQL_DESC_DATETIME_INTERVAL_CODE:
+      getVerboseType(conciseType, code);
+      result = code;
+      break;
+    case SQL_DESC_LENGTH:
+    case SQL_DESC_PRECISION:
+      result = record.m_precision;
+      break;
+    case SQL_DESC_SCALE:
+      result = record.m_scale;
+      break;
+    case SQL_DESC_NULLABLE:
+      result = record.m_nullable;
+      break;
+    case SQL_DESC_PARAMETER_TYPE:
+      if (static_cast<size_t>(recNumber) <= stmt.m_params.size()
+          && stmt.m_params[recNumber - 1].m_inputOutputType >= 0) {
+        result = stmt.m_params[recNumber - 1].m_inputOutputType;
+      } else {
+        result = SQL_PARAM_INPUT;
+      }
+      break;
+    case SQL_DESC_UNNAMED:
+      result = SQL_UNNAMED;
+      break;
+    default:
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::INVALID_DESCRIPTOR_FIELD_ID_MSG, fieldId));
+      return SQL_ERROR;
+  }
+  putNumericField(fieldId, result, value, nullptr);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SnappyDescriptor::getField(SQLSMALLINT recNumber,
+    SQLSMALLINT fieldId, SQLPOINTER value, SQLINTEGER bufferLength,
+    SQLINTEGER* stringLength) {
+  return getFieldT(recNumber, fieldId, value, bufferLength, stringLength,
+      sizeof(SQLCHAR));
+}
+
+SQLRETURN SnappyDescriptor::getFieldW(SQLSMALLINT recNumber,
+    SQLSMALLINT fieldId, SQLPOINTER value, SQLINTEGER bufferLength,
+    SQLINTEGER* stringLength) {
+  return getFieldT(recNumber, fieldId, value, bufferLength, stringLength,
+      sizeof(SQLWCHAR));
+}
+
+SQLRETURN SnappyDescriptor::setField(SQLSMALLINT recNumber,
+    SQLSMALLINT fieldId, SQLPOINTER value, SQLINTEGER bufferLength) {
+  clearLastError();
+  if (m_descType != SQL_ATTR_APP_ROW_DESC
+      && m_descType != SQL_ATTR_APP_PARAM_DESC) {
+    return SnappyHandleBase::errorNotImplemented(
+        "SQLSetDescField for implementation descriptors", this);
+  }
+  SnappyStatement& stmt = *m_stmt;
+  const bool isRow = (m_descType == SQL_ATTR_APP_ROW_DESC);
+  try {
+    switch (fieldId) {
+      // header fields are the same as the corresponding statement attributes
+      case SQL_DESC_ARRAY_SIZE:
+        return withStatementError(stmt.setAttribute(isRow
+            ? SQL_ATTR_ROW_ARRAY_SIZE : SQL_ATTR_PARAMSET_SIZE, value, 0));
+      case SQL_DESC_BIND_TYPE:
+        return withStatementError(stmt.setAttribute(isRow
+            ? SQL_ATTR_ROW_BIND_TYPE : SQL_ATTR_PARAM_BIND_TYPE, value, 0));
+      case SQL_DESC_BIND_OFFSET_PTR:
+        return withStatementError(stmt.setAttribute(isRow
+            ? SQL_ATTR_ROW_BIND_OFFSET_PTR : SQL_ATTR_PARAM_BIND_OFFSET_PTR,
+            value, 0));
+      case SQL_DESC_ARRAY_STATUS_PTR:
+        return withStatementError(stmt.setAttribute(isRow
+            ? SQL_ATTR_ROW_OPERATION_PTR : SQL_ATTR_PARAM_OPERATION_PTR,
+            value, 0));
+      case SQL_DESC_COUNT: {
+        const SQLLEN count = (SQLLEN)value;
+        if (count < 0) {
+          setException(GET_SQLEXCEPTION2(
+              SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, count,
+              "SQL_DESC_COUNT"));
+          return SQL_ERROR;
+        }
+        if (isRow) {
+          // reducing the count unbinds the columns beyond it
+          stmt.m_outputFields.resize(static_cast<size_t>(count));
+          stmt.invalidateFetchPlan();
+        } else if (static_cast<size_t>(count) < stmt.m_params.size()) {
+          // parameter records are only added when their fields are set
+          stmt.m_params.resize(static_cast<size_t>(count));
+          stmt.m_execParams.clear();
+        }
+        return SQL_SUCCESS;
+      }
+      default:
+        return setAppRecordField(recNumber, fieldId, value);
+    }
+  } catch (SQLException& sqle) {
+    setException(sqle);
+    return SQL_ERROR;
+  } catch (std::exception& se) {
+    setException(__FILE__, __LINE__, se);
+    return SQL_ERROR;
+  }
+}
+
+/**
+ * Get the concise type of an application record after setting one of
+ * SQL_DESC_TYPE, SQL_DESC_CONCISE_TYPE or SQL_DESC_DATETIME_INTERVAL_CODE.
+ */
+static SQLSMALLINT setTypeField(const SQLSMALLINT currentType,
+    const SQLSMALLINT fieldId, const SQLSMALLINT value) noexcept {
+  SQLSMALLINT code;
+  const SQLSMALLINT verboseType = getVerboseType(currentType, code);
+  switch (fieldId) {
+    case SQL_DESC_TYPE:
+      // keep the subcode if the verbose type is unchanged
+      return getConciseType(value, verboseType == value ? code : 0);
+    case SQL_DESC_DATETIME_INTERVAL_CODE:
+      // the subcode applies only to the datetime and interval types
+      return getConciseType(verboseType, value);
+    default:
+      return value;
+  }
+}
+
+SQLRETURN SnappyDescriptor::setAppRecordField(SQLSMALLINT recNumber,
+    SQLSMALLINT fieldId, SQLPOINTER value) {
+  SnappyStatement& stmt = *m_stmt;
+  const bool isRow = (m_descType == SQL_ATTR_APP_ROW_DESC);
+  if (recNumber <= 0) {
+    // bookmark columns are not supported
+    setException(GET_SQLEXCEPTION2(SQLStateMessage::COLUMN_NOT_FOUND_MSG1,
+        recNumber, static_cast<int>(isRow ? stmt.m_outputFields.size()
+            : stmt.m_params.size())));
+    return SQL_ERROR;
+  }
+  switch (fieldId) {
+    case SQL_DESC_TYPE:
+    case SQL_DESC_CONCISE_TYPE:
+    case SQL_DESC_DATETIME_INTERVAL_CODE:
+    case SQL_DESC_DATA_PTR:
+    case SQL_DESC_OCTET_LENGTH:
+    case SQL_DESC_INDICATOR_PTR:
+    case SQL_DESC_OCTET_LENGTH_PTR:
+      break;
+    default:
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::INVALID_DESCRIPTOR_FIELD_ID_MSG, fieldId));
+      return SQL_ERROR;
+  }
+
+  const size_t recIndex = recNumber - 1;
+  if (isRow) {
+    if (stmt.m_outputFields.size() <= recIndex) {
+      stmt.m_outputFields.resize(recIndex + 1);
+    }
+    SnappyStatement::OutputField& field = stmt.m_outputFields[recIndex];
+    switch (fieldId) {
+      case SQL_DESC_TYPE:
+      case SQL_DESC_CONCISE_TYPE:
+      case SQL_DESC_DATETIME_INTERVAL_CODE:
+        field.m_targetType = setTypeField(field.m_targetType, fieldId,
+            static_cast<SQLSMALLINT>((SQLLEN)value));
+        break;
+      case SQL_DESC_DATA_PTR:
+        field.m_targetValue = value;
+        break;
+      case SQL_DESC_OCTET_LENGTH:
+        field.m_valueSize = (SQLLEN)value;
+        break;
+      case SQL_DESC_INDICATOR_PTR:
+        field.m_indicatorPtr = (SQLLEN*)value;
+        break;
+      default:
+        field.m_lenOrIndPtr = (SQLLEN*)value;
+        break;
+    }
+    stmt.invalidateFetchPlan();
+  } else {
+    if (stmt.m_params.size() <= recIndex) {
+      stmt.m_params.resize(recIndex + 1);
+    }
+    SnappyStatement::Parameter& param = stmt.m_params[recIndex];
+    if (param.m_inputOutputType < 0) {
+      // new record: take the SQL type from IPD if the statement has been
+      // prepared else send the value as a string
+      const SQLSMALLINT paramType = stmt.isPrepared()
+          && recIndex < stmt.getParamRecords().size()
+          ? SnappyStatement::convertSQLTypeToType(
+              stmt.getParamRecords()[recIndex].m_sqlType) : SQL_VARCHAR;
+      param.set(static_cast<SQLUSMALLINT>(recNumber), SQL_PARAM_INPUT,
+          SQL_C_DEFAULT, paramType, 0, 0, nullptr, 0, nullptr);
+    }
+    switch (fieldId) {
+      case SQL_DESC_TYPE:
+      case SQL_DESC_CONCISE_TYPE:
+      case SQL_DESC_DATETIME_INTERVAL_CODE:
+        param.m_o_valueType = setTypeField(param.m_o_valueType, fieldId,
+            static_cast<SQLSMALLINT>((SQLLEN)value));
+        if (param.m_o_valueType == SQL_C_DEFAULT) {
+          param.m_o_valueType = SnappyStatement::convertTypeToCType(
+              param.m_o_paramType, param.m_paramNum);
+        }
+        break;
+      case SQL_DESC_DATA_PTR:
+        param.m_o_value = value;
+        break;
+      case SQL_DESC_OCTET_LENGTH:
+        param.m_o_valueSize = (SQLLEN)value;
+        break;
+      case SQL_DESC_INDICATOR_PTR:
+        param.m_o_indicatorPtr = (SQLLEN*)value;
+        break;
+      default:
+        param.m_o_lenOrIndp = (SQLLEN*)value;
+        break;
+    }
+    stmt.m_execParams.clear();
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SnappyDescriptor::copy(SnappyDescriptor* source,
+    SnappyDescriptor* target) {
+  target->clearLastError();
+  const int descType = source->m_descType;
+  if (descType != target->m_descType || (descType != SQL_ATTR_APP_ROW_DESC
+      && descType != SQL_ATTR_APP_PARAM_DESC)) {
+    return SnappyHandleBase::errorNotImplemented(
+        "SQLCopyDesc for other than ARD to ARD or APD to APD", target);
+  }
+  if (source == target) {
+    return SQL_SUCCESS;
+  }
+  SnappyStatement& src = *source->m_stmt;
+  SnappyStatement& tgt = *target->m_stmt;
+  try {
+    if (descType == SQL_ATTR_APP_ROW_DESC) {
+      tgt.m_outputFields = src.m_outputFields;
+      tgt.m_bulkCursor.setBatchSize(src.m_bulkCursor.batchSize());
+      tgt.m_bindingOrientation = src.m_bindingOrientation;
+      tgt.m_bindOffsetPtr = src.m_bindOffsetPtr;
+      tgt.m_rowOperationPtr = src.m_rowOperationPtr;
+      tgt.invalidateFetchPlan();
+    } else {
+      tgt.m_params = src.m_params;
+      tgt.m_execParams.clear();
+      tgt.m_paramSetSize = src.m_paramSetSize;
+      tgt.m_paramBindingOrientation = src.m_paramBindingOrientation;
+      tgt.m_paramBindOffsetPtr = src.m_paramBindOffsetPtr;
+      tgt.m_paramOperationPtr = src.m_paramOperationPtr;
+    }
+    return SQL_SUCCESS;
+  } catch (SQLException& sqle) {
+    target->setException(sqle);
+    return SQL_ERROR;
+  } catch (std::exception& se) {
+    target->setException(__FILE__, __LINE__, se);
+    return SQL_ERROR;
+  }
+}
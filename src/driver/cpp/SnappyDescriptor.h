@@ -41,30 +41,114 @@
 #define SNAPPYDESCRIPTOR_H_
 
 #include "DriverBase.h"
+#include "HandleAllocator.h"
 
 namespace io {
 namespace snappydata {
 
+  class SnappyStatement;
+
+  /**
+   * Snapshot of the metadata of a result column or a parameter used as a
+   * record of the implementation descriptors (IRD and IPD).
+   */
+  struct DescriptorRecord final {
+    std::string m_name;
+    std::string m_label;
+    std::string m_schema;
+    std::string m_table;
+    std::string m_typeName;
+    SQLType m_sqlType;
+    int32_t m_precision;
+    int32_t m_scale;
+    int32_t m_displaySize;
+    /** one of SQL_NO_NULLS, SQL_NULLABLE, SQL_NULLABLE_UNKNOWN */
+    SQLSMALLINT m_nullable;
+    /** one of SQL_ATTR_READONLY, SQL_ATTR_WRITE etc */
+    SQLSMALLINT m_updatable;
+    bool m_autoIncrement;
+    bool m_caseSensitive;
+    bool m_signed;
+  };
+
   /**
    * Contains the ODBC descriptor handles for
    * Application Parameter Descriptor(APD),
    * Implementation Parameter Descriptor(IPD),
    * Application Row Descriptor(ARD),
    * Implementation Row Descriptor(IPD).
-   * Encapsulates a JDBC parameter metadata and the resultsetmetadata.
+   *
+   * The application descriptors are views over the parameters and output
+   * fields bound to the statement, while the implementation descriptors
+   * are views over the snapshot of the parameter and result set metadata
+   * held by the statement that is taken once after every prepare/execute.
+   * These are created by the statement only when first requested.
    */
   class SnappyDescriptor final : public SnappyHandleBase {
   private:
-    int m_descType;
+    /** the statement that owns this implicit descriptor */
+    SnappyStatement* const m_stmt;
+
+    /** one of SQL_ATTR_APP_PARAM_DESC, SQL_ATTR_IMP_ROW_DESC etc */
+    const int m_descType;
+
+    /**
+     * Copy the error or warning, if any, of the statement after a call
+     * delegated to it and return the passed result.
+     */
+    SQLRETURN withStatementError(SQLRETURN result);
+
+    /** number of IRD records which is zero when there is no cursor */
+    size_t getResultRecordCount();
+
+    SQLRETURN getFieldT(SQLSMALLINT recNumber, SQLSMALLINT fieldId,
+        SQLPOINTER value, SQLINTEGER bufferLength, SQLINTEGER* stringLength,
+        const int sizeOfChar);
 
-    /** let SnappyStatement access the private fields */
-    friend class SnappyStatement;
+    /** get a record field of ARD or APD */
+    SQLRETURN getAppRecordField(SQLSMALLINT recNumber, SQLSMALLINT fieldId,
+        SQLPOINTER value);
+
+    /** set a record field of ARD or APD */
+    SQLRETURN setAppRecordField(SQLSMALLINT recNumber, SQLSMALLINT fieldId,
+        SQLPOINTER value);
+
+    /** get a record field of IPD */
+    SQLRETURN getParamRecordField(SQLSMALLINT recNumber,
+        SQLSMALLINT fieldId, SQLPOINTER value);
 
   public:
 
-    SnappyDescriptor(int descType);
+    SnappyDescriptor(SnappyStatement* stmt, int descType);
 
     ~SnappyDescriptor();
+
+    static void* operator new(size_t size) {
+      return HandleAllocator<SnappyDescriptor>::allocate(size);
+    }
+
+    static void operator delete(void* p, size_t size) noexcept {
+      HandleAllocator<SnappyDescriptor>::deallocate(p, size);
+    }
+
+    inline int getDescType() const noexcept {
+      return m_descType;
+    }
+
+    SQLRETURN getField(SQLSMALLINT recNumber, SQLSMALLINT fieldId,
+        SQLPOINTER value, SQLINTEGER bufferLength, SQLINTEGER* stringLength);
+
+    SQLRETURN getFieldW(SQLSMALLINT recNumber, SQLSMALLINT fieldId,
+        SQLPOINTER value, SQLINTEGER bufferLength, SQLINTEGER* stringLength);
+
+    SQLRETURN setField(SQLSMALLINT recNumber, SQLSMALLINT fieldId,
+        SQLPOINTER value, SQLINTEGER bufferLength);
+
+    /**
+     * Copy the records of the source descriptor into the target which
+     * must be an application descriptor of the same kind.
+     */
+    static SQLRETURN copy(SnappyDescriptor* source, SnappyDescriptor* target);
   };
 
 } /* namespace snappydata */
@@ -117,7 +117,41 @@ SQLUSMALLINT snappySupportedfunctions[] = { SQL_API_SQLALLOCHANDLE,
                                             SQL_API_SQLSETPOS,
                                             SQL_API_SQLTABLEPRIVILEGES,
                                             SQL_API_SQLDESCRIBECOL,
-                                            SQL_API_SQLDESCRIBEPARAM };
+                                            SQL_API_SQLDESCRIBEPARAM,
+                                            SQL_API_SQLGETDESCFIELD,
+                                            SQL_API_SQLSETDESCFIELD,
+                                            SQL_API_SQLCOPYDESC };
+
+namespace {
+  /**
+   * Owned copy of an input string argument of an API that may complete
+   * asynchronously after the application has reused its buffer. A null
+   * argument remains null.
+   */
+  template<typename CHAR_TYPE>
+  class InputString final {
+  private:
+    std::basic_string<CHAR_TYPE> m_str;
+    bool m_isNull;
+
+  public:
+    template<typename LEN_TYPE>
+    InputString(const CHAR_TYPE* str, const LEN_TYPE len) :
+        m_str(), m_isNull(str == nullptr) {
+      if (str) {
+        if (len == SQL_NTS) {
+          m_str.assign(str);
+        } else if (len > 0) {
+          m_str.assign(str, static_cast<size_t>(len));
+        }
+      }
+    }
+
+    CHAR_TYPE* get() const noexcept {
+      return m_isNull ? nullptr : const_cast<CHAR_TYPE*>(m_str.c_str());
+    }
+  };
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 ////               Environment APIS
@@ -309,6 +343,10 @@ SQLRETURN SQL_API SQLSetEnvAttr(SQLHENV envHandle,
     SQLRETURN result = ((SnappyEnvironment*)envHandle)->setAttribute(
         attribute, value, stringLength);
     FUNCTION_RETURN_HANDLE(envHandle, result);
+  } else if (attribute == SQL_ATTR_CONNECTION_POOLING) {
+    // process level attribute is set with a null handle
+    SQLRETURN result = SnappyEnvironment::setProcessConnectionPooling(value);
+    FUNCTION_RETURN(result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_ENV);
 }
@@ -410,8 +448,10 @@ SQLRETURN SQL_API SQLConnect(SQLHDBC connHandle, SQLCHAR* dsn,
     if (result != SQL_ERROR) {
       result = conn->connect(server, port, connProps, mdsn, (SQLCHAR*)nullptr,
           -1, nullptr);
-      FunctionTracer::trace("PROPS", nullptr, -1, "",
-          "Server", server, "Port", port, "DSN", mdsn);
+      if (SNAPPY_TRACE_ENABLED()) {
+        FunctionTracer::trace("PROPS", nullptr, -1, "",
+            "Server", server, "Port", port, "DSN", mdsn);
+      }
       FUNCTION_RETURN_HANDLE(conn, result);
     }
     FUNCTION_RETURN_HANDLE(conn, result);
@@ -455,8 +495,10 @@ SQLRETURN SQL_API SQLConnectW(SQLHDBC connHandle, SQLWCHAR* dsn,
     if (result != SQL_ERROR) {
       result = conn->connect(server, port, connProps, mdsn, (SQLCHAR*)nullptr,
           -1, nullptr);
-      FunctionTracer::trace("PROPS", nullptr, -1, "",
-          "Server", server, "Port", port, "DSN", mdsn);
+      if (SNAPPY_TRACE_ENABLED()) {
+        FunctionTracer::trace("PROPS", nullptr, -1, "",
+            "Server", server, "Port", port, "DSN", mdsn);
+      }
       FUNCTION_RETURN_HANDLE(conn, result);
     }
     FUNCTION_RETURN_HANDLE(conn, result);
@@ -501,8 +543,10 @@ SQLRETURN SQL_API SQLDriverConnect(SQLHDBC connHandle,
       if (result != SQL_ERROR) {
         result = conn->connect(server, port, connProps, mdsn, outConnStr,
             outConnStrSize, outConnStrLen);
-        FunctionTracer::trace("PROPS", nullptr, -1, "",
-            "Server", server, "Port", port, "DSN", mdsn);
+        if (SNAPPY_TRACE_ENABLED()) {
+          FunctionTracer::trace("PROPS", nullptr, -1, "",
+              "Server", server, "Port", port, "DSN", mdsn);
+        }
         FUNCTION_RETURN_HANDLE(conn, result, "OutConnStr", outConnStr,
             "OutConnStrLen", outConnStrLen);
       }
@@ -554,8 +598,10 @@ SQLRETURN SQL_API SQLDriverConnectW(SQLHDBC connHandle,
       if (result != SQL_ERROR) {
         result = conn->connect(server, port, connProps, mdsn, outConnStr,
             outConnStrSize, outConnStrLen);
-        FunctionTracer::trace("PROPS", nullptr, -1, "",
-            "Server", server, "Port", port, "DSN", mdsn);
+        if (SNAPPY_TRACE_ENABLED()) {
+          FunctionTracer::trace("PROPS", nullptr, -1, "",
+              "Server", server, "Port", port, "DSN", mdsn);
+        }
         FUNCTION_RETURN_HANDLE(conn, result, "OutConnStr", outConnStr,
             "OutConnStrLen", outConnStrLen);
       }
@@ -783,8 +829,10 @@ SQLRETURN SQL_API SQLPrepare(SQLHSTMT stmtHandle, SQLCHAR *stmtText,
   FUNCTION_ENTER("InputHandle", stmtHandle,
       "Statement", StringFunctions::toString(stmtText, textLength));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->prepare(stmtText,
-        textLength);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLPREPARE, [=]() {
+      return stmt->prepare(stmtText, textLength);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -795,8 +843,10 @@ SQLRETURN SQL_API SQLPrepareW(SQLHSTMT stmtHandle, SQLWCHAR *stmtText,
   FUNCTION_ENTER("InputHandle", stmtHandle,
       "Statement", StringFunctions::toString(stmtText, textLength));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->prepare(stmtText,
-        textLength);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLPREPARE, [=]() {
+      return stmt->prepare(stmtText, textLength);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -807,8 +857,11 @@ SQLRETURN SQL_API SQLExecDirect(SQLHSTMT stmtHandle,
   FUNCTION_ENTER("InputHandle", stmtHandle,
       "Statement", StringFunctions::toString(stmtText, textLength));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->execute(stmtText,
-        textLength);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> stmtTextArg(stmtText, textLength);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLEXECDIRECT, [=]() {
+      return stmt->execute(stmtTextArg.get(), textLength);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -819,8 +872,11 @@ SQLRETURN SQL_API SQLExecDirectW(SQLHSTMT stmtHandle,
   FUNCTION_ENTER("InputHandle", stmtHandle,
       "Statement", StringFunctions::toString(stmtText, textLength));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->execute(stmtText,
-        textLength);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> stmtTextArg(stmtText, textLength);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLEXECDIRECT, [=]() {
+      return stmt->execute(stmtTextArg.get(), textLength);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -829,7 +885,10 @@ SQLRETURN SQL_API SQLExecDirectW(SQLHSTMT stmtHandle,
 SQLRETURN SQL_API SQLExecute(SQLHSTMT stmtHandle) {
   FUNCTION_ENTER("InputHandle", stmtHandle);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->execute();
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLEXECUTE, [=]() {
+      return stmt->execute();
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -864,7 +923,10 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT stmtHandle) {
   FUNCTION_ENTER("InputHandle", stmtHandle);
   if (stmtHandle) {
     // TODO: what do docs say about multiple rowsets?
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->next();
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLFETCH, [=]() {
+      return stmt->next();
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -875,8 +937,10 @@ SQLRETURN SQL_API SQLFetchScroll(SQLHSTMT stmtHandle,
   FUNCTION_ENTER("InputHandle", stmtHandle,
       "FetchOrientation", fetchOrientation, "FetchOffset", fetchOffset);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->fetchScroll(
-        fetchOrientation, fetchOffset);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLFETCHSCROLL, [=]() {
+      return stmt->fetchScroll(fetchOrientation, fetchOffset);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -887,8 +951,10 @@ SQLRETURN SQL_API SQLSetPos(SQLHSTMT stmtHandle,
   FUNCTION_ENTER("InputHandle", stmtHandle, "RowNumber", rowNumber,
       "Operation", operation, "LockType", lockType);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->setPos(
-        rowNumber, operation, lockType);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLSETPOS, [=]() {
+      return stmt->setPos(rowNumber, operation, lockType);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -901,8 +967,11 @@ SQLRETURN SQL_API SQLGetData(SQLHSTMT stmtHandle,
       "TargetType", targetType, "TargetValue", targetValue,
       "ValueSize", valueSize);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getData(
-        columnNum, targetType, targetValue, valueSize, lenOrIndPtr);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLGETDATA, [=]() {
+      return stmt->getData(columnNum, targetType, targetValue, valueSize,
+          lenOrIndPtr);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -911,7 +980,10 @@ SQLRETURN SQL_API SQLGetData(SQLHSTMT stmtHandle,
 SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT stmtHandle) {
   FUNCTION_ENTER("InputHandle", stmtHandle);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->closeResultSet(false);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLCLOSECURSOR, [=]() {
+      return stmt->closeResultSet(false);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1184,8 +1256,14 @@ SQLRETURN SQL_API SQLTables(SQLHSTMT stmtHandle, SQLCHAR* catalogName,
       StringFunctions::toString(tableName, nameLength3), "TableTypes",
       StringFunctions::toString(tableTypes, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getTables(schemaName,
-        nameLength2, tableName, nameLength3, tableTypes, nameLength4);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLCHAR> tableNameArg(tableName, nameLength3);
+    const InputString<SQLCHAR> tableTypesArg(tableTypes, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLTABLES, [=]() {
+      return stmt->getTables(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, tableTypesArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1201,8 +1279,14 @@ SQLRETURN SQL_API SQLTablesW(SQLHSTMT stmtHandle, SQLWCHAR* catalogName,
       StringFunctions::toString(tableName, nameLength3), "TableTypes",
       StringFunctions::toString(tableTypes, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getTables(schemaName,
-        nameLength2, tableName, nameLength3, tableTypes, nameLength4);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLWCHAR> tableNameArg(tableName, nameLength3);
+    const InputString<SQLWCHAR> tableTypesArg(tableTypes, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLTABLES, [=]() {
+      return stmt->getTables(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, tableTypesArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1216,8 +1300,13 @@ SQLRETURN SQL_API SQLTablePrivileges(SQLHSTMT stmtHandle,
       StringFunctions::toString(schemaName, nameLength2), "Table",
       StringFunctions::toString(tableName, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getTablePrivileges(
-        schemaName, nameLength2, tableName, nameLength3);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLTABLEPRIVILEGES, [=]() {
+      return stmt->getTablePrivileges(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1231,8 +1320,13 @@ SQLRETURN SQL_API SQLTablePrivilegesW(SQLHSTMT stmtHandle,
       StringFunctions::toString(schemaName, nameLength2), "Table",
       StringFunctions::toString(tableName, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getTablePrivileges(
-        schemaName, nameLength2, tableName, nameLength3);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLWCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLTABLEPRIVILEGES, [=]() {
+      return stmt->getTablePrivileges(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1248,8 +1342,14 @@ SQLRETURN SQL_API SQLColumns(SQLHSTMT stmtHandle,
       StringFunctions::toString(tableName, nameLength3), "Column",
       StringFunctions::toString(columnName, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getColumns(schemaName,
-        nameLength2, tableName, nameLength3, columnName, nameLength4);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLCHAR> tableNameArg(tableName, nameLength3);
+    const InputString<SQLCHAR> columnNameArg(columnName, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLCOLUMNS, [=]() {
+      return stmt->getColumns(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, columnNameArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1265,8 +1365,14 @@ SQLRETURN SQL_API SQLColumnsW(SQLHSTMT stmtHandle,
       StringFunctions::toString(tableName, nameLength3), "Column",
       StringFunctions::toString(columnName, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getColumns(schemaName,
-        nameLength2, tableName, nameLength3, columnName, nameLength4);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLWCHAR> tableNameArg(tableName, nameLength3);
+    const InputString<SQLWCHAR> columnNameArg(columnName, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLCOLUMNS, [=]() {
+      return stmt->getColumns(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, columnNameArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1282,9 +1388,14 @@ SQLRETURN SQL_API SQLColumnPrivileges(SQLHSTMT stmtHandle, SQLCHAR* catalogName,
       StringFunctions::toString(tableName, nameLength3), "Column",
       StringFunctions::toString(columnName, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getColumnPrivileges(
-        schemaName, nameLength2, tableName, nameLength3, columnName,
-        nameLength4);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLCHAR> tableNameArg(tableName, nameLength3);
+    const InputString<SQLCHAR> columnNameArg(columnName, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLCOLUMNPRIVILEGES, [=]() {
+      return stmt->getColumnPrivileges(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, columnNameArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1300,9 +1411,14 @@ SQLRETURN SQL_API SQLColumnPrivilegesW(SQLHSTMT stmtHandle,
       StringFunctions::toString(tableName, nameLength3), "Column",
       StringFunctions::toString(columnName, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getColumnPrivileges(
-        schemaName, nameLength2, tableName, nameLength3, columnName,
-        nameLength4);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLWCHAR> tableNameArg(tableName, nameLength3);
+    const InputString<SQLWCHAR> columnNameArg(columnName, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLCOLUMNPRIVILEGES, [=]() {
+      return stmt->getColumnPrivileges(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, columnNameArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1318,9 +1434,14 @@ SQLRETURN SQL_API SQLStatistics(SQLHSTMT stmtHandle,
       StringFunctions::toString(tableName, nameLength3), "Unique", unique,
       "Reserved", reserved);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getIndexInfo(schemaName,
-        nameLength2, tableName, nameLength3, unique == SQL_INDEX_UNIQUE,
-        reserved == SQL_QUICK);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLSTATISTICS, [=]() {
+      return stmt->getIndexInfo(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, unique == SQL_INDEX_UNIQUE,
+          reserved == SQL_QUICK);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1336,9 +1457,14 @@ SQLRETURN SQL_API SQLStatisticsW(SQLHSTMT stmtHandle,
       StringFunctions::toString(tableName, nameLength3), "Unique", unique,
       "Reserved", reserved);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getIndexInfo(schemaName,
-        nameLength2, tableName, nameLength3, unique == SQL_INDEX_UNIQUE,
-        reserved == SQL_QUICK);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLWCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLSTATISTICS, [=]() {
+      return stmt->getIndexInfo(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3, unique == SQL_INDEX_UNIQUE,
+          reserved == SQL_QUICK);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1352,8 +1478,13 @@ SQLRETURN SQL_API SQLPrimaryKeys(SQLHSTMT stmtHandle,
       StringFunctions::toString(schemaName, nameLength2), "Table",
       StringFunctions::toString(tableName, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getPrimaryKeys(
-        schemaName, nameLength2, tableName, nameLength3);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLPRIMARYKEYS, [=]() {
+      return stmt->getPrimaryKeys(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1367,8 +1498,13 @@ SQLRETURN SQL_API SQLPrimaryKeysW(SQLHSTMT stmtHandle,
       StringFunctions::toString(schemaName, nameLength2), "Table",
       StringFunctions::toString(tableName, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getPrimaryKeys(
-        schemaName, nameLength2, tableName, nameLength3);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLWCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLPRIMARYKEYS, [=]() {
+      return stmt->getPrimaryKeys(schemaNameArg.get(), nameLength2,
+          tableNameArg.get(), nameLength3);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1387,23 +1523,29 @@ SQLRETURN SQL_API SQLForeignKeys(SQLHSTMT stmtHandle,
       StringFunctions::toString(fkSchemaName, nameLength2), "ForeignTable",
       StringFunctions::toString(fkTableName, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result;
     SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
-    if (pkTableName) {
-      if (fkTableName) {
-        result = stmt->getCrossReference(pkSchemaName, nameLength2, pkTableName,
-            nameLength3, fkSchemaName, nameLength5, fkTableName, nameLength6);
-        FUNCTION_RETURN_HANDLE(stmtHandle, result);
+    const InputString<SQLCHAR> pkSchemaNameArg(pkSchemaName, nameLength2);
+    const InputString<SQLCHAR> pkTableNameArg(pkTableName, nameLength3);
+    const InputString<SQLCHAR> fkSchemaNameArg(fkSchemaName, nameLength5);
+    const InputString<SQLCHAR> fkTableNameArg(fkTableName, nameLength6);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLFOREIGNKEYS,
+        [=]() -> SQLRETURN {
+      if (pkTableNameArg.get()) {
+        if (fkTableNameArg.get()) {
+          return stmt->getCrossReference(pkSchemaNameArg.get(), nameLength2,
+              pkTableNameArg.get(), nameLength3, fkSchemaNameArg.get(),
+              nameLength5, fkTableNameArg.get(), nameLength6);
+        } else {
+          return stmt->getExportedKeys(pkSchemaNameArg.get(), nameLength2,
+              pkTableNameArg.get(), nameLength3);
+        }
       } else {
-        result = stmt->getExportedKeys(pkSchemaName, nameLength2, pkTableName,
-            nameLength3);
+        // both nullptr should never happen since DriverManager is supposed to
+        // handle it
+        return stmt->getImportedKeys(fkSchemaNameArg.get(), nameLength5,
+            fkTableNameArg.get(), nameLength6);
       }
-    } else {
-      // both nullptr should never happen since DriverManager is supposed to
-      // handle it
-      result = stmt->getImportedKeys(fkSchemaName, nameLength2, fkTableName,
-          nameLength3);
-    }
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1422,22 +1564,29 @@ SQLRETURN SQL_API SQLForeignKeysW(SQLHSTMT stmtHandle,
       StringFunctions::toString(fkSchemaName, nameLength2), "ForeignTable",
       StringFunctions::toString(fkTableName, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result;
     SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
-    if (pkTableName) {
-      if (fkTableName) {
-        result = stmt->getCrossReference(pkSchemaName, nameLength2, pkTableName,
-            nameLength3, fkSchemaName, nameLength5, fkTableName, nameLength6);
+    const InputString<SQLWCHAR> pkSchemaNameArg(pkSchemaName, nameLength2);
+    const InputString<SQLWCHAR> pkTableNameArg(pkTableName, nameLength3);
+    const InputString<SQLWCHAR> fkSchemaNameArg(fkSchemaName, nameLength5);
+    const InputString<SQLWCHAR> fkTableNameArg(fkTableName, nameLength6);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLFOREIGNKEYS,
+        [=]() -> SQLRETURN {
+      if (pkTableNameArg.get()) {
+        if (fkTableNameArg.get()) {
+          return stmt->getCrossReference(pkSchemaNameArg.get(), nameLength2,
+              pkTableNameArg.get(), nameLength3, fkSchemaNameArg.get(),
+              nameLength5, fkTableNameArg.get(), nameLength6);
+        } else {
+          return stmt->getExportedKeys(pkSchemaNameArg.get(), nameLength2,
+              pkTableNameArg.get(), nameLength3);
+        }
       } else {
-        result = stmt->getExportedKeys(pkSchemaName, nameLength2, pkTableName,
-            nameLength3);
+        // both nullptr should never happen since DriverManager is supposed to
+        // handle it
+        return stmt->getImportedKeys(fkSchemaNameArg.get(), nameLength5,
+            fkTableNameArg.get(), nameLength6);
       }
-    } else {
-      // both nullptr should never happen since DriverManager is supposed to
-      // handle it
-      result = stmt->getImportedKeys(fkSchemaName, nameLength2, fkTableName,
-          nameLength3);
-    }
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1452,8 +1601,14 @@ SQLRETURN SQL_API SQLProcedures(SQLHSTMT stmtHandle,
       StringFunctions::toString(schemaPattern, nameLength2), "ProcedurePattern",
       StringFunctions::toString(procedureNamePattern, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getProcedures(
-        schemaPattern, nameLength2, procedureNamePattern, nameLength3);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaPatternArg(schemaPattern, nameLength2);
+    const InputString<SQLCHAR> procedureNamePatternArg(
+        procedureNamePattern, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLPROCEDURES, [=]() {
+      return stmt->getProcedures(schemaPatternArg.get(), nameLength2,
+          procedureNamePatternArg.get(), nameLength3);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1468,8 +1623,14 @@ SQLRETURN SQL_API SQLProceduresW(SQLHSTMT stmtHandle,
       StringFunctions::toString(schemaPattern, nameLength2), "ProcedurePattern",
       StringFunctions::toString(procedureNamePattern, nameLength3));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getProcedures(
-        schemaPattern, nameLength2, procedureNamePattern, nameLength3);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaPatternArg(schemaPattern, nameLength2);
+    const InputString<SQLWCHAR> procedureNamePatternArg(
+        procedureNamePattern, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLPROCEDURES, [=]() {
+      return stmt->getProcedures(schemaPatternArg.get(), nameLength2,
+          procedureNamePatternArg.get(), nameLength3);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1487,9 +1648,17 @@ SQLRETURN SQL_API SQLProcedureColumns(SQLHSTMT stmtHandle,
       "ColumnPattern",
       StringFunctions::toString(columnNamePattern, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getProcedureColumns(
-        schemaPattern, nameLength2, procedureNamePattern, nameLength3,
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaPatternArg(schemaPattern, nameLength2);
+    const InputString<SQLCHAR> procedureNamePatternArg(
+        procedureNamePattern, nameLength3);
+    const InputString<SQLCHAR> columnNamePatternArg(
         columnNamePattern, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLPROCEDURECOLUMNS, [=]() {
+      return stmt->getProcedureColumns(schemaPatternArg.get(), nameLength2,
+          procedureNamePatternArg.get(), nameLength3,
+          columnNamePatternArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1507,9 +1676,17 @@ SQLRETURN SQL_API SQLProcedureColumnsW(SQLHSTMT stmtHandle,
       "ColumnPattern",
       StringFunctions::toString(columnNamePattern, nameLength4));
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getProcedureColumns(
-        schemaPattern, nameLength2, procedureNamePattern, nameLength3,
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaPatternArg(schemaPattern, nameLength2);
+    const InputString<SQLWCHAR> procedureNamePatternArg(
+        procedureNamePattern, nameLength3);
+    const InputString<SQLWCHAR> columnNamePatternArg(
         columnNamePattern, nameLength4);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLPROCEDURECOLUMNS, [=]() {
+      return stmt->getProcedureColumns(schemaPatternArg.get(), nameLength2,
+          procedureNamePatternArg.get(), nameLength3,
+          columnNamePatternArg.get(), nameLength4);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1519,7 +1696,10 @@ SQLRETURN SQL_API SQLGetTypeInfo(SQLHSTMT stmtHandle,
     SQLSMALLINT dataType) {
   FUNCTION_ENTER("InputHandle", stmtHandle, "DataType", dataType);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getTypeInfo(dataType);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLGETTYPEINFO, [=]() {
+      return stmt->getTypeInfo(dataType);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1529,7 +1709,10 @@ SQLRETURN SQL_API SQLGetTypeInfoW(SQLHSTMT stmtHandle,
     SQLSMALLINT dataType) {
   FUNCTION_ENTER("InputHandle", stmtHandle, "DataType", dataType);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getTypeInfoW(dataType);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLGETTYPEINFO, [=]() {
+      return stmt->getTypeInfoW(dataType);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1539,8 +1722,10 @@ SQLRETURN SQL_API SQLBulkOperations(SQLHSTMT stmtHandle,
     SQLSMALLINT operation) {
   FUNCTION_ENTER("InputHandle", stmtHandle, "Operation", operation);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->bulkOperations(
-        operation);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLBULKOPERATIONS, [=]() {
+      return stmt->bulkOperations(operation);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1560,7 +1745,10 @@ SQLRETURN SQL_API SQLPutData(SQLHSTMT stmtHandle, SQLPOINTER dataPtr,
 SQLRETURN SQL_API SQLMoreResults(SQLHSTMT stmtHandle) {
   FUNCTION_ENTER("InputHandle", stmtHandle);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getMoreResults();
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLMORERESULTS, [=]() {
+      return stmt->getMoreResults();
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1570,7 +1758,10 @@ SQLRETURN SQL_API SQLParamData(SQLHSTMT stmtHandle,
     SQLPOINTER* valuePtr) {
   FUNCTION_ENTER("InputHandle", stmtHandle, "ValuePtr", valuePtr);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getParamData(valuePtr);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    SQLRETURN result = stmt->runLocked(SQL_API_SQLPARAMDATA, [=]() {
+      return stmt->getParamData(valuePtr);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1586,9 +1777,13 @@ SQLRETURN SQL_API SQLSpecialColumns(SQLHSTMT stmtHandle,
       StringFunctions::toString(tableName, nameLength3), "Scope", scope,
       "Nullable", nullable);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getSpecialColumns(
-        identifierType, schemaName, nameLength2, tableName, nameLength3, scope,
-        nullable);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLSPECIALCOLUMNS, [=]() {
+      return stmt->getSpecialColumns(identifierType, schemaNameArg.get(),
+          nameLength2, tableNameArg.get(), nameLength3, scope, nullable);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
@@ -1604,10 +1799,79 @@ SQLRETURN SQL_API SQLSpecialColumnsW(SQLHSTMT stmtHandle,
       StringFunctions::toString(tableName, nameLength3), "Scope", scope,
       "Nullable", nullable);
   if (stmtHandle) {
-    SQLRETURN result = ((SnappyStatement*)stmtHandle)->getSpecialColumns(
-        identifierType, schemaName, nameLength2, tableName, nameLength3,
-        scope, nullable);
+    SnappyStatement* stmt = (SnappyStatement*)stmtHandle;
+    const InputString<SQLWCHAR> schemaNameArg(schemaName, nameLength2);
+    const InputString<SQLWCHAR> tableNameArg(tableName, nameLength3);
+    SQLRETURN result = stmt->runAsync(SQL_API_SQLSPECIALCOLUMNS, [=]() {
+      return stmt->getSpecialColumns(identifierType, schemaNameArg.get(),
+          nameLength2, tableNameArg.get(), nameLength3, scope, nullable);
+    });
     FUNCTION_RETURN_HANDLE(stmtHandle, result);
   }
   return SnappyHandleBase::errorNullHandle(SQL_HANDLE_STMT);
 }
+
+///////////////////////////////////////////////////////////////////////////////
+////               Descriptor APIs
+///////////////////////////////////////////////////////////////////////////////
+
+SQLRETURN SQL_API SQLGetDescField(SQLHDESC descHandle,
+    SQLSMALLINT recNumber, SQLSMALLINT fieldId, SQLPOINTER value,
+    SQLINTEGER bufferLength, SQLINTEGER* stringLength) {
+  FUNCTION_ENTER("DescriptorHandle", descHandle, "RecNumber", recNumber,
+      "FieldIdentifier", fieldId, "BufferLength", bufferLength);
+  if (descHandle) {
+    SQLRETURN result = ((SnappyDescriptor*)descHandle)->getField(recNumber,
+        fieldId, value, bufferLength, stringLength);
+    FUNCTION_RETURN_HANDLE(descHandle, result);
+  }
+  return SnappyHandleBase::errorNullHandle(SQL_HANDLE_DESC);
+}
+
+SQLRETURN SQL_API SQLGetDescFieldW(SQLHDESC descHandle,
+    SQLSMALLINT recNumber, SQLSMALLINT fieldId, SQLPOINTER value,
+    SQLINTEGER bufferLength, SQLINTEGER* stringLength) {
+  FUNCTION_ENTER("DescriptorHandle", descHandle, "RecNumber", recNumber,
+      "FieldIdentifier", fieldId, "BufferLength", bufferLength);
+  if (descHandle) {
+    SQLRETURN result = ((SnappyDescriptor*)descHandle)->getFieldW(recNumber,
+        fieldId, value, bufferLength, stringLength);
+    FUNCTION_RETURN_HANDLE(descHandle, result);
+  }
+  return SnappyHandleBase::errorNullHandle(SQL_HANDLE_DESC);
+}
+
+SQLRETURN SQL_API SQLSetDescField(SQLHDESC descHandle,
+    SQLSMALLINT recNumber, SQLSMALLINT fieldId, SQLPOINTER value,
+    SQLINTEGER bufferLength) {
+  FUNCTION_ENTER("DescriptorHandle", descHandle, "RecNumber", recNumber,
+      "FieldIdentifier", fieldId, "Value", value,
+      "BufferLength", bufferLength);
+  if (descHandle) {
+    SQLRETURN result = ((SnappyDescriptor*)descHandle)->setField(recNumber,
+        fieldId, value, bufferLength);
+    FUNCTION_RETURN_HANDLE(descHandle, result);
+  }
+  return SnappyHandleBase::errorNullHandle(SQL_HANDLE_DESC);
+}
+
+SQLRETURN SQL_API SQLSetDescFieldW(SQLHDESC descHandle,
+    SQLSMALLINT recNumber, SQLSMALLINT fieldId, SQLPOINTER value,
+    SQLINTEGER bufferLength) {
+  // no character fields can be set, so same as SQLSetDescField
+  return SQLSetDescField(descHandle, recNumber, fieldId, value,
+      bufferLength);
+}
+
+SQLRETURN SQL_API SQLCopyDesc(SQLHDESC sourceDescHandle,
+    SQLHDESC targetDescHandle) {
+  FUNCTION_ENTER("SourceDescHandle", sourceDescHandle,
+      "TargetDescHandle", targetDescHandle);
+  if (sourceDescHandle && targetDescHandle) {
+    SQLRETURN result = SnappyDescriptor::copy(
+        (SnappyDescriptor*)sourceDescHandle,
+        (SnappyDescriptor*)targetDescHandle);
+    FUNCTION_RETURN_HANDLE(targetDescHandle, result);
+  }
+  return SnappyHandleBase::errorNullHandle(SQL_HANDLE_DESC);
+}
@@ -46,7 +46,9 @@
 #include "OdbcIniKeys.h"
 #include "SnappyDefaults.h"
 #include "Library.h"
+#include "AsyncExecutor.h"
 
+#include <fstream>
 #include <vector>
 
 using namespace io::snappydata;
@@ -54,7 +56,16 @@ using namespace io::snappydata::native;
 
 std::mutex SnappyEnvironment::g_sync;
 bool SnappyEnvironment::g_initialized = false;
-std::vector<SnappyEnvironment*> SnappyEnvironment::g_envHandles;
+std::unordered_set<SnappyEnvironment*> SnappyEnvironment::g_envHandles;
+SQLUINTEGER SnappyEnvironment::g_connPooling = SQL_CP_OFF;
+
+ConnectionPool& SnappyEnvironment::driverConnPool() {
+  static ConnectionPool* s_pool = new ConnectionPool();
+  return *s_pool;
+}
+
+/** file to write the FunctionSampler samples when last HENV is freed */
+static std::string g_traceSamplesFile;
 
 namespace _snappy_impl {
   static const std::vector<std::string> s_odbc30StatePrefixes = {
@@ -68,36 +79,36 @@ SQLRETURN SnappyEnvironment::handleErrorT(SQLSMALLINT handleType,
     SQLINTEGER* nativeError, CHAR_TYPE* messageText, SQLSMALLINT bufferLength,
     SQLSMALLINT* textLength, SQLSMALLINT textLenFactor) {
 
-  SQLException* sqlEx = nullptr;
-  const std::string* message;
+  std::shared_ptr<const DiagRecords> records;
+  const DiagRecords::Record* record;
   SQLRETURN result = getExceptionRecord(handleType, handle, recNumber,
-      std::max(SQL_MAX_MESSAGE_LENGTH, bufferLength - 1), textLength, sqlEx,
-      message);
+      textLength, records, record);
   if (!SQL_SUCCEEDED(result)) {
     return result;
   }
 
   if (sqlState) {
-    const std::string& state = sqlEx->getSQLState();
+    const std::string& state = record->m_sqlState;
     StringFunctions::copyString((SQLCHAR*)state.c_str(), state.length(),
         sqlState, 6, nullptr);
   }
   if (nativeError) {
-    *nativeError = sqlEx->getSeverity();
+    *nativeError = record->m_nativeError;
   }
   if (messageText || textLength) {
     if (bufferLength < 0) {
       return SQL_ERROR;
     }
+    const std::string& message = record->m_message;
     if (recNumber == 1 && LogWriter::debugEnabled()) {
       LogWriter::warn() << "Exception in operation" << LogWriter::NEWLINE
-          << *message << LogWriter::NEWLINE;
+          << message << LogWriter::NEWLINE;
     }
     if (!messageText) bufferLength = 0;
     SQLLEN len = 0;
     // copy the message as much as there is space in buffer
-    if (StringFunctions::copyString((SQLCHAR*)message->data(),
-        message->length(), messageText, bufferLength / textLenFactor, &len)) {
+    if (StringFunctions::copyString((SQLCHAR*)message.data(),
+        message.length(), messageText, bufferLength / textLenFactor, &len)) {
       result = SQL_SUCCESS_WITH_INFO;
     }
     if (textLength) {
@@ -109,17 +120,20 @@ SQLRETURN SnappyEnvironment::handleErrorT(SQLSMALLINT handleType,
 }
 
 SQLRETURN SnappyEnvironment::getExceptionRecord(SQLSMALLINT handleType,
-    SQLHANDLE handle, SQLSMALLINT recNumber, SQLUINTEGER maxRecordSize,
-    SQLSMALLINT* textLength, SQLException*& err, const std::string*& message) {
+    SQLHANDLE handle, SQLSMALLINT recNumber, SQLSMALLINT* textLength,
+    std::shared_ptr<const DiagRecords>& records,
+    const DiagRecords::Record*& record) {
   // return the last error, if any, else the last warning
   if (recNumber <= 0) {
     return SQL_ERROR;
   }
-  // try the global error first since it will override everything else
+  // try the global error first since it will override everything else;
+  // it is owned by the current thread so is only aliased here
   SnappyHandleBase* handleBase = nullptr;
-  err = SnappyHandleBase::lastGlobalError();
-  std::mutex* sync = &g_sync;
-  if (!err) {
+  records = std::shared_ptr<const DiagRecords>(
+      std::shared_ptr<const DiagRecords>(),
+      SnappyHandleBase::lastGlobalDiagRecords());
+  if (!records) {
     if (!handle) {
       return SQL_INVALID_HANDLE;
     }
@@ -139,28 +153,12 @@ SQLRETURN SnappyEnvironment::getExceptionRecord(SQLSMALLINT handleType,
       default:
         return SQL_INVALID_HANDLE;
     }
-    err = handleBase->lastError();
-    sync = &handleBase->m_connLock;
+    // hold a reference to the records since another thread, such as
+    // that of an asynchronous operation, may replace them concurrently
+    records = handleBase->diagRecords();
   }
-  if (err) {
-    {
-      // always overwrite global exception if there is some lock error
-      LockGuard<std::mutex> lock(*sync, false);
-
-      if (lock.lockFailed()) return SQL_ERROR;
-      err->fillRecords("[" ODBC_PRODUCT_NAME "] ", maxRecordSize,
-          LogWriter::fineEnabled());
-    }
-    const auto& records = err->getRecords();
-    if (static_cast<size_t>(recNumber) <= records.size()) {
-      err = records[recNumber - 1].first;
-      message = &records[recNumber - 1].second;
-    } else {
-      err = nullptr;
-      message = nullptr;
-    }
-  }
-  if (err) {
+  record = records ? records->get(recNumber) : nullptr;
+  if (record) {
     return SQL_SUCCESS;
   } else {
     if (textLength) *textLength = 0;
@@ -177,12 +175,12 @@ SQLRETURN SnappyEnvironment::handleDiagFieldT(SQLSMALLINT handleType,
   SQLLEN intRes = 0;
   SQLSMALLINT expectedIntSize = 0;
   std::string stringRes;
-  SQLException* sqlEx = nullptr;
-  const std::string* message;
+  std::shared_ptr<const DiagRecords> records;
+  const DiagRecords::Record* record;
   switch (diagId) {
     case SQL_DIAG_CURSOR_ROW_COUNT: {
       if (handleType != SQL_HANDLE_STMT
-          || !((SnappyStatement*)handle)->m_resultSet) {
+          || !((SnappyStatement*)handle)->hasOpenCursor()) {
         return SQL_ERROR;
       }
       hasIntRes = true;
@@ -210,11 +208,11 @@ SQLRETURN SnappyEnvironment::handleDiagFieldT(SQLSMALLINT handleType,
       hasIntRes = true;
       intRes = 0;
       expectedIntSize = SQL_IS_INTEGER;
-      result = getExceptionRecord(handleType, handle, 1, SQL_MAX_MESSAGE_LENGTH,
-          stringLength, sqlEx, message);
+      result = getExceptionRecord(handleType, handle, 1, stringLength,
+          records, record);
       if (SQL_SUCCEEDED(result)) {
         intRes = StringFunctions::restrictLength<SQLLEN, size_t>(
-            sqlEx->getRecords().size());
+            records->size());
       } else {
         return result;
       }
@@ -238,9 +236,9 @@ SQLRETURN SnappyEnvironment::handleDiagFieldT(SQLSMALLINT handleType,
     }
     case SQL_DIAG_CLASS_ORIGIN: {
       result = getExceptionRecord(handleType, handle, recNumber,
-          SQL_MAX_MESSAGE_LENGTH, stringLength, sqlEx, message);
+          stringLength, records, record);
       if (SQL_SUCCEEDED(result)) {
-        if (sqlEx->getSQLState().find("IM") == 0) {
+        if (record->m_sqlState.find("IM") == 0) {
           stringRes = "ODBC 3.0";
         } else {
           stringRes = "ISO 9075";
@@ -252,9 +250,9 @@ SQLRETURN SnappyEnvironment::handleDiagFieldT(SQLSMALLINT handleType,
     }
     case SQL_DIAG_SUBCLASS_ORIGIN: {
       result = getExceptionRecord(handleType, handle, recNumber,
-          SQL_MAX_MESSAGE_LENGTH, stringLength, sqlEx, message);
+          stringLength, records, record);
       if (SQL_SUCCEEDED(result)) {
-        const std::string& state = sqlEx->getSQLState();
+        const std::string& state = record->m_sqlState;
         for (auto& prefix : _snappy_impl::s_odbc30StatePrefixes) {
           if (state.find(prefix) == 0) {
             stringRes = "ODBC 3.0";
@@ -291,10 +289,10 @@ SQLRETURN SnappyEnvironment::handleDiagFieldT(SQLSMALLINT handleType,
     case SQL_DIAG_CONNECTION_NAME: {
       switch (handleType) {
         case SQL_HANDLE_DBC:
-          stringRes = ((SnappyConnection*)handle)->m_conn.toString();
+          stringRes = ((SnappyConnection*)handle)->m_conn->toString();
           break;
         case SQL_HANDLE_STMT:
-          stringRes = ((SnappyStatement*)handle)->m_conn.m_conn.toString();
+          stringRes = ((SnappyStatement*)handle)->m_conn.m_conn->toString();
           break;
         default:
           break;
@@ -316,9 +314,9 @@ SQLRETURN SnappyEnvironment::handleDiagFieldT(SQLSMALLINT handleType,
     }
     case SQL_DIAG_SQLSTATE: {
       result = getExceptionRecord(handleType, handle, recNumber,
-          SQL_MAX_MESSAGE_LENGTH, stringLength, sqlEx, message);
+          stringLength, records, record);
       if (SQL_SUCCEEDED(result)) {
-        stringRes = sqlEx->getSQLState();
+        stringRes = record->m_sqlState;
       } else {
         return result;
       }
@@ -328,9 +326,9 @@ SQLRETURN SnappyEnvironment::handleDiagFieldT(SQLSMALLINT handleType,
       hasIntRes = true;
       expectedIntSize = SQL_IS_INTEGER;
       result = getExceptionRecord(handleType, handle, recNumber,
-          SQL_MAX_MESSAGE_LENGTH, stringLength, sqlEx, message);
+          stringLength, records, record);
       if (SQL_SUCCEEDED(result)) {
-        intRes = sqlEx->getSeverity();
+        intRes = record->m_nativeError;
       } else {
         return result;
       }
@@ -408,6 +406,11 @@ SQLRETURN SnappyEnvironment::globalInitialize() {
     return SQL_SUCCESS;
   } else {
     LogWriter::setGlobalLoggingFlag("ODBC");
+    const char* samplesFile = ::getenv("SNAPPY_ODBC_TRACE_SAMPLES");
+    if (samplesFile && *samplesFile) {
+      g_traceSamplesFile = samplesFile;
+      FunctionSampler::setEnabled(true);
+    }
     Connection::initializeService();
     if (OdbcIniKeys::init() == SQL_ERROR) {
       return SQL_ERROR;
@@ -429,7 +432,7 @@ SQLRETURN SnappyEnvironment::newEnvironment(SnappyEnvironment*& envRef) {
   }
   SnappyEnvironment* env = new SnappyEnvironment(false);
   envRef = env;
-  g_envHandles.push_back(env);
+  g_envHandles.insert(env);
   return SQL_SUCCESS;
 }
 
@@ -453,6 +456,8 @@ SQLRETURN SnappyEnvironment::freeEnvironment(SnappyEnvironment* env) {
       return SQL_ERROR;
     }
 
+    bool lastEnvironment = false;
+    std::string samplesFile;
     {
       LockGuard<std::mutex> lock(g_sync, false);
       if (lock.lockFailed()) {
@@ -460,14 +465,23 @@ SQLRETURN SnappyEnvironment::freeEnvironment(SnappyEnvironment* env) {
       }
 
       //remove this env handle
-      for (std::vector<SnappyEnvironment*>::iterator iter =
-          g_envHandles.begin(); iter != g_envHandles.end(); ++iter) {
-        if (env == (*iter)) {
-          g_envHandles.erase(iter);
-          break;
-        }
+      g_envHandles.erase(env);
+      if (g_envHandles.empty()) {
+        driverConnPool().clear();
+        lastEnvironment = true;
+        samplesFile = g_traceSamplesFile;
       }
     }
+    // join the driver threads outside g_sync since the operations still
+    // running on them may need it
+    if (lastEnvironment) {
+      AsyncExecutor::instance().shutdown();
+      if (FunctionSampler::isEnabled()) {
+        std::ofstream samplesOut(samplesFile, std::ios::app);
+        FunctionSampler::dump(samplesOut);
+      }
+      TraceEvents::stop();
+    }
 
     delete env;
     return SQL_SUCCESS;
@@ -479,7 +493,7 @@ SQLRETURN SnappyEnvironment::freeEnvironment(SnappyEnvironment* env) {
 void SnappyEnvironment::addNewActiveConnection(SnappyConnection* conn) {
   LockGuard<std::mutex> lock(m_connLock);
 
-  m_connections.push_back(conn);
+  m_connections.insert(conn);
 }
 
 size_t SnappyEnvironment::getActiveConnectionsCount() {
@@ -498,8 +512,8 @@ SQLRETURN SnappyEnvironment::forEachActiveConnection(
     return SQL_ERROR;
   }
 
-  for (std::vector<SnappyConnection*>::iterator iter = m_connections.begin();
-      iter != m_connections.end(); ++iter) {
+  for (auto iter = m_connections.begin(); iter != m_connections.end();
+      ++iter) {
     conn = (*iter);
     if (conn->isActive()) {
       res = connOperation(conn);
@@ -533,14 +547,12 @@ SQLRETURN SnappyEnvironment::removeActiveConnection(SnappyConnection* conn) {
     return SQL_ERROR;
   }
 
-  for (std::vector<SnappyConnection*>::iterator iter = m_connections.begin();
-      iter != m_connections.end(); ++iter) {
-    if (conn == (*iter)) {
-      m_connections.erase(iter);
-      return SQL_SUCCESS;
-    }
+  if (m_connections.erase(conn) != 0) {
+    m_freedPerfCounters.addAll(conn->m_perfCounters);
+    return SQL_SUCCESS;
+  } else {
+    return SQL_NO_DATA;
   }
-  return SQL_NO_DATA;
 }
 
 SQLRETURN SnappyEnvironment::setAttribute(SQLINTEGER attribute, SQLPOINTER value,
@@ -575,21 +587,33 @@ SQLRETURN SnappyEnvironment::setAttribute(SQLINTEGER attribute, SQLPOINTER value
       }
       break;
     case SQL_ATTR_CONNECTION_POOLING:
-      // only CP_OFF supported for now
-      if (intValue != SQL_CP_OFF) {
-        setException(
-            GET_SQLEXCEPTION2(SQLStateMessage::FEATURE_NOT_IMPLEMENTED_MSG1,
-                "setAttribute(SQL_ATTR_CONNECTION_POOLING)"));
-        return SQL_ERROR;
+      switch (intValue) {
+        case SQL_CP_OFF:
+          m_connPooling = SQL_CP_OFF;
+          m_connPool.clear();
+          break;
+        case SQL_CP_ONE_PER_DRIVER:
+        case SQL_CP_ONE_PER_HENV:
+          m_connPooling = static_cast<SQLUINTEGER>(intValue);
+          break;
+        default:
+          setException(GET_SQLEXCEPTION2(
+              SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, intValue,
+              "SQL_ATTR_CONNECTION_POOLING"));
+          return SQL_ERROR;
       }
       break;
     case SQL_ATTR_CP_MATCH:
-      // only STRICT_MATCH supported
-      if (intValue != SQL_CP_STRICT_MATCH) {
-        setException(
-            GET_SQLEXCEPTION2(SQLStateMessage::FEATURE_NOT_IMPLEMENTED_MSG1,
-                "setAttribute(SQL_ATTR_CP_MATCH)"));
-        return SQL_ERROR;
+      switch (intValue) {
+        case SQL_CP_STRICT_MATCH:
+        case SQL_CP_RELAXED_MATCH:
+          m_cpMatch = static_cast<SQLUINTEGER>(intValue);
+          break;
+        default:
+          setException(GET_SQLEXCEPTION2(
+              SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, intValue,
+              "SQL_ATTR_CP_MATCH"));
+          return SQL_ERROR;
       }
       break;
     default:
@@ -601,6 +625,25 @@ SQLRETURN SnappyEnvironment::setAttribute(SQLINTEGER attribute, SQLPOINTER value
   return SQL_SUCCESS;
 }
 
+SQLRETURN SnappyEnvironment::setProcessConnectionPooling(SQLPOINTER value) {
+  const SQLUINTEGER intValue = (SQLUINTEGER)(SQLULEN)value;
+  switch (intValue) {
+    case SQL_CP_OFF:
+      g_connPooling = SQL_CP_OFF;
+      driverConnPool().clear();
+      return SQL_SUCCESS;
+    case SQL_CP_ONE_PER_DRIVER:
+    case SQL_CP_ONE_PER_HENV:
+      g_connPooling = intValue;
+      return SQL_SUCCESS;
+    default:
+      SnappyHandleBase::setGlobalException(GET_SQLEXCEPTION2(
+          SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, intValue,
+          "SQL_ATTR_CONNECTION_POOLING"));
+      return SQL_ERROR;
+  }
+}
+
 SQLRETURN SnappyEnvironment::getAttribute(SQLINTEGER attribute,
     SQLPOINTER resultValue, SQLINTEGER bufferLength,
     SQLINTEGER* stringLengthPtr) {
@@ -619,16 +662,42 @@ SQLRETURN SnappyEnvironment::getAttribute(SQLINTEGER attribute,
       }
       break;
     case SQL_ATTR_CONNECTION_POOLING:
-      // TODO: implement connection pooling (also fix setAttribute once done)
       if (result) {
-        *result = SQL_CP_OFF;
+        *result = m_connPooling;
       }
       break;
     case SQL_ATTR_CP_MATCH:
       if (result) {
-        *result = SQL_CP_STRICT_MATCH;
+        *result = m_cpMatch;
       }
       break;
+    case SQL_ATTR_PERF_ROUND_TRIPS:
+    case SQL_ATTR_PERF_ROWS_FETCHED:
+    case SQL_ATTR_PERF_BATCHES_FETCHED:
+    case SQL_ATTR_PERF_PREPARES:
+    case SQL_ATTR_PERF_EXECUTES:
+    case SQL_ATTR_PERF_NETWORK_NANOS:
+    case SQL_ATTR_PERF_CONVERSION_NANOS:
+    case SQL_ATTR_STMT_CACHE_HITS: {
+      // sum up the counters of all the connections only when read
+      const PerfCounters::Counter counter = PerfCounters::forAttribute(
+          attribute);
+      LockGuard<std::mutex> lock(m_connLock, false, this);
+      if (lock.lockFailed()) {
+        return SQL_ERROR;
+      }
+      SQLUBIGINT total = m_freedPerfCounters.get(counter);
+      for (SnappyConnection* conn : m_connections) {
+        total += conn->m_perfCounters.get(counter);
+      }
+      if (resultValue) {
+        *((SQLUBIGINT*)resultValue) = total;
+      }
+      if (stringLengthPtr) {
+        *stringLengthPtr = sizeof(SQLUBIGINT);
+      }
+      return SQL_SUCCESS;
+    }
     default:
       // should be handled by DriverManager
       std::ostringstream sstr;
@@ -44,10 +44,13 @@
 
 #include <functional>
 #include <mutex>
+#include <unordered_set>
 
 #include <Connection.h>
 
 #include "DriverBase.h"
+#include "ConnectionPool.h"
+#include "PerfCounters.h"
 
 namespace io {
 namespace snappydata {
@@ -70,13 +73,26 @@ namespace snappydata {
      */
     static bool g_initialized;
 
-    /** the list of all environment handles allocated for this app*/
-    static std::vector<SnappyEnvironment*> g_envHandles;
+    /** the set of all environment handles allocated for this app*/
+    static std::unordered_set<SnappyEnvironment*> g_envHandles;
+
+    /**
+     * The pool used for SQL_CP_ONE_PER_DRIVER connection pooling. It is
+     * never destroyed since connections may still be live at exit, and is
+     * drained explicitly when the last environment is freed.
+     */
+    static ConnectionPool& driverConnPool();
+
+    /**
+     * process level SQL_ATTR_CONNECTION_POOLING set with a null handle
+     * that is inherited by the environments allocated subsequently
+     */
+    static SQLUINTEGER g_connPooling;
 
     // TODO: implement the shared/non-shared environments
     const bool m_isShared;
-    /** the list of all connections registered in this environment */
-    std::vector<SnappyConnection*> m_connections;
+    /** the set of all connections registered in this environment */
+    std::unordered_set<SnappyConnection*> m_connections;
     /**
      * if set to true then the driver will do mappings as required for an
      * ODBC 2.x application; see
@@ -84,10 +100,22 @@ namespace snappydata {
      */
     bool m_appIsVersion2x;
 
+    /** the SQL_ATTR_CONNECTION_POOLING for this environment */
+    SQLUINTEGER m_connPooling;
+    /** the SQL_ATTR_CP_MATCH for this environment */
+    SQLUINTEGER m_cpMatch;
+    /** the pool used for SQL_CP_ONE_PER_HENV connection pooling */
+    ConnectionPool m_connPool;
+    /**
+     * the performance counters of the connections already freed which
+     * are added to those of the active ones when read
+     */
+    PerfCounters m_freedPerfCounters;
+
     static SQLRETURN getExceptionRecord(SQLSMALLINT handleType,
-        SQLHANDLE handle, SQLSMALLINT recNumber, SQLUINTEGER maxRecordSize,
-        SQLSMALLINT* textLength, SQLException*& err,
-        const std::string*& message);
+        SQLHANDLE handle, SQLSMALLINT recNumber, SQLSMALLINT* textLength,
+        std::shared_ptr<const DiagRecords>& records,
+        const DiagRecords::Record*& record);
 
     // couple of template error handling methods used by SQLCHAR/SQLWCHAR
     // variants of ODBC error retrieval methods
@@ -126,7 +154,9 @@ namespace snappydata {
      * non-shared environments.
      */
     inline SnappyEnvironment(const bool shared) :
-        m_isShared(shared), m_connections(), m_appIsVersion2x(false) {
+        m_isShared(shared), m_connections(), m_appIsVersion2x(false),
+        m_connPooling(g_connPooling), m_cpMatch(SQL_CP_STRICT_MATCH),
+        m_connPool(), m_freedPerfCounters() {
     }
 
     /**
@@ -146,6 +176,34 @@ namespace snappydata {
       return m_appIsVersion2x;
     }
 
+    /**
+     * Returns the pool to be used for connections in this environment as
+     * per SQL_ATTR_CONNECTION_POOLING, or null if pooling is off.
+     */
+    inline ConnectionPool* getConnectionPool() noexcept {
+      switch (m_connPooling) {
+        case SQL_CP_ONE_PER_DRIVER:
+          return &driverConnPool();
+        case SQL_CP_ONE_PER_HENV:
+          return &m_connPool;
+        default:
+          return nullptr;
+      }
+    }
+
+    /**
+     * Returns true if SQL_ATTR_CP_MATCH is SQL_CP_STRICT_MATCH.
+     */
+    inline bool isStrictPoolMatch() const noexcept {
+      return m_cpMatch != SQL_CP_RELAXED_MATCH;
+    }
+
+    /**
+     * Set the process level SQL_ATTR_CONNECTION_POOLING (i.e. invoked with
+     * a null environment handle).
+     */
+    static SQLRETURN setProcessConnectionPooling(SQLPOINTER value);
+
     /**
      * Execute a given function for each active connection in this
      * environment.
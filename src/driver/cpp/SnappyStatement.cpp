@@ -41,8 +41,11 @@
 
 #include "SnappyEnvironment.h"
 #include "SnappyStatement.h"
+#include "AsyncExecutor.h"
+#include "TextConversions.h"
 
 #include <ParametersBatch.h>
+#include <cmath>
 #include <limits>
 
 using namespace io::snappydata;
@@ -60,6 +63,13 @@ namespace snappydata {
 }
 
 void SnappyStatement::setResultSet(std::unique_ptr<ResultSet> &rs) {
+  releaseCatalogResult();
+  stopReadAhead();
+  m_getData.reset();
+  clearStagedRows();
+  invalidateFetchPlan();
+  invalidateDescriptors();
+  m_rowTracker.reset();
   if (rs) {
     m_resultSet = std::move(rs);
     rs.release();
@@ -71,6 +81,13 @@ void SnappyStatement::setResultSet(std::unique_ptr<ResultSet> &rs) {
 }
 
 void SnappyStatement::setResultSet(std::shared_ptr<ResultSet> &rs) {
+  releaseCatalogResult();
+  stopReadAhead();
+  m_getData.reset();
+  clearStagedRows();
+  invalidateFetchPlan();
+  invalidateDescriptors();
+  m_rowTracker.reset();
   if (rs) {
     m_resultSet = rs;
     m_cursor.initialize(*m_resultSet, true);
@@ -80,9 +97,223 @@ void SnappyStatement::setResultSet(std::shared_ptr<ResultSet> &rs) {
   }
 }
 
+/**
+ * Returns true if the character data of an input parameter with given
+ * SQL type should be parsed and sent as a value of that type.
+ */
+static inline bool isTypedTextParameter(const SQLSMALLINT inputOutputType,
+    const SQLSMALLINT paramType) noexcept {
+  if (inputOutputType != SQL_PARAM_INPUT) {
+    return false;
+  }
+  switch (paramType) {
+    case SQL_TINYINT:
+    case SQL_SMALLINT:
+    case SQL_INTEGER:
+    case SQL_BIGINT:
+    case SQL_REAL:
+    case SQL_FLOAT:
+    case SQL_DOUBLE:
+    case SQL_DECIMAL:
+    case SQL_NUMERIC:
+    case SQL_DATE:
+    case SQL_TYPE_DATE:
+    case SQL_TIME:
+    case SQL_TYPE_TIME:
+    case SQL_TIMESTAMP:
+    case SQL_TYPE_TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Copy the given wide characters to "chars" if all are ASCII and fit in
+ * the given maximum length.
+ */
+static bool narrowASCII(const SQLWCHAR* wchars, SQLLEN len, char* chars,
+    const size_t maxLen, size_t& outLen) noexcept {
+  if (len == SQL_NTS) {
+    len = StringFunctions::restrictLength<SQLLEN, size_t>(
+        StringFunctions::strlen(wchars));
+  }
+  if (len < 0 || static_cast<size_t>(len) > maxLen) {
+    return false;
+  }
+  for (SQLLEN i = 0; i < len; i++) {
+    const SQLWCHAR c = wchars[i];
+    if (c >= 0x80) {
+      return false;
+    }
+    chars[i] = static_cast<char>(c);
+  }
+  outLen = static_cast<size_t>(len);
+  return true;
+}
+
+bool SnappyStatement::bindTextAsTyped(Parameters& paramValues,
+    Parameter& param, const char* chars, const size_t len,
+    SQLRETURN& result) {
+  const uint32_t paramNum = param.m_paramNum;
+  bool valid, outOfRange = false;
+  result = SQL_SUCCESS;
+  switch (param.m_o_paramType) {
+    case SQL_TINYINT:
+    case SQL_SMALLINT:
+    case SQL_INTEGER:
+    case SQL_BIGINT: {
+      int64_t v;
+      bool truncated;
+      valid = TextConversions::parseIntegral(chars, len, v, truncated,
+          outOfRange);
+      if (!valid) {
+        double d;
+        if (!outOfRange && TextConversions::parseDouble(chars, len, d)) {
+          // leave the exponent form to the server
+          return false;
+        }
+        break;
+      }
+      switch (param.m_o_paramType) {
+        case SQL_TINYINT:
+          valid = v >= std::numeric_limits<int8_t>::min()
+              && v <= std::numeric_limits<int8_t>::max();
+          if (valid) {
+            paramValues.setByte(paramNum, static_cast<int8_t>(v));
+            param.m_paramType = SQLType::TINYINT;
+          }
+          break;
+        case SQL_SMALLINT:
+          valid = v >= std::numeric_limits<int16_t>::min()
+              && v <= std::numeric_limits<int16_t>::max();
+          if (valid) {
+            paramValues.setShort(paramNum, static_cast<int16_t>(v));
+            param.m_paramType = SQLType::SMALLINT;
+          }
+          break;
+        case SQL_INTEGER:
+          valid = v >= std::numeric_limits<int32_t>::min()
+              && v <= std::numeric_limits<int32_t>::max();
+          if (valid) {
+            paramValues.setInt(paramNum, static_cast<int32_t>(v));
+            param.m_paramType = SQLType::INTEGER;
+          }
+          break;
+        default:
+          paramValues.setInt64(paramNum, v);
+          param.m_paramType = SQLType::BIGINT;
+          break;
+      }
+      outOfRange = !valid;
+      if (valid && truncated) {
+        // fractional truncation is only a warning (01S07)
+        setException(GET_SQLEXCEPTION2(
+            SQLStateMessage::NUMERIC_TRUNCATED_MSG, "parameter", paramNum));
+        result = SQL_SUCCESS_WITH_INFO;
+      }
+      break;
+    }
+    case SQL_REAL:
+    case SQL_FLOAT:
+    case SQL_DOUBLE: {
+      double d;
+      valid = TextConversions::parseDouble(chars, len, d);
+      if (!valid) {
+        break;
+      }
+      if (param.m_o_paramType == SQL_REAL) {
+        valid = std::fabs(d) <= std::numeric_limits<float>::max();
+        if (valid) {
+          paramValues.setFloat(paramNum, static_cast<float>(d));
+          param.m_paramType = SQLType::FLOAT;
+        }
+        outOfRange = !valid;
+      } else {
+        paramValues.setDouble(paramNum, d);
+        param.m_paramType = SQLType::DOUBLE;
+      }
+      break;
+    }
+    case SQL_DECIMAL:
+    case SQL_NUMERIC: {
+      uint8_t magnitude[TextConversions::MAX_DECIMAL_BYTES];
+      size_t magLen;
+      int scale, signum;
+      // leave the exponent form and larger values to the server
+      if (!TextConversions::parseDecimal(chars, len, magnitude, magLen,
+          scale, signum)) {
+        return false;
+      }
+      if (signum == 0) {
+        paramValues.setDecimal(paramNum, Decimal::ZERO);
+      } else {
+        paramValues.setDecimal(paramNum, signum, scale,
+            (const int8_t*)magnitude, magLen, false);
+      }
+      param.m_paramType = SQLType::DECIMAL;
+      return true;
+    }
+    case SQL_DATE:
+    case SQL_TYPE_DATE: {
+      int year, month, day;
+      // leave the formats other than ISO to the server
+      if (!TextConversions::parseDate(chars, len, year, month, day)) {
+        return false;
+      }
+      DateTime dt(year, month, day);
+      paramValues.setDate(paramNum, dt);
+      param.m_paramType = SQLType::DATE;
+      return true;
+    }
+    case SQL_TIME:
+    case SQL_TYPE_TIME: {
+      int hour, minute, second;
+      if (!TextConversions::parseTime(chars, len, hour, minute, second)) {
+        return false;
+      }
+      DateTime tm(1970, 1, 1, hour, minute, second);
+      paramValues.setTime(paramNum, tm);
+      param.m_paramType = SQLType::TIME;
+      return true;
+    }
+    case SQL_TIMESTAMP:
+    case SQL_TYPE_TIMESTAMP: {
+      int year, month, day, hour, minute, second;
+      uint32_t nanos;
+      if (!TextConversions::parseTimestamp(chars, len, year, month, day,
+          hour, minute, second, nanos)) {
+        return false;
+      }
+      Timestamp ts(year, month, day, hour, minute, second, nanos);
+      paramValues.setTimestamp(paramNum, ts);
+      param.m_paramType = SQLType::TIMESTAMP;
+      return true;
+    }
+    default:
+      return false;
+  }
+  if (outOfRange) {
+    // numeric value out of range (22003)
+    setException(GET_SQLEXCEPTION2(
+        SQLStateMessage::LANG_OUTSIDE_RANGE_FOR_NUMERIC_MSG,
+        param.m_o_paramType, paramNum));
+    result = SQL_ERROR;
+  } else if (!valid) {
+    // invalid character value for cast (22018)
+    setException(GET_SQLEXCEPTION2(
+        SQLStateMessage::LANG_FORMAT_EXCEPTION_MSG, param.m_o_paramType,
+        paramNum));
+    result = SQL_ERROR;
+  }
+  return true;
+}
+
 SQLRETURN SnappyStatement::bindParameter(Parameters& paramValues,
     Parameter& param, std::map<int32_t, OutputParameter>* outParams,
-    bool appendPutData, SQLLEN valueOffset, SQLLEN lenOffset) {
+    bool appendPutData, SQLLEN valueOffset, SQLLEN lenOffset,
+    ParameterArena* arena) {
+  SQLRETURN ret = SQL_SUCCESS;
   if (!appendPutData) {
     // check if data at exec param and return
     if (param.m_isDataAtExecParam || IS_DATA_AT_EXEC(param.m_o_lenOrIndp)) {
@@ -95,7 +326,11 @@ SQLRETURN SnappyStatement::bindParameter(Parameters& paramValues,
   }
 
   // TODO: handle SQL_DEFAULT_PARAM in *m_o_lenOrIndp
-  if (param.m_o_value
+  // a NULL value may also be given by an indicator apart from the length
+  const bool isNullValue = !appendPutData && param.m_o_indicatorPtr
+      && param.m_o_indicatorPtr != param.m_o_lenOrIndp
+      && *(param.m_o_indicatorPtr + lenOffset) == SQL_NULL_DATA;
+  if (param.m_o_value && !isNullValue
       && param.m_inputOutputType != SQL_PARAM_OUTPUT) {
     const SQLSMALLINT ctype = param.m_o_valueType;
     SQLLEN len;
@@ -108,6 +343,19 @@ SQLRETURN SnappyStatement::bindParameter(Parameters& paramValues,
           len = SQL_NTS;
         }
         const char* value = PARAM_VALUE(param, valueOffset);
+        if (!appendPutData && (len >= 0 || len == SQL_NTS)
+            && isTypedTextParameter(param.m_inputOutputType,
+                param.m_o_paramType)) {
+          SQLRETURN result;
+          if (bindTextAsTyped(paramValues, param, value, len == SQL_NTS
+              ? ::strlen(value) : static_cast<size_t>(len), result)) {
+            if (result == SQL_ERROR) {
+              return result;
+            }
+            ret = result;
+            break;
+          }
+        }
         if (len < 0) {
           if (appendPutData) {
             paramValues.appendString(param.m_paramNum, value);
@@ -132,10 +380,42 @@ SQLRETURN SnappyStatement::bindParameter(Parameters& paramValues,
         } else {
           len = SQL_NTS;
         }
+        if (!appendPutData && (len >= 0 || len == SQL_NTS)
+            && isTypedTextParameter(param.m_inputOutputType,
+                param.m_o_paramType)) {
+          // numeric and temporal text is ASCII in the usual case
+          char chars[128];
+          size_t charsLen;
+          SQLRETURN result;
+          if (narrowASCII((const SQLWCHAR*)PARAM_VALUE(param, valueOffset),
+              len, chars, sizeof(chars), charsLen) && bindTextAsTyped(
+                  paramValues, param, chars, charsLen, result)) {
+            if (result == SQL_ERROR) {
+              return result;
+            }
+            ret = result;
+            break;
+          }
+        }
         if (appendPutData) {
           paramValues.appendString(param.m_paramNum, std::move(
               StringFunctions::toString(
                   (const SQLWCHAR*)PARAM_VALUE(param, valueOffset), len)));
+        } else if (arena) {
+          // transcode into the arena in a single pass with the worst case
+          // size of three UTF-8 bytes for every UTF-16 code unit
+          const SQLWCHAR* wchars = (const SQLWCHAR*)PARAM_VALUE(param,
+              valueOffset);
+          if (len == SQL_NTS) {
+            len = StringFunctions::restrictLength<SQLLEN, size_t>(
+                StringFunctions::strlen(wchars));
+          }
+          const SQLLEN maxLen = len * 3 + 1;
+          SQLCHAR* chars = (SQLCHAR*)arena->allocate(maxLen);
+          SQLLEN outLen = 0;
+          StringFunctions::copyString(wchars, len, chars, maxLen, &outLen);
+          paramValues.setString(param.m_paramNum, (const char*)chars,
+              static_cast<size_t>(outLen));
         } else {
           paramValues.setString(param.m_paramNum, std::move(
               StringFunctions::toString(
@@ -528,7 +808,15 @@ SQLRETURN SnappyStatement::bindParameter(Parameters& paramValues,
           param.m_o_scale);
     }
   }
-  return SQL_SUCCESS;
+  return ret;
+}
+
+SnappyDescriptor* SnappyStatement::getDescriptor(
+    std::unique_ptr<SnappyDescriptor>& desc, int descType) {
+  if (!desc) {
+    desc.reset(new SnappyDescriptor(this, descType));
+  }
+  return desc.get();
 }
 
 SQLRETURN SnappyStatement::newStatement(SnappyConnection* conn,
@@ -564,11 +852,15 @@ SQLRETURN SnappyStatement::freeStatement(SnappyStatement* stmt,
     try {
       switch (option) {
         case SQL_CLOSE:
-          result = stmt->closeResultSet(true);
-          stmt->m_result.reset();
+          result = stmt->runLocked(SQL_API_SQLFREESTMT, [stmt]() {
+            const SQLRETURN ret = stmt->closeResultSet(true);
+            stmt->m_result.reset();
+            return ret;
+          });
           break;
         case SQL_UNBIND:
           stmt->m_outputFields.clear();
+          stmt->invalidateFetchPlan();
           break;
         case SQL_DROP:
           delete stmt;
@@ -601,9 +893,13 @@ SQLRETURN SnappyStatement::bindParameters(
   SQLRETURN retVal = SQL_SUCCESS;
   m_execParams.resize(m_params.size());
   for (auto &param : m_params) {
-    retVal = bindParameter(m_execParams, param, outParams);
-    if (retVal != SQL_SUCCESS) {
-      break;
+    const SQLRETURN ret = bindParameter(m_execParams, param, outParams);
+    if (ret != SQL_SUCCESS) {
+      retVal = ret;
+      // continue binding the remaining parameters after a warning
+      if (ret != SQL_SUCCESS_WITH_INFO) {
+        break;
+      }
     }
   }
   return retVal;
@@ -629,7 +925,8 @@ static inline void updateStatus(SQLUSMALLINT& status, SQLRETURN& result,
 
 SQLRETURN SnappyStatement::bindArrayOfParameters(ParametersBatch& paramsBatch,
     SQLULEN setSize, SQLULEN* bindOffsetPtr, SQLULEN bindingOrientation,
-    SQLUSMALLINT* statusArr, SQLULEN* processedPtr) {
+    SQLUSMALLINT* statusArr, SQLULEN* processedPtr,
+    std::vector<uint32_t>& failedSets) {
   SQLRETURN result = SQL_SUCCESS;
   int numSetProcessed = 0;
   SQLLEN bindOffset = 0;
@@ -640,10 +937,14 @@ SQLRETURN SnappyStatement::bindArrayOfParameters(ParametersBatch& paramsBatch,
 
   SQLLEN offset = bindOffset;
   const auto structSize = bindingOrientation;
+  const size_t numParams = paramsBatch.numParams();
+  // scratch memory for the conversions of all the parameter sets that is
+  // reused for every set and released in one shot at the end
+  ParameterArena arena;
   for (uint32_t i = 0; i < setSize; i++) {
     // SQL_PARAM_SUCCESS == SQL_ROW_SUCCESS == SQL_SUCCESS == 0
     SQLUSMALLINT status = SQL_SUCCESS;
-    m_execParams.resize(paramsBatch.numParams());
+    m_execParams.resize(numParams);
     // SQL_PARAM_BIND_BY_COLUMN == SQL_BIND_BY_COLUMN
     if (structSize == SQL_BIND_BY_COLUMN) {
       /*
@@ -658,7 +959,7 @@ SQLRETURN SnappyStatement::bindArrayOfParameters(ParametersBatch& paramsBatch,
         // which is fine but will be set in subsequent calls by bindParameter
         const SQLLEN valueOffset = (i * param.m_o_valueSize) + bindOffset;
         updateStatus(status, result, bindParameter(m_execParams, param, nullptr,
-            false, valueOffset, offset));
+            false, valueOffset, offset, &arena));
       }
       offset++;
     } else {
@@ -671,12 +972,18 @@ SQLRETURN SnappyStatement::bindArrayOfParameters(ParametersBatch& paramsBatch,
        */
       for (Parameter& param : m_params) {
         updateStatus(status, result, bindParameter(m_execParams, param, nullptr,
-            false, offset, offset));
+            false, offset, offset, &arena));
       }
       offset += structSize;
     }
-    paramsBatch.moveParameters(m_execParams);
+    if (status == SQL_PARAM_ERROR) {
+      // leave out the set from the batch so that the others still execute
+      failedSets.push_back(i);
+    } else {
+      paramsBatch.moveParameters(m_execParams);
+    }
     m_execParams.clear();
+    arena.rewind();
     numSetProcessed++;
     if (statusArr) {
       statusArr[i] = status;
@@ -685,7 +992,176 @@ SQLRETURN SnappyStatement::bindArrayOfParameters(ParametersBatch& paramsBatch,
   if (processedPtr) {
     *processedPtr = numSetProcessed;
   }
+  if (result == SQL_ERROR && failedSets.size() < setSize) {
+    result = SQL_SUCCESS_WITH_INFO;
+  }
+
+  return result;
+}
+
+/**
+ * Set the row status array from the update counts of a batch which skips
+ * the parameter sets that failed to bind.
+ */
+template<typename UPDATE_COUNTS>
+static void setBatchRowStatus(SQLUSMALLINT* rowStatusPtr,
+    const SQLULEN setSize, const UPDATE_COUNTS& updateCounts,
+    const std::vector<uint32_t>& failedSets, const SQLUSMALLINT rowStatus) {
+  size_t failedIndex = 0, countIndex = 0;
+  for (uint32_t i = 0; i < setSize; i++) {
+    if (failedIndex < failedSets.size() && failedSets[failedIndex] == i) {
+      rowStatusPtr[i] = SQL_ROW_ERROR;
+      failedIndex++;
+    } else {
+      rowStatusPtr[i] = updateCounts.at(countIndex++) > 0 ? rowStatus
+          : SQL_ROW_NOROW;
+    }
+  }
+}
+
+/**
+ * Get the bytes of a string column as a pointer and length. For character
+ * columns this points directly into the storage held by the Row so avoids
+ * the allocation and copy of Row::getString. Integer, floating point and
+ * temporal values are formatted into the passed "scratch" buffer which
+ * must have space for TextConversions::MAX_FORMAT_LEN characters. Other
+ * types, and floating point values with a precision other than the
+ * default, are converted to a string by the Row which is held in the
+ * passed "holder" to keep it alive.
+ *
+ * Returns false if the column value is null.
+ */
+static bool getStringView(const Row& outputRow, const uint32_t columnNum,
+    const SQLUINTEGER precision, std::unique_ptr<std::string>& holder,
+    char* scratch, const char*& data, size_t& len) {
+  switch (outputRow.getType(columnNum)) {
+    case SQLType::TINYINT:
+    case SQLType::SMALLINT:
+    case SQLType::INTEGER:
+    case SQLType::BIGINT: {
+      const int64_t v = outputRow.getInt64(columnNum);
+      if (v == 0 && outputRow.isNull(columnNum)) {
+        return false;
+      }
+      data = scratch;
+      len = TextConversions::formatInt64(v, scratch);
+      return true;
+    }
+    case SQLType::FLOAT: {
+      if (precision != DEFAULT_REAL_PRECISION) {
+        break; // let the Row format with the requested precision
+      }
+      const float v = outputRow.getFloat(columnNum);
+      if (v == 0 && outputRow.isNull(columnNum)) {
+        return false;
+      }
+      data = scratch;
+      len = TextConversions::formatFloat(v, scratch);
+      return true;
+    }
+    case SQLType::DOUBLE: {
+      if (precision != DEFAULT_REAL_PRECISION) {
+        break; // let the Row format with the requested precision
+      }
+      const double v = outputRow.getDouble(columnNum);
+      if (v == 0 && outputRow.isNull(columnNum)) {
+        return false;
+      }
+      data = scratch;
+      len = TextConversions::formatDouble(v, scratch);
+      return true;
+    }
+    case SQLType::DATE: {
+      DateTime date = outputRow.getDate(columnNum);
+      if (date.getEpochTime() == 0 && outputRow.isNull(columnNum)) {
+        return false;
+      }
+      struct tm t = date.toDateTime(false);
+      data = scratch;
+      len = TextConversions::formatDate(t.tm_year + 1900, t.tm_mon + 1,
+          t.tm_mday, scratch);
+      return true;
+    }
+    case SQLType::TIME: {
+      DateTime time = outputRow.getTime(columnNum);
+      if (time.getEpochTime() == 0 && outputRow.isNull(columnNum)) {
+        return false;
+      }
+      struct tm t = time.toDateTime(false);
+      data = scratch;
+      len = TextConversions::formatTime(t.tm_hour, t.tm_min, t.tm_sec,
+          scratch);
+      return true;
+    }
+    case SQLType::TIMESTAMP: {
+      Timestamp ts = outputRow.getTimestamp(columnNum);
+      if (ts.getEpochTime() == 0 && outputRow.isNull(columnNum)) {
+        return false;
+      }
+      struct tm t = ts.toDateTime(false);
+      data = scratch;
+      len = TextConversions::formatTimestamp(t.tm_year + 1900, t.tm_mon + 1,
+          t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec,
+          static_cast<uint32_t>(ts.getNanos()), scratch);
+      return true;
+    }
+    case SQLType::CHAR:
+    case SQLType::VARCHAR:
+    case SQLType::LONGVARCHAR: {
+      const std::string* str = outputRow.getColumnValue(
+          columnNum).getOrNull<std::string>();
+      if (str) {
+        data = str->data();
+        len = str->length();
+        return true;
+      } else if (outputRow.isNull(columnNum)) {
+        return false;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  holder = outputRow.getString(columnNum, precision);
+  if (holder) {
+    data = holder->data();
+    len = holder->length();
+    return true;
+  } else {
+    return false;
+  }
+}
 
+/**
+ * Set the error (22002) for a NULL value to be returned in a column or
+ * parameter that has no length/indicator buffer.
+ */
+static SQLRETURN errorIndicatorRequired(SnappyHandleBase& handle,
+    const uint32_t columnNum) {
+  handle.setException(GET_SQLEXCEPTION2(
+      SQLStateMessage::NULL_INDICATOR_REQUIRED_MSG, columnNum));
+  return SQL_ERROR;
+}
+
+/**
+ * Set the indicator of a value bound with an indicator buffer apart from
+ * its length buffer, to which the converter has written SQL_NULL_DATA
+ * for a NULL value, and return the result of the conversion.
+ */
+static SQLRETURN setSeparateIndicator(SnappyHandleBase& handle,
+    const uint32_t columnNum, const SQLRETURN result,
+    const SQLLEN* lenOrIndp, SQLLEN* indicatorPtr) {
+  if (result == SQL_ERROR) {
+    return result;
+  }
+  if (*lenOrIndp == SQL_NULL_DATA) {
+    if (!indicatorPtr) {
+      return errorIndicatorRequired(handle, columnNum);
+    }
+    *indicatorPtr = SQL_NULL_DATA;
+  } else if (indicatorPtr) {
+    *indicatorPtr = 0;
+  }
   return result;
 }
 
@@ -694,15 +1170,23 @@ SQLRETURN SnappyStatement::fillOutput(const Row& outputRow,
     SQLSMALLINT ctype, const SQLUINTEGER precision, SQLLEN* lenOrIndp) {
   SQLRETURN res = SQL_SUCCESS;
 
+  if (!lenOrIndp && outputRow.isNull(columnNum)) {
+    return errorIndicatorRequired(*this, columnNum);
+  }
+
   if (ctype == SQL_C_DEFAULT) {
     ctype = convertSQLTypeToCType(outputRow.getType(columnNum));
   }
   switch (ctype) {
     case SQL_C_CHAR: {
-      auto outStr = outputRow.getString(columnNum, precision);
-      if (outStr) {
-        if (StringFunctions::copyString((const SQLCHAR*)outStr->c_str(),
-            outStr->length(), (SQLCHAR*)value, valueSize, lenOrIndp)) {
+      const char* strData;
+      size_t strLen;
+      std::unique_ptr<std::string> outStr;
+      char scratch[TextConversions::MAX_FORMAT_LEN];
+      if (getStringView(outputRow, columnNum, precision, outStr, scratch,
+          strData, strLen)) {
+        if (StringFunctions::copyString((const SQLCHAR*)strData, strLen,
+            (SQLCHAR*)value, valueSize, lenOrIndp)) {
           res = SQL_SUCCESS_WITH_INFO;
         }
       } else {
@@ -716,11 +1200,15 @@ SQLRETURN SnappyStatement::fillOutput(const Row& outputRow,
       break;
     }
     case SQL_C_WCHAR: {
-      auto outStr = outputRow.getString(columnNum, precision);
-      if (outStr) {
+      const char* strData;
+      size_t strLen;
+      std::unique_ptr<std::string> outStr;
+      char scratch[TextConversions::MAX_FORMAT_LEN];
+      if (getStringView(outputRow, columnNum, precision, outStr, scratch,
+          strData, strLen)) {
         // as per MSDN docs the "valueSize" is in bytes hence length is half of it
-        if (StringFunctions::copyString((const SQLCHAR*)outStr->c_str(),
-            outStr->length(), (SQLWCHAR*)value, valueSize >> 1, lenOrIndp)) {
+        if (StringFunctions::copyString((const SQLCHAR*)strData, strLen,
+            (SQLWCHAR*)value, valueSize >> 1, lenOrIndp)) {
           res = SQL_SUCCESS_WITH_INFO;
         }
         if (lenOrIndp) {
@@ -1388,9 +1876,16 @@ SQLRETURN SnappyStatement::fillOutParameters(const Result& result) {
         // std::move is safe here since result.getOutputParameters is called
         // exactly once from here and never used after this
         outParams.addColumn(std::move(result->second));
+        SQLLEN* lenOrIndp = param.m_o_lenOrIndp ? param.m_o_lenOrIndp
+            : param.m_o_indicatorPtr;
         retVal = fillOutput(outParams, ++outParamIndex, param.m_o_value,
             param.m_o_valueSize, param.m_o_valueType, param.m_o_precision,
-            param.m_o_lenOrIndp);
+            lenOrIndp);
+        if (param.m_o_lenOrIndp
+            && param.m_o_indicatorPtr != param.m_o_lenOrIndp) {
+          retVal = setSeparateIndicator(*this, param.m_paramNum, retVal,
+              param.m_o_lenOrIndp, param.m_o_indicatorPtr);
+        }
       }
       if (retVal != SQL_SUCCESS) {
         break;
@@ -1400,22 +1895,247 @@ SQLRETURN SnappyStatement::fillOutParameters(const Result& result) {
   return retVal;
 }
 
+// getters for fixed width values used by the fetch plan converters
+
+static inline int16_t getRowShort(const Row& row, const uint32_t col) {
+  return row.getShort(col);
+}
+
+static inline uint16_t getRowUShort(const Row& row, const uint32_t col) {
+  return row.getUnsignedShort(col);
+}
+
+static inline int32_t getRowInt(const Row& row, const uint32_t col) {
+  return row.getInt(col);
+}
+
+static inline uint32_t getRowUInt(const Row& row, const uint32_t col) {
+  return row.getUnsignedInt(col);
+}
+
+static inline int64_t getRowInt64(const Row& row, const uint32_t col) {
+  return row.getInt64(col);
+}
+
+static inline uint64_t getRowUInt64(const Row& row, const uint32_t col) {
+  return row.getUnsignedInt64(col);
+}
+
+static inline int8_t getRowByte(const Row& row, const uint32_t col) {
+  return row.getByte(col);
+}
+
+static inline uint8_t getRowUByte(const Row& row, const uint32_t col) {
+  return row.getUnsignedByte(col);
+}
+
+static inline float getRowFloat(const Row& row, const uint32_t col) {
+  return row.getFloat(col);
+}
+
+static inline double getRowDouble(const Row& row, const uint32_t col) {
+  return row.getDouble(col);
+}
+
+/**
+ * Specialized fetch plan converter for fixed width C types that avoids
+ * the per-cell switch in fillOutput. Behaviour is identical to the
+ * corresponding case in fillOutput.
+ */
+template<typename C_TYPE, typename V,
+    V (*GET_VALUE)(const Row&, const uint32_t), SQLLEN LEN>
+static SQLRETURN fetchFixedWidth(SnappyStatement& stmt,
+    const Row& outputRow, const uint32_t columnNum, SQLPOINTER value,
+    const SQLLEN, const SQLSMALLINT, SQLLEN* lenOrIndp) {
+  const V v = GET_VALUE(outputRow, columnNum);
+  if (v == 0 && outputRow.isNull(columnNum)) {
+    if (!lenOrIndp) {
+      return errorIndicatorRequired(stmt, columnNum);
+    }
+    *(C_TYPE*)value = static_cast<C_TYPE>(v);
+    *lenOrIndp = SQL_NULL_DATA;
+  } else {
+    *(C_TYPE*)value = static_cast<C_TYPE>(v);
+    if (lenOrIndp) {
+      *lenOrIndp = LEN;
+    }
+  }
+  return SQL_SUCCESS;
+}
+
+template<typename C_TYPE, typename V,
+    V (*GET_VALUE)(const Row&, const uint32_t), SQLLEN LEN>
+SQLRETURN SnappyStatement::fetchFixedWidthColumn(SnappyStatement& stmt,
+    const std::vector<Row>& rows, const FetchPlanEntry& entry,
+    const SQLULEN bindOffset, size_t& errorRow) {
+  const uint32_t columnNum = entry.m_columnNum;
+  const size_t numRows = rows.size();
+  // BufferLength is ignored for fixed-length C types (and is often passed
+  // as zero) so the elements of the column-wise array are contiguous
+  C_TYPE* const values = (C_TYPE*)((char*)entry.m_targetValue + bindOffset);
+  for (size_t i = 0; i < numRows; i++) {
+    values[i] = static_cast<C_TYPE>(GET_VALUE(rows[i], columnNum));
+  }
+  if (entry.m_lenOrIndPtr) {
+    SQLLEN* lenOrIndPtr = (SQLLEN*)((char*)entry.m_lenOrIndPtr + bindOffset);
+    for (size_t i = 0; i < numRows; i++) {
+      lenOrIndPtr[i] = (values[i] == 0 && rows[i].isNull(columnNum))
+          ? SQL_NULL_DATA : LEN;
+    }
+  } else {
+    // a NULL value cannot be returned without an indicator
+    for (size_t i = 0; i < numRows; i++) {
+      if (values[i] == 0 && rows[i].isNull(columnNum)) {
+        errorRow = i;
+        return errorIndicatorRequired(stmt, columnNum);
+      }
+    }
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SnappyStatement::fetchColumnWithConverter(SnappyStatement& stmt,
+    const std::vector<Row>& rows, const FetchPlanEntry& entry,
+    const SQLULEN bindOffset, size_t& errorRow) {
+  SQLRETURN result = SQL_SUCCESS, result2;
+  const size_t numRows = rows.size();
+  const SQLLEN valueSize = entry.m_valueSize;
+  char* targetValue = (char*)entry.m_targetValue + bindOffset;
+  SQLLEN* lenOrIndPtr = entry.m_lenOrIndPtr
+      ? (SQLLEN*)((char*)entry.m_lenOrIndPtr + bindOffset) : nullptr;
+  for (size_t i = 0; i < numRows; i++, targetValue += valueSize) {
+    result2 = entry.m_convert(stmt, rows[i], entry.m_columnNum, targetValue,
+        valueSize, entry.m_ctype, lenOrIndPtr ? lenOrIndPtr + i : nullptr);
+    if (result2 != SQL_SUCCESS) {
+      result = result2;
+      if (result2 == SQL_ERROR) {
+        errorRow = i;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+SQLRETURN SnappyStatement::fetchWithFillOutput(SnappyStatement& stmt,
+    const Row& outputRow, const uint32_t columnNum, SQLPOINTER value,
+    const SQLLEN valueSize, const SQLSMALLINT ctype, SQLLEN* lenOrIndp) {
+  return stmt.fillOutput(outputRow, columnNum, value, valueSize, ctype,
+      DEFAULT_REAL_PRECISION, lenOrIndp);
+}
+
+#define FIXED_WIDTH_CONVERTERS(C_TYPE, V, GET_VALUE, LEN) \
+    convert = fetchFixedWidth<C_TYPE, V, GET_VALUE, LEN>; \
+    convertColumn = fetchFixedWidthColumn<C_TYPE, V, GET_VALUE, LEN>
+
+void SnappyStatement::buildFetchPlan(const Row& outputRow) {
+  m_fetchPlan.clear();
+  m_fetchPlan.reserve(m_outputFields.size());
+  uint32_t columnNum = 0;
+  for (const auto& outputField : m_outputFields) {
+    ++columnNum;
+    if (!outputField.m_targetValue) continue;
+
+    SQLSMALLINT ctype = outputField.m_targetType;
+    if (ctype == SQL_C_DEFAULT) {
+      // resolve using the column meta-data rather than the current value
+      // which may be a null
+      ctype = convertSQLTypeToCType(hasOpenCursor()
+          ? getResultRecord(columnNum).m_sqlType
+          : outputRow.getType(columnNum));
+    }
+    FetchConverter convert;
+    FetchColumnConverter convertColumn;
+    switch (ctype) {
+      case SQL_C_SSHORT:
+      case SQL_C_SHORT:
+        FIXED_WIDTH_CONVERTERS(SQLSMALLINT, int16_t, getRowShort,
+            sizeof(SQLSMALLINT));
+        break;
+      case SQL_C_USHORT:
+        FIXED_WIDTH_CONVERTERS(SQLUSMALLINT, uint16_t, getRowUShort,
+            sizeof(SQLUSMALLINT));
+        break;
+      case SQL_C_SLONG:
+        FIXED_WIDTH_CONVERTERS(SQLINTEGER, int32_t, getRowInt,
+            sizeof(SQLINTEGER));
+        break;
+      case SQL_C_ULONG:
+        FIXED_WIDTH_CONVERTERS(SQLUINTEGER, uint32_t, getRowUInt,
+            sizeof(SQLUINTEGER));
+        break;
+      case SQL_C_LONG:
+        FIXED_WIDTH_CONVERTERS(SQLINTEGER, int32_t, getRowInt, sizeof(SQLLEN));
+        break;
+      case SQL_C_FLOAT:
+        FIXED_WIDTH_CONVERTERS(SQLREAL, float, getRowFloat, sizeof(SQLREAL));
+        break;
+      case SQL_C_DOUBLE:
+        FIXED_WIDTH_CONVERTERS(SQLDOUBLE, double, getRowDouble,
+            sizeof(SQLDOUBLE));
+        break;
+      case SQL_C_BIT:
+        FIXED_WIDTH_CONVERTERS(SQLCHAR, int8_t, getRowByte, sizeof(SQLCHAR));
+        break;
+      case SQL_C_UTINYINT:
+      case SQL_C_TINYINT:
+        FIXED_WIDTH_CONVERTERS(SQLCHAR, uint8_t, getRowUByte, sizeof(SQLCHAR));
+        break;
+      case SQL_C_STINYINT:
+        FIXED_WIDTH_CONVERTERS(SQLSCHAR, int8_t, getRowByte, sizeof(SQLSCHAR));
+        break;
+      case SQL_C_SBIGINT:
+        FIXED_WIDTH_CONVERTERS(SQLBIGINT, int64_t, getRowInt64,
+            sizeof(SQLBIGINT));
+        break;
+      case SQL_C_UBIGINT:
+        FIXED_WIDTH_CONVERTERS(SQLUBIGINT, uint64_t, getRowUInt64,
+            sizeof(SQLUBIGINT));
+        break;
+      default:
+        // strings, binary, temporal, numeric, interval and GUID types
+        convert = fetchWithFillOutput;
+        convertColumn = fetchColumnWithConverter;
+        break;
+    }
+    FetchPlanEntry entry;
+    entry.m_columnNum = columnNum;
+    entry.m_ctype = ctype;
+    entry.m_convert = convert;
+    entry.m_convertColumn = convertColumn;
+    entry.m_targetValue = outputField.m_targetValue;
+    entry.m_valueSize = outputField.m_valueSize;
+    entry.m_lenOrIndPtr = outputField.m_lenOrIndPtr
+        ? outputField.m_lenOrIndPtr : outputField.m_indicatorPtr;
+    entry.m_indicatorPtr = outputField.m_indicatorPtr;
+    entry.m_separateIndicator = outputField.m_lenOrIndPtr
+        && outputField.m_indicatorPtr != outputField.m_lenOrIndPtr;
+    m_fetchPlan.push_back(entry);
+  }
+  m_fetchPlanValid = true;
+}
+
+#undef FIXED_WIDTH_CONVERTERS
+
 SQLRETURN SnappyStatement::fillOutputFields() {
+  PerfCounters::Timer timer(m_perfCounters, PerfCounters::CONVERSION_NANOS);
   SQLRETURN result = SQL_SUCCESS, result2 = SQL_SUCCESS;
 
-  const Row* currentRow = m_cursor.get();
+  const Row* currentRow = getCurrentRow();
   if (currentRow) {
+    if (!m_fetchPlanValid) {
+      buildFetchPlan(*currentRow);
+    }
     // now bind the output fields
-    uint32_t columnNum = 1;
-    for (const auto &outputField : m_outputFields) {
-      auto targetValue = outputField.m_targetValue;
-      if (targetValue) {
-        result2 = fillOutput(*currentRow, columnNum, targetValue,
-            outputField.m_valueSize, outputField.m_targetType,
-            DEFAULT_REAL_PRECISION, outputField.m_lenOrIndPtr);
+    for (const auto& entry : m_fetchPlan) {
+      result2 = entry.m_convert(*this, *currentRow, entry.m_columnNum,
+          entry.m_targetValue, entry.m_valueSize, entry.m_ctype,
+          entry.m_lenOrIndPtr);
+      if (entry.m_separateIndicator) {
+        result2 = setSeparateIndicator(*this, entry.m_columnNum, result2,
+            entry.m_lenOrIndPtr, entry.m_indicatorPtr);
       }
       if (result2 != SQL_SUCCESS) result = result2;
-      ++columnNum;
     }
     return result;
   } else {
@@ -1425,9 +2145,16 @@ SQLRETURN SnappyStatement::fillOutputFields() {
   }
 }
 
-#include <iostream>
-
 SQLRETURN SnappyStatement::fillOutputFieldsWithArrays() {
+  if (m_bindingOrientation == SQL_BIND_BY_COLUMN
+      && m_stmtAttrs.getResultSetType() == ResultSetType::FORWARD_ONLY
+      && !m_stmtAttrs.isUpdatable()) {
+    return fillOutputFieldsByColumn();
+  }
+
+  // the fetches from the server by the moves of the cursor within the
+  // rowset are excluded from the conversion time
+  PerfCounters::Timer timer(m_perfCounters, PerfCounters::CONVERSION_NANOS);
   Row* currentRow;
   SQLRETURN result = SQL_SUCCESS;
   SQLULEN bindOffset = 0;
@@ -1439,21 +2166,28 @@ SQLRETURN SnappyStatement::fillOutputFieldsWithArrays() {
 
   do {
     currentRow = m_cursor.get();
+    m_rowTracker.track(currentRow);
+    if (!m_fetchPlanValid) {
+      buildFetchPlan(*currentRow);
+    }
     int32_t position = m_bulkCursor.position();
     if (m_bindingOrientation == SQL_BIND_BY_COLUMN) {
-      uint32_t columnNum = 0;
-      for (const auto& outputField : m_outputFields) {
-        ++columnNum;
-        SQLPOINTER targetValue = outputField.m_targetValue;
-        if (!targetValue) continue;
-        const SQLLEN valueSize = outputField.m_valueSize;
-        targetValue = (((char*)targetValue)
+      for (const auto& entry : m_fetchPlan) {
+        const SQLLEN valueSize = entry.m_valueSize;
+        SQLPOINTER targetValue = (((char*)entry.m_targetValue)
             + (position * valueSize) + bindOffset);
-        SQLLEN* lenOrIndPtr = (SQLLEN*)((char*)(outputField.m_lenOrIndPtr
-            + position) + bindOffset);
+        SQLLEN* lenOrIndPtr = entry.m_lenOrIndPtr
+            ? (SQLLEN*)((char*)(entry.m_lenOrIndPtr + position)
+                + bindOffset) : nullptr;
 
-        result = fillOutput(*currentRow, columnNum, targetValue, valueSize,
-            outputField.m_targetType, DEFAULT_REAL_PRECISION, lenOrIndPtr);
+        result = entry.m_convert(*this, *currentRow, entry.m_columnNum,
+            targetValue, valueSize, entry.m_ctype, lenOrIndPtr);
+        if (entry.m_separateIndicator) {
+          result = setSeparateIndicator(*this, entry.m_columnNum, result,
+              lenOrIndPtr, entry.m_indicatorPtr
+                  ? (SQLLEN*)((char*)(entry.m_indicatorPtr + position)
+                      + bindOffset) : nullptr);
+        }
 
         if (result == SQL_ERROR) {
           break;
@@ -1461,18 +2195,20 @@ SQLRETURN SnappyStatement::fillOutputFieldsWithArrays() {
       }
     } else {/*ROW_WISE_BINDING*/
       const auto structSize = m_bindingOrientation;
-      uint32_t columnNum = 0;
-      for (const auto& outputField : m_outputFields) {
-        ++columnNum;
-        SQLPOINTER targetValue = outputField.m_targetValue;
-        if (!targetValue) continue;
-        targetValue = (((char*)targetValue)
+      for (const auto& entry : m_fetchPlan) {
+        SQLPOINTER targetValue = (((char*)entry.m_targetValue)
             + (position * structSize) + bindOffset);
-        SQLLEN* lenOrIndPtr = (SQLLEN*)(((char*)outputField.m_lenOrIndPtr)
-            + ((position * structSize) + bindOffset));
-        result = fillOutput(*currentRow, columnNum, targetValue,
-            outputField.m_valueSize, outputField.m_targetType,
-            DEFAULT_REAL_PRECISION, lenOrIndPtr);
+        SQLLEN* lenOrIndPtr = entry.m_lenOrIndPtr
+            ? (SQLLEN*)(((char*)entry.m_lenOrIndPtr)
+                + ((position * structSize) + bindOffset)) : nullptr;
+        result = entry.m_convert(*this, *currentRow, entry.m_columnNum,
+            targetValue, entry.m_valueSize, entry.m_ctype, lenOrIndPtr);
+        if (entry.m_separateIndicator) {
+          result = setSeparateIndicator(*this, entry.m_columnNum, result,
+              lenOrIndPtr, entry.m_indicatorPtr
+                  ? (SQLLEN*)(((char*)entry.m_indicatorPtr)
+                      + ((position * structSize) + bindOffset)) : nullptr);
+        }
         if (result == SQL_ERROR) {
           break;
         }
@@ -1485,7 +2221,106 @@ SQLRETURN SnappyStatement::fillOutputFieldsWithArrays() {
     if (m_rowStatusPtr) {
       m_rowStatusPtr[position] = SQL_ROW_SUCCESS;
     }
-  } while (m_bulkCursor.next());
+  } while (bulkCursorNext(&timer));
+  m_rowTracker.flush(m_perfCounters);
+  if (m_fetchedRowsPtr) {
+    *m_fetchedRowsPtr = rowsFetched;
+  }
+  return result == SQL_SUCCESS && rowsFetched == 0 ? SQL_NO_DATA : result;
+}
+
+SQLRETURN SnappyStatement::fillOutputFieldsByColumn() {
+  // Stage all the rows of the rowset. The rows are moved out of the cursor
+  // since those of the previous batch are released by the cursor when it
+  // moves to the next batch from server. This is only done for forward-only
+  // cursors that will never revisit the rows, while the staged rows are
+  // kept for SQLSetPos and SQLGetData till the cursor moves.
+  clearStagedRows();
+  do {
+    Row* currentRow = m_cursor.get();
+    m_rowTracker.track(currentRow);
+    if (!m_fetchPlanValid) {
+      buildFetchPlan(*currentRow);
+    }
+    m_stagedRows.push_back(std::move(*currentRow));
+  } while (bulkCursorNext());
+  m_rowTracker.flush(m_perfCounters);
+
+  // the cursor is positioned on the last row of the rowset
+  m_stagedPosition = m_stagedRows.size() - 1;
+  return fillOutputFieldsFromStagedRows();
+}
+
+SQLRETURN SnappyStatement::fillOutputFieldsFromStagedRows() {
+  PerfCounters::Timer timer(m_perfCounters, PerfCounters::CONVERSION_NANOS);
+  SQLRETURN result = SQL_SUCCESS, result2;
+  SQLULEN bindOffset = 0;
+  if (m_bindOffsetPtr) {
+    bindOffset = *m_bindOffsetPtr;
+  }
+
+  size_t rowsFetched = m_stagedRows.size();
+  if (m_bindingOrientation == SQL_BIND_BY_COLUMN) {
+    for (const auto& entry : m_fetchPlan) {
+      size_t errorRow = 0;
+      result2 = entry.m_convertColumn(*this, m_stagedRows, entry, bindOffset,
+          errorRow);
+      if (entry.m_separateIndicator && result2 != SQL_ERROR) {
+        const SQLLEN* lenOrIndPtr = (const SQLLEN*)(
+            (const char*)entry.m_lenOrIndPtr + bindOffset);
+        SQLLEN* indicatorPtr = entry.m_indicatorPtr ? (SQLLEN*)(
+            (char*)entry.m_indicatorPtr + bindOffset) : nullptr;
+        for (size_t i = 0; i < rowsFetched; i++) {
+          result2 = setSeparateIndicator(*this, entry.m_columnNum, result2,
+              lenOrIndPtr + i, indicatorPtr ? indicatorPtr + i : nullptr);
+          if (result2 == SQL_ERROR) {
+            errorRow = i;
+            break;
+          }
+        }
+      }
+      if (result2 != SQL_SUCCESS) {
+        result = result2;
+        if (result2 == SQL_ERROR) {
+          rowsFetched = errorRow;
+          break;
+        }
+      }
+    }
+  } else {/*ROW_WISE_BINDING*/
+    const auto structSize = m_bindingOrientation;
+    for (size_t position = 0; position < rowsFetched; position++) {
+      const Row& row = m_stagedRows[position];
+      for (const auto& entry : m_fetchPlan) {
+        SQLPOINTER targetValue = (((char*)entry.m_targetValue)
+            + (position * structSize) + bindOffset);
+        SQLLEN* lenOrIndPtr = entry.m_lenOrIndPtr
+            ? (SQLLEN*)(((char*)entry.m_lenOrIndPtr)
+                + ((position * structSize) + bindOffset)) : nullptr;
+        result2 = entry.m_convert(*this, row, entry.m_columnNum,
+            targetValue, entry.m_valueSize, entry.m_ctype, lenOrIndPtr);
+        if (entry.m_separateIndicator) {
+          result2 = setSeparateIndicator(*this, entry.m_columnNum, result2,
+              lenOrIndPtr, entry.m_indicatorPtr
+                  ? (SQLLEN*)(((char*)entry.m_indicatorPtr)
+                      + ((position * structSize) + bindOffset)) : nullptr);
+        }
+        if (result2 != SQL_SUCCESS) {
+          result = result2;
+          if (result2 == SQL_ERROR) break;
+        }
+      }
+      if (result == SQL_ERROR) {
+        rowsFetched = position;
+        break;
+      }
+    }
+  }
+  if (m_rowStatusPtr) {
+    for (size_t i = 0; i < rowsFetched; i++) {
+      m_rowStatusPtr[i] = SQL_ROW_SUCCESS;
+    }
+  }
   if (m_fetchedRowsPtr) {
     *m_fetchedRowsPtr = rowsFetched;
   }
@@ -1887,6 +2722,47 @@ SQLRETURN SnappyStatement::addParameter(SQLUSMALLINT paramNum,
   }
 }
 
+/**
+ * Key for the connection's statement cache that includes the statement
+ * attributes that are sent to the server with the prepare.
+ */
+static std::string getStatementCacheKey(const std::string& sqlText,
+    const StatementAttributes& attrs) {
+  std::string key;
+  key.reserve(sqlText.size() + 32);
+  key.append(std::to_string(static_cast<int>(attrs.getResultSetType())))
+      .append(attrs.isUpdatable() ? ":U:" : ":R:")
+      .append(std::to_string(static_cast<int>(
+          attrs.getResultSetHoldability()))).push_back(':');
+  key.append(std::to_string(attrs.getMaxRows())).push_back(':');
+  key.append(std::to_string(attrs.getMaxFieldSize())).push_back(':');
+  key.append(std::to_string(attrs.getTimeout()))
+      .append(attrs.hasEscapeProcessing() ? ":E\n" : ":N\n");
+  key.append(sqlText);
+  return key;
+}
+
+void SnappyStatement::releasePreparedStatement() {
+  if (m_pstmt) {
+    // cannot cache if a result set is still open on the statement
+    if (!m_pstmtCacheKey.empty() && !m_resultSet) {
+      m_conn.cacheStatement(m_pstmtCacheKey, std::move(m_pstmt));
+    } else {
+      m_pstmt->close();
+    }
+    m_pstmt.reset();
+    invalidateDescriptors();
+  }
+  m_pstmtCacheKey.clear();
+}
+
+void SnappyStatement::prepareOnServer(const std::string& sqlText) {
+  PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+  countRoundTrip(PerfCounters::PREPARES);
+  m_pstmt = m_conn.m_conn->prepareStatement(sqlText, EMPTY_OUTPUT_PARAMS,
+      m_stmtAttrs);
+}
+
 SQLRETURN SnappyStatement::prepare(const std::string& sqlText) {
   clearLastError();
   try {
@@ -1895,8 +2771,25 @@ SQLRETURN SnappyStatement::prepare(const std::string& sqlText) {
     // clear any old parameters
     m_params.clear();
     m_execParams.clear();
-    m_pstmt = m_conn.m_conn.prepareStatement(sqlText, EMPTY_OUTPUT_PARAMS,
-        m_stmtAttrs);
+    invalidateDescriptors();
+    m_preparedDDL = CatalogCache::isDDL(sqlText);
+    if (m_conn.isStatementCacheEnabled()) {
+      std::string key = getStatementCacheKey(sqlText, m_stmtAttrs);
+      if (m_pstmt && key == m_pstmtCacheKey) {
+        // re-prepare of the same statement
+        return SQL_SUCCESS;
+      }
+      releasePreparedStatement();
+      m_pstmt = m_conn.takeCachedStatement(key);
+      m_pstmtCacheKey = std::move(key);
+      if (m_pstmt) {
+        m_perfCounters.add(PerfCounters::STMT_CACHE_HITS, 1);
+        return SQL_SUCCESS;
+      }
+    } else {
+      m_pstmtCacheKey.clear();
+    }
+    prepareOnServer(sqlText);
 
     return handleWarnings(m_pstmt.get());
   } catch (SQLException& sqle) {
@@ -1928,22 +2821,36 @@ SQLRETURN SnappyStatement::executeWithArrayOfParams(
       // clear any old parameters
       m_params.clear();
       m_execParams.clear();
-      m_pstmt = m_conn.m_conn.prepareStatement(sqlText, EMPTY_OUTPUT_PARAMS,
-          m_stmtAttrs);
+      invalidateDescriptors();
+      m_pstmtCacheKey.clear();
+      m_preparedDDL = CatalogCache::isDDL(sqlText);
+      prepareOnServer(sqlText);
     }
 
     ParametersBatch paramsBatch(*m_pstmt);
     paramsBatch.reserve(m_paramSetSize);
-    SQLRETURN result = bindArrayOfParameters(paramsBatch, m_paramSetSize,
-        m_paramBindOffsetPtr, m_paramBindingOrientation, m_paramStatusArr,
-        m_paramsProcessedPtr);
+    std::vector<uint32_t> failedSets;
+    SQLRETURN result;
+    {
+      PerfCounters::Timer timer(m_perfCounters,
+          PerfCounters::CONVERSION_NANOS);
+      result = bindArrayOfParameters(paramsBatch, m_paramSetSize,
+          m_paramBindOffsetPtr, m_paramBindingOrientation, m_paramStatusArr,
+          m_paramsProcessedPtr, failedSets);
+    }
+    if (failedSets.size() == m_paramSetSize) {
+      // nothing to execute
+      return result;
+    }
+    PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+    countRoundTrip(PerfCounters::EXECUTES);
     const auto updateCounts(std::move(m_pstmt->executeBatch(paramsBatch)));
+    if (m_preparedDDL) {
+      m_conn.m_catalogCache.clear();
+    }
     if (m_rowStatusPtr) {
-      const SQLSMALLINT rowStatus = getRowStatus(
-          m_pstmt->getStatementType());
-      for (uint32_t i = 0; i < m_paramSetSize; i++) {
-        m_rowStatusPtr[i] = updateCounts.at(i) > 0 ? rowStatus : SQL_ROW_NOROW;
-      }
+      setBatchRowStatus(m_rowStatusPtr, m_paramSetSize, updateCounts,
+          failedSets, getRowStatus(m_pstmt->getStatementType()));
     }
     return result;
   } catch (SQLException& sqle) {
@@ -1958,7 +2865,7 @@ SQLRETURN SnappyStatement::executeWithArrayOfParams(
 SQLRETURN SnappyStatement::execute(const std::string& sqlText) {
   clearLastError();
   SQLRETURN result = SQL_SUCCESS;
-  if (!m_resultSet) {
+  if (!hasOpenCursor()) {
     try {
       m_result.reset();
       if (m_paramSetSize > 1) {
@@ -1968,20 +2875,39 @@ SQLRETURN SnappyStatement::execute(const std::string& sqlText) {
       const size_t numParams = m_params.size();
       if (numParams > 0) {
         std::map<int32_t, OutputParameter> outParams;
-        result = bindParameters(&outParams);
+        {
+          PerfCounters::Timer timer(m_perfCounters,
+              PerfCounters::CONVERSION_NANOS);
+          result = bindParameters(&outParams);
+        }
         if (result != SQL_SUCCESS && result != SQL_SUCCESS_WITH_INFO) {
           return result;
         }
         // need to prepare too, so use prepareAndExecute
-        m_result = m_conn.m_conn.prepareAndExecute(sqlText, m_execParams,
-            outParams, m_stmtAttrs);
+        {
+          PerfCounters::Timer timer(m_perfCounters,
+              PerfCounters::NETWORK_NANOS);
+          countRoundTrip(PerfCounters::EXECUTES);
+          m_perfCounters.add(PerfCounters::PREPARES, 1);
+          m_result = m_conn.m_conn->prepareAndExecute(sqlText, m_execParams,
+              outParams, m_stmtAttrs);
+        }
+        m_pstmtCacheKey.clear();
         m_pstmt = m_result->getPreparedStatement();
         m_execParams.clear();
       } else {
-        m_result = m_conn.m_conn.execute(sqlText, EMPTY_OUTPUT_PARAMS,
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::NETWORK_NANOS);
+        countRoundTrip(PerfCounters::EXECUTES);
+        m_result = m_conn.m_conn->execute(sqlText, EMPTY_OUTPUT_PARAMS,
             m_stmtAttrs);
+        m_pstmtCacheKey.clear();
         m_pstmt.reset();
       }
+      m_preparedDDL = CatalogCache::isDDL(sqlText);
+      if (m_preparedDDL) {
+        m_conn.m_catalogCache.clear();
+      }
 
       auto rs = m_result->getResultSet();
       setResultSet(rs);
@@ -2007,7 +2933,7 @@ SQLRETURN SnappyStatement::execute(const std::string& sqlText) {
 SQLRETURN SnappyStatement::execute() {
   clearLastError();
   SQLRETURN result = SQL_SUCCESS;
-  if (!m_resultSet) {
+  if (!hasOpenCursor()) {
     try {
       m_result.reset();
       if (!isPrepared()) {
@@ -2021,12 +2947,24 @@ SQLRETURN SnappyStatement::execute() {
         return executeWithArrayOfParams("");
       }
 
-      result = bindParameters(nullptr);
+      {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::CONVERSION_NANOS);
+        result = bindParameters(nullptr);
+      }
       if (result != SQL_SUCCESS && result != SQL_SUCCESS_WITH_INFO) {
         return result;
       }
-      m_result = m_pstmt->execute(m_execParams);
+      {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::NETWORK_NANOS);
+        countRoundTrip(PerfCounters::EXECUTES);
+        m_result = m_pstmt->execute(m_execParams);
+      }
       m_execParams.clear();
+      if (m_preparedDDL) {
+        m_conn.m_catalogCache.clear();
+      }
       auto rs = m_result->getResultSet();
       setResultSet(rs);
       fillOutParameters(*m_result);
@@ -2050,17 +2988,12 @@ SQLRETURN SnappyStatement::bulkOperations(SQLUSMALLINT operation) {
   if (operation == SQL_ADD) {
     try {
       std::string batchQueryString("INSERT INTO ");
-      if (!m_resultSet) {
-        if (!m_pstmt) {
-          setException(GET_SQLEXCEPTION2(
-              SQLStateMessage::STATEMENT_NOT_PREPARED_MSG));
-          return SQL_ERROR;
-        } else {
-          batchQueryString.append(m_pstmt->getColumnDescriptor(1).getTable());
-        }
-      } else {
-        batchQueryString.append(m_resultSet->getColumnDescriptor(1).getTable());
+      if (!m_resultSet && !m_pstmt) {
+        setException(GET_SQLEXCEPTION2(
+            SQLStateMessage::STATEMENT_NOT_PREPARED_MSG));
+        return SQL_ERROR;
       }
+      batchQueryString.append(getResultRecord(1).m_table);
       batchQueryString.append(" VALUES (");
       // TODO: if bind m_targetValue is null then need to bind by column names
       // skipping such fields? (check SQLBulkOperations documentation)
@@ -2071,9 +3004,7 @@ SQLRETURN SnappyStatement::bulkOperations(SQLUSMALLINT operation) {
         } else {
           batchQueryString.append(",?");
         }
-        SQLType sqlType = (!m_resultSet
-            ? m_pstmt->getColumnDescriptor(columnNum).getSQLType()
-            : m_resultSet->getColumnDescriptor(columnNum).getSQLType());
+        const SQLType sqlType = getResultRecord(columnNum).m_sqlType;
         addParameter(columnNum, SQL_PARAM_INPUT, outputField.m_targetType,
             convertSQLTypeToType(sqlType), 0, 0, outputField.m_targetValue,
             outputField.m_valueSize, nullptr /* null-terminated strings */);
@@ -2081,19 +3012,36 @@ SQLRETURN SnappyStatement::bulkOperations(SQLUSMALLINT operation) {
       }
       batchQueryString.push_back(')');
       // need to prepare the statement and bind the parameters
-      auto batchStmt = m_conn.m_conn.prepareStatement(
-          batchQueryString, EMPTY_OUTPUT_PARAMS, m_stmtAttrs);
+      std::unique_ptr<PreparedStatement> batchStmt;
+      {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::NETWORK_NANOS);
+        countRoundTrip(PerfCounters::PREPARES);
+        batchStmt = m_conn.m_conn->prepareStatement(
+            batchQueryString, EMPTY_OUTPUT_PARAMS, m_stmtAttrs);
+      }
       ParametersBatch paramsBatch(*batchStmt);
       SQLULEN paramSetSize = (SQLULEN)m_bulkCursor.batchSize();
       paramsBatch.reserve(paramSetSize);
-      SQLRETURN result = bindArrayOfParameters(paramsBatch, paramSetSize,
-          m_bindOffsetPtr, m_bindingOrientation, m_rowStatusPtr, nullptr);
+      std::vector<uint32_t> failedSets;
+      SQLRETURN result;
+      {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::CONVERSION_NANOS);
+        result = bindArrayOfParameters(paramsBatch, paramSetSize,
+            m_bindOffsetPtr, m_bindingOrientation, m_rowStatusPtr, nullptr,
+            failedSets);
+      }
+      if (failedSets.size() == paramSetSize) {
+        // nothing to execute
+        return result;
+      }
+      PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+      countRoundTrip(PerfCounters::EXECUTES);
       const auto updateCounts(std::move(batchStmt->executeBatch(paramsBatch)));
       if (m_rowStatusPtr) {
-        for (uint32_t i = 0; i < paramSetSize; i++) {
-          m_rowStatusPtr[i] =
-              updateCounts.at(i) > 0 ? SQL_ROW_ADDED : SQL_ROW_NOROW;
-        }
+        setBatchRowStatus(m_rowStatusPtr, paramSetSize, updateCounts,
+            failedSets, SQL_ROW_ADDED);
       }
       return result;
     } catch (SQLException& sqle) {
@@ -2118,7 +3066,9 @@ SQLRETURN SnappyStatement::bindOutputField(SQLUSMALLINT columnNum,
     SQLLEN *lenOrIndPtr) {
   clearLastError();
   uint32_t numColumns;
-  if (m_resultSet) {
+  if (m_catalogResult) {
+    numColumns = static_cast<uint32_t>(m_catalogResult->m_records.size());
+  } else if (m_resultSet) {
     numColumns = m_resultSet->getColumnCount();
   /* (doesn't work for routed queries in current snappy master)
   } else if (isPrepared()) {
@@ -2136,6 +3086,7 @@ SQLRETURN SnappyStatement::bindOutputField(SQLUSMALLINT columnNum,
     }
     m_outputFields[columnNum - 1].set(targetType, targetValue, valueSize,
         lenOrIndPtr);
+    invalidateFetchPlan();
     return SQL_SUCCESS;
   } else {
     setException(
@@ -2148,6 +3099,7 @@ SQLRETURN SnappyStatement::bindOutputField(SQLUSMALLINT columnNum,
 SQLRETURN SnappyStatement::setPos(SQLSETPOSIROW rowNum,
     SQLUSMALLINT operation, SQLUSMALLINT lockType) {
   clearLastError();
+  m_getData.reset();
   // TODO: need to verify other lock types
   if (lockType != SQL_LOCK_NO_CHANGE || rowNum < 0 ||
       rowNum >= std::numeric_limits<int32_t>::max()) {
@@ -2165,6 +3117,49 @@ SQLRETURN SnappyStatement::setPos(SQLSETPOSIROW rowNum,
   }
   const int32_t rowNumber = static_cast<int32_t>(rowNum);
   try {
+    if (m_prefetcher) {
+      // the ResultPrefetcher owns the cursor so the rowset is only held
+      // in memory; such rows are never updated, deleted or inserted
+      const size_t numRows = m_stagedRows.empty()
+          ? (m_prefetcher->get() ? 1 : 0) : m_stagedRows.size();
+      if (operation != SQL_POSITION && operation != SQL_REFRESH) {
+        setException(GET_SQLEXCEPTION2(
+            SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, operation,
+            "operation type in setPos for a read-only cursor"));
+        return SQL_ERROR;
+      }
+      if (static_cast<size_t>(rowNumber) > numRows ||
+          (rowNumber == 0 && operation == SQL_POSITION) || numRows == 0) {
+        setException(GET_SQLEXCEPTION2(
+            SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, rowNum,
+            "ROW NUMBER"));
+        return SQL_ERROR;
+      }
+      if (rowNumber > 0 && !m_stagedRows.empty()) {
+        m_stagedPosition = static_cast<size_t>(rowNumber - 1);
+      }
+      if (operation == SQL_POSITION) {
+        return SQL_SUCCESS;
+      }
+      // refresh the bound buffers from the rows in memory
+      return m_stagedRows.empty() ? fillOutputFields()
+          : fillOutputFieldsFromStagedRows();
+    }
+    if (hasOpenCursor() && !m_stagedRows.empty()) {
+      // the rows of a forward-only rowset are only held by m_stagedRows
+      if (operation == SQL_POSITION) {
+        if (rowNumber < 1 || static_cast<size_t>(rowNumber) >
+            m_stagedRows.size()) {
+          setException(GET_SQLEXCEPTION2(
+              SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG, rowNum,
+              "ROW NUMBER"));
+          return SQL_ERROR;
+        }
+        m_stagedPosition = static_cast<size_t>(rowNumber - 1);
+        return SQL_SUCCESS;
+      }
+      clearStagedRows();
+    }
     if (m_resultSet) {
       SQLRETURN result = SQL_SUCCESS, result2;
       switch (operation) {
@@ -2251,56 +3246,74 @@ SQLRETURN SnappyStatement::setPos(SQLSETPOSIROW rowNum,
 SQLRETURN SnappyStatement::fetchScroll(SQLSMALLINT fetchOrientation,
     SQLLEN offset) {
   clearLastError();
+  m_getData.reset();
+  clearStagedRows();
 
   int32_t fetchOffset = StringFunctions::restrictLength<int32_t, SQLLEN>(
       offset);
   try {
-    if (m_resultSet) {
+    if (hasOpenCursor()) {
       SQLRETURN result = SQL_SUCCESS, result2;
       bool bRetVal = false;
-      switch (fetchOrientation) {
-        case SQL_FETCH_NEXT:
-          bRetVal = m_cursor.next();
-          break;
-        case SQL_FETCH_PRIOR:
-          bRetVal = m_cursor.previous();
-          break;
-        case SQL_FETCH_RELATIVE:
-          m_cursor += fetchOffset;
-          bRetVal = m_cursor.isOnRow();
-          break;
-        case SQL_FETCH_ABSOLUTE: {
-          const bool beforeFirst = fetchOffset == 0;
-          if (fetchOffset > 0) {
-            fetchOffset--;
-          }
-          m_cursor = m_resultSet->begin(fetchOffset);
-          if (beforeFirst) {
+      if (m_catalogResult && fetchOrientation != SQL_FETCH_NEXT) {
+        // rows of a catalog result held in memory are only returned forward
+        setException(
+            GET_SQLEXCEPTION2(SQLStateMessage::FEATURE_NOT_IMPLEMENTED_MSG1,
+                "scrolling of a catalog result in fetchScroll"));
+        return SQL_ERROR;
+      }
+      if (fetchOrientation == SQL_FETCH_NEXT &&
+          (m_prefetcher || usesReadAhead())) {
+        return next();
+      }
+      {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::NETWORK_NANOS);
+        switch (fetchOrientation) {
+          case SQL_FETCH_NEXT:
+            bRetVal = m_cursor.next();
+            break;
+          case SQL_FETCH_PRIOR:
             bRetVal = m_cursor.previous();
-          } else {
+            break;
+          case SQL_FETCH_RELATIVE:
+            m_cursor += fetchOffset;
             bRetVal = m_cursor.isOnRow();
+            break;
+          case SQL_FETCH_ABSOLUTE: {
+            const bool beforeFirst = fetchOffset == 0;
+            if (fetchOffset > 0) {
+              fetchOffset--;
+            }
+            m_cursor = m_resultSet->begin(fetchOffset);
+            if (beforeFirst) {
+              bRetVal = m_cursor.previous();
+            } else {
+              bRetVal = m_cursor.isOnRow();
+            }
+            break;
           }
-          break;
+          case SQL_FETCH_FIRST:
+            m_cursor = m_resultSet->begin();
+            bRetVal = m_cursor.isOnRow();
+            break;
+          case SQL_FETCH_LAST:
+            m_cursor = m_resultSet->begin(-1);
+            bRetVal = m_cursor.isOnRow();
+            break;
+          case SQL_FETCH_BOOKMARK:
+          default:
+            // not supported fetch orientation
+            setException(
+                GET_SQLEXCEPTION2(SQLStateMessage::FEATURE_NOT_IMPLEMENTED_MSG1,
+                    "SQL_FETCH_BOOKMARK in fetchScroll"));
+            return SQL_ERROR;
         }
-        case SQL_FETCH_FIRST:
-          m_cursor = m_resultSet->begin();
-          bRetVal = m_cursor.isOnRow();
-          break;
-        case SQL_FETCH_LAST:
-          m_cursor = m_resultSet->begin(-1);
-          bRetVal = m_cursor.isOnRow();
-          break;
-        case SQL_FETCH_BOOKMARK:
-        default:
-          // not supported fetch orientation
-          setException(
-              GET_SQLEXCEPTION2(SQLStateMessage::FEATURE_NOT_IMPLEMENTED_MSG1,
-                  "SQL_FETCH_BOOKMARK in fetchScroll"));
-          return SQL_ERROR;
       }
       if (bRetVal) {
         if (m_bulkCursor.batchSize() <= 1) {
           setRowStatus();
+          trackCurrentRow();
           // now bind the output fields
           result = fillOutputFields();
         } else {
@@ -2331,16 +3344,21 @@ SQLRETURN SnappyStatement::fetchScroll(SQLSMALLINT fetchOrientation,
 
 SQLRETURN SnappyStatement::next() {
   clearLastError();
+  m_getData.reset();
+  clearStagedRows();
   try {
-    if (!m_resultSet) {
+    if (!hasOpenCursor()) {
       // no open cursor
       setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG2));
       return SQL_ERROR;
-    } else if (m_cursor.next()) {
+    } else if (m_prefetcher || usesReadAhead()) {
+      return nextPrefetched();
+    } else if (cursorNext()) {
       SQLRETURN result = SQL_SUCCESS, r;
       if (m_bulkCursor.batchSize() <= 1) {
         setRowStatus();
+        trackCurrentRow();
         // now bind the output fields
         result = fillOutputFields();
       } else {
@@ -2351,7 +3369,7 @@ SQLRETURN SnappyStatement::next() {
       return result == SQL_SUCCESS ? r : result;
     }
   } catch (SQLException& sqle) {
-    if (sqle.getReason() != SQLStateMessage::NO_CURRENT_ROW_MSG.format()) {
+    if (!isEndOfCursor(sqle)) {
       setException(sqle);
       return SQL_ERROR;
     }
@@ -2362,6 +3380,100 @@ SQLRETURN SnappyStatement::next() {
   return SQL_NO_DATA;
 }
 
+bool SnappyStatement::usesReadAhead() const noexcept {
+  return m_readAheadRows > 0 && m_asyncEnable == SQL_ASYNC_ENABLE_OFF
+      && m_resultSet
+      && m_stmtAttrs.getResultSetType() == ResultSetType::FORWARD_ONLY
+      && !m_stmtAttrs.isUpdatable();
+}
+
+void SnappyStatement::stopReadAhead() noexcept {
+  // rows of a catalog result held in memory are dropped only with the cursor
+  if (m_prefetcher && !m_catalogResult) {
+    // waits for any read in progress in the background
+    m_prefetcher.reset();
+  }
+}
+
+bool SnappyStatement::keepsCursor(const SQLUSMALLINT functionId) noexcept {
+  switch (functionId) {
+    case SQL_API_SQLFETCH:
+    case SQL_API_SQLFETCHSCROLL:
+    case SQL_API_SQLGETDATA:
+    case SQL_API_SQLSETPOS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool SnappyStatement::needsConnectionLock(
+    const SQLUSMALLINT functionId) const noexcept {
+  switch (functionId) {
+    case SQL_API_SQLFETCH:
+    case SQL_API_SQLFETCHSCROLL:
+      // the read-ahead of this statement itself serializes on the lock
+      // while the rows of catalog results are already in memory
+      return !m_prefetcher && !usesReadAhead();
+    case SQL_API_SQLGETDATA:
+      // values like LOBs may be read in chunks from the server
+      return !m_catalogResult;
+    case SQL_API_SQLSETPOS:
+      // rows read ahead are positioned in memory
+      return !m_prefetcher;
+    default:
+      return true;
+  }
+}
+
+void SnappyStatement::releaseCatalogResult() noexcept {
+  if (m_catalogResult) {
+    m_prefetcher.reset();
+    m_catalogResult.reset();
+  }
+}
+
+SQLRETURN SnappyStatement::nextPrefetched() {
+  if (!m_prefetcher) {
+    m_prefetcher.reset(new ResultPrefetcher(m_cursor,
+        static_cast<size_t>(m_readAheadRows), m_conn.m_execLock,
+        m_perfCounters));
+  }
+  // includes the time spent waiting for the rows being read ahead
+  Row* currentRow = prefetchedNext();
+  if (!currentRow) {
+    if (m_fetchedRowsPtr) {
+      *m_fetchedRowsPtr = 0;
+    }
+    return SQL_NO_DATA;
+  }
+  const uint32_t batchSize = m_bulkCursor.batchSize();
+  if (batchSize <= 1) {
+    // rows read ahead are never updated, deleted or inserted
+    if (m_fetchedRowsPtr) {
+      *m_fetchedRowsPtr = 1;
+    }
+    if (m_rowStatusPtr) {
+      *m_rowStatusPtr = SQL_ROW_SUCCESS;
+    }
+    return fillOutputFields();
+  }
+
+  // stage the rows of the rowset moving them out of the prefetcher
+  // like in fillOutputFieldsByColumn
+  if (!m_fetchPlanValid) {
+    buildFetchPlan(*currentRow);
+  }
+  clearStagedRows();
+  do {
+    m_stagedRows.push_back(std::move(*currentRow));
+  } while (m_stagedRows.size() < batchSize
+      && (currentRow = prefetchedNext()) != nullptr);
+  // the staged rows are kept for SQLSetPos and SQLGetData
+  m_stagedPosition = m_stagedRows.size() - 1;
+  return fillOutputFieldsFromStagedRows();
+}
+
 SQLRETURN SnappyStatement::getUpdateCount(SQLLEN *count, bool updateError) {
   if (updateError) clearLastError();
   // TODO: also handle for UPDATE/DELETE in SQLSetPos
@@ -2379,18 +3491,156 @@ SQLRETURN SnappyStatement::getUpdateCount(SQLLEN *count, bool updateError) {
   }
 }
 
+SQLRETURN SnappyStatement::fillOutputPiece(const Row& outputRow,
+    const SQLUSMALLINT columnNum, SQLPOINTER value, const SQLLEN valueSize,
+    const SQLSMALLINT ctype, SQLLEN* lenOrIndp) {
+  GetDataState& state = m_getData;
+  if (state.m_columnNum != columnNum || state.m_ctype != ctype) {
+    // first call for the column so get the full value; character columns
+    // are read directly from the Row storage while others are converted
+    // once and held in the state for the subsequent calls
+    state.reset();
+    state.m_columnNum = columnNum;
+    state.m_ctype = ctype;
+    const char* strData;
+    size_t strLen;
+    std::unique_ptr<std::string> outStr;
+    char scratch[TextConversions::MAX_FORMAT_LEN];
+    bool isNull;
+    if (ctype == SQL_C_BINARY) {
+      outStr = outputRow.getBinary(columnNum);
+      isNull = !outStr;
+      if (!isNull) {
+        state.m_buffer.swap(*outStr);
+      }
+    } else if (!(isNull = !getStringView(outputRow, columnNum,
+        DEFAULT_REAL_PRECISION, outStr, scratch, strData, strLen))) {
+      if (ctype == SQL_C_WCHAR) {
+        // convert the whole value once, leaving space for null terminator
+        state.m_buffer.resize((strLen + 1) * sizeof(SQLWCHAR));
+        SQLLEN wlen = 0;
+        StringFunctions::copyString((const SQLCHAR*)strData, strLen,
+            (SQLWCHAR*)&state.m_buffer[0], strLen + 1, &wlen);
+        state.m_buffer.resize(wlen * sizeof(SQLWCHAR));
+      } else if (outStr) {
+        state.m_buffer.swap(*outStr);
+      } else if (strData == scratch) {
+        state.m_buffer.assign(strData, strLen);
+      } else {
+        state.m_data = strData;
+        state.m_length = strLen;
+      }
+    }
+    if (isNull) {
+      if (!lenOrIndp) {
+        state.reset();
+        return errorIndicatorRequired(*this, columnNum);
+      }
+      state.m_offset = 1; // next call should return SQL_NO_DATA
+      *lenOrIndp = SQL_NULL_DATA;
+      return SQL_SUCCESS;
+    }
+    if (!state.m_data) {
+      state.m_data = state.m_buffer.data();
+      state.m_length = state.m_buffer.size();
+    }
+  } else if (state.m_offset >= state.m_length) {
+    // all of the value has been returned by previous calls
+    return SQL_NO_DATA;
+  }
+
+  const size_t remaining = state.m_length - state.m_offset;
+  const char* data = state.m_data + state.m_offset;
+  size_t copyLen;
+  switch (ctype) {
+    case SQL_C_CHAR:
+      copyLen = valueSize > 0 ? std::min(remaining,
+          static_cast<size_t>(valueSize - 1)) : 0;
+      if (valueSize > 0) {
+        ::memcpy(value, data, copyLen);
+        ((char*)value)[copyLen] = '\0';
+      }
+      break;
+    case SQL_C_WCHAR: {
+      const size_t maxUnits = valueSize >= (SQLLEN)sizeof(SQLWCHAR)
+          ? static_cast<size_t>(valueSize) / sizeof(SQLWCHAR) - 1 : 0;
+      size_t units = std::min(remaining / sizeof(SQLWCHAR), maxUnits);
+      // don't split a surrogate pair across the pieces
+      if (units > 0 && units < remaining / sizeof(SQLWCHAR)) {
+        const SQLWCHAR last = ((const SQLWCHAR*)data)[units - 1];
+        if (last >= 0xD800 && last <= 0xDBFF) units--;
+      }
+      copyLen = units * sizeof(SQLWCHAR);
+      if (valueSize >= (SQLLEN)sizeof(SQLWCHAR)) {
+        ::memcpy(value, data, copyLen);
+        ((SQLWCHAR*)value)[units] = 0;
+      }
+      break;
+    }
+    default: // SQL_C_BINARY
+      copyLen = valueSize > 0 ? std::min(remaining,
+          static_cast<size_t>(valueSize)) : 0;
+      ::memcpy(value, data, copyLen);
+      break;
+  }
+  // the length is that of the data remaining before this call
+  if (lenOrIndp) {
+    *lenOrIndp = static_cast<SQLLEN>(remaining);
+  }
+  // an empty value is returned once by the first call
+  state.m_offset += (copyLen > 0 ? copyLen : (remaining == 0 ? 1 : 0));
+  if (copyLen < remaining) {
+    setException(GET_SQLEXCEPTION2(SQLStateMessage::STRING_TRUNCATED_MSG,
+        "output column", valueSize));
+    return SQL_SUCCESS_WITH_INFO;
+  } else {
+    return SQL_SUCCESS;
+  }
+}
+
 SQLRETURN SnappyStatement::getData(SQLUSMALLINT columnNum,
     SQLSMALLINT targetType, SQLPOINTER targetValue, SQLLEN valueSize,
     SQLLEN *lenOrIndPtr) {
   clearLastError();
   try {
-    if (m_cursor.isOnRow()) {
+    if (isOnRow()) {
       if (targetValue) {
-        const Row* currentRow = m_cursor.get();
-        const SQLRETURN result = fillOutput(*currentRow, columnNum,
-            targetValue, valueSize, targetType,
-            DEFAULT_REAL_PRECISION, lenOrIndPtr);
-        const SQLRETURN ret = handleWarnings(m_resultSet.get());
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::CONVERSION_NANOS);
+        const Row* currentRow = getCurrentRow();
+        if (targetType == SQL_C_DEFAULT) {
+          targetType = convertSQLTypeToCType(
+              currentRow->getType(columnNum));
+        }
+        SQLRETURN result;
+        switch (targetType) {
+          case SQL_C_CHAR:
+          case SQL_C_WCHAR:
+          case SQL_C_BINARY:
+            result = fillOutputPiece(*currentRow, columnNum, targetValue,
+                valueSize, targetType, lenOrIndPtr);
+            break;
+          default:
+            // fixed size values are returned only by the first call
+            if (m_getData.m_columnNum == columnNum
+                && m_getData.m_ctype == targetType) {
+              return SQL_NO_DATA;
+            }
+            m_getData.reset();
+            result = fillOutput(*currentRow, columnNum, targetValue,
+                valueSize, targetType, DEFAULT_REAL_PRECISION, lenOrIndPtr);
+            if (result != SQL_ERROR) {
+              m_getData.m_columnNum = columnNum;
+              m_getData.m_ctype = targetType;
+            }
+            break;
+        }
+        if (result == SQL_NO_DATA) {
+          return result;
+        }
+        // the cached catalog results never have warnings
+        const SQLRETURN ret = m_catalogResult ? SQL_SUCCESS
+            : handleWarnings(m_resultSet.get());
         return result == SQL_SUCCESS ? ret : result;
       }
     } else {
@@ -2418,22 +3668,34 @@ SQLRETURN SnappyStatement::getAttributeT(SQLINTEGER attribute,
   try {
     switch (attribute) {
       case SQL_ATTR_APP_ROW_DESC:
-        if (valueBuffer) *(SQLPOINTER*)valueBuffer = m_ardDesc.get();
+        if (valueBuffer) {
+          *(SQLPOINTER*)valueBuffer = getDescriptor(m_ardDesc,
+              SQL_ATTR_APP_ROW_DESC);
+        }
         if (valueLen) *valueLen = sizeof(SnappyDescriptor);
         break;
 
       case SQL_ATTR_IMP_ROW_DESC:
-        if (valueBuffer) *(SQLPOINTER*)valueBuffer = m_irdDesc.get();
+        if (valueBuffer) {
+          *(SQLPOINTER*)valueBuffer = getDescriptor(m_irdDesc,
+              SQL_ATTR_IMP_ROW_DESC);
+        }
         if (valueLen) *valueLen = sizeof(SnappyDescriptor);
         break;
 
       case SQL_ATTR_APP_PARAM_DESC:
-        if (valueBuffer) *(SQLPOINTER*)valueBuffer = m_apdDesc.get();
+        if (valueBuffer) {
+          *(SQLPOINTER*)valueBuffer = getDescriptor(m_apdDesc,
+              SQL_ATTR_APP_PARAM_DESC);
+        }
         if (valueLen) *valueLen = sizeof(SnappyDescriptor);
         break;
 
       case SQL_ATTR_IMP_PARAM_DESC:
-        if (valueBuffer) *(SQLPOINTER*)valueBuffer = m_ipdDesc.get();
+        if (valueBuffer) {
+          *(SQLPOINTER*)valueBuffer = getDescriptor(m_ipdDesc,
+              SQL_ATTR_IMP_PARAM_DESC);
+        }
         if (valueLen) *valueLen = sizeof(SnappyDescriptor);
         break;
 
@@ -2589,11 +3851,48 @@ SQLRETURN SnappyStatement::getAttributeT(SQLINTEGER attribute,
         if (valueLen) *valueLen = sizeof(m_rowOperationPtr);
         break;
 
-      // TODO: Need to implement below attribs
       case SQL_ATTR_ASYNC_ENABLE:
-        getIntValue(SQL_ASYNC_ENABLE_OFF, valueBuffer, valueLen, true);
+        getIntValue(m_asyncEnable, valueBuffer, valueLen, true);
+        break;
+
+      case SQL_ATTR_READ_AHEAD_ROWS:
+        getIntValue(m_readAheadRows, valueBuffer, valueLen, true);
+        break;
+
+      case SQL_ATTR_PERF_ROUND_TRIPS:
+      case SQL_ATTR_PERF_ROWS_FETCHED:
+      case SQL_ATTR_PERF_BATCHES_FETCHED:
+      case SQL_ATTR_PERF_PREPARES:
+      case SQL_ATTR_PERF_EXECUTES:
+      case SQL_ATTR_PERF_NETWORK_NANOS:
+      case SQL_ATTR_PERF_CONVERSION_NANOS:
+      case SQL_ATTR_STMT_CACHE_HITS:
+        if (valueBuffer) {
+          *((SQLUBIGINT*)valueBuffer) = m_perfCounters.get(
+              PerfCounters::forAttribute(attribute));
+        }
+        if (valueLen) *valueLen = sizeof(SQLUBIGINT);
+        break;
+
+      case SQL_ATTR_ASYNC_STMT_EVENT:
+        if (valueBuffer) *(SQLPOINTER*)valueBuffer = m_asyncEvent;
+        if (valueLen) *valueLen = sizeof(m_asyncEvent);
+        break;
+
+      case SQL_ATTR_ASYNC_STMT_PCALLBACK:
+        if (valueBuffer) {
+          *(SQLPOINTER*)valueBuffer = (SQLPOINTER)m_asyncCallback;
+        }
+        if (valueLen) *valueLen = sizeof(SQLPOINTER);
+        break;
+
+      case SQL_ATTR_ASYNC_STMT_PCONTEXT:
+        if (valueBuffer) *(SQLPOINTER*)valueBuffer = m_asyncContext;
+        if (valueLen) *valueLen = sizeof(m_asyncContext);
         break;
 
+      // TODO: Need to implement below attribs
+
       case SQL_ATTR_RETRIEVE_DATA:
         getIntValue(SQL_RD_ON, valueBuffer, valueLen, true);
         break;
@@ -2896,11 +4195,45 @@ SQLRETURN SnappyStatement::setAttributeT(SQLINTEGER attribute,
                 "SQL_ATTR_APP_ROW_DESC"));
         ret = SQL_ERROR;
         break;
-      case SQL_ATTR_ASYNC_ENABLE:
-        setException(
-            GET_SQLEXCEPTION2(SQLStateMessage::FEATURE_NOT_IMPLEMENTED_MSG1,
-                "SQL_ATTR_ASYNC_ENABLE"));
-        ret = SQL_ERROR;
+      case SQL_ATTR_ASYNC_ENABLE: {
+        const SQLULEN intValue = (SQLULEN)valueBuffer;
+        if (intValue != SQL_ASYNC_ENABLE_OFF &&
+            intValue != SQL_ASYNC_ENABLE_ON) {
+          setException(GET_SQLEXCEPTION2(
+              SQLStateMessage::INVALID_ATTRIBUTE_VALUE_MSG,
+              intValue, "SQL_ATTR_ASYNC_ENABLE"));
+          ret = SQL_ERROR;
+        } else if (m_asyncTask) {
+          setException(GET_SQLEXCEPTION2(
+              SQLStateMessage::FUNCTION_SEQUENCE_ERROR_MSG,
+              "SQL_ATTR_ASYNC_ENABLE changed while a function is executing"));
+          ret = SQL_ERROR;
+        } else if (m_prefetcher && !m_catalogResult &&
+            intValue != SQL_ASYNC_ENABLE_OFF) {
+          // rows already read ahead cannot be handed back to the cursor
+          setException(GET_SQLEXCEPTION2(
+              SQLStateMessage::FUNCTION_SEQUENCE_ERROR_MSG,
+              "SQL_ATTR_ASYNC_ENABLE changed while the cursor reads ahead"));
+          ret = SQL_ERROR;
+        } else {
+          m_asyncEnable = intValue;
+        }
+        break;
+      }
+      // the event is signalled by the driver manager when it is notified
+      // by the callback, so only needs to be remembered here
+      case SQL_ATTR_ASYNC_STMT_EVENT:
+        m_asyncEvent = valueBuffer;
+        break;
+      case SQL_ATTR_ASYNC_STMT_PCALLBACK:
+        m_asyncCallback = (AsyncNotificationCallback)valueBuffer;
+        break;
+      case SQL_ATTR_ASYNC_STMT_PCONTEXT:
+        m_asyncContext = valueBuffer;
+        break;
+      // takes effect from the next cursor opened on the statement
+      case SQL_ATTR_READ_AHEAD_ROWS:
+        m_readAheadRows = (SQLULEN)valueBuffer;
         break;
       case SQL_ATTR_RETRIEVE_DATA:
         setException(
@@ -2926,21 +4259,117 @@ SQLRETURN SnappyStatement::setAttributeT(SQLINTEGER attribute,
   return ret;
 }
 
-const ColumnDescriptor SnappyStatement::getColumnDescriptor(
-    SQLUSMALLINT columnNumber, uint32_t* columnCount) const {
-  if (m_resultSet) {
-    if (columnCount) {
-      *columnCount = m_resultSet->getColumnCount();
+template<typename SOURCE>
+void SnappyStatement::snapshotColumns(SOURCE& source,
+    std::vector<DescriptorRecord>& records) {
+  const uint32_t columnCount = source.getColumnCount();
+  records.clear();
+  records.resize(columnCount);
+  for (uint32_t columnNum = 1; columnNum <= columnCount; columnNum++) {
+    const ColumnDescriptor descriptor = source.getColumnDescriptor(columnNum);
+    DescriptorRecord& record = records[columnNum - 1];
+
+    record.m_name = descriptor.getName();
+    record.m_label = descriptor.getLabel();
+    record.m_schema = descriptor.getSchema();
+    record.m_table = descriptor.getTable();
+    record.m_typeName = descriptor.getTypeName();
+    record.m_sqlType = descriptor.getSQLType();
+    record.m_precision = descriptor.getPrecision();
+    record.m_scale = descriptor.getScale();
+    record.m_displaySize = descriptor.getDisplaySize();
+    record.m_nullable = convertNullability(descriptor.getNullability());
+    switch (descriptor.getUpdatable()) {
+      case ColumnUpdatable::READ_ONLY:
+        record.m_updatable = SQL_ATTR_READONLY;
+        break;
+      case ColumnUpdatable::UPDATABLE:
+        record.m_updatable = SQL_DESC_UPDATABLE;
+        break;
+      case ColumnUpdatable::DEFINITELY_UPDATABLE:
+        record.m_updatable = SQL_ATTR_WRITE;
+        break;
+      default:
+        record.m_updatable = SQL_ATTR_READWRITE_UNKNOWN;
+        break;
     }
-    return m_resultSet->getColumnDescriptor(columnNumber);
-  } else if (isPrepared()) {
-    if (columnCount) {
-      *columnCount = m_pstmt->getColumnCount();
+    record.m_autoIncrement = descriptor.isAutoIncrement();
+    record.m_caseSensitive = descriptor.isCaseSensitive();
+    record.m_signed = descriptor.isSigned();
+  }
+}
+
+std::vector<DescriptorRecord>& SnappyStatement::getResultRecords() {
+  std::vector<DescriptorRecord>& records = m_resultRecords;
+  if (!m_resultRecordsValid) {
+    if (m_resultSet) {
+      snapshotColumns(*m_resultSet, records);
+    } else if (isPrepared()) {
+      snapshotColumns(*m_pstmt, records);
+    } else {
+      // no open cursor
+      throw GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG2);
+    }
+    m_resultRecordsValid = true;
+  }
+  return records;
+}
+
+const DescriptorRecord& SnappyStatement::getResultRecord(
+    SQLUSMALLINT columnNumber, uint32_t* columnCount) {
+  const std::vector<DescriptorRecord>& records = getResultRecords();
+  const size_t numColumns = records.size();
+  if (columnCount) {
+    *columnCount = static_cast<uint32_t>(numColumns);
+  }
+  if (columnNumber > 0 && columnNumber <= numColumns) {
+    return records[columnNumber - 1];
+  } else {
+    throw GET_SQLEXCEPTION2(SQLStateMessage::COLUMN_NOT_FOUND_MSG1,
+        columnNumber, static_cast<int>(numColumns));
+  }
+}
+
+std::vector<DescriptorRecord>& SnappyStatement::getParamRecords() {
+  std::vector<DescriptorRecord>& records = m_paramRecords;
+  if (!m_paramRecordsValid) {
+    if (!isPrepared()) {
+      throw GET_SQLEXCEPTION2(SQLStateMessage::FUNCTION_SEQUENCE_ERROR_MSG,
+          "statement not prepared for parameter descriptor");
+    }
+    const uint32_t numParams = m_pstmt->getParameterCount();
+    records.clear();
+    records.resize(numParams);
+    for (uint32_t paramNum = 1; paramNum <= numParams; paramNum++) {
+      auto pmd = m_pstmt->getParameterDescriptor(paramNum);
+      DescriptorRecord& record = records[paramNum - 1];
+      record.m_sqlType = pmd.getSQLType();
+      record.m_precision = pmd.getPrecision();
+      record.m_scale = pmd.getScale();
+      record.m_displaySize = 0;
+      record.m_nullable = convertNullability(pmd.getNullability());
+      record.m_updatable = SQL_ATTR_READWRITE_UNKNOWN;
+      record.m_autoIncrement = false;
+      record.m_caseSensitive = false;
+      record.m_signed = true;
     }
-    return m_pstmt->getColumnDescriptor(columnNumber);
+    m_paramRecordsValid = true;
+  }
+  return records;
+}
+
+const DescriptorRecord& SnappyStatement::getParamRecord(
+    SQLUSMALLINT paramNumber, uint32_t* paramCount) {
+  const std::vector<DescriptorRecord>& records = getParamRecords();
+  const size_t numParams = records.size();
+  if (paramCount) {
+    *paramCount = static_cast<uint32_t>(numParams);
+  }
+  if (paramNumber > 0 && paramNumber <= numParams) {
+    return records[paramNumber - 1];
   } else {
-    // no open cursor
-    throw GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG2);
+    throw GET_SQLEXCEPTION2(SQLStateMessage::COLUMN_NOT_FOUND_MSG1,
+        paramNumber, static_cast<int>(numParams));
   }
 }
 
@@ -2953,11 +4382,11 @@ SQLRETURN SnappyStatement::getResultColumnDescriptorT(
   // TODO: handle SQL_ATTR_USE_BOOKMARKS below for columnNumber == 0
   try {
     SQLRETURN result = SQL_SUCCESS;
-    const ColumnDescriptor descriptor = getColumnDescriptor(columnNumber);
+    const DescriptorRecord& record = getResultRecord(columnNumber);
 
     if (columnName) {
       if (bufferLength >= 0) {
-        const std::string& colName = descriptor.getName();
+        const std::string& colName = record.m_name;
         const size_t sz = colName.size();
         SQLLEN nameLen;
         if (sz > 0) {
@@ -2984,17 +4413,17 @@ SQLRETURN SnappyStatement::getResultColumnDescriptorT(
       }
     }
     if (dataType) {
-      *dataType = convertSQLTypeToType(descriptor.getSQLType(),
+      *dataType = convertSQLTypeToType(record.m_sqlType,
           sizeof(CHAR_TYPE) == 1);
     }
     if (columnSize) {
-      *columnSize = descriptor.getDisplaySize();
+      *columnSize = record.m_displaySize;
     }
     if (decimalDigits) {
-      *decimalDigits = descriptor.getPrecision();
+      *decimalDigits = record.m_precision;
     }
     if (nullable) {
-      *nullable = convertNullability(descriptor.getNullability());
+      *nullable = record.m_nullable;
     }
     return result;
   } catch (SQLException& sqle) {
@@ -3014,9 +4443,14 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
   // TODO: handle SQL_ATTR_USE_BOOKMARKS below for columnNumber == 0
   try {
     SQLRETURN result = SQL_SUCCESS;
-    uint32_t columnCount;
-    const ColumnDescriptor descriptor = getColumnDescriptor(columnNumber,
-        &columnCount);
+    if (fieldId == SQL_DESC_COUNT || fieldId == SQL_COLUMN_COUNT) {
+      // column number is ignored for the count
+      if (numericAttribute) {
+        *numericAttribute = static_cast<SQLLEN>(getResultRecords().size());
+      }
+      return SQL_SUCCESS;
+    }
+    const DescriptorRecord& record = getResultRecord(columnNumber);
 
     const char* descType = nullptr;
     std::string stringAttribute;
@@ -3025,32 +4459,32 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
       case SQL_DESC_AUTO_UNIQUE_VALUE:
         if (numericAttribute) {
           *numericAttribute =
-              descriptor.isAutoIncrement() ? SQL_TRUE : SQL_FALSE;
+              record.m_autoIncrement ? SQL_TRUE : SQL_FALSE;
         }
         break;
       case SQL_DESC_BASE_COLUMN_NAME:
         if (charAttribute) {
           descType = "Column Name";
-          stringAttribute = descriptor.getName();
+          stringAttribute = record.m_name;
         }
         break;
       case SQL_DESC_NAME:
       case SQL_COLUMN_NAME:
         if (charAttribute) {
           descType = "Column Name or Alias";
-          stringAttribute = descriptor.getName();
+          stringAttribute = record.m_name;
         }
         break;
       case SQL_DESC_BASE_TABLE_NAME:
         if (charAttribute) {
           descType = "Table Name";
-          stringAttribute = descriptor.getTable();
+          stringAttribute = record.m_table;
         }
         break;
       case SQL_DESC_CASE_SENSITIVE:
         if (numericAttribute) {
           *numericAttribute =
-              descriptor.isCaseSensitive() ? SQL_TRUE : SQL_FALSE;
+              record.m_caseSensitive ? SQL_TRUE : SQL_FALSE;
         }
         break;
       case SQL_DESC_CATALOG_NAME:
@@ -3061,27 +4495,21 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
         break;
       case SQL_DESC_CONCISE_TYPE:
         if (numericAttribute) {
-          *numericAttribute = convertSQLTypeToType(descriptor.getSQLType(),
+          *numericAttribute = convertSQLTypeToType(record.m_sqlType,
               sizeOfChar == 1);
         }
         break;
-      case SQL_DESC_COUNT:
-      case SQL_COLUMN_COUNT:
-        if (numericAttribute) {
-          *numericAttribute = columnCount;
-        }
-        break;
       case SQL_DESC_DISPLAY_SIZE:
         if (numericAttribute) {
-          *numericAttribute = descriptor.getDisplaySize();
+          *numericAttribute = record.m_displaySize;
         }
         break;
       case SQL_DESC_FIXED_PREC_SCALE:
         if (numericAttribute) {
-          switch (descriptor.getSQLType()) {
+          switch (record.m_sqlType) {
             case SQLType::DECIMAL:
               *numericAttribute =
-                  descriptor.getScale() > 0 ? SQL_TRUE : SQL_FALSE;
+                  record.m_scale > 0 ? SQL_TRUE : SQL_FALSE;
               break;
             default:
               *numericAttribute = SQL_FALSE;
@@ -3092,7 +4520,7 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
       case SQL_DESC_LABEL:
         if (charAttribute) {
           descType = "Column Label";
-          stringAttribute = descriptor.getLabel();
+          stringAttribute = record.m_label;
         }
         break;
       case SQL_DESC_LENGTH:
@@ -3100,7 +4528,7 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
       case SQL_COLUMN_LENGTH:
       case SQL_COLUMN_PRECISION:
         if (numericAttribute) {
-          *numericAttribute = descriptor.getPrecision();
+          *numericAttribute = record.m_precision;
         }
         break;
       case SQL_DESC_LITERAL_PREFIX:
@@ -3111,7 +4539,7 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
           if (!descType) {
             descType = "Literal Suffix";
           }
-          switch (descriptor.getSQLType()) {
+          switch (record.m_sqlType) {
             case SQLType::CHAR:
             case SQLType::VARCHAR:
             case SQLType::LONGVARCHAR:
@@ -3150,24 +4578,24 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
       case SQL_DESC_LOCAL_TYPE_NAME:
         if (charAttribute) {
           descType = "Column Local Type Name";
-          stringAttribute = descriptor.getTypeName();
+          stringAttribute = record.m_typeName;
         }
         break;
       case SQL_DESC_TYPE_NAME:
         if (charAttribute) {
           descType = "Column Type Name";
-          stringAttribute = descriptor.getTypeName();
+          stringAttribute = record.m_typeName;
         }
         break;
       case SQL_DESC_NULLABLE:
       case SQL_COLUMN_NULLABLE:
         if (numericAttribute) {
-          *numericAttribute = convertNullability(descriptor.getNullability());
+          *numericAttribute = record.m_nullable;
         }
         break;
       case SQL_DESC_NUM_PREC_RADIX:
         if (numericAttribute) {
-          switch (descriptor.getSQLType()) {
+          switch (record.m_sqlType) {
             case SQLType::BIGINT:
             case SQLType::BOOLEAN:
             case SQLType::DATE:
@@ -3191,8 +4619,8 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
         break;
       case SQL_DESC_OCTET_LENGTH:
         if (numericAttribute) {
-          SQLLEN precision = descriptor.getPrecision();
-          switch (descriptor.getSQLType()) {
+          SQLLEN precision = record.m_precision;
+          switch (record.m_sqlType) {
             case SQLType::CHAR:
             case SQLType::VARCHAR:
             case SQLType::LONGVARCHAR:
@@ -3211,24 +4639,24 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
       case SQL_DESC_SCALE:
       case SQL_COLUMN_SCALE:
         if (numericAttribute) {
-          *numericAttribute = descriptor.getScale();
+          *numericAttribute = record.m_scale;
         }
         break;
       case SQL_DESC_SCHEMA_NAME:
         if (charAttribute) {
           descType = "Schema Name";
-          stringAttribute = descriptor.getSchema();
+          stringAttribute = record.m_schema;
         }
         break;
       case SQL_DESC_TABLE_NAME:
         if (charAttribute) {
           descType = "Table Name";
-          stringAttribute = descriptor.getTable();
+          stringAttribute = record.m_table;
         }
         break;
       case SQL_DESC_TYPE: {
         if (numericAttribute) {
-          const auto sqlType = descriptor.getSQLType();
+          const auto sqlType = record.m_sqlType;
           switch (sqlType) {
             case SQLType::DATE:
             case SQLType::TIME:
@@ -3245,7 +4673,7 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
       }
       case SQL_DESC_SEARCHABLE:
         if (numericAttribute) {
-          switch (descriptor.getSQLType()) {
+          switch (record.m_sqlType) {
             case SQLType::CHAR:
             case SQLType::VARCHAR:
             case SQLType::LONGVARCHAR:
@@ -3267,32 +4695,18 @@ SQLRETURN SnappyStatement::getColumnAttributeT(SQLUSMALLINT columnNumber,
         break;
       case SQL_DESC_UNNAMED:
         if (numericAttribute) {
-          const auto columnName = descriptor.getName();
-          *numericAttribute = columnName.size() > 0 ? SQL_NAMED
+          *numericAttribute = record.m_name.size() > 0 ? SQL_NAMED
               : SQL_UNNAMED;
         }
         break;
       case SQL_DESC_UNSIGNED:
         if (numericAttribute) {
-          *numericAttribute = descriptor.isSigned() ? SQL_FALSE : SQL_TRUE;
+          *numericAttribute = record.m_signed ? SQL_FALSE : SQL_TRUE;
         }
         break;
       case SQL_DESC_UPDATABLE:
         if (numericAttribute) {
-          switch (descriptor.getUpdatable()) {
-            case ColumnUpdatable::READ_ONLY:
-              *numericAttribute = SQL_ATTR_READONLY;
-              break;
-            case ColumnUpdatable::UPDATABLE:
-              *numericAttribute = SQL_DESC_UPDATABLE;
-              break;
-            case ColumnUpdatable::DEFINITELY_UPDATABLE:
-              *numericAttribute = SQL_ATTR_WRITE;
-              break;
-            default:
-              *numericAttribute = SQL_ATTR_READWRITE_UNKNOWN;
-              break;
-          }
+          *numericAttribute = record.m_updatable;
         }
         break;
       default:
@@ -3356,8 +4770,10 @@ SQLRETURN SnappyStatement::getCursorNameT(CHAR_TYPE* cursorName,
   try {
     if (cursorName) {
       if (bufferLength >= 0) {
-        std::string rcursorName =
-            m_resultSet ? m_resultSet->getCursorName() : "";
+        std::string rcursorName;
+        if (m_resultSet && !m_catalogResult) {
+          rcursorName = m_resultSet->getCursorName();
+        }
         const auto rsize = rcursorName.size();
         if (rsize > 0) {
           SQLLEN nameLen;
@@ -3420,12 +4836,94 @@ SQLRETURN SnappyStatement::setCursorNameT(CHAR_TYPE* cursorName,
   return result;
 }
 
+std::shared_ptr<const CatalogResult> SnappyStatement::readCatalogResult(
+    std::shared_ptr<ResultSet>& rs) {
+  std::shared_ptr<CatalogResult> result(new CatalogResult());
+  snapshotColumns(*rs, result->m_records);
+  ResultSet::iterator iter;
+  iter.initialize(*rs, true);
+  PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+  PerfCounters::RowTracker rowTracker;
+  try {
+    while (iter.next()) {
+      rowTracker.track(iter.get());
+      result->m_rows.push_back(std::move(*iter.get()));
+    }
+    rowTracker.flush(m_perfCounters);
+  } catch (SQLException& sqle) {
+    rowTracker.flush(m_perfCounters);
+    // end of the cursor is also signalled by this exception
+    if (!isEndOfCursor(sqle)) {
+      throw;
+    }
+  }
+  iter.clear();
+  rs->close(false);
+  rs.reset();
+  return result;
+}
+
+void SnappyStatement::setCatalogResult(
+    const std::shared_ptr<const CatalogResult>& result) {
+  releaseCatalogResult();
+  stopReadAhead();
+  m_getData.reset();
+  clearStagedRows();
+  invalidateFetchPlan();
+  invalidateDescriptors();
+  // the rows are returned by a ResultPrefetcher from a copy held by this
+  // statement while m_catalogResult marks the open cursor
+  m_resultSet = nullptr;
+  m_cursor.clear();
+  m_resultRecords = result->m_records;
+  m_resultRecordsValid = true;
+  std::vector<Row> rows(result->m_rows);
+  m_prefetcher.reset(new ResultPrefetcher(std::move(rows), m_cursor,
+      m_conn.m_execLock));
+  m_catalogResult = result;
+}
+
+template<typename TFetch>
+SQLRETURN SnappyStatement::setCatalogResultSet(const CatalogCache::Key& key,
+    TFetch&& fetch) {
+  CatalogCache& cache = m_conn.m_catalogCache;
+  std::shared_ptr<const CatalogResult> result;
+  auto fetchFromServer = [&]() -> decltype(fetch()) {
+    PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+    m_perfCounters.add(PerfCounters::ROUND_TRIPS, 1);
+    return fetch();
+  };
+  if (cache.isEnabled() && isCatalogResultCacheable()) {
+    result = cache.get(key);
+    if (!result) {
+      std::shared_ptr<ResultSet> rs(fetchFromServer());
+      // results with warnings are returned as usual and never cached
+      if (rs && !rs->hasWarnings()) {
+        result = readCatalogResult(rs);
+        cache.put(key, result);
+      } else {
+        setResultSet(rs);
+      }
+    }
+  } else {
+    auto rs = fetchFromServer();
+    setResultSet(rs);
+  }
+  m_pstmt.reset();
+  if (result) {
+    setCatalogResult(result);
+    return SQL_SUCCESS;
+  } else {
+    return handleWarnings(m_resultSet.get());
+  }
+}
+
 template<typename CHAR_TYPE>
 SQLRETURN SnappyStatement::getTablesT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2,
     CHAR_TYPE* tableTypes, SQLSMALLINT nameLength3) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3443,8 +4941,8 @@ SQLRETURN SnappyStatement::getTablesT(CHAR_TYPE* schemaName,
     if (tableName) {
       args.setTable(StringFunctions::toString(tableName, nameLength2));
     }
+    std::vector<std::string> stableTypes;
     if (tableTypes) {
-      std::vector<std::string> stableTypes;
       const int allTypesLen = sizeof(SQL_ALL_TABLE_TYPES) - 1;
       // check for "%" pattern for all types that corresponds to nullptr
       // in JDBC
@@ -3463,11 +4961,17 @@ SQLRETURN SnappyStatement::getTablesT(CHAR_TYPE* schemaName,
       }
       args.setTableTypes(stableTypes);
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::TABLES, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("TABLES");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2);
+    if (tableTypes) {
+      key.add(stableTypes);
+    } else {
+      key.add(nullptr);
+    }
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::TABLES, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3481,7 +4985,7 @@ template<typename CHAR_TYPE>
 SQLRETURN SnappyStatement::getTablePrivilegesT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3499,11 +5003,12 @@ SQLRETURN SnappyStatement::getTablePrivilegesT(CHAR_TYPE* schemaName,
     if (tableName) {
       args.setTable(StringFunctions::toString(tableName, nameLength2));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::TABLEPRIVILEGES, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("TABLEPRIVILEGES");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::TABLEPRIVILEGES, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3518,7 +5023,7 @@ SQLRETURN SnappyStatement::getColumnsT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2,
     CHAR_TYPE* columnName, SQLSMALLINT nameLength3) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3539,11 +5044,13 @@ SQLRETURN SnappyStatement::getColumnsT(CHAR_TYPE* schemaName,
     if (columnName) {
       args.setColumnName(StringFunctions::toString(columnName, nameLength3));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::COLUMNS, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("COLUMNS");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2)
+        .add(columnName, nameLength3);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::COLUMNS, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3558,7 +5065,7 @@ SQLRETURN SnappyStatement::getSpecialColumnsT(SQLUSMALLINT idType,
     CHAR_TYPE *schemaName, SQLSMALLINT nameLength1, CHAR_TYPE *tableName,
     SQLSMALLINT nameLength2, SQLUSMALLINT scope, SQLUSMALLINT nullable) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3577,13 +5084,20 @@ SQLRETURN SnappyStatement::getSpecialColumnsT(SQLUSMALLINT idType,
       args.setTable(StringFunctions::toString(tableName, nameLength2));
     }
     if (idType == SQL_BEST_ROWID) {
-      auto rs = m_conn.m_conn.getBestRowIdentifier(args, scope,
-          nullable != SQL_NO_NULLS);
-      setResultSet(rs);
+      CatalogCache::Key key("BESTROWIDENTIFIER");
+      key.add(schemaName, nameLength1).add(tableName, nameLength2)
+          .add(scope).add(nullable != SQL_NO_NULLS);
+      return setCatalogResultSet(key, [&]() {
+        return m_conn.m_conn->getBestRowIdentifier(args, scope,
+            nullable != SQL_NO_NULLS);
+      });
     } else if (idType == SQL_ROWVER) {
-      auto rs = m_conn.m_conn.getSchemaMetaData(
-          DatabaseMetaDataCall::VERSIONCOLUMNS, args);
-      setResultSet(rs);
+      CatalogCache::Key key("VERSIONCOLUMNS");
+      key.add(schemaName, nameLength1).add(tableName, nameLength2);
+      return setCatalogResultSet(key, [&]() {
+        return m_conn.m_conn->getSchemaMetaData(
+            DatabaseMetaDataCall::VERSIONCOLUMNS, args);
+      });
     }
     m_pstmt.reset();
     return handleWarnings(m_resultSet.get());
@@ -3601,7 +5115,7 @@ SQLRETURN SnappyStatement::getColumnPrivilegesT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2,
     CHAR_TYPE* columnName, SQLSMALLINT nameLength3) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3622,11 +5136,13 @@ SQLRETURN SnappyStatement::getColumnPrivilegesT(CHAR_TYPE* schemaName,
     if (columnName) {
       args.setColumnName(StringFunctions::toString(columnName, nameLength3));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::COLUMNPRIVILEGES, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("COLUMNPRIVILEGES");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2)
+        .add(columnName, nameLength3);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::COLUMNPRIVILEGES, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3641,7 +5157,7 @@ SQLRETURN SnappyStatement::getIndexInfoT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2,
     bool unique, bool approximate) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3659,10 +5175,12 @@ SQLRETURN SnappyStatement::getIndexInfoT(CHAR_TYPE* schemaName,
     if (tableName) {
       args.setTable(StringFunctions::toString(tableName, nameLength2));
     }
-    auto rs = m_conn.m_conn.getIndexInfo(args, unique, approximate);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("INDEXINFO");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2)
+        .add(unique).add(approximate);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getIndexInfo(args, unique, approximate);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3676,7 +5194,7 @@ template<typename CHAR_TYPE>
 SQLRETURN SnappyStatement::getPrimaryKeysT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3694,11 +5212,12 @@ SQLRETURN SnappyStatement::getPrimaryKeysT(CHAR_TYPE* schemaName,
     if (tableName) {
       args.setTable(StringFunctions::toString(tableName, nameLength2));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::PRIMARYKEYS, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("PRIMARYKEYS");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::PRIMARYKEYS, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3712,7 +5231,7 @@ template<typename CHAR_TYPE>
 SQLRETURN SnappyStatement::getImportedKeysT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3730,11 +5249,12 @@ SQLRETURN SnappyStatement::getImportedKeysT(CHAR_TYPE* schemaName,
     if (tableName) {
       args.setTable(StringFunctions::toString(tableName, nameLength2));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::IMPORTEDKEYS, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("IMPORTEDKEYS");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::IMPORTEDKEYS, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3748,7 +5268,7 @@ template<typename CHAR_TYPE>
 SQLRETURN SnappyStatement::getExportedKeysT(CHAR_TYPE* schemaName,
     SQLSMALLINT nameLength1, CHAR_TYPE* tableName, SQLSMALLINT nameLength2) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3766,11 +5286,12 @@ SQLRETURN SnappyStatement::getExportedKeysT(CHAR_TYPE* schemaName,
     if (tableName) {
       args.setTable(StringFunctions::toString(tableName, nameLength2));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::EXPORTEDKEYS, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("EXPORTEDKEYS");
+    key.add(schemaName, nameLength1).add(tableName, nameLength2);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::EXPORTEDKEYS, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3787,7 +5308,7 @@ SQLRETURN SnappyStatement::getCrossReferenceT(CHAR_TYPE* parentSchemaName,
     SQLSMALLINT nameLength3, CHAR_TYPE* foreignTableName,
     SQLSMALLINT nameLength4) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3815,11 +5336,15 @@ SQLRETURN SnappyStatement::getCrossReferenceT(CHAR_TYPE* parentSchemaName,
       args.setForeignTable(
           StringFunctions::toString(foreignTableName, nameLength4));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::CROSSREFERENCE, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("CROSSREFERENCE");
+    key.add(parentSchemaName, nameLength1)
+        .add(parentTableName, nameLength2)
+        .add(foreignSchemaName, nameLength3)
+        .add(foreignTableName, nameLength4);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::CROSSREFERENCE, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3834,7 +5359,7 @@ SQLRETURN SnappyStatement::getProceduresT(CHAR_TYPE* schemaPattern,
     SQLSMALLINT nameLength1, CHAR_TYPE* procedureNamePattern,
     SQLSMALLINT nameLength2) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3853,11 +5378,13 @@ SQLRETURN SnappyStatement::getProceduresT(CHAR_TYPE* schemaPattern,
       args.setProcedureName(
           StringFunctions::toString(procedureNamePattern, nameLength2));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::PROCEDURES, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("PROCEDURES");
+    key.add(schemaPattern, nameLength1)
+        .add(procedureNamePattern, nameLength2);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::PROCEDURES, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3873,7 +5400,7 @@ SQLRETURN SnappyStatement::getProcedureColumnsT(CHAR_TYPE* schemaPattern,
     SQLSMALLINT nameLength2, CHAR_TYPE* columnNamePattern,
     SQLSMALLINT nameLength3) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3896,11 +5423,14 @@ SQLRETURN SnappyStatement::getProcedureColumnsT(CHAR_TYPE* schemaPattern,
       args.setColumnName(
           StringFunctions::toString(columnNamePattern, nameLength3));
     }
-    auto rs = m_conn.m_conn.getSchemaMetaData(
-        DatabaseMetaDataCall::PROCEDURECOLUMNS, args);
-    setResultSet(rs);
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("PROCEDURECOLUMNS");
+    key.add(schemaPattern, nameLength1)
+        .add(procedureNamePattern, nameLength2)
+        .add(columnNamePattern, nameLength3);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::PROCEDURECOLUMNS, args);
+    });
   } catch (SQLException &sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -3913,7 +5443,7 @@ SQLRETURN SnappyStatement::getProcedureColumnsT(CHAR_TYPE* schemaPattern,
 template<typename CHAR_TYPE>
 SQLRETURN SnappyStatement::getTypeInfoT(SQLSMALLINT dataType) {
   clearLastError();
-  if (m_resultSet) {
+  if (hasOpenCursor()) {
     // old cursor still open
     setException(
         GET_SQLEXCEPTION2(SQLStateMessage::INVALID_CURSOR_STATE_MSG1));
@@ -3924,18 +5454,15 @@ SQLRETURN SnappyStatement::getTypeInfoT(SQLSMALLINT dataType) {
     m_params.clear();
     m_execParams.clear();
 
-    if (dataType == SQL_ALL_TYPES) {
-      auto rs = m_conn.m_conn.getSchemaMetaData(
-          DatabaseMetaDataCall::TYPEINFO, args);
-      setResultSet(rs);
-    } else {
-      auto rs = m_conn.m_conn.getSchemaMetaData(
-          DatabaseMetaDataCall::TYPEINFO,
-          args.setType(convertTypeToSQLType(dataType, 1)));
-      setResultSet(rs);
+    if (dataType != SQL_ALL_TYPES) {
+      args.setType(convertTypeToSQLType(dataType, 1));
     }
-    m_pstmt.reset();
-    return handleWarnings(m_resultSet.get());
+    CatalogCache::Key key("TYPEINFO");
+    key.add(dataType);
+    return setCatalogResultSet(key, [&]() {
+      return m_conn.m_conn->getSchemaMetaData(
+          DatabaseMetaDataCall::TYPEINFO, args);
+    });
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -4000,20 +5527,13 @@ SQLRETURN SnappyStatement::getParamMetadata(SQLUSMALLINT paramNumber,
     SQLSMALLINT* decimalDigitsPtr, SQLSMALLINT* nullablePtr) {
   clearLastError();
   try {
-    if (isPrepared()) {
-      auto pmd = m_pstmt->getParameterDescriptor(paramNumber);
-      *paramDataTypePtr = convertSQLTypeToType(pmd.getSQLType());
-      *paramSizePtr = pmd.getPrecision();
-      *decimalDigitsPtr = pmd.getScale();
-      *nullablePtr = convertNullability(pmd.getNullability());
-      return SQL_SUCCESS;
-    } else {
-      // statement not prepared
-      setException(
-          GET_SQLEXCEPTION2(SQLStateMessage::FUNCTION_SEQUENCE_ERROR_MSG,
-              "statement not prepared for parameter descriptor"));
-      return SQL_ERROR;
-    }
+    // throws FUNCTION_SEQUENCE_ERROR if the statement is not prepared
+    const DescriptorRecord& record = getParamRecord(paramNumber);
+    *paramDataTypePtr = convertSQLTypeToType(record.m_sqlType);
+    *paramSizePtr = record.m_precision;
+    *decimalDigitsPtr = record.m_scale;
+    *nullablePtr = record.m_nullable;
+    return SQL_SUCCESS;
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -4026,7 +5546,13 @@ SQLRETURN SnappyStatement::getParamMetadata(SQLUSMALLINT paramNumber,
 SQLRETURN SnappyStatement::getNumResultColumns(SQLSMALLINT* columnCount) {
   clearLastError();
   try {
-    if (m_resultSet) {
+    if (m_catalogResult) {
+      if (columnCount) {
+        *columnCount = static_cast<SQLSMALLINT>(
+            m_catalogResult->m_records.size());
+      }
+      return SQL_SUCCESS;
+    } else if (m_resultSet) {
       if (columnCount) {
         *columnCount = m_resultSet->getColumnCount();
       }
@@ -4272,16 +5798,32 @@ SQLRETURN SnappyStatement::getMoreResults() {
   clearLastError();
 
   try {
+    stopReadAhead();
     if (isPrepared()) {
-      auto rs = m_pstmt->getNextResults();
+      std::shared_ptr<ResultSet> rs;
+      {
+        PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+        rs = m_pstmt->getNextResults();
+        m_perfCounters.add(PerfCounters::ROUND_TRIPS, 1);
+      }
       setResultSet(rs);
       if (m_resultSet && m_resultSet->isOpen()) {
         return handleWarnings(m_resultSet.get());
       } else {
         return SQL_NO_DATA;
       }
+    } else if (m_catalogResult) {
+      // a catalog result has no more results
+      std::shared_ptr<ResultSet> rs;
+      setResultSet(rs);
+      return SQL_NO_DATA;
     } else if (m_resultSet) {
-      auto rs = m_resultSet->getNextResults();
+      std::shared_ptr<ResultSet> rs;
+      {
+        PerfCounters::Timer timer(m_perfCounters, PerfCounters::NETWORK_NANOS);
+        rs = m_resultSet->getNextResults();
+        m_perfCounters.add(PerfCounters::ROUND_TRIPS, 1);
+      }
       setResultSet(rs);
       if (m_resultSet && m_resultSet->isOpen()) {
         return handleWarnings(m_resultSet.get());
@@ -4300,15 +5842,38 @@ SQLRETURN SnappyStatement::getMoreResults() {
   }
 }
 
+void SnappyStatement::flushPutData() {
+  if (m_putData) {
+    std::unique_ptr<PutDataBuffer> putData(std::move(m_putData));
+    Parameter& param = m_params[m_currentParameterIndex];
+    std::string value;
+    putData->moveTo(value);
+    putData.reset();
+    if (param.m_o_valueType == SQL_C_BINARY) {
+      m_execParams.setBinary(param.m_paramNum, (const int8_t*)value.data(),
+          value.size());
+      param.m_paramType = SQLType::VARBINARY;
+    } else {
+      m_execParams.setString(param.m_paramNum, std::move(value));
+      param.m_paramType = SQLType::VARCHAR;
+    }
+  }
+}
+
 // TODO: do we need to check the statement type
 SQLRETURN SnappyStatement::getParamData(SQLPOINTER* valuePtr) {
   clearLastError();
   const size_t totalParamCount = m_params.size();
   try {
+    // the value of previous parameter is complete
+    flushPutData();
     for (size_t i = m_currentParameterIndex; i < totalParamCount; i++) {
       Parameter& param = m_params[i];
       if (param.m_isDataAtExecParam || IS_DATA_AT_EXEC(param.m_o_lenOrIndp)) {
-        valuePtr = &param.m_o_value;
+        // return the application's token for the parameter
+        if (valuePtr) {
+          *valuePtr = param.m_o_value;
+        }
         m_currentParameterIndex = i;
         param.m_o_value = nullptr;
         param.m_o_valueSize = 0;
@@ -4343,6 +5908,34 @@ SQLRETURN SnappyStatement::putData(SQLPOINTER dataPtr, SQLLEN dataLength) {
     if (dataPtr && dataLength == SQL_NULL_DATA) {
       dataPtr = nullptr;
     }
+    // character and binary values are accumulated in PutDataBuffer and
+    // set in the parameter only once complete
+    const SQLSMALLINT ctype = currentParam.m_o_valueType;
+    if (dataPtr && (dataLength >= 0 || dataLength == SQL_NTS) && (
+        ctype == SQL_C_CHAR || ctype == SQL_C_WCHAR || ctype == SQL_C_BINARY)) {
+      if (!m_putData) {
+        m_putData.reset(new PutDataBuffer(m_conn.m_putDataSpillSize));
+      }
+      if (ctype == SQL_C_WCHAR) {
+        const SQLWCHAR* chars = (const SQLWCHAR*)dataPtr;
+        m_putData->appendWide(chars, dataLength == SQL_NTS
+            ? StringFunctions::strlen(chars)
+            : static_cast<size_t>(dataLength) / sizeof(SQLWCHAR));
+      } else {
+        m_putData->append(dataPtr, dataLength == SQL_NTS
+            ? ::strlen((const char*)dataPtr)
+            : static_cast<size_t>(dataLength));
+      }
+      currentParam.m_isBound = true;
+      return SQL_SUCCESS;
+    }
+    if (!dataPtr && m_putData) {
+      // a null value cannot follow the pieces sent for the parameter
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::CONCATENATE_NULL_VALUE_MSG));
+      return SQL_ERROR;
+    }
+    m_putData.reset();
     currentParam.m_o_value = dataPtr;
     // temporarily point m_o_lenOrIndp to dataLength and use RAII to revert
     struct SwitchLenOrIndp {
@@ -4371,10 +5964,20 @@ SQLRETURN SnappyStatement::putData(SQLPOINTER dataPtr, SQLLEN dataLength) {
 SQLRETURN SnappyStatement::closeResultSet(bool ifPresent) {
   clearLastError();
   try {
-    if (m_resultSet) {
-      m_resultSet->close(false);
+    if (hasOpenCursor()) {
+      stopReadAhead();
+      m_getData.reset();
+      clearStagedRows();
+      if (m_catalogResult) {
+        // the result is shared by other statements and has no ResultSet
+        releaseCatalogResult();
+      } else {
+        m_resultSet->close(false);
+      }
       m_resultSet = nullptr;
       m_cursor.clear();
+      invalidateFetchPlan();
+      m_resultRecordsValid = false;
     } else if (!ifPresent) {
       // no open cursor
       setException(
@@ -4395,14 +5998,130 @@ SQLRETURN SnappyStatement::resetParameters() {
   clearLastError();
   m_params.clear();
   m_execParams.clear();
+  m_putData.reset();
   return SQL_SUCCESS;
 }
 
-SQLRETURN SnappyStatement::cancel() {
+void SnappyStatement::AsyncTask::complete(const SQLRETURN result) {
+  {
+    std::lock_guard<std::mutex> sync(m_lock);
+    m_result = result;
+    m_done.store(true, std::memory_order_release);
+  }
+  m_doneCond.notify_all();
+}
+
+void SnappyStatement::AsyncTask::await() {
+  std::unique_lock<std::mutex> sync(m_lock);
+  while (!m_done.load(std::memory_order_acquire)) {
+    m_doneCond.wait(sync);
+  }
+}
+
+SQLRETURN SnappyStatement::executeAsync(const SQLUSMALLINT functionId,
+    std::function<SQLRETURN()>&& op) {
+  if (m_asyncTask) {
+    // poll for the result of the operation in progress
+    const AsyncTask& task = *m_asyncTask;
+    if (task.m_functionId != functionId) {
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::FUNCTION_SEQUENCE_ERROR_MSG,
+          "another asynchronous function is still executing"));
+      return SQL_ERROR;
+    }
+    if (!task.m_done.load(std::memory_order_acquire)) {
+      return SQL_STILL_EXECUTING;
+    }
+    std::shared_ptr<AsyncTask> done(std::move(m_asyncTask));
+    // an operation canceled before it started, or that failed after a
+    // cancel was requested, reports HY008 as required by SQLCancel
+    if (task.m_state.load(std::memory_order_acquire) ==
+        AsyncTask::CANCELED || (task.m_result == SQL_ERROR &&
+            task.m_cancelRequested.load(std::memory_order_acquire))) {
+      setException(GET_SQLEXCEPTION2(
+          SQLStateMessage::OPERATION_CANCELED_MSG));
+      return SQL_ERROR;
+    }
+    setDiagRecords(task.m_diagnostics);
+    return task.m_result;
+  }
+
   clearLastError();
+  std::shared_ptr<AsyncTask> task = std::make_shared<AsyncTask>(functionId);
+  // operations on a connection are serialized by the lock
+  std::recursive_mutex& execLock = m_conn.m_execLock;
+  const AsyncNotificationCallback callback = m_asyncCallback;
+  const SQLPOINTER context = m_asyncContext;
+  SnappyStatement* const stmt = this;
+  m_asyncTask = task;
+  try {
+    AsyncExecutor::instance().submit(
+        [task, op, callback, context, stmt, &execLock]() {
+      SQLRETURN result = SQL_ERROR;
+      int state = AsyncTask::QUEUED;
+      if (task->m_state.compare_exchange_strong(state, AsyncTask::RUNNING)) {
+        std::lock_guard<std::recursive_mutex> sync(execLock);
+        // the application may read the diagnostics of the statement while
+        // polling, so keep these aside till it polls the final result
+        DeferredDiagnostics diagnostics(stmt);
+        try {
+          result = op();
+        } catch (...) {
+          // the operations record their own errors in the handle
+          result = SQL_ERROR;
+        }
+        task->m_diagnostics = diagnostics.records();
+      }
+      task->complete(result);
+      if (callback) {
+        callback(context, TRUE);
+      }
+    });
+  } catch (std::exception& se) {
+    m_asyncTask.reset();
+    setException(__FILE__, __LINE__, se);
+    return SQL_ERROR;
+  }
+  return SQL_STILL_EXECUTING;
+}
+
+void SnappyStatement::awaitAsync() noexcept {
+  std::shared_ptr<AsyncTask> task(std::move(m_asyncTask));
+  if (task) {
+    int state = AsyncTask::QUEUED;
+    if (!task->m_state.compare_exchange_strong(state, AsyncTask::CANCELED)
+        && !task->m_done.load(std::memory_order_acquire)) {
+      try {
+        m_conn.m_conn->cancelCurrentStatement();
+      } catch (std::exception&) {
+        // ignore failure and wait for the operation to end
+      }
+    }
+    task->await();
+  }
+}
+
+SQLRETURN SnappyStatement::cancel() {
+  const std::shared_ptr<AsyncTask> task = m_asyncTask;
+  if (task && !task->m_done.load(std::memory_order_acquire)) {
+    // skip the operation if it has not started yet else cancel it below
+    // without clearing the diagnostics that belong to the running operation
+    int state = AsyncTask::QUEUED;
+    if (task->m_state.compare_exchange_strong(state, AsyncTask::CANCELED)) {
+      return SQL_SUCCESS;
+    }
+    task->m_cancelRequested.store(true, std::memory_order_release);
+  } else {
+    clearLastError();
+    // cancels data-at-execution processing, if any
+    m_putData.reset();
+  }
   try {
     if (isPrepared()) {
       if (m_pstmt->cancel()) return SQL_SUCCESS;
+    } else if (m_catalogResult) {
+      // nothing executing on the server
+      return SQL_SUCCESS;
     } else if (m_resultSet) {
       if (m_resultSet->cancelStatement()) return SQL_SUCCESS;
     } else {
@@ -4424,18 +6143,24 @@ SQLRETURN SnappyStatement::cancel() {
 SQLRETURN SnappyStatement::close() noexcept {
   clearLastError();
   try {
-    if (m_resultSet) {
-      m_resultSet->close(!isPrepared());
+    if (hasOpenCursor()) {
+      stopReadAhead();
+      m_getData.reset();
+      clearStagedRows();
+      if (m_catalogResult) {
+        releaseCatalogResult();
+      } else {
+        m_resultSet->close(!isPrepared());
+      }
       m_resultSet = nullptr;
     }
-    if (isPrepared()) {
-      m_pstmt->close();
-      m_pstmt.reset();
-    }
+    releasePreparedStatement();
     m_result.reset();
     m_params.clear();
     m_execParams.clear();
     m_outputFields.clear();
+    m_fetchPlan.clear();
+    invalidateFetchPlan();
   } catch (SQLException& sqle) {
     setException(sqle);
     return SQL_ERROR;
@@ -49,6 +49,12 @@
 #include "StringFunctions.h"
 #include "SnappyDescriptor.h"
 #include "BatchRowIterator.h"
+#include "ParameterArena.h"
+#include "PutDataBuffer.h"
+#include "ResultPrefetcher.h"
+
+#include <condition_variable>
+#include <functional>
 
 namespace io {
 namespace snappydata {
@@ -104,6 +110,18 @@ namespace snappydata {
     /** the underlying native prepared statement */
     std::unique_ptr<PreparedStatement> m_pstmt;
 
+    /**
+     * the key in the connection's statement cache when m_pstmt has been
+     * created by {@link #prepare}, else empty
+     */
+    std::string m_pstmtCacheKey;
+
+    /** the performance counters that also count for the connection */
+    PerfCounters m_perfCounters;
+
+    /** counts the rows and batches read from m_cursor */
+    PerfCounters::RowTracker m_rowTracker;
+
     /** attributes for this statement */
     StatementAttributes m_stmtAttrs;
 
@@ -122,7 +140,10 @@ namespace snappydata {
       SQLSMALLINT m_o_scale;
       SQLPOINTER m_o_value { nullptr };
       SQLLEN m_o_valueSize { 0 };
+      /** the length buffer (SQL_DESC_OCTET_LENGTH_PTR) */
       SQLLEN* m_o_lenOrIndp { nullptr };
+      /** the indicator buffer (SQL_DESC_INDICATOR_PTR) */
+      SQLLEN* m_o_indicatorPtr { nullptr };
 
       ~Parameter() {
         m_o_value = nullptr;
@@ -146,6 +167,7 @@ namespace snappydata {
         // lenOrIndp can be uninitialized at this point
         m_isDataAtExecParam = false;
         m_o_lenOrIndp = lenOrIndp;
+        m_o_indicatorPtr = lenOrIndp;
         m_o_value = value;
         m_o_valueSize = valueSize;
         if (m_o_valueType == SQL_C_DEFAULT) {
@@ -158,7 +180,10 @@ namespace snappydata {
       SQLSMALLINT m_targetType { 0 };
       SQLPOINTER m_targetValue { nullptr };
       SQLLEN m_valueSize { 0 };
+      /** the length buffer (SQL_DESC_OCTET_LENGTH_PTR) */
       SQLLEN *m_lenOrIndPtr { nullptr };
+      /** the indicator buffer (SQL_DESC_INDICATOR_PTR) */
+      SQLLEN *m_indicatorPtr { nullptr };
 
       inline void set(SQLSMALLINT targetType, SQLPOINTER targetValue,
           SQLLEN valueSize, SQLLEN* lenOrIndPtr) {
@@ -166,6 +191,85 @@ namespace snappydata {
         m_targetValue = targetValue;
         m_valueSize = valueSize;
         m_lenOrIndPtr = lenOrIndPtr;
+        m_indicatorPtr = lenOrIndPtr;
+      }
+    };
+
+    /**
+     * Converter for a single bound output column as resolved in the
+     * fetch plan. The ctype passed is already resolved for SQL_C_DEFAULT.
+     */
+    typedef SQLRETURN (*FetchConverter)(SnappyStatement& stmt,
+        const Row& outputRow, const uint32_t columnNum, SQLPOINTER value,
+        const SQLLEN valueSize, const SQLSMALLINT ctype, SQLLEN* lenOrIndp);
+
+    struct FetchPlanEntry;
+
+    /**
+     * Converter for a single bound output column across a whole rowset
+     * used for column-wise binding. Sets the index of the failed row in
+     * "errorRow" when returning SQL_ERROR.
+     */
+    typedef SQLRETURN (*FetchColumnConverter)(SnappyStatement& stmt,
+        const std::vector<Row>& rows, const FetchPlanEntry& entry,
+        const SQLULEN bindOffset, size_t& errorRow);
+
+    /**
+     * A bound output column compiled into the fetch plan with its
+     * resolved C type and the converters to be used for it.
+     */
+    struct FetchPlanEntry final {
+      uint32_t m_columnNum;
+      SQLSMALLINT m_ctype;
+      FetchConverter m_convert;
+      FetchColumnConverter m_convertColumn;
+      SQLPOINTER m_targetValue;
+      SQLLEN m_valueSize;
+      /**
+       * buffer written by the converters with the length or
+       * SQL_NULL_DATA: the length buffer if any, else the indicator
+       */
+      SQLLEN* m_lenOrIndPtr;
+      /** the indicator buffer when it was set apart from the length */
+      SQLLEN* m_indicatorPtr;
+      /** true if the indicator is not the same as m_lenOrIndPtr */
+      bool m_separateIndicator;
+    };
+
+    /**
+     * State of the column being read piecewise by successive SQLGetData
+     * calls on the current row.
+     */
+    struct GetDataState final {
+      /** the column being read, or zero if none */
+      SQLUSMALLINT m_columnNum { 0 };
+      /** the C type (with SQL_C_DEFAULT resolved) being read */
+      SQLSMALLINT m_ctype { 0 };
+      /** start of the value in the C type being returned */
+      const char* m_data { nullptr };
+      /** total length of the value in bytes */
+      size_t m_length { 0 };
+      /** number of bytes of the value already returned */
+      size_t m_offset { 0 };
+      /**
+       * Holds the value when it does not point into the Row storage
+       * e.g. the converted UTF-16 string for SQL_C_WCHAR.
+       */
+      std::string m_buffer;
+
+      inline void reset() noexcept {
+        if (m_columnNum != 0) {
+          m_columnNum = 0;
+          m_data = nullptr;
+          m_length = 0;
+          m_offset = 0;
+          // don't hold on to the memory of a large value
+          if (m_buffer.capacity() > 64 * 1024) {
+            std::string().swap(m_buffer);
+          } else {
+            m_buffer.clear();
+          }
+        }
       }
     };
 
@@ -178,6 +282,29 @@ namespace snappydata {
     /** the output fields bound to this statement */
     std::vector<OutputField> m_outputFields;
 
+    /**
+     * The fetch plan compiled from m_outputFields when the first row of
+     * a result set is filled. Invalidated whenever the bindings or the
+     * result set change.
+     */
+    std::vector<FetchPlanEntry> m_fetchPlan;
+
+    /** true if m_fetchPlan is in sync with m_outputFields and result set */
+    bool m_fetchPlanValid;
+
+    /**
+     * Rows of the current rowset staged for column-at-a-time fill
+     * with column-wise binding. These are moved out of the cursor so are
+     * kept till the cursor moves to let SQLSetPos and SQLGetData address
+     * any row of the rowset.
+     */
+    std::vector<Row> m_stagedRows;
+    /** position of the current row in m_stagedRows */
+    size_t m_stagedPosition;
+
+    /** state of SQLGetData for the current row */
+    GetDataState m_getData;
+
     /**
      * The result of a statement execution. This is returned in case normal
      * execute has been invoked on underlying native API and not
@@ -210,13 +337,23 @@ namespace snappydata {
     Cursor m_cursorType;
 
     /**
-     * ODBC implicit descriptor handles required for ODBC driver manger
+     * ODBC implicit descriptor handles required for ODBC driver manger,
+     * created only when first requested by the application
      */
     std::unique_ptr<SnappyDescriptor> m_apdDesc;
     std::unique_ptr<SnappyDescriptor> m_ipdDesc;
     std::unique_ptr<SnappyDescriptor> m_ardDesc;
     std::unique_ptr<SnappyDescriptor> m_irdDesc;
 
+    /** the records of IRD, if m_resultRecordsValid is true */
+    std::vector<DescriptorRecord> m_resultRecords;
+    /** the records of IPD, if m_paramRecordsValid is true */
+    std::vector<DescriptorRecord> m_paramRecords;
+    /** true if m_resultRecords is in sync with the current result */
+    bool m_resultRecordsValid;
+    /** true if m_paramRecords is in sync with the current statement */
+    bool m_paramRecordsValid;
+
     /**
      * if true then use case insensitive arguments to meta-data queries
      * else the values are case sensitive
@@ -271,30 +408,116 @@ namespace snappydata {
     /** current executing parameter */
     size_t m_currentParameterIndex;
 
+    /**
+     * the character or binary value of current data-at-execution
+     * parameter being sent by SQLPutData
+     */
+    std::unique_ptr<PutDataBuffer> m_putData;
+
+    /** state of an operation executing on the driver threads */
+    struct AsyncTask final {
+      enum State {
+        QUEUED, RUNNING, CANCELED
+      };
+
+      /** the SQL_API_* identifier of the ODBC function being executed */
+      const SQLUSMALLINT m_functionId;
+      /** one of QUEUED, RUNNING or CANCELED (before it started) */
+      std::atomic<int> m_state;
+      /** set by SQLCancel of the operation after it started */
+      std::atomic<bool> m_cancelRequested;
+      std::atomic<bool> m_done;
+      SQLRETURN m_result;
+      /** published on the statement when the result is polled */
+      std::shared_ptr<const DiagRecords> m_diagnostics;
+      std::mutex m_lock;
+      std::condition_variable m_doneCond;
+
+      explicit AsyncTask(const SQLUSMALLINT functionId) :
+          m_functionId(functionId), m_state(QUEUED),
+          m_cancelRequested(false), m_done(false),
+          m_result(SQL_ERROR), m_diagnostics(), m_lock(), m_doneCond() {
+      }
+
+      void complete(const SQLRETURN result);
+
+      /** wait for the task to complete */
+      void await();
+    };
+
+    /** the operation currently executing asynchronously, if any */
+    std::shared_ptr<AsyncTask> m_asyncTask;
+
+    /** value of SQL_ATTR_ASYNC_ENABLE */
+    SQLULEN m_asyncEnable;
+
+    /** value of SQL_ATTR_ASYNC_STMT_EVENT set by the driver manager */
+    SQLPOINTER m_asyncEvent;
+
+    /**
+     * callback set by the driver manager to be invoked with
+     * m_asyncContext when an asynchronous operation completes
+     */
+    AsyncNotificationCallback m_asyncCallback;
+
+    /** value of SQL_ATTR_ASYNC_STMT_PCONTEXT */
+    SQLPOINTER m_asyncContext;
+
+    /** value of SQL_ATTR_READ_AHEAD_ROWS */
+    SQLULEN m_readAheadRows;
+
+    /** the read-ahead of the rows of current cursor, if any */
+    std::unique_ptr<ResultPrefetcher> m_prefetcher;
+
+    /**
+     * the catalog function result whose rows, held in memory by
+     * m_prefetcher, are returned by the current cursor, if any
+     */
+    std::shared_ptr<const CatalogResult> m_catalogResult;
+
+    /** true if the prepared statement is a DDL statement */
+    bool m_preparedDDL;
+
     /** C-style printf GUID format string */
     static const char* s_GUID_FORMAT;
 
     /** needs to access m_resultSet and some others for SnappyDiagRecField */
     friend class SnappyEnvironment;
 
+    /** the implicit descriptors are backed by the bindings and metadata */
+    friend class SnappyDescriptor;
+
     inline SnappyStatement(SnappyConnection* conn) :
-        m_conn(*conn), m_params(), m_execParams(), m_outputFields(),
-        m_cursor(), m_bulkCursor(m_cursor, 1),
-        m_apdDesc(new SnappyDescriptor(SQL_ATTR_APP_PARAM_DESC)),
-        m_ipdDesc(new SnappyDescriptor(SQL_ATTR_IMP_PARAM_DESC)),
-        m_ardDesc(new SnappyDescriptor(SQL_ATTR_APP_ROW_DESC)),
-        m_irdDesc(new SnappyDescriptor(SQL_ATTR_IMP_ROW_DESC)) {
+        m_conn(*conn), m_pstmtCacheKey(),
+        m_perfCounters(&conn->m_perfCounters), m_rowTracker(), m_params(),
+        m_execParams(),
+        m_outputFields(), m_fetchPlan(), m_fetchPlanValid(false),
+        m_stagedRows(), m_stagedPosition(0), m_getData(), m_cursor(), m_bulkCursor(m_cursor, 1),
+        m_apdDesc(), m_ipdDesc(), m_ardDesc(), m_irdDesc(),
+        m_resultRecords(), m_paramRecords(), m_resultRecordsValid(false),
+        m_paramRecordsValid(false) {
       initWithDefaultValues();
     }
 
     ~SnappyStatement() {
-      close();
+      awaitAsync();
+      runLocked(SQL_API_SQLFREESTMT, [this]() {
+        return close();
+      });
+    }
+
+    static void* operator new(size_t size) {
+      return HandleAllocator<SnappyStatement>::allocate(size);
+    }
+
+    static void operator delete(void* p, size_t size) noexcept {
+      HandleAllocator<SnappyStatement>::deallocate(p, size);
     }
 
     void initWithDefaultValues() {
       m_cursorType = Cursor::FORWARD_ONLY;
       m_stmtAttrs.setResultSetHoldability(
-          m_conn.m_conn.getResultSetHoldability());
+          m_conn.m_conn->getResultSetHoldability());
       m_bookmark = -1;
       m_bindingOrientation = SQL_BIND_BY_COLUMN;
       m_rowStatusPtr = nullptr;
@@ -310,8 +533,76 @@ namespace snappydata {
       m_paramBindOffsetPtr = nullptr;
       m_fetchedRowsPtr = nullptr;
       m_bindOffsetPtr = nullptr;
+      m_asyncEnable = m_conn.m_asyncEnable;
+      m_asyncEvent = nullptr;
+      m_asyncCallback = nullptr;
+      m_asyncContext = nullptr;
+      m_readAheadRows = m_conn.m_readAheadRows;
+      m_preparedDDL = false;
     }
 
+    /**
+     * Return true if the rows of current cursor are, or will be on the
+     * first fetch, read ahead by a ResultPrefetcher.
+     */
+    bool usesReadAhead() const noexcept;
+
+    /** stop any read-ahead of the rows of current cursor */
+    void stopReadAhead() noexcept;
+
+    /**
+     * Return true if the operation for the given function only moves
+     * within or reads the current cursor, so leaves its read-ahead alone.
+     * Any other operation will close or replace the cursor.
+     */
+    static bool keepsCursor(const SQLUSMALLINT functionId) noexcept;
+
+    /**
+     * Return true if the operation for the given function may use the
+     * transport of the connection so needs to hold its m_execLock.
+     */
+    bool needsConnectionLock(const SQLUSMALLINT functionId) const noexcept;
+
+    /** fetch the next row or rowset from the ResultPrefetcher */
+    SQLRETURN nextPrefetched();
+
+    /** drop the in-memory rows of current cursor if it is a CatalogResult */
+    void releaseCatalogResult() noexcept;
+
+    /** the current row of the cursor */
+    inline Row* getCurrentRow() {
+      if (!m_stagedRows.empty()) {
+        return &m_stagedRows[m_stagedPosition];
+      }
+      return m_prefetcher ? m_prefetcher->get() : m_cursor.get();
+    }
+
+    /** true if the cursor is positioned on a row */
+    inline bool isOnRow() {
+      if (!m_stagedRows.empty()) {
+        return true;
+      }
+      return m_prefetcher ? m_prefetcher->get() != nullptr
+          : m_cursor.isOnRow();
+    }
+
+    /** release the staged rows of the previous rowset when cursor moves */
+    inline void clearStagedRows() noexcept {
+      m_stagedRows.clear();
+      m_stagedPosition = 0;
+    }
+
+    /**
+     * Start the given operation on the driver threads, or poll for the
+     * result of the one started by a previous call, returning
+     * SQL_STILL_EXECUTING till it completes.
+     */
+    SQLRETURN executeAsync(const SQLUSMALLINT functionId,
+        std::function<SQLRETURN()>&& op);
+
+    /** cancel and wait for any asynchronous operation in progress */
+    void awaitAsync() noexcept;
+
     /**
      * Sets the ResultSet in this statement and transfers ownership. Note that
      * incoming ResultSet is nulled after this call and should never be used.
@@ -333,30 +624,174 @@ namespace snappydata {
     /** bind all the parameters to the underlying prepared statement */
     SQLRETURN bindParameters(std::map<int32_t, OutputParameter>* outParams);
 
-    /** bind an array of parameters to the underlying prepared statement */
+    /**
+     * bind an array of parameters to the underlying prepared statement;
+     * the sets that fail to bind are left out of the batch and their
+     * indexes added to "failedSets"
+     */
     SQLRETURN bindArrayOfParameters(ParametersBatch& paramsBatch,
         SQLULEN setSize, SQLULEN* bindOffsetPtr,
         SQLULEN bindingOrientation, SQLUSMALLINT* statusArr,
-        SQLULEN* processedPtr);
+        SQLULEN* processedPtr, std::vector<uint32_t>& failedSets);
+
+    /**
+     * Bind the character data of a parameter declared with a numeric or
+     * temporal SQL type as a value of that type. Returns false if the
+     * text should be sent as is for the server to convert, else returns
+     * true with "result" as SQL_ERROR if the text is malformed (22018) or
+     * out of range (22003) for the type, and SQL_SUCCESS_WITH_INFO if a
+     * fraction was truncated for an integer type (01S07).
+     */
+    bool bindTextAsTyped(Parameters& paramValues, Parameter& param,
+        const char* chars, const size_t len, SQLRETURN& result);
 
     /** bind a given parameter to the underlying prepared statement */
     SQLRETURN bindParameter(Parameters& paramValues, Parameter& param,
         std::map<int32_t, OutputParameter>* outParams,
         bool appendPutData = false, SQLLEN valueOffset = 0,
-        SQLLEN lenOffset = 0);
+        SQLLEN lenOffset = 0, ParameterArena* arena = nullptr);
 
     /** fill output values from given Row */
     SQLRETURN fillOutput(const Row& outputRow, const uint32_t outputColumn,
         SQLPOINTER value, const SQLLEN valueSize, SQLSMALLINT ctype,
         const SQLUINTEGER precision, SQLLEN* lenOrIndp);
 
+    /**
+     * Fill the next piece of a character or binary column for SQLGetData
+     * continuing from where the last call on the same column left off.
+     */
+    SQLRETURN fillOutputPiece(const Row& outputRow,
+        const SQLUSMALLINT columnNum, SQLPOINTER value,
+        const SQLLEN valueSize, const SQLSMALLINT ctype, SQLLEN* lenOrIndp);
+
     /** fill output and input parameters in this prepared statement */
     SQLRETURN fillOutParameters(const Result& result);
 
+    /**
+     * Set the value accumulated in m_putData, if any, for the current
+     * data-at-execution parameter.
+     */
+    void flushPutData();
+
+    /**
+     * Generic converter for the fetch plan that falls back to the full
+     * {@link #fillOutput} for the already resolved ctype.
+     */
+    static SQLRETURN fetchWithFillOutput(SnappyStatement& stmt,
+        const Row& outputRow, const uint32_t columnNum, SQLPOINTER value,
+        const SQLLEN valueSize, const SQLSMALLINT ctype, SQLLEN* lenOrIndp);
+
+    /**
+     * Column converter for the fetch plan for fixed width C types that
+     * writes contiguous arrays of values followed by the null indicators.
+     */
+    template<typename C_TYPE, typename V,
+        V (*GET_VALUE)(const Row&, const uint32_t), SQLLEN LEN>
+    static SQLRETURN fetchFixedWidthColumn(SnappyStatement& stmt,
+        const std::vector<Row>& rows, const FetchPlanEntry& entry,
+        const SQLULEN bindOffset, size_t& errorRow);
+
+    /**
+     * Generic column converter for the fetch plan that invokes the
+     * per-cell converter for each row of the rowset.
+     */
+    static SQLRETURN fetchColumnWithConverter(SnappyStatement& stmt,
+        const std::vector<Row>& rows, const FetchPlanEntry& entry,
+        const SQLULEN bindOffset, size_t& errorRow);
+
+    /**
+     * Compile the bound output fields into m_fetchPlan resolving
+     * SQL_C_DEFAULT and the converter for each column.
+     */
+    void buildFetchPlan(const Row& outputRow);
+
+    /** mark the fetch plan as stale after a change in bindings/result */
+    inline void invalidateFetchPlan() noexcept {
+      m_fetchPlanValid = false;
+    }
+
+    /**
+     * Return the current prepared statement, if any, to the connection's
+     * statement cache (or close it if not cacheable).
+     */
+    void releasePreparedStatement();
+
+    /**
+     * Prepare the given statement on the server into m_pstmt.
+     *
+     * @throws SQLException on error, so caller should handle
+     */
+    void prepareOnServer(const std::string& sqlText);
+
+    /** count a round trip to the server for the given operation */
+    inline void countRoundTrip(const PerfCounters::Counter op) noexcept {
+      m_perfCounters.add(PerfCounters::ROUND_TRIPS, 1);
+      m_perfCounters.add(op, 1);
+    }
+
+    /**
+     * Move the cursor to the next row, timing the move if it may fetch
+     * the next batch from the server.
+     */
+    inline bool cursorNext() {
+      if (SNAPPY_UNLIKELY(m_rowTracker.mayFetch())) {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::NETWORK_NANOS);
+        return m_cursor.next();
+      }
+      return m_cursor.next();
+    }
+
+    /**
+     * Move to the next row of the rowset, timing the move if it may fetch
+     * the next batch from the server. The time is excluded from the given
+     * Timer of the enclosing conversions, if any.
+     */
+    inline bool bulkCursorNext(PerfCounters::Timer* outer = nullptr) {
+      if (SNAPPY_UNLIKELY(m_rowTracker.mayFetch())) {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::NETWORK_NANOS, outer);
+        return m_bulkCursor.next();
+      }
+      return m_bulkCursor.next();
+    }
+
+    /**
+     * The next row read ahead, timing any wait for the next chunk of rows
+     * to be read.
+     */
+    inline Row* prefetchedNext() {
+      if (SNAPPY_UNLIKELY(m_prefetcher->atChunkEnd())) {
+        PerfCounters::Timer timer(m_perfCounters,
+            PerfCounters::NETWORK_NANOS);
+        return m_prefetcher->next();
+      }
+      return m_prefetcher->next();
+    }
+
+    /** count the row at the current position of the cursor */
+    inline void trackCurrentRow() noexcept {
+      m_rowTracker.track(m_cursor.get());
+      m_rowTracker.flush(m_perfCounters);
+    }
+
     SQLRETURN fillOutputFields();
 
     SQLRETURN fillOutputFieldsWithArrays();
 
+    /**
+     * Fill a rowset for column-wise binding of a forward-only cursor by
+     * staging all the rows of the rowset and then filling one bound
+     * column at a time.
+     */
+    SQLRETURN fillOutputFieldsByColumn();
+
+    /**
+     * Fill the bound columns of a rowset from the rows in m_stagedRows
+     * for either column-wise or row-wise binding.
+     */
+    SQLRETURN fillOutputFieldsFromStagedRows();
+
     void setRowStatus();
 
     /** Prepare the statement with current parameters. */
@@ -399,13 +834,91 @@ namespace snappydata {
         SQLINTEGER valueLen);
 
     /**
-     * Get the ColumnDescriptor from ResultSet or PreparedStatement of the
-     * given column number.
+     * Fill the records from the column metadata of the given ResultSet
+     * or PreparedStatement.
+     */
+    template<typename SOURCE>
+    static void snapshotColumns(SOURCE& source,
+        std::vector<DescriptorRecord>& records);
+
+    /**
+     * Get the IRD records taking a snapshot of the ResultSet or
+     * PreparedStatement metadata, if not done already.
      *
      * @throws SQLException caller must handle
      */
-    const ColumnDescriptor getColumnDescriptor(SQLUSMALLINT columnNumber,
-        uint32_t* columnCount = nullptr) const;
+    std::vector<DescriptorRecord>& getResultRecords();
+
+    /**
+     * Get the IRD record of the given column number.
+     *
+     * @throws SQLException caller must handle
+     */
+    const DescriptorRecord& getResultRecord(SQLUSMALLINT columnNumber,
+        uint32_t* columnCount = nullptr);
+
+    /**
+     * Get the IPD records taking a snapshot of the PreparedStatement
+     * parameter metadata, if not done already.
+     *
+     * @throws SQLException caller must handle
+     */
+    std::vector<DescriptorRecord>& getParamRecords();
+
+    /**
+     * Get the IPD record of the given parameter number.
+     *
+     * @throws SQLException caller must handle
+     */
+    const DescriptorRecord& getParamRecord(SQLUSMALLINT paramNumber,
+        uint32_t* paramCount = nullptr);
+
+    /** mark the IRD and IPD snapshots as stale */
+    inline void invalidateDescriptors() noexcept {
+      m_resultRecordsValid = false;
+      m_paramRecordsValid = false;
+    }
+
+    /** get the implicit descriptor of given type creating it if required */
+    SnappyDescriptor* getDescriptor(std::unique_ptr<SnappyDescriptor>& desc,
+        int descType);
+
+    /**
+     * Returns true if there is an open cursor which is either m_resultSet
+     * or a catalog result.
+     */
+    inline bool hasOpenCursor() const noexcept {
+      return m_resultSet || m_catalogResult;
+    }
+
+    /** Returns true if the results of catalog functions can be cached. */
+    inline bool isCatalogResultCacheable() const noexcept {
+      return m_stmtAttrs.getResultSetType() == ResultSetType::FORWARD_ONLY
+          && !m_stmtAttrs.isUpdatable();
+    }
+
+    /**
+     * Read all the rows and metadata of the given catalog ResultSet which
+     * is closed and released.
+     *
+     * @throws SQLException caller must handle
+     */
+    std::shared_ptr<const CatalogResult> readCatalogResult(
+        std::shared_ptr<ResultSet>& rs);
+
+    /** Set the given catalog function result as the current cursor. */
+    void setCatalogResult(const std::shared_ptr<const CatalogResult>& result);
+
+    /**
+     * Set the result of a catalog function as the current cursor, reading
+     * it using the given function unless found in the CatalogCache of the
+     * connection for the given key.
+     *
+     * @throws SQLException caller must handle
+     */
+    template<typename TFetch>
+    SQLRETURN setCatalogResultSet(const CatalogCache::Key& key,
+        TFetch&& fetch);
 
     template<typename CHAR_TYPE>
     SQLRETURN getResultColumnDescriptorT(SQLUSMALLINT columnNumber,
@@ -509,6 +1022,45 @@ namespace snappydata {
     static SQLRETURN newStatement(SnappyConnection* conn,
         SnappyStatement*& stmtRef);
 
+    /**
+     * Run the given operation for an ODBC function synchronously holding
+     * the lock of the connection if the operation may use its transport.
+     * Other operations, like fetches of rows already read ahead or the
+     * metadata of the current result, run concurrently with those of the
+     * other statements on the connection.
+     */
+    template<typename TOp>
+    inline SQLRETURN runLocked(const SQLUSMALLINT functionId, TOp&& op) {
+      if (!keepsCursor(functionId)) {
+        // the read-ahead itself takes the lock so stop it before that
+        stopReadAhead();
+      }
+      if (needsConnectionLock(functionId)) {
+        std::lock_guard<std::recursive_mutex> sync(m_conn.m_execLock);
+        return op();
+      } else {
+        return op();
+      }
+    }
+
+    /**
+     * Invoke the given operation for the ODBC function identified by
+     * functionId (one of SQL_API_*), running it asynchronously on the
+     * driver threads when SQL_ATTR_ASYNC_ENABLE is on. Subsequent calls
+     * for the same function poll for the result and the passed operation
+     * is ignored.
+     */
+    template<typename TOp>
+    inline SQLRETURN runAsync(const SQLUSMALLINT functionId, TOp&& op) {
+      if (SNAPPY_LIKELY(m_asyncEnable == SQL_ASYNC_ENABLE_OFF &&
+          !m_asyncTask)) {
+        return runLocked(functionId, std::forward<TOp>(op));
+      } else {
+        return executeAsync(functionId, std::function<SQLRETURN()>(
+            std::forward<TOp>(op)));
+      }
+    }
+
     /**
      * Free the cursor or parameters of the statement, or this statement
      * itself depending on the given option.
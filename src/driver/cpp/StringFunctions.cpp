@@ -40,10 +40,15 @@
  */
 
 #include "StringFunctions.h"
-#include "Utils.h"
 
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define SNAPPY_USE_SSE2 1
+#  include <emmintrin.h>
+#endif
+
 using namespace io::snappydata;
 
 namespace _snappy_impl {
@@ -67,15 +72,284 @@ static bool copyString(const void *chars, const size_t len, void *outStr,
   }
 }
 
-static std::string toString(const SQLWCHAR *chars, const SQLLEN len) {
-  std::string result;
-  if (len != SQL_NTS) {
-    // reserve some length to reduce reallocations (for best case ASCII)
-    result.reserve(len);
+/** replacement character used for invalid UTF-8 or UTF-16 sequences */
+static const uint32_t REPLACEMENT_CHAR = 0xFFFD;
+
+/**
+ * Widen the leading ASCII characters from "chars" into "outStr" for upto
+ * "maxLen" characters. Returns the number of characters copied which stops
+ * at the first non-ASCII character.
+ */
+static inline size_t widenASCII(const uint8_t *chars, const size_t maxLen,
+    SQLWCHAR *outStr) {
+  size_t i = 0;
+#ifdef SNAPPY_USE_SSE2
+  if (sizeof(SQLWCHAR) == 2) {
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= maxLen; i += 16) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)(chars + i));
+      if (_mm_movemask_epi8(v) != 0) break;
+      _mm_storeu_si128((__m128i*)(outStr + i), _mm_unpacklo_epi8(v, zero));
+      _mm_storeu_si128((__m128i*)(outStr + i + 8),
+          _mm_unpackhi_epi8(v, zero));
+    }
+  }
+#endif
+  for (; i < maxLen; i++) {
+    const uint8_t c = chars[i];
+    if (c >= 0x80) break;
+    outStr[i] = c;
+  }
+  return i;
+}
+
+/**
+ * Narrow the leading ASCII characters from "chars" into "outStr" for upto
+ * "maxLen" characters. Returns the number of characters copied which stops
+ * at the first non-ASCII character.
+ */
+static inline size_t narrowASCII(const SQLWCHAR *chars, const size_t maxLen,
+    uint8_t *outStr) {
+  size_t i = 0;
+#ifdef SNAPPY_USE_SSE2
+  if (sizeof(SQLWCHAR) == 2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nonASCII = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for (; i + 8 <= maxLen; i += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)(chars + i));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, nonASCII),
+          zero)) != 0xFFFF) break;
+      _mm_storel_epi64((__m128i*)(outStr + i), _mm_packus_epi16(v, v));
+    }
+  }
+#endif
+  for (; i < maxLen; i++) {
+    const SQLWCHAR c = chars[i];
+    if (c >= 0x80) break;
+    outStr[i] = static_cast<uint8_t>(c);
+  }
+  return i;
+}
+
+/**
+ * Return the number of leading ASCII characters in given UTF-8 string.
+ */
+static inline size_t skipASCII(const uint8_t *chars, const size_t len) {
+  size_t i = 0;
+#ifdef SNAPPY_USE_SSE2
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(chars + i));
+    if (_mm_movemask_epi8(v) != 0) break;
+  }
+#endif
+  while (i < len && chars[i] < 0x80) {
+    i++;
+  }
+  return i;
+}
+
+/**
+ * Decode a multi-byte UTF-8 sequence having the non-ASCII lead byte at
+ * "chars" and return the code point also setting the number of bytes
+ * consumed. Invalid sequences return REPLACEMENT_CHAR consuming one byte.
+ */
+static inline uint32_t decodeUTF8(const uint8_t *chars, const uint8_t *end,
+    size_t &consumed) {
+  const uint32_t c = chars[0];
+  const size_t avail = end - chars;
+  if (c >= 0xC2 && c <= 0xDF) {
+    if (avail >= 2 && (chars[1] & 0xC0) == 0x80) {
+      consumed = 2;
+      return ((c & 0x1F) << 6) | (chars[1] & 0x3F);
+    }
+  } else if (c >= 0xE0 && c <= 0xEF) {
+    if (avail >= 3 && (chars[1] & 0xC0) == 0x80
+        && (chars[2] & 0xC0) == 0x80) {
+      const uint32_t cp = ((c & 0x0F) << 12) | ((chars[1] & 0x3F) << 6)
+          | (chars[2] & 0x3F);
+      if (cp >= 0x800 && (cp < 0xD800 || cp > 0xDFFF)) {
+        consumed = 3;
+        return cp;
+      }
+    }
+  } else if (c >= 0xF0 && c <= 0xF4) {
+    if (avail >= 4 && (chars[1] & 0xC0) == 0x80
+        && (chars[2] & 0xC0) == 0x80 && (chars[3] & 0xC0) == 0x80) {
+      const uint32_t cp = ((c & 0x07) << 18) | ((chars[1] & 0x3F) << 12)
+          | ((chars[2] & 0x3F) << 6) | (chars[3] & 0x3F);
+      if (cp >= 0x10000 && cp <= 0x10FFFF) {
+        consumed = 4;
+        return cp;
+      }
+    }
+  }
+  consumed = 1;
+  return REPLACEMENT_CHAR;
+}
+
+/**
+ * Convert given UTF-8 string to UTF-16 writing at most "outMaxLen" code
+ * units directly into "outStr". Returns the total number of code units of
+ * the full conversion if "fullLength" is true, else stops once the output
+ * is full and returns a value greater than "outMaxLen" if there was more
+ * input to be converted.
+ */
+static size_t convertUTF8ToUTF16(const uint8_t *chars, const size_t len,
+    SQLWCHAR *outStr, const size_t outMaxLen, const bool fullLength) {
+  const uint8_t *end = chars + len;
+  size_t outLen = 0;
+  while (chars < end) {
+    if (*chars < 0x80) {
+      size_t n;
+      if (outLen < outMaxLen) {
+        n = widenASCII(chars, std::min<size_t>(end - chars,
+            outMaxLen - outLen), outStr + outLen);
+      } else if (fullLength) {
+        n = skipASCII(chars, end - chars);
+      } else {
+        return outLen + 1;
+      }
+      chars += n;
+      outLen += n;
+    } else {
+      size_t consumed;
+      const uint32_t cp = decodeUTF8(chars, end, consumed);
+      chars += consumed;
+      if (cp < 0x10000) {
+        if (outLen < outMaxLen) {
+          outStr[outLen] = static_cast<SQLWCHAR>(cp);
+        } else if (!fullLength) {
+          return outLen + 1;
+        }
+        outLen++;
+      } else {
+        // encode as a surrogate pair
+        const uint32_t v = cp - 0x10000;
+        if (outLen < outMaxLen) {
+          outStr[outLen] = static_cast<SQLWCHAR>(0xD800 + (v >> 10));
+        } else if (!fullLength) {
+          return outLen + 1;
+        }
+        if (outLen + 1 < outMaxLen) {
+          outStr[outLen + 1] = static_cast<SQLWCHAR>(0xDC00 + (v & 0x3FF));
+        } else if (!fullLength) {
+          return outLen + 2;
+        }
+        outLen += 2;
+      }
+    }
+  }
+  return outLen;
+}
+
+/**
+ * Convert given UTF-16 string to UTF-8 writing at most "outMaxLen" bytes
+ * directly into "outStr". Returns the total number of bytes of the full
+ * conversion if "fullLength" is true, else stops once the output is full
+ * and returns a value greater than "outMaxLen" if there was more input
+ * to be converted.
+ */
+static size_t convertUTF16ToUTF8(const SQLWCHAR *chars, const size_t len,
+    uint8_t *outStr, const size_t outMaxLen, const bool fullLength) {
+  const SQLWCHAR *end = chars + len;
+  size_t outLen = 0;
+  while (chars < end) {
+    uint32_t cp = *chars;
+    if (cp < 0x80) {
+      if (outLen < outMaxLen) {
+        const size_t n = narrowASCII(chars, std::min<size_t>(end - chars,
+            outMaxLen - outLen), outStr + outLen);
+        chars += n;
+        outLen += n;
+      } else if (fullLength) {
+        chars++;
+        outLen++;
+      } else {
+        return outLen + 1;
+      }
+      continue;
+    }
+    chars++;
+    if (cp >= 0xD800 && cp <= 0xDFFF) {
+      // combine a valid surrogate pair else use the replacement character
+      if (cp <= 0xDBFF && chars < end && *chars >= 0xDC00
+          && *chars <= 0xDFFF) {
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (*chars - 0xDC00);
+        chars++;
+      } else {
+        cp = REPLACEMENT_CHAR;
+      }
+    }
+    uint8_t bytes[4];
+    size_t numBytes;
+    if (cp < 0x800) {
+      bytes[0] = static_cast<uint8_t>(0xC0 | (cp >> 6));
+      bytes[1] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+      numBytes = 2;
+    } else if (cp < 0x10000) {
+      bytes[0] = static_cast<uint8_t>(0xE0 | (cp >> 12));
+      bytes[1] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+      bytes[2] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+      numBytes = 3;
+    } else {
+      bytes[0] = static_cast<uint8_t>(0xF0 | (cp >> 18));
+      bytes[1] = static_cast<uint8_t>(0x80 | ((cp >> 12) & 0x3F));
+      bytes[2] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+      bytes[3] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+      numBytes = 4;
+    }
+    for (size_t i = 0; i < numBytes; i++, outLen++) {
+      if (outLen < outMaxLen) {
+        outStr[outLen] = bytes[i];
+      } else if (!fullLength) {
+        return outLen + 1;
+      }
+    }
+  }
+  return outLen;
+}
+
+/**
+ * Common handling for the transcoding copyString variants: null terminate
+ * the output, set the total length and return true if truncated.
+ */
+template<typename CHAR_TYPE>
+static inline bool endCopyString(const size_t outLen, CHAR_TYPE *outStr,
+    const SQLLEN outMaxLen, SQLLEN *totalLen) {
+  if (totalLen) {
+    *totalLen = StringFunctions::restrictLength<SQLLEN, size_t>(outLen);
+  }
+  if (outMaxLen > 0) {
+    const size_t limit = static_cast<size_t>(outMaxLen - 1);
+    if (outLen <= limit) {
+      outStr[outLen] = 0;
+      return false;
+    } else {
+      outStr[limit] = 0;
+      return true;
+    }
+  } else {
+    return true;
+  }
+}
+
+static std::string toString(const SQLWCHAR *chars, SQLLEN len) {
+  if (len == SQL_NTS) {
+    len = StringFunctions::restrictLength<SQLLEN, size_t>(
+        StringFunctions::strlen(chars));
+  }
+  const size_t srcLen = static_cast<size_t>(len);
+  // first attempt assuming the best case of ASCII and go for another
+  // round with the exact required size if required
+  std::string result(srcLen, '\0');
+  const size_t outLen = convertUTF16ToUTF8(chars, srcLen,
+      (uint8_t*)&result[0], srcLen, true);
+  if (outLen > srcLen) {
+    result.resize(outLen);
+    convertUTF16ToUTF8(chars, srcLen, (uint8_t*)&result[0], outLen, false);
+  } else {
+    result.resize(outLen);
   }
-  client::Utils::convertUTF16ToUTF8(chars, len, [&](char c) {
-    result.push_back(c);
-  });
   return result;
 }
 
@@ -105,20 +379,15 @@ bool StringFunctions::copyString(const SQLWCHAR *chars, SQLLEN len,
 
 bool StringFunctions::copyString(const SQLCHAR *chars, SQLLEN len,
     SQLWCHAR *outStr, SQLLEN outMaxLen, SQLLEN *totalLen) {
-  // It is safer and faster in most cases to do the full conversion in one pass
-  // that will avoid any checks for outMaxLen and totalLen for each character.
-  // The truncation case should be an uncommon one.
+  // Convert directly into the output buffer. The remaining input is only
+  // scanned beyond the end of output buffer if the total length is required.
   if (chars) {
-    std::u16string result;
-    if (len != SQL_NTS) {
-      // reserve some length to reduce reallocations (for best case ASCII)
-      result.reserve(len);
-    }
-    client::Utils::convertUTF8ToUTF16((const char*)chars, len, [&](int c) {
-      result.push_back(static_cast<char16_t>(c));
-    });
-    return _snappy_impl::copyString(result.c_str(), result.length(),
-        outStr, outMaxLen, totalLen, 2);
+    if (len == SQL_NTS) len = restrictLength<SQLLEN, size_t>(strlen(chars));
+    const size_t outLimit = outMaxLen > 0 ? static_cast<size_t>(
+        outMaxLen - 1) : 0;
+    const size_t outLen = _snappy_impl::convertUTF8ToUTF16(chars,
+        static_cast<size_t>(len), outStr, outLimit, totalLen != nullptr);
+    return _snappy_impl::endCopyString(outLen, outStr, outMaxLen, totalLen);
   } else {
     if (totalLen) *totalLen = SQL_NULL_DATA;
     return false;
@@ -127,14 +396,15 @@ bool StringFunctions::copyString(const SQLCHAR *chars, SQLLEN len,
 
 bool StringFunctions::copyString(const SQLWCHAR *chars, SQLLEN len,
     SQLCHAR *outStr, SQLLEN outMaxLen, SQLLEN *totalLen) {
-  // It is safer and faster in most cases to do the full conversion in one pass
-  // that will avoid any checks for outMaxLen and totalLen for each character.
-  // The truncation case should be an uncommon one.
+  // Convert directly into the output buffer. The remaining input is only
+  // scanned beyond the end of output buffer if the total length is required.
   if (chars) {
-    // compiler should optimize to avoid any copy or move, so no rvalue below
-    std::string result = _snappy_impl::toString(chars, len);
-    return _snappy_impl::copyString(result.c_str(), result.length(),
-        outStr, outMaxLen, totalLen, 1);
+    if (len == SQL_NTS) len = restrictLength<SQLLEN, size_t>(strlen(chars));
+    const size_t outLimit = outMaxLen > 0 ? static_cast<size_t>(
+        outMaxLen - 1) : 0;
+    const size_t outLen = _snappy_impl::convertUTF16ToUTF8(chars,
+        static_cast<size_t>(len), outStr, outLimit, totalLen != nullptr);
+    return _snappy_impl::endCopyString(outLen, outStr, outMaxLen, totalLen);
   } else {
     if (totalLen) *totalLen = SQL_NULL_DATA;
     return false;
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * TextConversions.cpp
+ */
+
+#include "TextConversions.h"
+
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+using namespace io::snappydata;
+
+namespace _snappy_impl {
+
+/** the two digit strings for 00 to 99 */
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static inline size_t numDigits(const uint64_t v) noexcept {
+  // each comparison is a single instruction which compiles to a
+  // conditional add without any branches
+  return 1 + (v >= 10ULL) + (v >= 100ULL) + (v >= 1000ULL)
+      + (v >= 10000ULL) + (v >= 100000ULL) + (v >= 1000000ULL)
+      + (v >= 10000000ULL) + (v >= 100000000ULL) + (v >= 1000000000ULL)
+      + (v >= 10000000000ULL) + (v >= 100000000000ULL)
+      + (v >= 1000000000000ULL) + (v >= 10000000000000ULL)
+      + (v >= 100000000000000ULL) + (v >= 1000000000000000ULL)
+      + (v >= 10000000000000000ULL) + (v >= 100000000000000000ULL)
+      + (v >= 1000000000000000000ULL) + (v >= 10000000000000000000ULL);
+}
+
+/**
+ * Write the given number of least significant digits of "v" ending just
+ * before "end", two at a time.
+ */
+static inline void writeDigits(uint64_t v, size_t n, char* end) noexcept {
+  while (n >= 2) {
+    const size_t pair = static_cast<size_t>(v % 100) * 2;
+    v /= 100;
+    end -= 2;
+    end[0] = DIGIT_PAIRS[pair];
+    end[1] = DIGIT_PAIRS[pair + 1];
+    n -= 2;
+  }
+  if (n != 0) {
+    *(end - 1) = static_cast<char>('0' + (v % 10));
+  }
+}
+
+static inline char* writeTwoDigits(const int v, char* out) noexcept {
+  const size_t pair = static_cast<size_t>(v) * 2;
+  out[0] = DIGIT_PAIRS[pair];
+  out[1] = DIGIT_PAIRS[pair + 1];
+  return out + 2;
+}
+
+static inline char* writeDate(const int year, const int month,
+    const int day, char* out) noexcept {
+  if (year >= 0 && year <= 9999) {
+    writeDigits(static_cast<uint64_t>(year), 4, out + 4);
+    out += 4;
+  } else {
+    out += TextConversions::formatInt64(year, out);
+  }
+  *out++ = '-';
+  out = writeTwoDigits(month, out);
+  *out++ = '-';
+  return writeTwoDigits(day, out);
+}
+
+static inline char* writeTime(const int hour, const int minute,
+    const int second, char* out) noexcept {
+  out = writeTwoDigits(hour, out);
+  *out++ = ':';
+  out = writeTwoDigits(minute, out);
+  *out++ = ':';
+  return writeTwoDigits(second, out);
+}
+
+/** exact powers of ten as doubles */
+static const double POW10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+/**
+ * Fast path for values that are a decimal with few significant digits,
+ * as is typical for stored quantities and prices. Finds the smallest
+ * number of fractional digits "k" such that v is the nearest value to
+ * n / 10^k where both n and 10^k are exact, so the division is correctly
+ * rounded. The result is identical to the "%.<maxDigits>g" format which
+ * has no exponent in the range handled here. Returns zero if the value
+ * needs more than "maxDigits" significant digits or is out of range.
+ */
+template<typename T>
+static size_t formatShortDecimal(const T v, const int maxDigits,
+    char* out) noexcept {
+  const double limit = POW10[maxDigits];
+  const double absv = std::fabs(static_cast<double>(v));
+  if (!(absv >= 1e-4 && absv < limit)) {
+    return 0;
+  }
+  for (int k = 0; k <= maxDigits; k++) {
+    const double scaled = absv * POW10[k];
+    if (scaled >= limit) {
+      break;
+    }
+    const uint64_t n = static_cast<uint64_t>(scaled + 0.5);
+    if (static_cast<T>(static_cast<double>(n) / POW10[k]) == static_cast<T>(
+        absv)) {
+      char* p = out;
+      if (v < 0) {
+        *p++ = '-';
+      }
+      const uint64_t divisor = static_cast<uint64_t>(POW10[k]);
+      p += TextConversions::formatUInt64(n / divisor, p);
+      if (k > 0) {
+        *p++ = '.';
+        writeDigits(n % divisor, k, p + k);
+        p += k;
+      }
+      return p - out;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Format with increasing precision, starting from the number of digits
+ * that are always preserved by the type, till the result parses back to
+ * the same value. Also replaces a locale specific decimal separator.
+ */
+template<typename T>
+static size_t formatShortest(const T v, int precision, const int maxPrecision,
+    char* out) noexcept {
+  int len = ::snprintf(out, TextConversions::MAX_FORMAT_LEN, "%.*g",
+      precision, static_cast<double>(v));
+  if (std::isfinite(v)) {
+    while (precision < maxPrecision
+        && static_cast<T>(::strtod(out, nullptr)) != v) {
+      len = ::snprintf(out, TextConversions::MAX_FORMAT_LEN, "%.*g",
+          ++precision, static_cast<double>(v));
+    }
+    for (int i = 0; i < len; i++) {
+      const char c = out[i];
+      if ((c < '0' || c > '9') && c != '-' && c != '+' && c != 'e') {
+        out[i] = '.';
+      }
+    }
+  }
+  return len > 0 ? static_cast<size_t>(len) : 0;
+}
+
+/** Remove the leading and trailing spaces returning false if empty. */
+static inline bool trim(const char*& s, size_t& len) noexcept {
+  while (len > 0 && *s == ' ') {
+    s++;
+    len--;
+  }
+  while (len > 0 && s[len - 1] == ' ') {
+    len--;
+  }
+  return len > 0;
+}
+
+static inline bool isDigit(const char c) noexcept {
+  return static_cast<unsigned>(c - '0') < 10;
+}
+
+/**
+ * Read exactly "n" digits from "s" into "v" advancing "s".
+ */
+static inline bool readDigits(const char*& s, const char* end, int n,
+    int& v) noexcept {
+  if (end - s < n) {
+    return false;
+  }
+  v = 0;
+  while (n-- > 0) {
+    const char c = *s++;
+    if (!isDigit(c)) {
+      return false;
+    }
+    v = v * 10 + (c - '0');
+  }
+  return true;
+}
+
+static inline bool expect(const char*& s, const char* end,
+    const char c) noexcept {
+  if (s < end && *s == c) {
+    s++;
+    return true;
+  } else {
+    return false;
+  }
+}
+
+static bool readDate(const char*& s, const char* end, int& year,
+    int& month, int& day) noexcept {
+  static const int DAYS_IN_MONTH[] = { 31, 29, 31, 30, 31, 30, 31, 31, 30,
+      31, 30, 31 };
+  if (readDigits(s, end, 4, year) && expect(s, end, '-')
+      && readDigits(s, end, 2, month) && expect(s, end, '-')
+      && readDigits(s, end, 2, day) && month >= 1 && month <= 12
+      && day >= 1 && day <= DAYS_IN_MONTH[month - 1]) {
+    // check 29th February for non-leap years
+    return !(month == 2 && day == 29 && ((year % 4) != 0
+        || ((year % 100) == 0 && (year % 400) != 0)));
+  } else {
+    return false;
+  }
+}
+
+static bool readTime(const char*& s, const char* end, int& hour,
+    int& minute, int& second) noexcept {
+  return readDigits(s, end, 2, hour) && expect(s, end, ':')
+      && readDigits(s, end, 2, minute) && expect(s, end, ':')
+      && readDigits(s, end, 2, second) && hour <= 23 && minute <= 59
+      && second <= 59;
+}
+
+} /* namespace _snappy_impl */
+
+using namespace _snappy_impl;
+
+size_t TextConversions::formatUInt64(const uint64_t v, char* out) noexcept {
+  const size_t n = numDigits(v);
+  writeDigits(v, n, out + n);
+  return n;
+}
+
+size_t TextConversions::formatInt64(const int64_t v, char* out) noexcept {
+  if (v >= 0) {
+    return formatUInt64(static_cast<uint64_t>(v), out);
+  } else {
+    *out = '-';
+    // negate as unsigned to handle the minimum value
+    return formatUInt64(0ULL - static_cast<uint64_t>(v), out + 1) + 1;
+  }
+}
+
+size_t TextConversions::formatDouble(const double v, char* out) noexcept {
+  const size_t len = formatShortDecimal<double>(v, 15, out);
+  return len != 0 ? len : formatShortest<double>(v, 15, 17, out);
+}
+
+size_t TextConversions::formatFloat(const float v, char* out) noexcept {
+  const size_t len = formatShortDecimal<float>(v, 6, out);
+  return len != 0 ? len : formatShortest<float>(v, 6, 9, out);
+}
+
+size_t TextConversions::formatDate(const int year, const int month,
+    const int day, char* out) noexcept {
+  return writeDate(year, month, day, out) - out;
+}
+
+size_t TextConversions::formatTime(const int hour, const int minute,
+    const int second, char* out) noexcept {
+  return writeTime(hour, minute, second, out) - out;
+}
+
+size_t TextConversions::formatTimestamp(const int year, const int month,
+    const int day, const int hour, const int minute, const int second,
+    const uint32_t nanos, char* out) noexcept {
+  char* p = writeDate(year, month, day, out);
+  *p++ = ' ';
+  p = writeTime(hour, minute, second, p);
+  if (nanos != 0) {
+    *p++ = '.';
+    writeDigits(nanos, 9, p + 9);
+    p += 9;
+    // remove the trailing zeros of the fraction
+    while (*(p - 1) == '0') {
+      p--;
+    }
+  }
+  return p - out;
+}
+
+bool TextConversions::parseInt64(const char* s, size_t len,
+    int64_t& v) noexcept {
+  if (!trim(s, len)) {
+    return false;
+  }
+  const char* end = s + len;
+  const bool negative = (*s == '-');
+  if (negative || *s == '+') {
+    s++;
+  }
+  if (s == end) {
+    return false;
+  }
+  // accumulate as negative which has the larger range
+  const int64_t minValue = std::numeric_limits<int64_t>::min();
+  int64_t result = 0;
+  while (s < end) {
+    const char c = *s++;
+    if (!isDigit(c)) {
+      return false;
+    }
+    const int digit = c - '0';
+    if (result < (minValue + digit) / 10) {
+      return false;
+    }
+    result = result * 10 - digit;
+  }
+  if (negative) {
+    v = result;
+    return true;
+  } else if (result != minValue) {
+    v = -result;
+    return true;
+  } else {
+    return false;
+  }
+}
+
+bool TextConversions::parseIntegral(const char* s, size_t len,
+    int64_t& v, bool& truncated, bool& overflow) noexcept {
+  truncated = false;
+  overflow = false;
+  if (!trim(s, len)) {
+    return false;
+  }
+  const char* end = s + len;
+  const bool negative = (*s == '-');
+  if (negative || *s == '+') {
+    s++;
+  }
+  // accumulate as negative which has the larger range
+  const int64_t minValue = std::numeric_limits<int64_t>::min();
+  int64_t result = 0;
+  bool outOfRange = false;
+  const char* digits = s;
+  while (s < end && isDigit(*s)) {
+    const int digit = *s++ - '0';
+    if (outOfRange || result < (minValue + digit) / 10) {
+      outOfRange = true;
+    } else {
+      result = result * 10 - digit;
+    }
+  }
+  bool hasDigits = (s != digits);
+  if (s < end && *s == '.') {
+    digits = ++s;
+    while (s < end && isDigit(*s)) {
+      if (*s++ != '0') {
+        truncated = true;
+      }
+    }
+    hasDigits |= (s != digits);
+  }
+  if (s != end || !hasDigits) {
+    return false;
+  }
+  if (outOfRange || (!negative && result == minValue)) {
+    overflow = true;
+    return false;
+  }
+  v = negative ? result : -result;
+  return true;
+}
+
+bool TextConversions::parseDouble(const char* s, size_t len,
+    double& v) noexcept {
+  char buf[128];
+  if (!trim(s, len) || len >= sizeof(buf)) {
+    return false;
+  }
+  // validate the characters since strtod also accepts other forms and
+  // replace the decimal point with that of the current locale
+  const char decimalPoint = *::localeconv()->decimal_point;
+  bool hasDigit = false;
+  for (size_t i = 0; i < len; i++) {
+    const char c = s[i];
+    if (isDigit(c)) {
+      hasDigit = true;
+      buf[i] = c;
+    } else if (c == '.') {
+      buf[i] = decimalPoint;
+    } else if (c == '-' || c == '+' || c == 'e' || c == 'E') {
+      buf[i] = c;
+    } else {
+      return false;
+    }
+  }
+  buf[len] = '\0';
+  char* endp;
+  v = ::strtod(buf, &endp);
+  return hasDigit && endp == buf + len && std::isfinite(v);
+}
+
+bool TextConversions::parseDecimal(const char* s, size_t len,
+    uint8_t* magnitude, size_t& magLen, int& scale, int& signum) noexcept {
+  if (!trim(s, len)) {
+    return false;
+  }
+  const char* end = s + len;
+  const bool negative = (*s == '-');
+  if (negative || *s == '+') {
+    s++;
+  }
+  magLen = 0;
+  scale = 0;
+  bool hasDigit = false, inFraction = false;
+  while (s < end) {
+    const char c = *s++;
+    if (isDigit(c)) {
+      // magnitude = magnitude * 10 + digit over the little-endian bytes
+      uint32_t carry = static_cast<uint32_t>(c - '0');
+      for (size_t i = 0; i < magLen; i++) {
+        carry += static_cast<uint32_t>(magnitude[i]) * 10;
+        magnitude[i] = static_cast<uint8_t>(carry);
+        carry >>= 8;
+      }
+      if (carry != 0) {
+        if (magLen == MAX_DECIMAL_BYTES) {
+          return false;
+        }
+        magnitude[magLen++] = static_cast<uint8_t>(carry);
+      }
+      hasDigit = true;
+      if (inFraction) {
+        scale++;
+      }
+    } else if (c == '.' && !inFraction) {
+      inFraction = true;
+    } else {
+      return false;
+    }
+  }
+  signum = magLen == 0 ? 0 : (negative ? -1 : 1);
+  return hasDigit;
+}
+
+bool TextConversions::parseDate(const char* s, size_t len, int& year,
+    int& month, int& day) noexcept {
+  if (!trim(s, len)) {
+    return false;
+  }
+  const char* end = s + len;
+  return readDate(s, end, year, month, day) && s == end;
+}
+
+bool TextConversions::parseTime(const char* s, size_t len, int& hour,
+    int& minute, int& second) noexcept {
+  if (!trim(s, len)) {
+    return false;
+  }
+  const char* end = s + len;
+  return readTime(s, end, hour, minute, second) && s == end;
+}
+
+bool TextConversions::parseTimestamp(const char* s, size_t len, int& year,
+    int& month, int& day, int& hour, int& minute, int& second,
+    uint32_t& nanos) noexcept {
+  if (!trim(s, len)) {
+    return false;
+  }
+  const char* end = s + len;
+  if (!readDate(s, end, year, month, day)) {
+    return false;
+  }
+  hour = minute = second = 0;
+  nanos = 0;
+  if (s == end) {
+    return true;
+  }
+  if (!(expect(s, end, ' ') || expect(s, end, 'T'))
+      || !readTime(s, end, hour, minute, second)) {
+    return false;
+  }
+  if (expect(s, end, '.')) {
+    uint32_t multiplier = 100000000;
+    if (s == end) {
+      return false;
+    }
+    while (s < end) {
+      const char c = *s++;
+      if (!isDigit(c) || multiplier == 0) {
+        return false;
+      }
+      nanos += static_cast<uint32_t>(c - '0') * multiplier;
+      multiplier /= 10;
+    }
+  }
+  return s == end;
+}
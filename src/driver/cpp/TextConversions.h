@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * TextConversions.h
+ *
+ * Conversions between the text representation and the native values of
+ * numeric and temporal types that avoid the heap and stream formatting.
+ */
+
+#ifndef TEXTCONVERSIONS_H_
+#define TEXTCONVERSIONS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * Static class to format numeric and temporal values into a caller
+   * provided buffer, and to parse them back from text.
+   *
+   * The format methods need space for at least {@link #MAX_FORMAT_LEN}
+   * characters in the output buffer. None of them write a terminating
+   * null and all return the number of characters written.
+   *
+   * The parse methods take text that is not null terminated, ignore
+   * leading and trailing spaces, and return false if the text is not
+   * in the expected format or the value is out of range.
+   */
+  class TextConversions final {
+  private:
+    TextConversions() = delete; // no instance
+
+  public:
+    /** maximum number of characters written by any of the format methods */
+    static const size_t MAX_FORMAT_LEN = 32;
+
+    static size_t formatInt64(const int64_t v, char* out) noexcept;
+
+    static size_t formatUInt64(const uint64_t v, char* out) noexcept;
+
+    /**
+     * Format using the shortest representation that parses back to the
+     * exact same double value.
+     */
+    static size_t formatDouble(const double v, char* out) noexcept;
+
+    /**
+     * Format using the shortest representation that parses back to the
+     * exact same float value.
+     */
+    static size_t formatFloat(const float v, char* out) noexcept;
+
+    /** Format as yyyy-mm-dd. */
+    static size_t formatDate(const int year, const int month, const int day,
+        char* out) noexcept;
+
+    /** Format as hh:mm:ss. */
+    static size_t formatTime(const int hour, const int minute,
+        const int second, char* out) noexcept;
+
+    /**
+     * Format as yyyy-mm-dd hh:mm:ss[.fffffffff] where the fraction is
+     * omitted if zero and has its trailing zeros removed otherwise.
+     */
+    static size_t formatTimestamp(const int year, const int month,
+        const int day, const int hour, const int minute, const int second,
+        const uint32_t nanos, char* out) noexcept;
+
+    /** maximum number of bytes in the magnitude output by parseDecimal */
+    static const size_t MAX_DECIMAL_BYTES = 16;
+
+    /** Parse an optionally signed integer. */
+    static bool parseInt64(const char* s, size_t len, int64_t& v) noexcept;
+
+    /**
+     * Parse an optionally signed integer that may have a fraction which
+     * is discarded, setting "truncated" if it has a non-zero digit. The
+     * integral digits are read exactly. Sets "overflow" when returning
+     * false for a value that does not fit in int64_t. Does not accept the
+     * exponent notation.
+     */
+    static bool parseIntegral(const char* s, size_t len, int64_t& v,
+        bool& truncated, bool& overflow) noexcept;
+
+    /**
+     * Parse a floating point number in decimal or exponent notation.
+     * Does not accept the hexadecimal, infinity or NaN forms.
+     */
+    static bool parseDouble(const char* s, size_t len, double& v) noexcept;
+
+    /**
+     * Parse a decimal number into the little-endian bytes of its unscaled
+     * magnitude, as in SQL_NUMERIC_STRUCT, along with the scale and the
+     * sign (-1, 0 or 1). Also returns false if the magnitude needs more
+     * than {@link #MAX_DECIMAL_BYTES} bytes or exponent notation is used.
+     */
+    static bool parseDecimal(const char* s, size_t len, uint8_t* magnitude,
+        size_t& magLen, int& scale, int& signum) noexcept;
+
+    /** Parse yyyy-mm-dd. */
+    static bool parseDate(const char* s, size_t len, int& year, int& month,
+        int& day) noexcept;
+
+    /** Parse hh:mm:ss. */
+    static bool parseTime(const char* s, size_t len, int& hour, int& minute,
+        int& second) noexcept;
+
+    /**
+     * Parse yyyy-mm-dd[( |T)hh:mm:ss[.f...]] with upto nine digits of the
+     * fraction of a second.
+     */
+    static bool parseTimestamp(const char* s, size_t len, int& year,
+        int& month, int& day, int& hour, int& minute, int& second,
+        uint32_t& nanos) noexcept;
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* TEXTCONVERSIONS_H_ */
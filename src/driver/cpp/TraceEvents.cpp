@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * TraceEvents.cpp
+ */
+
+#include "TraceEvents.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WINDOWS
+#include <process.h>
+#define SNAPPY_GETPID _getpid
+#else
+#include <unistd.h>
+#define SNAPPY_GETPID ::getpid
+#endif
+
+using namespace io::snappydata;
+
+std::atomic<bool> TraceEvents::s_enabled(false);
+
+namespace {
+  const uint64_t BUFFER_MASK = TraceEvents::BUFFER_SIZE - 1;
+  /** interval at which the buffers are drained to the file */
+  const std::chrono::milliseconds FLUSH_INTERVAL(100);
+  const char* const CATEGORY_NAMES[] = { "odbc", "network", "conversion" };
+
+  /**
+   * Ring buffer of the events of a thread. The thread only advances
+   * m_head and the flusher only advances m_tail.
+   */
+  struct Buffer final {
+    /** the small number that identifies the thread in the trace */
+    const uint32_t m_threadNum;
+    std::atomic<uint64_t> m_head;
+    std::atomic<uint64_t> m_tail;
+    /** events dropped because the buffer was full */
+    std::atomic<uint64_t> m_dropped;
+    /** dropped events already reported in the trace, used by flusher */
+    uint64_t m_droppedReported;
+    /** set when the thread exits after which the buffer is removed */
+    std::atomic<bool> m_exited;
+    TraceEvents::Event m_events[TraceEvents::BUFFER_SIZE];
+
+    explicit Buffer(const uint32_t threadNum) : m_threadNum(threadNum),
+        m_head(0), m_tail(0), m_dropped(0), m_droppedReported(0),
+        m_exited(false) {
+    }
+  };
+
+  std::mutex g_bufferLock;
+  std::vector<std::shared_ptr<Buffer> > g_buffers;
+  uint32_t g_numThreads = 0;
+
+  /** registers the buffer of a thread and marks it when thread exits */
+  struct ThreadBuffer final {
+    std::shared_ptr<Buffer> m_buffer;
+
+    ThreadBuffer() {
+      std::lock_guard<std::mutex> sync(g_bufferLock);
+      m_buffer = std::make_shared<Buffer>(++g_numThreads);
+      g_buffers.push_back(m_buffer);
+    }
+
+    ~ThreadBuffer() {
+      // the flusher removes the buffer once all its events are written
+      m_buffer->m_exited.store(true, std::memory_order_release);
+    }
+  };
+
+  /** held by start and stop */
+  std::mutex g_stateLock;
+  std::ofstream g_out;
+  long g_pid = 0;
+  std::thread g_flusher;
+  std::mutex g_flushLock;
+  std::condition_variable g_flushCond;
+  bool g_stopFlusher = false;
+
+  void writeMicros(std::ostream& out, const int64_t nanos) {
+    out << (nanos / 1000) << '.' << std::setw(3) << (nanos % 1000);
+  }
+
+  void writeEvent(std::ostream& out, const uint32_t threadNum,
+      const TraceEvents::Event& event) {
+    out << ",\n{\"name\":\"" << event.m_name << "\",\"cat\":\""
+        << CATEGORY_NAMES[event.m_category] << "\",\"ph\":\"X\",\"ts\":";
+    writeMicros(out, event.m_startTime);
+    out << ",\"dur\":";
+    writeMicros(out, event.m_endTime - event.m_startTime);
+    out << ",\"pid\":" << g_pid << ",\"tid\":" << threadNum << '}';
+  }
+
+  /** write the events of all the buffers; only called by one thread */
+  void drain(std::ostream& out) {
+    std::vector<std::shared_ptr<Buffer> > buffers;
+    {
+      std::lock_guard<std::mutex> sync(g_bufferLock);
+      buffers = g_buffers;
+    }
+    bool hasExited = false;
+    for (const auto& buffer : buffers) {
+      const bool exited = buffer->m_exited.load(std::memory_order_acquire);
+      const uint64_t head = buffer->m_head.load(std::memory_order_acquire);
+      for (uint64_t tail = buffer->m_tail.load(std::memory_order_relaxed);
+          tail < head; tail++) {
+        writeEvent(out, buffer->m_threadNum,
+            buffer->m_events[tail & BUFFER_MASK]);
+      }
+      buffer->m_tail.store(head, std::memory_order_release);
+
+      const uint64_t dropped = buffer->m_dropped.load(
+          std::memory_order_relaxed);
+      if (dropped != buffer->m_droppedReported) {
+        const int64_t now = std::chrono::duration_cast<
+            std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                .time_since_epoch()).count();
+        out << ",\n{\"name\":\"dropped events\",\"ph\":\"i\",\"s\":\"t\","
+            "\"ts\":";
+        writeMicros(out, now);
+        out << ",\"pid\":" << g_pid << ",\"tid\":" << buffer->m_threadNum
+            << ",\"args\":{\"count\":"
+            << (dropped - buffer->m_droppedReported) << "}}";
+        buffer->m_droppedReported = dropped;
+      }
+      hasExited |= exited;
+    }
+    out.flush();
+
+    if (hasExited) {
+      std::lock_guard<std::mutex> sync(g_bufferLock);
+      for (auto iter = g_buffers.begin(); iter != g_buffers.end();) {
+        Buffer& buffer = **iter;
+        if (buffer.m_exited.load(std::memory_order_acquire) &&
+            buffer.m_head.load(std::memory_order_acquire) ==
+                buffer.m_tail.load(std::memory_order_relaxed)) {
+          iter = g_buffers.erase(iter);
+        } else {
+          ++iter;
+        }
+      }
+    }
+  }
+
+  void flushLoop() {
+    std::unique_lock<std::mutex> sync(g_flushLock);
+    while (!g_stopFlusher) {
+      g_flushCond.wait_for(sync, FLUSH_INTERVAL);
+      if (g_stopFlusher) {
+        break;
+      }
+      sync.unlock();
+      try {
+        drain(g_out);
+      } catch (...) {
+        // ignore and retry in the next round
+      }
+      sync.lock();
+    }
+  }
+}
+
+void TraceEvents::record(const Category category, const char* name,
+    const int64_t startTime, const int64_t endTime) noexcept {
+  try {
+    static thread_local ThreadBuffer t_buffer;
+    Buffer& buffer = *t_buffer.m_buffer;
+    const uint64_t head = buffer.m_head.load(std::memory_order_relaxed);
+    if (head - buffer.m_tail.load(std::memory_order_acquire) >=
+        BUFFER_SIZE) {
+      buffer.m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    Event& event = buffer.m_events[head & BUFFER_MASK];
+    event.m_name = name;
+    event.m_startTime = startTime;
+    event.m_endTime = endTime;
+    event.m_category = category;
+    buffer.m_head.store(head + 1, std::memory_order_release);
+  } catch (...) {
+    // ignore failure to allocate the buffer
+  }
+}
+
+bool TraceEvents::start(const std::string& file) {
+  std::lock_guard<std::mutex> sync(g_stateLock);
+  if (g_flusher.joinable()) {
+    return true;
+  }
+  g_out.open(file.c_str(), std::ios::out | std::ios::trunc);
+  if (!g_out) {
+    g_out.clear();
+    return false;
+  }
+  g_pid = static_cast<long>(SNAPPY_GETPID());
+  g_out << std::setfill('0');
+  // the closing bracket is optional in the JSON array format of trace
+  // events, so the file is readable even if the process did not stop
+  g_out << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << g_pid
+      << ",\"args\":{\"name\":\"snappyodbc\"}}";
+  {
+    // discard the events recorded after an earlier trace was stopped
+    std::lock_guard<std::mutex> bufferSync(g_bufferLock);
+    for (const auto& buffer : g_buffers) {
+      buffer->m_tail.store(buffer->m_head.load(std::memory_order_acquire),
+          std::memory_order_release);
+      buffer->m_droppedReported = buffer->m_dropped.load(
+          std::memory_order_relaxed);
+    }
+  }
+  g_stopFlusher = false;
+  try {
+    g_flusher = std::thread(flushLoop);
+  } catch (...) {
+    g_out.close();
+    return false;
+  }
+  s_enabled.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void TraceEvents::stop() noexcept {
+  std::lock_guard<std::mutex> sync(g_stateLock);
+  if (!g_flusher.joinable()) {
+    return;
+  }
+  s_enabled.store(false, std::memory_order_relaxed);
+  try {
+    {
+      std::lock_guard<std::mutex> flushSync(g_flushLock);
+      g_stopFlusher = true;
+    }
+    g_flushCond.notify_all();
+    g_flusher.join();
+    drain(g_out);
+    g_out << "\n]\n";
+    g_out.close();
+  } catch (...) {
+    // nothing more can be done with the trace file
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * TraceEvents.h
+ *
+ * Timeline of the API calls, server operations and conversions of the
+ * driver written as a Chrome trace-event JSON file.
+ */
+
+#ifndef TRACEEVENTS_H_
+#define TRACEEVENTS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace io {
+namespace snappydata {
+
+  /**
+   * Records complete events (with start and end timestamps) into fixed
+   * size per-thread buffers. Each buffer has a single writer, its thread,
+   * and a single reader, the background thread that drains all the
+   * buffers periodically and appends the events to the trace file in the
+   * Chrome trace-event format that can be loaded by chrome://tracing or
+   * the Perfetto UI. Recording never blocks nor allocates after the first
+   * event of a thread; events are dropped if a buffer is full.
+   *
+   * Started by the first connection that has TraceEventsFile set and
+   * stopped, completing the file, when the last environment is freed.
+   */
+  class TraceEvents final {
+  public:
+    /** the category of an event shown in the timeline */
+    enum Category : uint8_t {
+      /** an ODBC API call */
+      API,
+      /** an operation of the native client waiting for the server */
+      NETWORK,
+      /** conversion of parameters and output values */
+      CONVERSION
+    };
+
+    /** an event as held in the buffer of a thread */
+    struct Event {
+      /** name of the event which should be a string literal */
+      const char* m_name;
+      /** nanoseconds since steady_clock epoch */
+      int64_t m_startTime;
+      int64_t m_endTime;
+      Category m_category;
+    };
+
+    /** number of events buffered per thread (must be a power of two) */
+    static const size_t BUFFER_SIZE = 8192;
+
+  private:
+    static std::atomic<bool> s_enabled;
+
+    TraceEvents() = delete;
+
+  public:
+    static bool isEnabled() noexcept {
+      return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void record(const Category category, const char* name,
+        const int64_t startTime, const int64_t endTime) noexcept;
+
+    /**
+     * Start writing the events to given file which is overwritten. Does
+     * nothing and returns true if already started. Returns false if the
+     * file could not be opened.
+     */
+    static bool start(const std::string& file);
+
+    /** Write all the pending events and complete the file. */
+    static void stop() noexcept;
+  };
+
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* TRACEEVENTS_H_ */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * LatencyHistogram.cpp
+ */
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace io::snappydata::loadgen;
+
+constexpr int LatencyHistogram::SUB_BUCKET_BITS;
+constexpr int LatencyHistogram::SUB_BUCKET_HALF;
+constexpr int LatencyHistogram::MAX_EXPONENT;
+constexpr int LatencyHistogram::NUM_BUCKETS;
+
+LatencyHistogram::LatencyHistogram() :
+    m_counts(NUM_BUCKETS, 0), m_totalCount(0),
+    m_min(std::numeric_limits<uint64_t>::max()), m_max(0), m_sum(0.0) {
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) noexcept {
+  // values below 2 * SUB_BUCKET_HALF are recorded exactly; above that the
+  // value is shifted down to keep SUB_BUCKET_BITS + 1 significant bits
+  if (value < (2 * SUB_BUCKET_HALF)) {
+    return static_cast<int>(value);
+  }
+  int msb = 63;
+  while ((value >> msb) == 0) msb--;
+  int exponent = msb - SUB_BUCKET_BITS;
+  if (exponent > MAX_EXPONENT) {
+    return NUM_BUCKETS - 1;
+  }
+  return (exponent << SUB_BUCKET_BITS) + static_cast<int>(value >> exponent);
+}
+
+uint64_t LatencyHistogram::bucketValue(int index) noexcept {
+  if (index < (2 * SUB_BUCKET_HALF)) {
+    return static_cast<uint64_t>(index);
+  }
+  const int exponent = (index >> SUB_BUCKET_BITS) - 1;
+  const uint64_t mantissa = static_cast<uint64_t>(
+      index - (exponent << SUB_BUCKET_BITS));
+  return mantissa << exponent;
+}
+
+void LatencyHistogram::record(uint64_t nanos) noexcept {
+  m_counts[bucketIndex(nanos)]++;
+  m_totalCount++;
+  m_sum += static_cast<double>(nanos);
+  if (nanos < m_min) m_min = nanos;
+  if (nanos > m_max) m_max = nanos;
+}
+
+void LatencyHistogram::add(const LatencyHistogram& other) noexcept {
+  for (int i = 0; i < NUM_BUCKETS; i++) {
+    m_counts[i] += other.m_counts[i];
+  }
+  m_totalCount += other.m_totalCount;
+  m_sum += other.m_sum;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+}
+
+void LatencyHistogram::reset() noexcept {
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_totalCount = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+  m_sum = 0.0;
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const noexcept {
+  if (m_totalCount == 0) {
+    return 0;
+  }
+  const double fraction = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+  const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(
+      std::ceil(fraction * m_totalCount)));
+  uint64_t seen = 0;
+  for (int i = 0; i < NUM_BUCKETS; i++) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      // report the upper end of the bucket capped by the actual maximum
+      const uint64_t upper = i + 1 < NUM_BUCKETS ? bucketValue(i + 1) - 1
+          : m_max;
+      return std::min(std::max(upper, bucketValue(i)), m_max);
+    }
+  }
+  return m_max;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * LatencyHistogram.h
+ */
+
+#ifndef LATENCYHISTOGRAM_H_
+#define LATENCYHISTOGRAM_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace io {
+namespace snappydata {
+namespace loadgen {
+
+  /**
+   * A log-linear latency histogram in the manner of HdrHistogram with
+   * 64 linear sub-buckets per power of two, so any recorded value is
+   * reported within 1.6% of its actual value. Values are in nanoseconds
+   * and can go up to about 2^50 (13 days).
+   *
+   * Not thread-safe: each thread records into its own histogram and they
+   * are merged with add when the run is over.
+   */
+  class LatencyHistogram final {
+  private:
+    static constexpr int SUB_BUCKET_BITS = 6;
+    static constexpr int SUB_BUCKET_HALF = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 44;
+    static constexpr int NUM_BUCKETS = SUB_BUCKET_HALF * (MAX_EXPONENT + 2);
+
+    std::vector<uint64_t> m_counts;
+    uint64_t m_totalCount;
+    uint64_t m_min;
+    uint64_t m_max;
+    double m_sum;
+
+    static int bucketIndex(uint64_t value) noexcept;
+
+    /** the smallest value mapped to the given bucket */
+    static uint64_t bucketValue(int index) noexcept;
+
+  public:
+    LatencyHistogram();
+
+    void record(uint64_t nanos) noexcept;
+
+    /** merge the counts of another histogram into this one */
+    void add(const LatencyHistogram& other) noexcept;
+
+    void reset() noexcept;
+
+    uint64_t count() const noexcept {
+      return m_totalCount;
+    }
+
+    uint64_t min() const noexcept {
+      return m_totalCount != 0 ? m_min : 0;
+    }
+
+    uint64_t max() const noexcept {
+      return m_max;
+    }
+
+    double mean() const noexcept {
+      return m_totalCount != 0 ? m_sum / m_totalCount : 0.0;
+    }
+
+    /** value at the given percentile in [0, 100] */
+    uint64_t percentile(double percentile) const noexcept;
+  };
+
+} /* namespace loadgen */
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * LoadGenMain.cpp
+ *
+ * snappy-odbc-bench: runs a configurable mix of point selects, range
+ * scans, batch inserts, updates and catalog calls from many threads
+ * against a DSN or connection string, and reports the throughput and
+ * latency percentiles of each operation as text, CSV or JSON.
+ */
+
+#include "LoadGenerator.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace io::snappydata::loadgen;
+
+namespace {
+
+  enum class Format {
+    TEXT, CSV, JSON
+  };
+
+  const double PERCENTILES[] = { 50.0, 90.0, 99.0, 99.9 };
+  const char* const PERCENTILE_NAMES[] = { "p50", "p90", "p99", "p999" };
+
+  void usage(const char* program) {
+    std::cerr << "Usage: " << program << " --conn <DSN=...|connection string>"
+        << " [--threads <n>] [--mode shared-env|thread-env|shared-conn]"
+        << " [--warmup <secs>] [--duration <secs>] [--interval <secs>]"
+        << " [--mix point=60,range=20,insert=10,update=5,catalog=5]"
+        << " [--rows <n>] [--range-rows <n>] [--row-array <n>]"
+        << " [--batch <n>] [--table <name>] [--no-setup]"
+        << " [--format text|csv|json] [--output <file>]" << std::endl;
+  }
+
+  bool parseMix(const char* arg, unsigned mix[NUM_OP_TYPES]) {
+    for (int i = 0; i < NUM_OP_TYPES; i++) {
+      mix[i] = 0;
+    }
+    unsigned total = 0;
+    std::string spec(arg);
+    size_t start = 0;
+    while (start < spec.size()) {
+      size_t end = spec.find(',', start);
+      if (end == std::string::npos) end = spec.size();
+      const std::string item = spec.substr(start, end - start);
+      const size_t eq = item.find('=');
+      if (eq == std::string::npos) {
+        return false;
+      }
+      const std::string name = item.substr(0, eq);
+      int op = 0;
+      while (op < NUM_OP_TYPES && name != opName(static_cast<OpType>(op))) {
+        op++;
+      }
+      if (op == NUM_OP_TYPES) {
+        return false;
+      }
+      mix[op] = static_cast<unsigned>(std::strtoul(
+          item.c_str() + eq + 1, nullptr, 10));
+      total += mix[op];
+      start = end + 1;
+    }
+    return total != 0;
+  }
+
+  bool parseArgs(int argc, const char* argv[], LoadOptions& options,
+      Format& format, std::string& outputFile) {
+    for (int i = 1; i < argc; i++) {
+      const char* arg = argv[i];
+      if (::strcmp(arg, "--no-setup") == 0) {
+        options.m_setup = false;
+        continue;
+      }
+      if (i + 1 >= argc) {
+        return false;
+      }
+      const char* value = argv[++i];
+      if (::strcmp(arg, "--conn") == 0) {
+        options.m_connStr = value;
+      } else if (::strcmp(arg, "--threads") == 0) {
+        options.m_numThreads = std::atoi(value);
+      } else if (::strcmp(arg, "--mode") == 0) {
+        if (::strcmp(value, "shared-env") == 0) {
+          options.m_mode = ConnectionMode::SHARED_ENV;
+        } else if (::strcmp(value, "thread-env") == 0) {
+          options.m_mode = ConnectionMode::THREAD_ENV;
+        } else if (::strcmp(value, "shared-conn") == 0) {
+          options.m_mode = ConnectionMode::SHARED_CONNECTION;
+        } else {
+          return false;
+        }
+      } else if (::strcmp(arg, "--warmup") == 0) {
+        options.m_warmupSecs = std::atoi(value);
+      } else if (::strcmp(arg, "--duration") == 0) {
+        options.m_durationSecs = std::atoi(value);
+      } else if (::strcmp(arg, "--interval") == 0) {
+        options.m_intervalSecs = std::atoi(value);
+      } else if (::strcmp(arg, "--mix") == 0) {
+        if (!parseMix(value, options.m_mix)) {
+          return false;
+        }
+      } else if (::strcmp(arg, "--rows") == 0) {
+        options.m_numRows = std::atoll(value);
+      } else if (::strcmp(arg, "--range-rows") == 0) {
+        options.m_rangeRows = std::atoi(value);
+      } else if (::strcmp(arg, "--row-array") == 0) {
+        options.m_rowArraySize = std::atoi(value);
+      } else if (::strcmp(arg, "--batch") == 0) {
+        options.m_batchSize = std::atoi(value);
+      } else if (::strcmp(arg, "--table") == 0) {
+        options.m_table = value;
+      } else if (::strcmp(arg, "--format") == 0) {
+        if (::strcmp(value, "text") == 0) {
+          format = Format::TEXT;
+        } else if (::strcmp(value, "csv") == 0) {
+          format = Format::CSV;
+        } else if (::strcmp(value, "json") == 0) {
+          format = Format::JSON;
+        } else {
+          return false;
+        }
+      } else if (::strcmp(arg, "--output") == 0) {
+        outputFile = value;
+      } else {
+        return false;
+      }
+    }
+    return !options.m_connStr.empty() && options.m_numThreads > 0 &&
+        options.m_warmupSecs >= 0 && options.m_durationSecs > 0 &&
+        options.m_numRows > 0 && options.m_rangeRows > 0 &&
+        options.m_rowArraySize > 0 && options.m_batchSize > 0;
+  }
+
+  inline double toMicros(uint64_t nanos) {
+    return nanos / 1000.0;
+  }
+
+  void writeText(const LoadGenerator& gen, std::ostream& out) {
+    const double secs = gen.elapsedSecs();
+    out << std::fixed << std::setprecision(1);
+    out << std::left << std::setw(8) << "op" << std::right
+        << std::setw(12) << "count" << std::setw(12) << "ops/s"
+        << std::setw(8) << "errors" << std::setw(10) << "mean(us)";
+    for (const char* name : PERCENTILE_NAMES) {
+      out << std::setw(10) << name;
+    }
+    out << std::setw(12) << "max(us)" << std::endl;
+    for (int op = 0; op < NUM_OP_TYPES; op++) {
+      const OpResult& result = gen.result(static_cast<OpType>(op));
+      const LatencyHistogram& latency = result.m_latency;
+      if (latency.count() == 0 && result.m_numErrors == 0) continue;
+      out << std::left << std::setw(8) << opName(static_cast<OpType>(op))
+          << std::right << std::setw(12) << latency.count()
+          << std::setw(12) << (latency.count() / secs)
+          << std::setw(8) << result.m_numErrors
+          << std::setw(10) << toMicros(static_cast<uint64_t>(latency.mean()));
+      for (double p : PERCENTILES) {
+        out << std::setw(10) << toMicros(latency.percentile(p));
+      }
+      out << std::setw(12) << toMicros(latency.max()) << std::endl;
+    }
+    out << std::endl << "ops/s per interval:";
+    for (double tps : gen.throughput()) {
+      out << ' ' << tps;
+    }
+    out << std::endl;
+  }
+
+  void writeCsv(const LoadGenerator& gen, std::ostream& out) {
+    const double secs = gen.elapsedSecs();
+    out << "op,count,ops_per_sec,errors,mean_us";
+    for (const char* name : PERCENTILE_NAMES) {
+      out << ',' << name << "_us";
+    }
+    out << ",max_us" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for (int op = 0; op < NUM_OP_TYPES; op++) {
+      const OpResult& result = gen.result(static_cast<OpType>(op));
+      const LatencyHistogram& latency = result.m_latency;
+      out << opName(static_cast<OpType>(op)) << ',' << latency.count()
+          << ',' << (latency.count() / secs) << ',' << result.m_numErrors
+          << ',' << (latency.mean() / 1000.0);
+      for (double p : PERCENTILES) {
+        out << ',' << toMicros(latency.percentile(p));
+      }
+      out << ',' << toMicros(latency.max()) << std::endl;
+    }
+  }
+
+  void writeJson(const LoadGenerator& gen, std::ostream& out) {
+    const LoadOptions& options = gen.options();
+    const double secs = gen.elapsedSecs();
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"threads\": " << options.m_numThreads
+        << ",\n  \"duration_secs\": " << secs << ",\n  \"operations\": [";
+    const char* sep = "\n";
+    for (int op = 0; op < NUM_OP_TYPES; op++) {
+      const OpResult& result = gen.result(static_cast<OpType>(op));
+      const LatencyHistogram& latency = result.m_latency;
+      out << sep << "    {\"op\": \"" << opName(static_cast<OpType>(op))
+          << "\", \"count\": " << latency.count() << ", \"ops_per_sec\": "
+          << (latency.count() / secs) << ", \"errors\": "
+          << result.m_numErrors << ", \"mean_us\": "
+          << (latency.mean() / 1000.0);
+      for (size_t i = 0; i < sizeof(PERCENTILES) / sizeof(*PERCENTILES);
+          i++) {
+        out << ", \"" << PERCENTILE_NAMES[i] << "_us\": "
+            << toMicros(latency.percentile(PERCENTILES[i]));
+      }
+      out << ", \"max_us\": " << toMicros(latency.max()) << '}';
+      sep = ",\n";
+    }
+    out << "\n  ],\n  \"ops_per_sec_per_interval\": [";
+    sep = "";
+    for (double tps : gen.throughput()) {
+      out << sep << tps;
+      sep = ", ";
+    }
+    out << "]\n}" << std::endl;
+  }
+
+} /* anonymous namespace */
+
+int main(int argc, const char* argv[]) {
+  LoadOptions options;
+  Format format = Format::TEXT;
+  std::string outputFile;
+  if (!parseArgs(argc, argv, options, format, outputFile)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  LoadGenerator gen(options);
+  if (!gen.run()) {
+    return 2;
+  }
+
+  std::ofstream file;
+  if (!outputFile.empty()) {
+    file.open(outputFile.c_str());
+    if (!file) {
+      std::cerr << "Failed to write " << outputFile << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& out = outputFile.empty() ? std::cout : file;
+  switch (format) {
+    case Format::TEXT:
+      writeText(gen, out);
+      break;
+    case Format::CSV:
+      writeCsv(gen, out);
+      break;
+    case Format::JSON:
+      writeJson(gen, out);
+      break;
+  }
+  return 0;
+}
@@ -0,0 +1,586 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * LoadGenerator.cpp
+ */
+
+#include "LoadGenerator.h"
+
+#ifdef _WINDOWS
+#include <windows.h>
+#endif
+extern "C" {
+#include <sqltypes.h>
+#include <sql.h>
+#include <sqlext.h>
+}
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+using namespace io::snappydata::loadgen;
+
+namespace {
+
+  const int VALUE_LEN = 100;
+
+  /** rows inserted per execute by the setup */
+  const int LOAD_BATCH = 1000;
+
+  typedef std::chrono::steady_clock Clock;
+
+  void printError(SQLSMALLINT handleType, SQLHANDLE handle,
+      const std::string& op) {
+    SQLCHAR sqlState[6] = { 0 };
+    SQLINTEGER errorCode = 0;
+    SQLCHAR message[1024] = { 0 };
+    SQLSMALLINT messageLen;
+    ::SQLGetDiagRec(handleType, handle, 1, sqlState, &errorCode, message,
+        sizeof(message), &messageLen);
+    std::cerr << op << " failed with SQLState=" << sqlState << ", ErrorCode="
+        << errorCode << ": " << message << std::endl;
+  }
+
+  bool check(SQLRETURN rc, SQLSMALLINT handleType, SQLHANDLE handle,
+      const std::string& op) {
+    if (SQL_SUCCEEDED(rc) || rc == SQL_NO_DATA) {
+      return true;
+    }
+    printError(handleType, handle, op);
+    return false;
+  }
+
+  SQLLEN fillValue(SQLCHAR* value, int64_t id) {
+    const int len = ::snprintf((char*)value, VALUE_LEN + 1,
+        "value-%lld-abcdefghijklmnopqrstuvwxyz", (long long)id);
+    return len < VALUE_LEN ? len : VALUE_LEN;
+  }
+
+  bool connect(SQLHENV env, SQLHDBC& conn, const std::string& connStr) {
+    if (!SQL_SUCCEEDED(::SQLAllocHandle(SQL_HANDLE_DBC, env, &conn))) {
+      printError(SQL_HANDLE_ENV, env, "SQLAllocHandle(DBC)");
+      return false;
+    }
+    if (!SQL_SUCCEEDED(::SQLDriverConnect(conn, nullptr,
+        (SQLCHAR*)connStr.c_str(), SQL_NTS, nullptr, 0, nullptr,
+        SQL_DRIVER_NOPROMPT))) {
+      printError(SQL_HANDLE_DBC, conn, "SQLDriverConnect");
+      ::SQLFreeHandle(SQL_HANDLE_DBC, conn);
+      conn = SQL_NULL_HDBC;
+      return false;
+    }
+    return true;
+  }
+
+  void disconnect(SQLHDBC conn) {
+    if (conn != SQL_NULL_HDBC) {
+      ::SQLDisconnect(conn);
+      ::SQLFreeHandle(SQL_HANDLE_DBC, conn);
+    }
+  }
+
+  SQLHENV allocEnvironment() {
+    SQLHENV env = SQL_NULL_HENV;
+    if (!SQL_SUCCEEDED(::SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &env))) {
+      std::cerr << "Failed to allocate an ODBC environment" << std::endl;
+      return SQL_NULL_HENV;
+    }
+    ::SQLSetEnvAttr(env, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+    return env;
+  }
+
+  /** xorshift64* for the keys and the operation mix */
+  inline uint64_t nextRandom(uint64_t& state) noexcept {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * UINT64_C(2685821657736338717);
+  }
+
+} /* anonymous namespace */
+
+namespace io {
+namespace snappydata {
+namespace loadgen {
+
+  /**
+   * A thread of the load with its own prepared statements and bound
+   * buffers for each operation type.
+   */
+  class LoadWorker final {
+  private:
+    LoadGenerator& m_gen;
+    const LoadOptions& m_options;
+    const int m_index;
+    SQLHENV m_env;
+    bool m_ownsEnv;
+    SQLHDBC m_conn;
+    bool m_ownsConn;
+    SQLHSTMT m_stmts[NUM_OP_TYPES];
+    bool m_failed[NUM_OP_TYPES];
+    uint64_t m_random;
+
+    SQLBIGINT m_id;
+    SQLBIGINT m_lowId;
+    SQLBIGINT m_highId;
+    SQLCHAR m_value[VALUE_LEN + 1];
+    SQLLEN m_valueLen;
+
+    SQLULEN m_numFetched;
+    std::vector<SQLBIGINT> m_rangeIds;
+    std::vector<SQLINTEGER> m_rangeKeys;
+    std::vector<SQLCHAR> m_rangeValues;
+    std::vector<SQLLEN> m_rangeValueLens;
+
+    int64_t m_nextInsertId;
+    std::vector<SQLBIGINT> m_insertIds;
+    std::vector<SQLINTEGER> m_insertKeys;
+    std::vector<SQLCHAR> m_insertValues;
+    std::vector<SQLLEN> m_insertValueLens;
+
+    std::thread m_thread;
+
+    SQLBIGINT randomId() noexcept {
+      return 1 + static_cast<SQLBIGINT>(nextRandom(m_random)
+          % static_cast<uint64_t>(m_options.m_numRows));
+    }
+
+    bool prepare(OpType op, const std::string& sql) {
+      SQLHSTMT& stmt = m_stmts[static_cast<int>(op)];
+      if (!SQL_SUCCEEDED(::SQLAllocHandle(SQL_HANDLE_STMT, m_conn, &stmt))) {
+        printError(SQL_HANDLE_DBC, m_conn, "SQLAllocHandle(STMT)");
+        stmt = SQL_NULL_HSTMT;
+        return false;
+      }
+      return sql.empty() || check(::SQLPrepare(stmt, (SQLCHAR*)sql.c_str(),
+          SQL_NTS), SQL_HANDLE_STMT, stmt, "SQLPrepare(" + sql + ")");
+    }
+
+    SQLRETURN fetchAll(SQLHSTMT stmt, bool scroll) {
+      SQLRETURN rc;
+      while (SQL_SUCCEEDED(rc = scroll
+          ? ::SQLFetchScroll(stmt, SQL_FETCH_NEXT, 0) : ::SQLFetch(stmt))) {
+      }
+      ::SQLFreeStmt(stmt, SQL_CLOSE);
+      return rc == SQL_NO_DATA ? SQL_SUCCESS : rc;
+    }
+
+    SQLRETURN execute(OpType op) {
+      SQLHSTMT stmt = m_stmts[static_cast<int>(op)];
+      SQLRETURN rc;
+      switch (op) {
+        case OpType::POINT_SELECT:
+          m_id = randomId();
+          rc = ::SQLExecute(stmt);
+          return SQL_SUCCEEDED(rc) ? fetchAll(stmt, false) : rc;
+        case OpType::RANGE_SCAN: {
+          const int64_t maxLow = std::max<int64_t>(1,
+              m_options.m_numRows - m_options.m_rangeRows + 1);
+          m_lowId = 1 + static_cast<SQLBIGINT>(nextRandom(m_random)
+              % static_cast<uint64_t>(maxLow));
+          m_highId = m_lowId + m_options.m_rangeRows - 1;
+          rc = ::SQLExecute(stmt);
+          return SQL_SUCCEEDED(rc) ? fetchAll(stmt, true) : rc;
+        }
+        case OpType::INSERT:
+          for (int i = 0; i < m_options.m_batchSize; i++) {
+            const int64_t id = m_nextInsertId++;
+            m_insertIds[i] = id;
+            m_insertKeys[i] = static_cast<SQLINTEGER>(id % 1000);
+            m_insertValueLens[i] = fillValue(
+                &m_insertValues[i * (VALUE_LEN + 1)], id);
+          }
+          return ::SQLExecute(stmt);
+        case OpType::UPDATE:
+          m_id = randomId();
+          m_valueLen = fillValue(m_value, static_cast<int64_t>(
+              nextRandom(m_random) >> 1));
+          return ::SQLExecute(stmt);
+        case OpType::CATALOG:
+          rc = ::SQLColumns(stmt, nullptr, 0, nullptr, 0,
+              (SQLCHAR*)m_options.m_table.c_str(), SQL_NTS, nullptr, 0);
+          return SQL_SUCCEEDED(rc) ? fetchAll(stmt, false) : rc;
+      }
+      return SQL_ERROR;
+    }
+
+    void run() {
+      unsigned cumulative[NUM_OP_TYPES];
+      unsigned total = 0;
+      for (int i = 0; i < NUM_OP_TYPES; i++) {
+        total += m_options.m_mix[i];
+        cumulative[i] = total;
+      }
+      while (!m_gen.m_stopped.load(std::memory_order_relaxed)) {
+        const unsigned pick = static_cast<unsigned>(
+            nextRandom(m_random) % total);
+        int opIndex = 0;
+        while (pick >= cumulative[opIndex]) opIndex++;
+
+        const bool measuring = m_gen.m_measuring.load(
+            std::memory_order_relaxed);
+        auto start = Clock::now();
+        const SQLRETURN rc = execute(static_cast<OpType>(opIndex));
+        auto end = Clock::now();
+        if (!SQL_SUCCEEDED(rc) && !m_failed[opIndex]) {
+          // print only the first error of each operation type
+          m_failed[opIndex] = true;
+          printError(SQL_HANDLE_STMT, m_stmts[opIndex],
+              opName(static_cast<OpType>(opIndex)));
+        }
+        if (measuring) {
+          OpResult& result = m_results[opIndex];
+          if (SQL_SUCCEEDED(rc)) {
+            result.m_latency.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    end - start).count()));
+          } else {
+            result.m_numErrors++;
+          }
+          m_numOps.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+
+  public:
+    OpResult m_results[NUM_OP_TYPES];
+    std::atomic<uint64_t> m_numOps;
+
+    LoadWorker(LoadGenerator& gen, int index) :
+        m_gen(gen), m_options(gen.m_options), m_index(index),
+        m_env(SQL_NULL_HENV), m_ownsEnv(false), m_conn(SQL_NULL_HDBC),
+        m_ownsConn(false), m_random(UINT64_C(0x9e3779b97f4a7c15)
+            * static_cast<uint64_t>(index + 1)), m_id(0), m_lowId(0),
+        m_highId(0), m_valueLen(0), m_numFetched(0),
+        m_nextInsertId(static_cast<int64_t>(index + 1)
+            * INT64_C(1000000000000)),
+        m_numOps(0) {
+      for (int i = 0; i < NUM_OP_TYPES; i++) {
+        m_stmts[i] = SQL_NULL_HSTMT;
+        m_failed[i] = false;
+      }
+    }
+
+    ~LoadWorker() {
+      join();
+      for (SQLHSTMT stmt : m_stmts) {
+        if (stmt != SQL_NULL_HSTMT) {
+          ::SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+        }
+      }
+      if (m_ownsConn) {
+        disconnect(m_conn);
+      }
+      if (m_ownsEnv) {
+        ::SQLFreeHandle(SQL_HANDLE_ENV, m_env);
+      }
+    }
+
+    /**
+     * Connect as per the ConnectionMode and prepare the statements of all
+     * the operations in the mix.
+     */
+    bool open(SQLHENV sharedEnv, SQLHDBC sharedConn) {
+      if (sharedConn != SQL_NULL_HDBC) {
+        m_env = sharedEnv;
+        m_conn = sharedConn;
+      } else {
+        if (sharedEnv != SQL_NULL_HENV) {
+          m_env = sharedEnv;
+        } else if ((m_env = allocEnvironment()) != SQL_NULL_HENV) {
+          m_ownsEnv = true;
+        } else {
+          return false;
+        }
+        if (!connect(m_env, m_conn, m_options.m_connStr)) {
+          return false;
+        }
+        m_ownsConn = true;
+      }
+
+      const std::string& table = m_options.m_table;
+      const unsigned* mix = m_options.m_mix;
+      if (mix[static_cast<int>(OpType::POINT_SELECT)] != 0) {
+        if (!prepare(OpType::POINT_SELECT, "SELECT ID, K, V FROM " + table
+            + " WHERE ID = ?")) {
+          return false;
+        }
+        ::SQLBindParameter(m_stmts[static_cast<int>(OpType::POINT_SELECT)],
+            1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT, 0, 0, &m_id, 0,
+            nullptr);
+      }
+      if (mix[static_cast<int>(OpType::RANGE_SCAN)] != 0) {
+        if (!prepare(OpType::RANGE_SCAN, "SELECT ID, K, V FROM " + table
+            + " WHERE ID BETWEEN ? AND ?")) {
+          return false;
+        }
+        SQLHSTMT stmt = m_stmts[static_cast<int>(OpType::RANGE_SCAN)];
+        const size_t arraySize = static_cast<size_t>(m_options.m_rowArraySize);
+        m_rangeIds.resize(arraySize);
+        m_rangeKeys.resize(arraySize);
+        m_rangeValues.resize(arraySize * (VALUE_LEN + 1));
+        m_rangeValueLens.resize(arraySize);
+        ::SQLBindParameter(stmt, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT,
+            SQL_BIGINT, 0, 0, &m_lowId, 0, nullptr);
+        ::SQLBindParameter(stmt, 2, SQL_PARAM_INPUT, SQL_C_SBIGINT,
+            SQL_BIGINT, 0, 0, &m_highId, 0, nullptr);
+        ::SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE,
+            (SQLPOINTER)arraySize, 0);
+        ::SQLSetStmtAttr(stmt, SQL_ATTR_ROWS_FETCHED_PTR, &m_numFetched, 0);
+        ::SQLBindCol(stmt, 1, SQL_C_SBIGINT, m_rangeIds.data(), 0, nullptr);
+        ::SQLBindCol(stmt, 2, SQL_C_LONG, m_rangeKeys.data(), 0, nullptr);
+        ::SQLBindCol(stmt, 3, SQL_C_CHAR, m_rangeValues.data(),
+            VALUE_LEN + 1, m_rangeValueLens.data());
+      }
+      if (mix[static_cast<int>(OpType::INSERT)] != 0) {
+        if (!prepare(OpType::INSERT, "INSERT INTO " + table
+            + "_INS VALUES (?, ?, ?)")) {
+          return false;
+        }
+        SQLHSTMT stmt = m_stmts[static_cast<int>(OpType::INSERT)];
+        const size_t batchSize = static_cast<size_t>(m_options.m_batchSize);
+        m_insertIds.resize(batchSize);
+        m_insertKeys.resize(batchSize);
+        m_insertValues.resize(batchSize * (VALUE_LEN + 1));
+        m_insertValueLens.resize(batchSize);
+        ::SQLSetStmtAttr(stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)batchSize,
+            0);
+        ::SQLBindParameter(stmt, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT,
+            SQL_BIGINT, 0, 0, m_insertIds.data(), 0, nullptr);
+        ::SQLBindParameter(stmt, 2, SQL_PARAM_INPUT, SQL_C_LONG,
+            SQL_INTEGER, 0, 0, m_insertKeys.data(), 0, nullptr);
+        ::SQLBindParameter(stmt, 3, SQL_PARAM_INPUT, SQL_C_CHAR,
+            SQL_VARCHAR, VALUE_LEN, 0, m_insertValues.data(), VALUE_LEN + 1,
+            m_insertValueLens.data());
+      }
+      if (mix[static_cast<int>(OpType::UPDATE)] != 0) {
+        if (!prepare(OpType::UPDATE, "UPDATE " + table
+            + " SET V = ? WHERE ID = ?")) {
+          return false;
+        }
+        SQLHSTMT stmt = m_stmts[static_cast<int>(OpType::UPDATE)];
+        ::SQLBindParameter(stmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR,
+            SQL_VARCHAR, VALUE_LEN, 0, m_value, sizeof(m_value),
+            &m_valueLen);
+        ::SQLBindParameter(stmt, 2, SQL_PARAM_INPUT, SQL_C_SBIGINT,
+            SQL_BIGINT, 0, 0, &m_id, 0, nullptr);
+      }
+      if (mix[static_cast<int>(OpType::CATALOG)] != 0) {
+        if (!prepare(OpType::CATALOG, std::string())) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    void start() {
+      m_thread = std::thread(&LoadWorker::run, this);
+    }
+
+    void join() {
+      if (m_thread.joinable()) {
+        m_thread.join();
+      }
+    }
+  };
+
+} /* namespace loadgen */
+} /* namespace snappydata */
+} /* namespace io */
+
+const char* io::snappydata::loadgen::opName(OpType op) noexcept {
+  switch (op) {
+    case OpType::POINT_SELECT:
+      return "point";
+    case OpType::RANGE_SCAN:
+      return "range";
+    case OpType::INSERT:
+      return "insert";
+    case OpType::UPDATE:
+      return "update";
+    case OpType::CATALOG:
+      return "catalog";
+  }
+  return "unknown";
+}
+
+LoadOptions::LoadOptions() :
+    m_connStr(), m_table("SNAPPY_ODBC_BENCH"), m_numThreads(4),
+    m_mode(ConnectionMode::SHARED_ENV), m_warmupSecs(10),
+    m_durationSecs(60), m_intervalSecs(1), m_numRows(100000),
+    m_rangeRows(100), m_rowArraySize(50), m_batchSize(100), m_mix(),
+    m_setup(true) {
+  m_mix[static_cast<int>(OpType::POINT_SELECT)] = 60;
+  m_mix[static_cast<int>(OpType::RANGE_SCAN)] = 20;
+  m_mix[static_cast<int>(OpType::INSERT)] = 10;
+  m_mix[static_cast<int>(OpType::UPDATE)] = 5;
+  m_mix[static_cast<int>(OpType::CATALOG)] = 5;
+}
+
+LoadGenerator::LoadGenerator(const LoadOptions& options) :
+    m_options(options), m_workers(), m_measuring(false), m_stopped(false),
+    m_results(), m_throughput(), m_elapsedSecs(0.0) {
+}
+
+LoadGenerator::~LoadGenerator() {
+  m_stopped.store(true);
+  m_workers.clear();
+}
+
+bool LoadGenerator::setup() {
+  SQLHENV env = allocEnvironment();
+  if (env == SQL_NULL_HENV) {
+    return false;
+  }
+  SQLHDBC conn = SQL_NULL_HDBC;
+  SQLHSTMT stmt = SQL_NULL_HSTMT;
+  bool success = connect(env, conn, m_options.m_connStr) && SQL_SUCCEEDED(
+      ::SQLAllocHandle(SQL_HANDLE_STMT, conn, &stmt));
+  const std::string& table = m_options.m_table;
+  const std::string columns = " (ID BIGINT NOT NULL, K INTEGER, "
+      "V VARCHAR(" + std::to_string(VALUE_LEN) + ")";
+  const std::string ddls[] = { "DROP TABLE IF EXISTS " + table,
+      "DROP TABLE IF EXISTS " + table + "_INS",
+      "CREATE TABLE " + table + columns + ", PRIMARY KEY (ID))",
+      "CREATE TABLE " + table + "_INS" + columns + ")" };
+  for (const std::string& ddl : ddls) {
+    if (!success) break;
+    success = check(::SQLExecDirect(stmt, (SQLCHAR*)ddl.c_str(), SQL_NTS),
+        SQL_HANDLE_STMT, stmt, ddl);
+  }
+
+  // load the rows with arrays of parameters
+  std::vector<SQLBIGINT> ids(LOAD_BATCH);
+  std::vector<SQLINTEGER> keys(LOAD_BATCH);
+  std::vector<SQLCHAR> values(LOAD_BATCH * (VALUE_LEN + 1));
+  std::vector<SQLLEN> valueLens(LOAD_BATCH);
+  SQLULEN paramSetSize = 0;
+  const std::string insert = "INSERT INTO " + table + " VALUES (?, ?, ?)";
+  if (success) {
+    success = check(::SQLPrepare(stmt, (SQLCHAR*)insert.c_str(), SQL_NTS),
+        SQL_HANDLE_STMT, stmt, insert);
+    ::SQLBindParameter(stmt, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT,
+        0, 0, ids.data(), 0, nullptr);
+    ::SQLBindParameter(stmt, 2, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+        0, 0, keys.data(), 0, nullptr);
+    ::SQLBindParameter(stmt, 3, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+        VALUE_LEN, 0, values.data(), VALUE_LEN + 1, valueLens.data());
+  }
+  std::cout << "Loading " << m_options.m_numRows << " rows into " << table
+      << std::endl;
+  for (int64_t id = 1; success && id <= m_options.m_numRows;) {
+    const SQLULEN batch = static_cast<SQLULEN>(std::min<int64_t>(LOAD_BATCH,
+        m_options.m_numRows - id + 1));
+    for (SQLULEN i = 0; i < batch; i++, id++) {
+      ids[i] = id;
+      keys[i] = static_cast<SQLINTEGER>(id % 1000);
+      valueLens[i] = fillValue(&values[i * (VALUE_LEN + 1)], id);
+    }
+    if (batch != paramSetSize) {
+      ::SQLSetStmtAttr(stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)batch, 0);
+      paramSetSize = batch;
+    }
+    success = check(::SQLExecute(stmt), SQL_HANDLE_STMT, stmt, insert);
+  }
+
+  if (stmt != SQL_NULL_HSTMT) {
+    ::SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+  }
+  disconnect(conn);
+  ::SQLFreeHandle(SQL_HANDLE_ENV, env);
+  return success;
+}
+
+bool LoadGenerator::run() {
+  if (m_options.m_setup && !setup()) {
+    return false;
+  }
+
+  SQLHENV sharedEnv = SQL_NULL_HENV;
+  SQLHDBC sharedConn = SQL_NULL_HDBC;
+  if (m_options.m_mode != ConnectionMode::THREAD_ENV) {
+    if ((sharedEnv = allocEnvironment()) == SQL_NULL_HENV) {
+      return false;
+    }
+    if (m_options.m_mode == ConnectionMode::SHARED_CONNECTION &&
+        !connect(sharedEnv, sharedConn, m_options.m_connStr)) {
+      ::SQLFreeHandle(SQL_HANDLE_ENV, sharedEnv);
+      return false;
+    }
+  }
+
+  bool success = true;
+  for (int i = 0; success && i < m_options.m_numThreads; i++) {
+    m_workers.emplace_back(new LoadWorker(*this, i));
+    success = m_workers.back()->open(sharedEnv, sharedConn);
+  }
+
+  if (success) {
+    std::cout << "Running " << m_options.m_numThreads << " threads with "
+        << m_options.m_warmupSecs << "s warmup and " << m_options.m_durationSecs
+        << "s timed run" << std::endl;
+    for (auto& worker : m_workers) {
+      worker->start();
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(m_options.m_warmupSecs));
+
+    m_measuring.store(true);
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::seconds(m_options.m_durationSecs);
+    const auto interval = std::chrono::seconds(
+        std::max(m_options.m_intervalSecs, 1));
+    auto sampleTime = start;
+    uint64_t lastOps = 0;
+    while (sampleTime < end) {
+      auto nextSample = std::min(sampleTime + interval, end);
+      std::this_thread::sleep_until(nextSample);
+      uint64_t numOps = 0;
+      for (auto& worker : m_workers) {
+        numOps += worker->m_numOps.load(std::memory_order_relaxed);
+      }
+      const double secs = std::chrono::duration<double>(
+          Clock::now() - sampleTime).count();
+      m_throughput.push_back(secs > 0.0 ? (numOps - lastOps) / secs : 0.0);
+      lastOps = numOps;
+      sampleTime = nextSample;
+    }
+    m_stopped.store(true);
+    for (auto& worker : m_workers) {
+      worker->join();
+    }
+    m_elapsedSecs = std::chrono::duration<double>(Clock::now()
+        - start).count();
+
+    for (auto& worker : m_workers) {
+      for (int op = 0; op < NUM_OP_TYPES; op++) {
+        m_results[op].m_latency.add(worker->m_results[op].m_latency);
+        m_results[op].m_numErrors += worker->m_results[op].m_numErrors;
+      }
+    }
+  }
+  m_stopped.store(true);
+  m_workers.clear();
+  disconnect(sharedConn);
+  if (sharedEnv != SQL_NULL_HENV) {
+    ::SQLFreeHandle(SQL_HANDLE_ENV, sharedEnv);
+  }
+  return success;
+}
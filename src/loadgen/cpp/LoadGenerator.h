@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * LoadGenerator.h
+ *
+ * Multi-threaded ODBC workload generator of snappy-odbc-bench.
+ */
+
+#ifndef LOADGENERATOR_H_
+#define LOADGENERATOR_H_
+
+#include "LatencyHistogram.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace io {
+namespace snappydata {
+namespace loadgen {
+
+  enum class OpType {
+    /** SELECT of one row by primary key */
+    POINT_SELECT,
+    /** SELECT of a key range fetched with a row array */
+    RANGE_SCAN,
+    /** INSERT of a batch with an array of parameters */
+    INSERT,
+    /** UPDATE of one row by primary key */
+    UPDATE,
+    /** SQLColumns on the benchmark table */
+    CATALOG
+  };
+
+  constexpr int NUM_OP_TYPES = static_cast<int>(OpType::CATALOG) + 1;
+
+  /** the name used for the operation in options and output */
+  const char* opName(OpType op) noexcept;
+
+  enum class ConnectionMode {
+    /** one environment with a connection per thread */
+    SHARED_ENV,
+    /** an environment and connection per thread */
+    THREAD_ENV,
+    /** statements of all threads on one connection */
+    SHARED_CONNECTION
+  };
+
+  struct LoadOptions {
+    std::string m_connStr;
+    std::string m_table;
+    int m_numThreads;
+    ConnectionMode m_mode;
+    int m_warmupSecs;
+    int m_durationSecs;
+    /** seconds between the throughput samples */
+    int m_intervalSecs;
+    /** rows loaded by the setup and the range of keys used */
+    int64_t m_numRows;
+    /** keys selected by a range scan */
+    int m_rangeRows;
+    /** SQL_ATTR_ROW_ARRAY_SIZE for the range scans */
+    int m_rowArraySize;
+    /** SQL_ATTR_PARAMSET_SIZE for the inserts */
+    int m_batchSize;
+    /** relative weight of each operation in the mix */
+    unsigned m_mix[NUM_OP_TYPES];
+    /** create and load the tables before the run */
+    bool m_setup;
+
+    LoadOptions();
+  };
+
+  /** measurements of one operation type over the timed run */
+  struct OpResult {
+    LatencyHistogram m_latency;
+    uint64_t m_numErrors;
+
+    OpResult() : m_latency(), m_numErrors(0) {
+    }
+  };
+
+  class LoadWorker;
+
+  class LoadGenerator final {
+  private:
+    const LoadOptions m_options;
+    std::vector<std::unique_ptr<LoadWorker>> m_workers;
+    std::atomic<bool> m_measuring;
+    std::atomic<bool> m_stopped;
+
+    OpResult m_results[NUM_OP_TYPES];
+    /** operations per second in each interval of the timed run */
+    std::vector<double> m_throughput;
+    double m_elapsedSecs;
+
+    bool setup();
+
+    friend class LoadWorker;
+
+  public:
+    explicit LoadGenerator(const LoadOptions& options);
+
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    /**
+     * Run the setup if configured, connect the threads, run the warmup
+     * and then the timed run. Returns false if the setup or a connection
+     * failed after printing the error.
+     */
+    bool run();
+
+    const LoadOptions& options() const noexcept {
+      return m_options;
+    }
+
+    const OpResult& result(OpType op) const noexcept {
+      return m_results[static_cast<int>(op)];
+    }
+
+    const std::vector<double>& throughput() const noexcept {
+      return m_throughput;
+    }
+
+    /** length of the timed run in seconds */
+    double elapsedSecs() const noexcept {
+      return m_elapsedSecs;
+    }
+  };
+
+} /* namespace loadgen */
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* LOADGENERATOR_H_ */
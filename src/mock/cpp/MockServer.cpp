@@ -0,0 +1,881 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * MockServer.cpp
+ */
+
+#include "MockServer.h"
+#include "../../driver/cpp/TextConversions.h"
+
+#include <Parameters.h>
+#include <SnappyDataService.h>
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/server/TThreadedServer.h>
+#include <thrift/transport/TBufferTransports.h>
+#include <thrift/transport/TServerSocket.h>
+#include <thrift/transport/TVirtualTransport.h>
+
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace io::snappydata;
+using namespace io::snappydata::mock;
+
+namespace at = apache::thrift;
+
+namespace {
+
+  /**
+   * Paces the bytes read and written on a connection to the configured
+   * bandwidth. Sits below the buffered or framed transport so that the
+   * limit applies to what goes on the wire.
+   */
+  class ThrottledTransport final : public at::transport::TVirtualTransport<
+      ThrottledTransport> {
+  private:
+    std::shared_ptr<at::transport::TTransport> m_transport;
+    const std::atomic<uint64_t>& m_bandwidth;
+    std::chrono::steady_clock::time_point m_readFree;
+    std::chrono::steady_clock::time_point m_writeFree;
+
+    void pace(std::chrono::steady_clock::time_point& nextFree,
+        uint32_t numBytes) {
+      const uint64_t bandwidth = m_bandwidth.load(std::memory_order_relaxed);
+      if (bandwidth == 0 || numBytes == 0) return;
+
+      auto now = std::chrono::steady_clock::now();
+      if (nextFree < now) nextFree = now;
+      nextFree += std::chrono::microseconds(
+          (numBytes * UINT64_C(1000000)) / bandwidth);
+      std::this_thread::sleep_until(nextFree);
+    }
+
+  public:
+    ThrottledTransport(std::shared_ptr<at::transport::TTransport> transport,
+        const std::atomic<uint64_t>& bandwidth) :
+        m_transport(std::move(transport)), m_bandwidth(bandwidth),
+        m_readFree(), m_writeFree() {
+    }
+
+    bool isOpen() const override {
+      return m_transport->isOpen();
+    }
+
+    bool peek() override {
+      return m_transport->peek();
+    }
+
+    void open() override {
+      m_transport->open();
+    }
+
+    void close() override {
+      m_transport->close();
+    }
+
+    uint32_t read(uint8_t* buf, uint32_t len) {
+      const uint32_t n = m_transport->read(buf, len);
+      pace(m_readFree, n);
+      return n;
+    }
+
+    void write(const uint8_t* buf, uint32_t len) {
+      pace(m_writeFree, len);
+      m_transport->write(buf, len);
+    }
+
+    void flush() override {
+      m_transport->flush();
+    }
+  };
+
+  class ThrottledTransportFactory final :
+      public at::transport::TTransportFactory {
+  private:
+    std::shared_ptr<at::transport::TTransportFactory> m_factory;
+    const std::atomic<uint64_t>& m_bandwidth;
+
+  public:
+    ThrottledTransportFactory(
+        std::shared_ptr<at::transport::TTransportFactory> factory,
+        const std::atomic<uint64_t>& bandwidth) :
+        m_factory(std::move(factory)), m_bandwidth(bandwidth) {
+    }
+
+    std::shared_ptr<at::transport::TTransport> getTransport(
+        std::shared_ptr<at::transport::TTransport> trans) override {
+      return m_factory->getTransport(std::make_shared<ThrottledTransport>(
+          std::move(trans), m_bandwidth));
+    }
+  };
+
+  /** signals the thread waiting in MockServer::start once listening */
+  class ServeListener final : public at::server::TServerEventHandler {
+  private:
+    std::promise<void> m_listening;
+
+  public:
+    std::future<void> listening() {
+      return m_listening.get_future();
+    }
+
+    void preServe() override {
+      m_listening.set_value();
+    }
+  };
+
+  /** splitmix64 so that each row can be generated independently */
+  inline uint64_t nextRandom(uint64_t& state) noexcept {
+    uint64_t z = (state += UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+  }
+
+  inline double toUnit(uint64_t v) noexcept {
+    return (v >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  bool isQuery(const std::string& sql) {
+    auto pos = std::find_if(sql.begin(), sql.end(), [](char c) {
+      return !std::isspace(static_cast<unsigned char>(c));
+    });
+    static const char select[] = "select";
+    for (const char* p = select; *p; ++p, ++pos) {
+      if (pos == sql.end() || std::tolower(
+          static_cast<unsigned char>(*pos)) != *p) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void checkShape(const ResultShape& shape) {
+    for (const auto& spec : shape.m_columns) {
+      if (spec.m_type > thrift::SnappyType::CLOB
+          || spec.m_type < thrift::SnappyType::BOOLEAN) {
+        throw std::invalid_argument("MockServer: unsupported column type "
+            + std::to_string(spec.m_type));
+      }
+    }
+  }
+
+  int32_t numParameters(const std::string& sql) {
+    return static_cast<int32_t>(std::count(sql.begin(), sql.end(), '?'));
+  }
+
+  void throwError(const char* sqlState, const std::string& reason) {
+    thrift::SnappyException se;
+    se.exceptionData.__set_reason(reason);
+    se.exceptionData.__set_sqlState(sqlState);
+    se.exceptionData.__set_errorCode(20000);
+    se.__set_serverInfo("MockServer");
+    throw se;
+  }
+
+} /* anonymous namespace */
+
+namespace io {
+namespace snappydata {
+namespace mock {
+
+  /**
+   * The service implementation. Calls not overridden here are the no-op
+   * ones of the generated SnappyDataServiceNull.
+   */
+  class MockHandler final : public thrift::SnappyDataServiceNull {
+  private:
+    struct Statement {
+      int64_t m_connId;
+      std::string m_sql;
+    };
+
+    struct Cursor {
+      std::shared_ptr<const ResultShape> m_shape;
+      int64_t m_connId;
+      int64_t m_stmtId;
+      /** index of the row after the last one sent */
+      int64_t m_position;
+    };
+
+    const MockServerOptions m_options;
+    std::atomic<int64_t> m_latency;
+
+    std::mutex m_lock;
+    std::unordered_map<std::string, std::shared_ptr<const ResultShape>>
+        m_results;
+    std::shared_ptr<const ResultShape> m_defaultResult;
+    std::unordered_map<int64_t, Statement> m_statements;
+    std::unordered_map<int64_t, Cursor> m_cursors;
+    int64_t m_nextId;
+
+    void serviceDelay() {
+      m_numCalls.fetch_add(1, std::memory_order_relaxed);
+      const int64_t latency = m_latency.load(std::memory_order_relaxed);
+      if (latency > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(latency));
+      }
+    }
+
+    std::shared_ptr<const ResultShape> lookupResult(const std::string& sql) {
+      std::lock_guard<std::mutex> sync(m_lock);
+      auto r = m_results.find(sql);
+      if (r != m_results.end()) {
+        return r->second;
+      } else if (isQuery(sql)) {
+        return m_defaultResult;
+      } else {
+        return nullptr;
+      }
+    }
+
+    static thrift::ColumnDescriptor describe(const ColumnSpec& spec,
+        int32_t columnNum) {
+      thrift::ColumnDescriptor desc;
+      thrift::SnappyType::type type = spec.m_type;
+      // LOBs are served inline
+      if (type == thrift::SnappyType::CLOB) {
+        type = thrift::SnappyType::LONGVARCHAR;
+      } else if (type == thrift::SnappyType::BLOB) {
+        type = thrift::SnappyType::LONGVARBINARY;
+      }
+      desc.__set_type(type);
+      desc.__set_descriptorFlags(spec.m_nullRatio > 0.0
+          ? thrift::snappydataConstants::COLUMN_NULLABLE
+          : thrift::snappydataConstants::COLUMN_NONULLS);
+      desc.__set_name("C" + std::to_string(columnNum));
+      desc.__set_fullTableName("APP.MOCK");
+      switch (type) {
+        case thrift::SnappyType::CHAR:
+        case thrift::SnappyType::VARCHAR:
+        case thrift::SnappyType::LONGVARCHAR:
+        case thrift::SnappyType::BINARY:
+        case thrift::SnappyType::VARBINARY:
+        case thrift::SnappyType::LONGVARBINARY:
+          desc.__set_precision(std::max(spec.m_width, 1));
+          break;
+        case thrift::SnappyType::DECIMAL:
+          desc.__set_precision(std::max(spec.m_width, 4));
+          desc.__set_scale(2);
+          break;
+        default:
+          break;
+      }
+      return desc;
+    }
+
+    static void fillValue(client::Parameters& row, int32_t columnNum,
+        const ColumnSpec& spec, uint64_t& state, std::string& buf) {
+      const uint64_t v = nextRandom(state);
+      if (spec.m_nullRatio > 0.0 && toUnit(v) < spec.m_nullRatio) {
+        row.setNull(columnNum, true);
+        return;
+      }
+      const uint64_t r = nextRandom(state);
+      switch (spec.m_type) {
+        case thrift::SnappyType::BOOLEAN:
+          row.setBoolean(columnNum, (r & 1) != 0);
+          break;
+        case thrift::SnappyType::TINYINT:
+          row.setByte(columnNum, static_cast<int8_t>(r));
+          break;
+        case thrift::SnappyType::SMALLINT:
+          row.setShort(columnNum, static_cast<int16_t>(r));
+          break;
+        case thrift::SnappyType::INTEGER:
+          row.setInt(columnNum, static_cast<int32_t>(r));
+          break;
+        case thrift::SnappyType::BIGINT:
+          row.setInt64(columnNum, static_cast<int64_t>(r));
+          break;
+        case thrift::SnappyType::FLOAT:
+          row.setFloat(columnNum, static_cast<float>(toUnit(r) * 1.0e6));
+          break;
+        case thrift::SnappyType::DOUBLE:
+          row.setDouble(columnNum, toUnit(r) * 1.0e9);
+          break;
+        case thrift::SnappyType::DECIMAL: {
+          const int precision = std::max(spec.m_width, 4);
+          // at most (precision - 2) integral digits with scale 2
+          buf.assign(std::to_string(r % UINT64_C(1000000000000000000)));
+          buf.resize(std::min<size_t>(buf.size(), precision));
+          while (buf.size() < 3) buf.insert(0, 1, '0');
+          buf.insert(buf.size() - 2, 1, '.');
+          uint8_t magnitude[TextConversions::MAX_DECIMAL_BYTES];
+          size_t magLen;
+          int scale, signum;
+          TextConversions::parseDecimal(buf.data(), buf.size(), magnitude,
+              magLen, scale, signum);
+          if (signum == 0) {
+            row.setDecimal(columnNum, client::Decimal::ZERO);
+          } else {
+            row.setDecimal(columnNum, signum, scale,
+                (const int8_t*)magnitude, magLen, false);
+          }
+          break;
+        }
+        case thrift::SnappyType::CHAR:
+        case thrift::SnappyType::VARCHAR:
+        case thrift::SnappyType::LONGVARCHAR:
+        case thrift::SnappyType::CLOB:
+        case thrift::SnappyType::BINARY:
+        case thrift::SnappyType::VARBINARY:
+        case thrift::SnappyType::LONGVARBINARY:
+        case thrift::SnappyType::BLOB: {
+          static const char s_chars[] =
+              "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+          const size_t width = std::max(spec.m_width, 1);
+          const size_t len = spec.m_type == thrift::SnappyType::CHAR
+              ? width : (width + 1) / 2 + (r % (width / 2 + 1));
+          buf.resize(len);
+          uint64_t bits = r;
+          for (size_t i = 0; i < len; i++) {
+            if ((i & 7) == 7) bits = nextRandom(state);
+            buf[i] = s_chars[(bits & 0xff) % (sizeof(s_chars) - 1)];
+            bits >>= 8;
+          }
+          if (spec.m_type == thrift::SnappyType::BINARY
+              || spec.m_type == thrift::SnappyType::VARBINARY
+              || spec.m_type == thrift::SnappyType::LONGVARBINARY
+              || spec.m_type == thrift::SnappyType::BLOB) {
+            row.setBinary(columnNum, (const int8_t*)buf.data(), len);
+          } else {
+            row.setString(columnNum, buf.data(), len);
+          }
+          break;
+        }
+        case thrift::SnappyType::DATE:
+          row.setDate(columnNum, client::DateTime(1970 + (r % 100),
+              1 + ((r >> 8) % 12), 1 + ((r >> 16) % 28)));
+          break;
+        case thrift::SnappyType::TIME:
+          row.setTime(columnNum, client::DateTime(1970, 1, 1,
+              (r % 24), ((r >> 8) % 60), ((r >> 16) % 60)));
+          break;
+        case thrift::SnappyType::TIMESTAMP:
+          row.setTimestamp(columnNum, client::Timestamp(1970 + (r % 100),
+              1 + ((r >> 8) % 12), 1 + ((r >> 16) % 28), ((r >> 24) % 24),
+              ((r >> 32) % 60), ((r >> 40) % 60),
+              static_cast<uint32_t>((r >> 44) % 1000000) * 1000));
+          break;
+        default:
+          // rejected by MockServer::setResult
+          row.setNull(columnNum, true);
+          break;
+      }
+    }
+
+    /**
+     * Fill the batch of rows starting at the given one. The rows are
+     * generated from a state seeded with the row number so every row is
+     * the same in any scan of the result.
+     */
+    void fillRows(thrift::RowSet& rs, const ResultShape& shape,
+        int64_t start, int32_t batchSize) {
+      const int64_t end = std::min(shape.m_numRows, start + batchSize);
+      const int32_t numColumns = static_cast<int32_t>(shape.m_columns.size());
+      std::string buf;
+      rs.rows.reserve(static_cast<size_t>(std::max<int64_t>(end - start, 0)));
+      for (int64_t rowNum = start; rowNum < end; rowNum++) {
+        uint64_t state = shape.m_seed * UINT64_C(0x100000001b3)
+            ^ static_cast<uint64_t>(rowNum);
+        client::Parameters row;
+        row.resize(numColumns);
+        for (int32_t i = 0; i < numColumns; i++) {
+          fillValue(row, i + 1, shape.m_columns[i], state, buf);
+        }
+        rs.rows.emplace_back(std::move(row));
+      }
+      rs.__set_offset(static_cast<int32_t>(start));
+      m_numRowsSent.fetch_add(rs.rows.size(), std::memory_order_relaxed);
+    }
+
+    void openResult(thrift::RowSet& rs, int64_t connId, int64_t stmtId,
+        std::shared_ptr<const ResultShape> shape,
+        const thrift::StatementAttrs& attrs) {
+      const int32_t batchSize = (attrs.__isset.batchSize
+          && attrs.batchSize > 0) ? attrs.batchSize : m_options.m_batchSize;
+
+      std::vector<thrift::ColumnDescriptor> metadata;
+      metadata.reserve(shape->m_columns.size());
+      int32_t columnNum = 0;
+      for (const auto& spec : shape->m_columns) {
+        metadata.push_back(describe(spec, ++columnNum));
+      }
+      rs.__set_metadata(std::move(metadata));
+      rs.connId = connId;
+      rs.statementId = stmtId;
+      fillRows(rs, *shape, 0, batchSize);
+
+      const int64_t position = static_cast<int64_t>(rs.rows.size());
+      if (position >= shape->m_numRows) {
+        rs.flags = thrift::snappydataConstants::ROWSET_LAST_BATCH;
+        rs.cursorId = thrift::snappydataConstants::INVALID_ID;
+      } else {
+        std::lock_guard<std::mutex> sync(m_lock);
+        const int64_t cursorId = m_nextId++;
+        m_cursors.emplace(cursorId, Cursor { std::move(shape), connId,
+            stmtId, position });
+        rs.flags = 0;
+        rs.cursorId = cursorId;
+      }
+    }
+
+    void executeSQL(thrift::StatementResult& result, int64_t connId,
+        int64_t stmtId, const std::string& sql, int32_t numParamRows,
+        const thrift::StatementAttrs& attrs) {
+      m_numParamRows.fetch_add(numParamRows, std::memory_order_relaxed);
+      if (auto shape = lookupResult(sql)) {
+        thrift::RowSet rs;
+        openResult(rs, connId, stmtId, std::move(shape), attrs);
+        result.__set_resultSet(std::move(rs));
+      } else if (numParamRows > 1) {
+        result.__set_batchUpdateCounts(std::vector<int32_t>(numParamRows, 1));
+      } else {
+        result.__set_updateCount(1);
+      }
+    }
+
+    Statement getStatement(int64_t stmtId) {
+      std::lock_guard<std::mutex> sync(m_lock);
+      auto s = m_statements.find(stmtId);
+      if (s == m_statements.end()) {
+        throwError("XJ012", "unknown statement ID " + std::to_string(stmtId));
+      }
+      return s->second;
+    }
+
+  public:
+    std::atomic<uint64_t> m_bandwidth;
+    std::atomic<uint64_t> m_numCalls;
+    std::atomic<uint64_t> m_numParamRows;
+    std::atomic<uint64_t> m_numRowsSent;
+    std::string m_host;
+    int m_port;
+
+    explicit MockHandler(const MockServerOptions& options) :
+        m_options(options), m_latency(options.m_latency.count()), m_lock(),
+        m_results(), m_defaultResult(std::make_shared<ResultShape>(
+            std::vector<ColumnSpec> { ColumnSpec(thrift::SnappyType::INTEGER),
+                ColumnSpec(thrift::SnappyType::VARCHAR, 32) }, 1)),
+        m_statements(), m_cursors(), m_nextId(1),
+        m_bandwidth(options.m_bandwidth), m_numCalls(0), m_numParamRows(0),
+        m_numRowsSent(0), m_host("127.0.0.1"), m_port(0) {
+    }
+
+    void setResult(const std::string& sql, const ResultShape& shape) {
+      auto result = std::make_shared<ResultShape>(shape);
+      std::lock_guard<std::mutex> sync(m_lock);
+      m_results[sql] = std::move(result);
+    }
+
+    void setDefaultResult(const ResultShape& shape) {
+      auto result = std::make_shared<ResultShape>(shape);
+      std::lock_guard<std::mutex> sync(m_lock);
+      m_defaultResult = std::move(result);
+    }
+
+    void setLatency(std::chrono::microseconds latency) {
+      m_latency.store(latency.count(), std::memory_order_relaxed);
+    }
+
+    void getPreferredServer(thrift::HostAddress& _return,
+        const std::set<thrift::ServerType::type>& serverTypes,
+        const std::set<std::string>& serverGroups,
+        const std::set<thrift::HostAddress>& failedServers) override {
+      serviceDelay();
+      _return.__set_hostName(m_host);
+      _return.__set_port(m_port);
+    }
+
+    void getAllServersWithPreferredServer(
+        std::vector<thrift::HostAddress>& _return,
+        const std::set<thrift::ServerType::type>& serverTypes,
+        const std::set<std::string>& serverGroups,
+        const std::set<thrift::HostAddress>& failedServers) override {
+      thrift::HostAddress server;
+      getPreferredServer(server, serverTypes, serverGroups, failedServers);
+      _return.push_back(std::move(server));
+    }
+
+    void openConnection(thrift::ConnectionProperties& _return,
+        const thrift::OpenConnectionArgs& arguments) override {
+      serviceDelay();
+      std::lock_guard<std::mutex> sync(m_lock);
+      _return.__set_connId(m_nextId++);
+      _return.__set_clientHostName(arguments.clientHostName);
+      _return.__set_clientID(arguments.clientID);
+      if (arguments.__isset.userName) {
+        _return.__set_userName(arguments.userName);
+        _return.__set_defaultSchema(arguments.userName);
+      } else {
+        _return.__set_defaultSchema("APP");
+      }
+    }
+
+    void execute(thrift::StatementResult& _return, const int64_t connId,
+        const std::string& sql,
+        const std::map<int32_t, thrift::OutputParameter>& outputParams,
+        const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      executeSQL(_return, connId, thrift::snappydataConstants::INVALID_ID,
+          sql, 0, attrs);
+    }
+
+    void executeUpdate(thrift::UpdateResult& _return, const int64_t connId,
+        const std::vector<std::string>& sqls,
+        const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      if (sqls.size() == 1) {
+        _return.__set_updateCount(1);
+      } else {
+        _return.__set_batchUpdateCounts(std::vector<int32_t>(
+            sqls.size(), 1));
+      }
+    }
+
+    void executeQuery(thrift::RowSet& _return, const int64_t connId,
+        const std::string& sql, const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      auto shape = lookupResult(sql);
+      if (!shape) {
+        throwError("X0Y79", "statement does not return a result: " + sql);
+      }
+      openResult(_return, connId, thrift::snappydataConstants::INVALID_ID,
+          std::move(shape), attrs);
+    }
+
+    void prepareStatement(thrift::PrepareResult& _return,
+        const int64_t connId, const std::string& sql,
+        const std::map<int32_t, thrift::OutputParameter>& outputParams,
+        const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      auto shape = lookupResult(sql);
+      std::vector<thrift::ColumnDescriptor> params;
+      const int32_t numParams = numParameters(sql);
+      for (int32_t i = 1; i <= numParams; i++) {
+        params.push_back(describe(ColumnSpec(thrift::SnappyType::VARCHAR,
+            32672, 1.0), i));
+      }
+      _return.__set_parameterMetaData(std::move(params));
+      if (shape) {
+        std::vector<thrift::ColumnDescriptor> metadata;
+        int32_t columnNum = 0;
+        for (const auto& spec : shape->m_columns) {
+          metadata.push_back(describe(spec, ++columnNum));
+        }
+        _return.__set_resultSetMetaData(std::move(metadata));
+        _return.__set_statementType(
+            thrift::snappydataConstants::STATEMENT_TYPE_SELECT);
+      } else {
+        _return.__set_statementType(
+            thrift::snappydataConstants::STATEMENT_TYPE_INSERT);
+      }
+      std::lock_guard<std::mutex> sync(m_lock);
+      const int64_t stmtId = m_nextId++;
+      m_statements.emplace(stmtId, Statement { connId, sql });
+      _return.__set_statementId(stmtId);
+    }
+
+    void executePrepared(thrift::StatementResult& _return,
+        const int64_t stmtId, const thrift::Row& params,
+        const std::map<int32_t, thrift::OutputParameter>& outputParams,
+        const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      const Statement stmt = getStatement(stmtId);
+      executeSQL(_return, stmt.m_connId, stmtId, stmt.m_sql, 1, attrs);
+    }
+
+    void executePreparedUpdate(thrift::UpdateResult& _return,
+        const int64_t stmtId, const thrift::Row& params,
+        const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      getStatement(stmtId);
+      m_numParamRows.fetch_add(1, std::memory_order_relaxed);
+      _return.__set_updateCount(1);
+    }
+
+    void executePreparedQuery(thrift::RowSet& _return, const int64_t stmtId,
+        const thrift::Row& params, const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      const Statement stmt = getStatement(stmtId);
+      m_numParamRows.fetch_add(1, std::memory_order_relaxed);
+      auto shape = lookupResult(stmt.m_sql);
+      if (!shape) {
+        throwError("X0Y79", "statement does not return a result: "
+            + stmt.m_sql);
+      }
+      openResult(_return, stmt.m_connId, stmtId, std::move(shape), attrs);
+    }
+
+    void executePreparedBatch(thrift::UpdateResult& _return,
+        const int64_t stmtId, const std::vector<thrift::Row>& paramsBatch,
+        const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      serviceDelay();
+      getStatement(stmtId);
+      m_numParamRows.fetch_add(paramsBatch.size(), std::memory_order_relaxed);
+      _return.__set_batchUpdateCounts(std::vector<int32_t>(
+          paramsBatch.size(), 1));
+    }
+
+    void prepareAndExecute(thrift::StatementResult& _return,
+        const int64_t connId, const std::string& sql,
+        const std::vector<thrift::Row>& paramsBatch,
+        const std::map<int32_t, thrift::OutputParameter>& outputParams,
+        const thrift::StatementAttrs& attrs,
+        const std::string& token) override {
+      thrift::PrepareResult prepared;
+      prepareStatement(prepared, connId, sql, outputParams, attrs, token);
+      executeSQL(_return, connId, prepared.statementId, sql,
+          static_cast<int32_t>(paramsBatch.size()), attrs);
+      _return.__set_preparedResult(std::move(prepared));
+    }
+
+    void getNextResultSet(thrift::RowSet& _return, const int64_t cursorId,
+        const int8_t otherResultSetBehaviour,
+        const std::string& token) override {
+      serviceDelay();
+      // only single results are generated
+      closeResultSet(cursorId, token);
+      _return.flags = thrift::snappydataConstants::ROWSET_LAST_BATCH;
+      _return.cursorId = thrift::snappydataConstants::INVALID_ID;
+    }
+
+    void scrollCursor(thrift::RowSet& _return, const int64_t cursorId,
+        const int32_t offset, const bool offsetIsAbsolute,
+        const bool fetchReverse, const int32_t fetchSize,
+        const std::string& token) override {
+      serviceDelay();
+      std::unique_lock<std::mutex> sync(m_lock);
+      auto c = m_cursors.find(cursorId);
+      if (c == m_cursors.end()) {
+        throwError("XCL16", "unknown cursor ID " + std::to_string(cursorId));
+      }
+      Cursor& cursor = c->second;
+      const int64_t numRows = cursor.m_shape->m_numRows;
+      const int32_t batchSize = fetchSize > 0 ? fetchSize
+          : m_options.m_batchSize;
+      int64_t start = offsetIsAbsolute
+          ? (offset >= 0 ? offset : numRows + offset)
+          : cursor.m_position + offset;
+      // a reverse fetch returns the batch ending at the position
+      if (fetchReverse) start -= batchSize;
+      start = std::max<int64_t>(0, std::min(start, numRows));
+      auto shape = cursor.m_shape;
+      _return.connId = cursor.m_connId;
+      _return.statementId = cursor.m_stmtId;
+      _return.cursorId = cursorId;
+      sync.unlock();
+
+      fillRows(_return, *shape, start, batchSize);
+      const int64_t position = start + static_cast<int64_t>(
+          _return.rows.size());
+      _return.flags = position >= numRows
+          ? thrift::snappydataConstants::ROWSET_LAST_BATCH : 0;
+
+      sync.lock();
+      c = m_cursors.find(cursorId);
+      if (c != m_cursors.end()) {
+        c->second.m_position = position;
+      }
+    }
+
+    void closeResultSet(const int64_t cursorId,
+        const std::string& token) override {
+      std::lock_guard<std::mutex> sync(m_lock);
+      m_cursors.erase(cursorId);
+    }
+
+    void closeStatement(const int64_t stmtId,
+        const std::string& token) override {
+      std::lock_guard<std::mutex> sync(m_lock);
+      m_statements.erase(stmtId);
+    }
+
+    void closeConnection(const int64_t connId, const bool closeSocket,
+        const std::string& token) override {
+      std::lock_guard<std::mutex> sync(m_lock);
+      for (auto s = m_statements.begin(); s != m_statements.end();) {
+        if (s->second.m_connId == connId) {
+          s = m_statements.erase(s);
+        } else {
+          ++s;
+        }
+      }
+      for (auto c = m_cursors.begin(); c != m_cursors.end();) {
+        if (c->second.m_connId == connId) {
+          c = m_cursors.erase(c);
+        } else {
+          ++c;
+        }
+      }
+    }
+  };
+
+} /* namespace mock */
+} /* namespace snappydata */
+} /* namespace io */
+
+MockServer::MockServer(const MockServerOptions& options) :
+    m_options(options), m_handler(std::make_shared<MockHandler>(options)),
+    m_server(), m_serveThread(), m_port(0) {
+}
+
+MockServer::~MockServer() {
+  try {
+    stop();
+  } catch (...) {
+    // ignore in destructor
+  }
+}
+
+void MockServer::start() {
+  if (m_server) {
+    return;
+  }
+  auto serverSocket = std::make_shared<at::transport::TServerSocket>(
+      "127.0.0.1", m_options.m_port);
+  std::shared_ptr<at::transport::TTransportFactory> transportFactory;
+  if (m_options.m_framedTransport) {
+    transportFactory = std::make_shared<
+        at::transport::TFramedTransportFactory>();
+  } else {
+    transportFactory = std::make_shared<
+        at::transport::TBufferedTransportFactory>();
+  }
+  transportFactory = std::make_shared<ThrottledTransportFactory>(
+      std::move(transportFactory), m_handler->m_bandwidth);
+  std::shared_ptr<at::protocol::TProtocolFactory> protocolFactory;
+  if (m_options.m_binaryProtocol) {
+    protocolFactory = std::make_shared<
+        at::protocol::TBinaryProtocolFactory>();
+  } else {
+    protocolFactory = std::make_shared<
+        at::protocol::TCompactProtocolFactory>();
+  }
+  auto processor = std::make_shared<thrift::SnappyDataServiceProcessor>(
+      m_handler);
+  auto listener = std::make_shared<ServeListener>();
+  auto listening = listener->listening();
+
+  m_server = std::make_shared<at::server::TThreadedServer>(processor,
+      serverSocket, transportFactory, protocolFactory);
+  m_server->setServerEventHandler(listener);
+
+  auto server = m_server;
+  std::promise<void> failed;
+  auto failure = failed.get_future();
+  m_serveThread = std::thread([server](std::promise<void> failed) {
+    try {
+      server->serve();
+      failed.set_value();
+    } catch (...) {
+      failed.set_exception(std::current_exception());
+    }
+  }, std::move(failed));
+
+  // wait for either the listener or a failure to bind
+  while (listening.wait_for(std::chrono::milliseconds(10))
+      != std::future_status::ready) {
+    if (failure.wait_for(std::chrono::seconds(0))
+        == std::future_status::ready) {
+      m_serveThread.join();
+      m_server.reset();
+      failure.get();
+      throw std::runtime_error("MockServer stopped before listening");
+    }
+  }
+  m_handler->m_port = serverSocket->getPort();
+  m_port.store(m_handler->m_port, std::memory_order_release);
+}
+
+void MockServer::stop() {
+  if (m_server) {
+    m_server->stop();
+    if (m_serveThread.joinable()) {
+      m_serveThread.join();
+    }
+    m_server.reset();
+    m_port.store(0, std::memory_order_release);
+  }
+}
+
+std::string MockServer::getConnectionString() const {
+  std::string connStr;
+  connStr.append("Server=127.0.0.1;Port=").append(std::to_string(getPort()));
+  connStr.append(";User=app;Password=app;LoadBalance=false"
+      ";AutoReconnect=false;CredentialManager=false");
+  if (m_options.m_binaryProtocol) {
+    connStr.append(";BinaryProtocol=true");
+  }
+  if (m_options.m_framedTransport) {
+    connStr.append(";FramedTransport=true");
+  }
+  return connStr;
+}
+
+void MockServer::setResult(const std::string& sql,
+    const ResultShape& shape) {
+  checkShape(shape);
+  m_handler->setResult(sql, shape);
+}
+
+void MockServer::setDefaultResult(const ResultShape& shape) {
+  checkShape(shape);
+  m_handler->setDefaultResult(shape);
+}
+
+void MockServer::setLatency(std::chrono::microseconds latency) {
+  m_handler->setLatency(latency);
+}
+
+void MockServer::setBandwidth(uint64_t bytesPerSecond) {
+  m_handler->m_bandwidth.store(bytesPerSecond, std::memory_order_relaxed);
+}
+
+uint64_t MockServer::getNumCalls() const {
+  return m_handler->m_numCalls.load(std::memory_order_relaxed);
+}
+
+uint64_t MockServer::getNumParamRows() const {
+  return m_handler->m_numParamRows.load(std::memory_order_relaxed);
+}
+
+uint64_t MockServer::getNumRowsSent() const {
+  return m_handler->m_numRowsSent.load(std::memory_order_relaxed);
+}
+
+void MockServer::resetStats() {
+  m_handler->m_numCalls.store(0, std::memory_order_relaxed);
+  m_handler->m_numParamRows.store(0, std::memory_order_relaxed);
+  m_handler->m_numRowsSent.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+/**
+ * MockServer.h
+ *
+ * An in-process stand-in for a SnappyData server that speaks the same
+ * thrift protocol as the native client and serves generated results, so
+ * that the driver can be tested and benchmarked without a cluster.
+ */
+
+#ifndef MOCKSERVER_H_
+#define MOCKSERVER_H_
+
+#include <Types.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace apache {
+namespace thrift {
+namespace server {
+  class TServer;
+}
+}
+}
+
+namespace io {
+namespace snappydata {
+namespace mock {
+
+  class MockHandler;
+
+  /**
+   * Shape of one column of a generated result. The width is the maximum
+   * length for character and binary columns (the generated values vary
+   * between half and the full width) and the precision for DECIMAL.
+   */
+  struct ColumnSpec {
+    thrift::SnappyType::type m_type;
+    int32_t m_width;
+    /** fraction of the values that are null in [0, 1] */
+    double m_nullRatio;
+
+    ColumnSpec(thrift::SnappyType::type type, int32_t width = 0,
+        double nullRatio = 0.0) :
+        m_type(type), m_width(width), m_nullRatio(nullRatio) {
+    }
+  };
+
+  /**
+   * Shape of a generated result set. The values of a row depend only on
+   * the seed and the row number so every scan of a result, in whatever
+   * batches, sees the same data.
+   */
+  struct ResultShape {
+    std::vector<ColumnSpec> m_columns;
+    int64_t m_numRows;
+    uint64_t m_seed;
+
+    ResultShape() : m_columns(), m_numRows(0), m_seed(0) {
+    }
+
+    ResultShape(std::vector<ColumnSpec> columns, int64_t numRows,
+        uint64_t seed = 1) :
+        m_columns(std::move(columns)), m_numRows(numRows), m_seed(seed) {
+    }
+  };
+
+  struct MockServerOptions {
+    /** port to listen on with zero for an ephemeral port */
+    int m_port;
+    /** rows per batch when the client does not ask for a fetch size */
+    int32_t m_batchSize;
+    /** added to the service time of every call */
+    std::chrono::microseconds m_latency;
+    /**
+     * bytes per second allowed on each connection in either direction
+     * with zero for no limit
+     */
+    uint64_t m_bandwidth;
+    /** use TBinaryProtocol instead of the default TCompactProtocol */
+    bool m_binaryProtocol;
+    /** use framed instead of buffered transport */
+    bool m_framedTransport;
+
+    MockServerOptions() :
+        m_port(0), m_batchSize(1024), m_latency(0), m_bandwidth(0),
+        m_binaryProtocol(false), m_framedTransport(false) {
+    }
+  };
+
+  /**
+   * A loopback thrift server for the driver tests and benchmarks.
+   *
+   * SELECT statements (and those registered with setResult) return rows
+   * generated from a ResultShape while all other statements succeed with
+   * an update count of one per statement or batch row. The latency and
+   * bandwidth limits can be changed while the server is running.
+   */
+  class MockServer final {
+  private:
+    MockServerOptions m_options;
+    std::shared_ptr<MockHandler> m_handler;
+    std::shared_ptr<apache::thrift::server::TServer> m_server;
+    std::thread m_serveThread;
+    std::atomic<int> m_port;
+
+  public:
+    explicit MockServer(const MockServerOptions& options =
+        MockServerOptions());
+
+    ~MockServer();
+
+    MockServer(const MockServer&) = delete;
+    MockServer& operator=(const MockServer&) = delete;
+
+    /** start serving in a background thread and wait till it listens */
+    void start();
+
+    /** stop the server and wait for the serving thread to end */
+    void stop();
+
+    int getPort() const noexcept {
+      return m_port.load(std::memory_order_acquire);
+    }
+
+    /** a driver connection string without the Driver or DSN part */
+    std::string getConnectionString() const;
+
+    /** rows returned for the given statement text */
+    void setResult(const std::string& sql, const ResultShape& shape);
+
+    /** rows returned for the SELECT statements without a setResult */
+    void setDefaultResult(const ResultShape& shape);
+
+    void setLatency(std::chrono::microseconds latency);
+
+    void setBandwidth(uint64_t bytesPerSecond);
+
+    /** number of service calls received so far */
+    uint64_t getNumCalls() const;
+
+    /** number of parameter rows received in executes and batches */
+    uint64_t getNumParamRows() const;
+
+    /** number of result rows sent so far */
+    uint64_t getNumRowsSent() const;
+
+    /** forget the statistics above */
+    void resetStats();
+  };
+
+} /* namespace mock */
+} /* namespace snappydata */
+} /* namespace io */
+
+#endif /* MOCKSERVER_H_ */
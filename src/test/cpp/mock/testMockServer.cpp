@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+#include "../unit/TestHelper.h"
+#include "../../../mock/cpp/MockServer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace io::snappydata;
+using namespace io::snappydata::mock;
+
+//*-------------------------------------------------------------------------
+#define TESTNAME "MockServer"
+
+#define MOCK_ROWS 10000
+#define MOCK_BATCH 1000
+#define MOCK_PARAM_ROWS 100
+
+//*-------------------------------------------------------------------------
+
+/**
+ * Runs the driver against an in-process MockServer so these tests need
+ * neither a cluster nor the network.
+ */
+class MockServerTest : public ::testing::Test {
+protected:
+  static MockServer* s_server;
+
+  SQLHENV henv = SQL_NULL_HENV;
+  SQLHDBC hdbc = SQL_NULL_HDBC;
+  SQLHSTMT hstmt = SQL_NULL_HSTMT;
+
+  static void SetUpTestCase() {
+    MockServerOptions options;
+    options.m_batchSize = MOCK_BATCH;
+    s_server = new MockServer(options);
+    s_server->start();
+  }
+
+  static void TearDownTestCase() {
+    delete s_server;
+    s_server = nullptr;
+  }
+
+  void SetUp() override {
+    s_server->resetStats();
+    s_server->setLatency(std::chrono::microseconds(0));
+    s_server->setBandwidth(0);
+    connect(s_server->getConnectionString());
+  }
+
+  void TearDown() override {
+    disconnect();
+  }
+
+  void connect(const std::string& connStr) {
+    SQLRETURN retcode = SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &henv);
+    DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+        "SQLAllocHandle (HENV)");
+    retcode = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3,
+        0);
+    DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+        "SQLSetEnvAttr (HENV)");
+    retcode = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLAllocHandle (HDBC)");
+    retcode = SQLDriverConnect(hdbc, nullptr, (SQLCHAR*)connStr.c_str(),
+        SQL_NTS, nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLDriverConnect");
+    retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLAllocHandle (HSTMT)");
+  }
+
+  void disconnect() {
+    if (henv == SQL_NULL_HENV) return;
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+    SQLDisconnect(hdbc);
+    SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+    SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    hstmt = SQL_NULL_HSTMT;
+    hdbc = SQL_NULL_HDBC;
+    henv = SQL_NULL_HENV;
+  }
+};
+
+MockServer* MockServerTest::s_server = nullptr;
+
+TEST_F(MockServerTest, FetchGeneratedRows) {
+  s_server->setResult("SELECT * FROM MOCK_FETCH", ResultShape({
+      ColumnSpec(thrift::SnappyType::INTEGER),
+      ColumnSpec(thrift::SnappyType::VARCHAR, 20, 0.5),
+      ColumnSpec(thrift::SnappyType::DOUBLE) }, MOCK_ROWS));
+
+  SQLINTEGER id;
+  SQLCHAR name[32];
+  SQLLEN nameInd;
+  SQLDOUBLE value;
+  SQLRETURN retcode = SQLExecDirect(hstmt,
+      (SQLCHAR*)"SELECT * FROM MOCK_FETCH", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  SQLSMALLINT numCols = 0;
+  retcode = SQLNumResultCols(hstmt, &numCols);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLNumResultCols");
+  EXPECT_EQ(3, numCols);
+
+  SQLBindCol(hstmt, 1, SQL_C_LONG, &id, sizeof(id), nullptr);
+  SQLBindCol(hstmt, 2, SQL_C_CHAR, name, sizeof(name), &nameInd);
+  SQLBindCol(hstmt, 3, SQL_C_DOUBLE, &value, sizeof(value), nullptr);
+  int numRows = 0, numNulls = 0;
+  while ((retcode = SQLFetch(hstmt)) != SQL_NO_DATA) {
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch?");
+    if (!SQL_SUCCEEDED(retcode)) break;
+    if (nameInd == SQL_NULL_DATA) {
+      numNulls++;
+    } else {
+      EXPECT_GE(20, nameInd);
+      EXPECT_LE(10, nameInd);
+    }
+    numRows++;
+  }
+  EXPECT_EQ(MOCK_ROWS, numRows);
+  // null ratio of 0.5 over 10000 rows
+  EXPECT_LT(MOCK_ROWS * 4 / 10, numNulls);
+  EXPECT_GT(MOCK_ROWS * 6 / 10, numNulls);
+  EXPECT_EQ((uint64_t)MOCK_ROWS, s_server->getNumRowsSent());
+  // one batch with the execute and the rest with cursor scrolls
+  EXPECT_LE((uint64_t)(MOCK_ROWS / MOCK_BATCH), s_server->getNumCalls());
+  SQLCloseCursor(hstmt);
+}
+
+#define MOCK_ROWSET 7
+
+TEST_F(MockServerTest, PositionedAccessInRowset) {
+  // rowsets of 7 rows straddle the batches of 1000 rows from the server
+  s_server->setResult("SELECT * FROM MOCK_ROWSET", ResultShape({
+      ColumnSpec(thrift::SnappyType::INTEGER) }, MOCK_ROWS));
+
+  SQLINTEGER ids[MOCK_ROWSET];
+  SQLLEN idInds[MOCK_ROWSET];
+  SQLULEN numFetched = 0;
+  SQLRETURN retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE,
+      (SQLPOINTER)MOCK_ROWSET, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &numFetched, 0);
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM MOCK_ROWSET",
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  SQLBindCol(hstmt, 1, SQL_C_LONG, ids, sizeof(SQLINTEGER), idInds);
+
+  int numRows = 0;
+  while ((retcode = SQLFetch(hstmt)) != SQL_NO_DATA) {
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch?");
+    if (!SQL_SUCCEEDED(retcode)) break;
+    // every row of the rowset, and not just the last one, is addressable
+    for (SQLULEN i = 0; i < numFetched; i++) {
+      retcode = SQLSetPos(hstmt, (SQLSETPOSIROW)(i + 1), SQL_POSITION,
+          SQL_LOCK_NO_CHANGE);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLSetPos");
+      SQLINTEGER id = 0;
+      SQLLEN idInd = 0;
+      retcode = SQLGetData(hstmt, 1, SQL_C_LONG, &id, sizeof(id), &idInd);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLGetData");
+      EXPECT_EQ(ids[i], id);
+      EXPECT_EQ(idInds[i], idInd);
+    }
+    numRows += (int)numFetched;
+  }
+  EXPECT_EQ(MOCK_ROWS, numRows);
+  SQLCloseCursor(hstmt);
+}
+
+TEST_F(MockServerTest, FixedWidthColumnWithoutBufferLength) {
+  // BufferLength is ignored for fixed-length C types so zero is allowed
+  s_server->setResult("SELECT * FROM MOCK_FIXED_WIDTH", ResultShape({
+      ColumnSpec(thrift::SnappyType::BIGINT) }, MOCK_ROWS));
+
+  SQLBIGINT ids[MOCK_ROWSET];
+  SQLULEN numFetched = 0;
+  SQLRETURN retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE,
+      (SQLPOINTER)MOCK_ROWSET, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &numFetched, 0);
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM MOCK_FIXED_WIDTH",
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  SQLBindCol(hstmt, 1, SQL_C_SBIGINT, ids, 0, nullptr);
+
+  int numRows = 0;
+  while ((retcode = SQLFetch(hstmt)) != SQL_NO_DATA) {
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch?");
+    if (!SQL_SUCCEEDED(retcode)) break;
+    // every element of the array holds the value of its own row
+    for (SQLULEN i = 0; i < numFetched; i++) {
+      retcode = SQLSetPos(hstmt, (SQLSETPOSIROW)(i + 1), SQL_POSITION,
+          SQL_LOCK_NO_CHANGE);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLSetPos");
+      SQLBIGINT id = 0;
+      retcode = SQLGetData(hstmt, 1, SQL_C_SBIGINT, &id, 0, nullptr);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLGetData");
+      EXPECT_EQ(ids[i], id);
+    }
+    numRows += (int)numFetched;
+  }
+  EXPECT_EQ(MOCK_ROWS, numRows);
+  SQLCloseCursor(hstmt);
+}
+
+TEST_F(MockServerTest, PositionedAccessWithReadAhead) {
+  // positioning within the rows read ahead must not lose any of them
+  disconnect();
+  connect(s_server->getConnectionString() + ";ReadAheadRows=100");
+  s_server->setResult("SELECT * FROM MOCK_READ_AHEAD", ResultShape({
+      ColumnSpec(thrift::SnappyType::INTEGER) }, MOCK_ROWS));
+
+  const SQLULEN rowsetSizes[] = { 1, MOCK_ROWSET };
+  for (SQLULEN rowsetSize : rowsetSizes) {
+    SQLINTEGER ids[MOCK_ROWSET];
+    SQLULEN numFetched = 0;
+    SQLRETURN retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE,
+        (SQLPOINTER)rowsetSize, 0);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLSetStmtAttr");
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &numFetched, 0);
+    retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM MOCK_READ_AHEAD",
+        SQL_NTS);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLExecDirect");
+    SQLBindCol(hstmt, 1, SQL_C_LONG, ids, sizeof(SQLINTEGER), nullptr);
+
+    int numRows = 0;
+    while ((retcode = SQLFetch(hstmt)) != SQL_NO_DATA) {
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLFetch?");
+      if (!SQL_SUCCEEDED(retcode)) break;
+      retcode = SQLSetPos(hstmt, (SQLSETPOSIROW)numFetched, SQL_POSITION,
+          SQL_LOCK_NO_CHANGE);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLSetPos");
+      SQLINTEGER id = 0;
+      retcode = SQLGetData(hstmt, 1, SQL_C_LONG, &id, sizeof(id), nullptr);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLGetData");
+      EXPECT_EQ(ids[numFetched - 1], id);
+      numRows += (int)numFetched;
+    }
+    EXPECT_EQ(MOCK_ROWS, numRows);
+    EXPECT_EQ((uint64_t)MOCK_ROWS, s_server->getNumRowsSent());
+    SQLCloseCursor(hstmt);
+    SQLFreeStmt(hstmt, SQL_UNBIND);
+    s_server->resetStats();
+  }
+}
+
+TEST_F(MockServerTest, NullWithoutIndicator) {
+  s_server->setResult("SELECT * FROM MOCK_NULLS", ResultShape({
+      ColumnSpec(thrift::SnappyType::INTEGER, 0, 1.0),
+      ColumnSpec(thrift::SnappyType::VARCHAR, 20, 1.0) }, 10));
+
+  SQLRETURN retcode = SQLExecDirect(hstmt,
+      (SQLCHAR*)"SELECT * FROM MOCK_NULLS", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  SQLCHAR sqlState[6];
+
+  // a NULL cannot be fetched into a column bound without an indicator
+  SQLINTEGER id = 0;
+  SQLBindCol(hstmt, 1, SQL_C_LONG, &id, sizeof(id), nullptr);
+  retcode = SQLFetch(hstmt);
+  EXPECT_EQ(SQL_ERROR, retcode);
+  SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sqlState, nullptr, nullptr, 0,
+      nullptr);
+  EXPECT_STREQ("22002", (const char*)sqlState);
+
+  // nor read by SQLGetData without an indicator
+  SQLFreeStmt(hstmt, SQL_UNBIND);
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  SQLCHAR name[32];
+  retcode = SQLGetData(hstmt, 2, SQL_C_CHAR, name, sizeof(name), nullptr);
+  EXPECT_EQ(SQL_ERROR, retcode);
+  SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sqlState, nullptr, nullptr, 0,
+      nullptr);
+  EXPECT_STREQ("22002", (const char*)sqlState);
+  retcode = SQLGetData(hstmt, 1, SQL_C_LONG, &id, sizeof(id), nullptr);
+  EXPECT_EQ(SQL_ERROR, retcode);
+
+  // and is returned as SQL_NULL_DATA when there is one
+  SQLLEN nameInd = 0;
+  retcode = SQLGetData(hstmt, 2, SQL_C_CHAR, name, sizeof(name), &nameInd);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLGetData");
+  EXPECT_EQ(SQL_NULL_DATA, nameInd);
+  SQLCloseCursor(hstmt);
+}
+
+TEST_F(MockServerTest, ArrayOfParameters) {
+  SQLINTEGER ids[MOCK_PARAM_ROWS];
+  for (int i = 0; i < MOCK_PARAM_ROWS; i++) {
+    ids[i] = i + 1;
+  }
+  SQLRETURN retcode = SQLPrepare(hstmt,
+      (SQLCHAR*)"INSERT INTO MOCK_INSERT VALUES (?)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLPrepare");
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE,
+      (SQLPOINTER)MOCK_PARAM_ROWS, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  retcode = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+      SQL_INTEGER, 0, 0, ids, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  retcode = SQLExecute(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecute");
+
+  SQLLEN rowCount = 0;
+  retcode = SQLRowCount(hstmt, &rowCount);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLRowCount");
+  EXPECT_EQ(MOCK_PARAM_ROWS, rowCount);
+  EXPECT_EQ((uint64_t)MOCK_PARAM_ROWS, s_server->getNumParamRows());
+}
+
+TEST_F(MockServerTest, IntegerTextParameters) {
+  SQLRETURN retcode = SQLPrepare(hstmt,
+      (SQLCHAR*)"INSERT INTO MOCK_INSERT VALUES (?)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLPrepare");
+  SQLCHAR text[32];
+  SQLCHAR sqlState[6];
+  const struct {
+    SQLSMALLINT sqlType;
+    const char* text;
+    SQLRETURN expected;
+    const char* sqlState;
+  } cases[] = {
+    { SQL_BIGINT, "9007199254740993.0", SQL_SUCCESS, nullptr },
+    { SQL_BIGINT, "9223372036854775807.0", SQL_SUCCESS, nullptr },
+    { SQL_INTEGER, "12.7", SQL_SUCCESS_WITH_INFO, "01S07" },
+    { SQL_INTEGER, "12a", SQL_ERROR, "22018" },
+    { SQL_BIGINT, "9223372036854775808", SQL_ERROR, "22003" },
+    { SQL_INTEGER, "2147483648", SQL_ERROR, "22003" },
+  };
+  for (const auto& c : cases) {
+    ::strcpy((char*)text, c.text);
+    retcode = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR,
+        c.sqlType, 0, 0, text, sizeof(text), nullptr);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLBindParameter");
+    retcode = SQLExecute(hstmt);
+    EXPECT_EQ(c.expected, retcode) << c.text;
+    if (c.sqlState) {
+      SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sqlState, nullptr, nullptr,
+          0, nullptr);
+      EXPECT_STREQ(c.sqlState, (const char*)sqlState) << c.text;
+    }
+  }
+}
+
+TEST_F(MockServerTest, EmulatedLatency) {
+  const auto latency = std::chrono::milliseconds(20);
+  s_server->setLatency(latency);
+
+  auto start = std::chrono::steady_clock::now();
+  SQLRETURN retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT 1", SQL_NTS);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  EXPECT_LE(latency, elapsed);
+  SQLCloseCursor(hstmt);
+}
+
+// driver specific attributes for the performance counters
+#define SQL_ATTR_PERF_ROUND_TRIPS 50301
+#define SQL_ATTR_PERF_ROWS_FETCHED 50302
+#define SQL_ATTR_PERF_BATCHES_FETCHED 50303
+#define SQL_ATTR_PERF_EXECUTES 50305
+#define SQL_ATTR_PERF_NETWORK_NANOS 50306
+
+TEST_F(MockServerTest, PerformanceCounters) {
+  const auto latency = std::chrono::milliseconds(5);
+  s_server->setLatency(latency);
+  s_server->setResult("SELECT * FROM MOCK_COUNTERS", ResultShape({
+      ColumnSpec(thrift::SnappyType::INTEGER) }, MOCK_ROWS));
+
+  SQLINTEGER id;
+  SQLRETURN retcode = SQLExecDirect(hstmt,
+      (SQLCHAR*)"SELECT * FROM MOCK_COUNTERS", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  SQLBindCol(hstmt, 1, SQL_C_LONG, &id, sizeof(id), nullptr);
+  int numRows = 0;
+  while ((retcode = SQLFetch(hstmt)) != SQL_NO_DATA) {
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch?");
+    if (!SQL_SUCCEEDED(retcode)) break;
+    numRows++;
+  }
+  EXPECT_EQ(MOCK_ROWS, numRows);
+
+  SQLUBIGINT rows = 0, batches = 0, roundTrips = 0, executes = 0, nanos = 0;
+  retcode = SQLGetStmtAttr(hstmt, SQL_ATTR_PERF_ROWS_FETCHED, &rows, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLGetStmtAttr");
+  SQLGetStmtAttr(hstmt, SQL_ATTR_PERF_BATCHES_FETCHED, &batches, 0, nullptr);
+  SQLGetStmtAttr(hstmt, SQL_ATTR_PERF_ROUND_TRIPS, &roundTrips, 0, nullptr);
+  SQLGetStmtAttr(hstmt, SQL_ATTR_PERF_EXECUTES, &executes, 0, nullptr);
+  SQLGetStmtAttr(hstmt, SQL_ATTR_PERF_NETWORK_NANOS, &nanos, 0, nullptr);
+  EXPECT_EQ((SQLUBIGINT)MOCK_ROWS, rows);
+  EXPECT_LE((SQLUBIGINT)(MOCK_ROWS / MOCK_BATCH), batches);
+  // the first batch comes with the execute and the rest with a round trip
+  EXPECT_EQ(batches, roundTrips);
+  EXPECT_EQ(1u, executes);
+  EXPECT_LE((SQLUBIGINT)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      latency).count() * roundTrips, nanos);
+
+  // the connection and environment include the counts of the statement
+  SQLUBIGINT connRows = 0, envRows = 0;
+  retcode = SQLGetConnectAttr(hdbc, SQL_ATTR_PERF_ROWS_FETCHED, &connRows, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLGetConnectAttr");
+  retcode = SQLGetEnvAttr(henv, SQL_ATTR_PERF_ROWS_FETCHED, &envRows, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLGetEnvAttr");
+  EXPECT_LE(rows, connRows);
+  EXPECT_LE(connRows, envRows);
+  SQLCloseCursor(hstmt);
+}
+
+TEST_F(MockServerTest, TraceEvents) {
+  const std::string traceFile = "mock-trace-events.json";
+  // the trace is completed when the last environment is freed
+  disconnect();
+  connect(s_server->getConnectionString() + ";TraceEventsFile=" +
+      traceFile);
+
+  SQLINTEGER value;
+  SQLRETURN retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT 1", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  SQLBindCol(hstmt, 1, SQL_C_LONG, &value, sizeof(value), nullptr);
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  SQLCloseCursor(hstmt);
+  disconnect();
+
+  std::ifstream in(traceFile.c_str());
+  ASSERT_TRUE(in.good());
+  std::stringstream trace;
+  trace << in.rdbuf();
+  in.close();
+  const std::string events = trace.str();
+  ASSERT_FALSE(events.empty());
+  EXPECT_EQ('[', events.front());
+  EXPECT_NE(std::string::npos, events.rfind(']'));
+  EXPECT_NE(std::string::npos, events.find(
+      "{\"name\":\"SQLExecDirect\",\"cat\":\"odbc\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, events.find(
+      "{\"name\":\"SQLFetch\",\"cat\":\"odbc\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, events.find("\"cat\":\"network\""));
+  EXPECT_NE(std::string::npos, events.find("\"cat\":\"conversion\""));
+  std::remove(traceFile.c_str());
+}
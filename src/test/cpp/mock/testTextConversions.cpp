@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018 SnappyData, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you
+ * may not use this file except in compliance with the License. You
+ * may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License. See accompanying
+ * LICENSE file.
+ */
+
+#include "../unit/TestHelper.h"
+#include "../../../driver/cpp/TextConversions.h"
+
+#include <limits>
+
+using namespace io::snappydata;
+
+//*-------------------------------------------------------------------------
+#define TESTNAME "TextConversions"
+
+//*-------------------------------------------------------------------------
+
+TEST(TextConversionsTest, ParseIntegral) {
+  int64_t v = 0;
+  bool truncated, overflow;
+  // integral digits are exact even beyond the precision of a double
+  EXPECT_TRUE(TextConversions::parseIntegral("9007199254740993.0", 18, v,
+      truncated, overflow));
+  EXPECT_EQ(9007199254740993LL, v);
+  EXPECT_FALSE(truncated);
+  EXPECT_TRUE(TextConversions::parseIntegral("9223372036854775807.0", 21,
+      v, truncated, overflow));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), v);
+  EXPECT_TRUE(TextConversions::parseIntegral(" -9223372036854775808 ", 22,
+      v, truncated, overflow));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), v);
+
+  // a non-zero fraction is discarded and reported
+  EXPECT_TRUE(TextConversions::parseIntegral("12.7", 4, v, truncated,
+      overflow));
+  EXPECT_EQ(12, v);
+  EXPECT_TRUE(truncated);
+
+  EXPECT_FALSE(TextConversions::parseIntegral("12a", 3, v, truncated,
+      overflow));
+  EXPECT_FALSE(overflow);
+  EXPECT_FALSE(TextConversions::parseIntegral("1e3", 3, v, truncated,
+      overflow));
+  EXPECT_FALSE(overflow);
+  EXPECT_FALSE(TextConversions::parseIntegral("-.", 2, v, truncated,
+      overflow));
+  EXPECT_FALSE(overflow);
+  EXPECT_FALSE(TextConversions::parseIntegral("9223372036854775808", 19,
+      v, truncated, overflow));
+  EXPECT_TRUE(overflow);
+}
@@ -201,3 +201,40 @@ TEST(SQLAllocHandle, MultipleEnv) {
   DIAGRECCHECK(SQL_HANDLE_ENV, henv1, 1, SQL_SUCCESS, retcode,
       "SQLFreeHandle (HENV)");
 }
+
+TEST(SQLAllocHandle, StatementChurn) {
+  DECLARE_SQLHANDLES
+
+  //init sql handles (stmt, dbc, env)
+  INIT_SQLHANDLES
+
+  // statement handles freed and allocated again are recycled by the driver
+  for (int i = 0; i < 1000; i++) {
+    SQLHSTMT stmt = SQL_NULL_HSTMT;
+    retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &stmt);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLAllocHandle (HSTMT)");
+
+    // implicit descriptors are created on first request and kept
+    if (i % 100 == 0) {
+      SQLHDESC ard1 = SQL_NULL_HDESC, ard2 = SQL_NULL_HDESC;
+      retcode = SQLGetStmtAttr(stmt, SQL_ATTR_APP_ROW_DESC, &ard1, 0,
+          nullptr);
+      DIAGRECCHECK(SQL_HANDLE_STMT, stmt, 1, SQL_SUCCESS, retcode,
+          "SQLGetStmtAttr");
+      retcode = SQLGetStmtAttr(stmt, SQL_ATTR_APP_ROW_DESC, &ard2, 0,
+          nullptr);
+      DIAGRECCHECK(SQL_HANDLE_STMT, stmt, 1, SQL_SUCCESS, retcode,
+          "SQLGetStmtAttr");
+      EXPECT_TRUE(ard1 != SQL_NULL_HDESC);
+      EXPECT_EQ(ard1, ard2);
+    }
+
+    retcode = SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, stmt, 1, SQL_SUCCESS, retcode,
+        "SQLFreeHandle (HSTMT)");
+  }
+
+  //free sql handles (stmt, dbc, env)
+  FREE_SQLHANDLES
+}
@@ -472,3 +472,100 @@ TEST(SQLBindparameter, RowBinding) {
   //free sql handles
   FREE_SQLHANDLES
 }
+
+#define TEXT_ARRAY_SIZE 3
+#define TEXT_LEN 32
+
+TEST(SQLBindparameter, TextAsTypedValues) {
+  DECLARE_SQLHANDLES
+
+  SQLCHAR IdArray[TEXT_ARRAY_SIZE][TEXT_LEN] = { "1", "2x", "3" };
+  SQLCHAR PriceArray[TEXT_ARRAY_SIZE][TEXT_LEN] = { "10.25", "20.5",
+      "-0.125" };
+  SQLCHAR TsArray[TEXT_ARRAY_SIZE][TEXT_LEN] = { "2019-07-04 23:05:09.12",
+      "2019-07-05 00:00:00", "2019-07-06" };
+  SQLLEN IdInd[TEXT_ARRAY_SIZE], PriceInd[TEXT_ARRAY_SIZE],
+      TsInd[TEXT_ARRAY_SIZE];
+  SQLUSMALLINT ParamStatusArray[TEXT_ARRAY_SIZE];
+  SQLULEN paramsProcessed = 0;
+  SQLINTEGER count = 0;
+
+  //initialize the sql handles
+  INIT_SQLHANDLES
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE IF EXISTS TEXTPARAMS",
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE TEXTPARAMS "
+      "(ID INTEGER, PRICE DECIMAL(10, 3), TS TIMESTAMP)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  for (int i = 0; i < TEXT_ARRAY_SIZE; i++) {
+    IdInd[i] = PriceInd[i] = TsInd[i] = SQL_NTS;
+  }
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE,
+      (SQLPOINTER)TEXT_ARRAY_SIZE, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, ParamStatusArray,
+      0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR,
+      &paramsProcessed, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+
+  // text bound to typed columns is converted by the driver
+  retcode = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR,
+      SQL_INTEGER, 10, 0, IdArray, TEXT_LEN, IdInd);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  retcode = SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR,
+      SQL_DECIMAL, 10, 3, PriceArray, TEXT_LEN, PriceInd);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  retcode = SQLBindParameter(hstmt, 3, SQL_PARAM_INPUT, SQL_C_CHAR,
+      SQL_TYPE_TIMESTAMP, 29, 9, TsArray, TEXT_LEN, TsInd);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+
+  // the malformed second set fails alone while the others are inserted
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"INSERT INTO TEXTPARAMS "
+      "VALUES (?, ?, ?)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS_WITH_INFO, retcode,
+      "SQLExecDirect");
+  EXPECT_EQ((SQLULEN)TEXT_ARRAY_SIZE, paramsProcessed);
+  EXPECT_EQ(SQL_PARAM_SUCCESS, ParamStatusArray[0]);
+  EXPECT_EQ(SQL_PARAM_ERROR, ParamStatusArray[1]);
+  EXPECT_EQ(SQL_PARAM_SUCCESS, ParamStatusArray[2]);
+
+  retcode = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT COUNT(*) FROM TEXTPARAMS "
+      "WHERE (ID = 1 AND PRICE = 10.25 AND TS = '2019-07-04 23:05:09.12') "
+      "OR (ID = 3 AND PRICE = -0.125 AND TS = '2019-07-06 00:00:00')",
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  retcode = SQLGetData(hstmt, 1, SQL_C_LONG, &count, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLGetData");
+  EXPECT_EQ(2, count);
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE TEXTPARAMS", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  //free sql handles
+  FREE_SQLHANDLES
+}
@@ -42,6 +42,7 @@
 #define SQLSTMT1 "SELECT * FROM DUAL"
 #define TABLE "COLATRIBUTE"
 #define MAX_NAME_LEN 256
+#define DESC_TABLE "DESCFIELDS"
 //*-------------------------------------------------------------------------
 
 TEST(SQLColAttribute, ColumnAttributes) {
@@ -337,3 +338,186 @@ TEST(SQLColAttribute, ColumnAttributes) {
   //free sql handles
   FREE_SQLHANDLES
 }
+
+TEST(SQLColAttribute, DescriptorFields) {
+  DECLARE_SQLHANDLES
+
+  SQLHSTMT hstmt2 = SQL_NULL_HSTMT;
+  SQLHDESC hard = SQL_NULL_HDESC;
+  SQLHDESC hard2 = SQL_NULL_HDESC;
+  SQLCHAR name[MAX_NAME_LEN];
+  SQLINTEGER nameLen = 0;
+  SQLSMALLINT count = 0;
+  SQLSMALLINT type = 0;
+  SQLINTEGER id = 0;
+  SQLLEN idInd = 0;
+  SQLLEN idLen = 0;
+  SQLPOINTER ptr = nullptr;
+
+  //initialize the sql handles
+  INIT_SQLHANDLES
+
+  SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE IF EXISTS " DESC_TABLE,
+      SQL_NTS);
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE " DESC_TABLE
+      " (ID INTEGER, NAME VARCHAR(80))", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"INSERT INTO " DESC_TABLE
+      " VALUES (10, 'TestName')", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  retcode = SQLPrepare(hstmt, (SQLCHAR*)"SELECT ID, NAME FROM " DESC_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLPrepare");
+
+  /* --- IRD ------------------------------------------------------- */
+  retcode = SQLGetStmtAttr(hstmt, SQL_ATTR_IMP_ROW_DESC, &hdesc, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLGetStmtAttr");
+  retcode = SQLGetDescField(hdesc, 0, SQL_DESC_COUNT, &count, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hdesc, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ(2, count);
+  retcode = SQLGetDescField(hdesc, 1, SQL_DESC_CONCISE_TYPE, &type, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hdesc, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ(SQL_INTEGER, type);
+  retcode = SQLGetDescField(hdesc, 2, SQL_DESC_NAME, name, sizeof(name),
+      &nameLen);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hdesc, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_STREQ("NAME", (const char*)name);
+  EXPECT_EQ(4, nameLen);
+  retcode = SQLGetDescField(hdesc, 3, SQL_DESC_NAME, name, sizeof(name),
+      &nameLen);
+  EXPECT_EQ(SQL_NO_DATA, retcode);
+
+  /* --- ARD ------------------------------------------------------- */
+  retcode = SQLGetStmtAttr(hstmt, SQL_ATTR_APP_ROW_DESC, &hard, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLGetStmtAttr");
+  retcode = SQLSetDescField(hard, 1, SQL_DESC_CONCISE_TYPE,
+      (SQLPOINTER)SQL_C_SLONG, 0);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLSetDescField");
+  retcode = SQLSetDescField(hard, 1, SQL_DESC_INDICATOR_PTR, &idInd, 0);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLSetDescField");
+  retcode = SQLSetDescField(hard, 1, SQL_DESC_DATA_PTR, &id, 0);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLSetDescField");
+  retcode = SQLGetDescField(hard, 0, SQL_DESC_COUNT, &count, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ(1, count);
+  // the indicator and length buffers are separate fields
+  retcode = SQLGetDescField(hard, 1, SQL_DESC_OCTET_LENGTH_PTR, &ptr, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ(nullptr, ptr);
+  retcode = SQLGetDescField(hard, 1, SQL_DESC_INDICATOR_PTR, &ptr, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ((SQLPOINTER)&idInd, ptr);
+  retcode = SQLSetDescField(hard, 1, SQL_DESC_TYPE, (SQLPOINTER)SQL_DATETIME,
+      0);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLSetDescField");
+  retcode = SQLSetDescField(hard, 1, SQL_DESC_DATETIME_INTERVAL_CODE,
+      (SQLPOINTER)SQL_CODE_DATE, 0);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLSetDescField");
+  retcode = SQLGetDescField(hard, 1, SQL_DESC_CONCISE_TYPE, &type, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ(SQL_C_TYPE_DATE, type);
+  retcode = SQLGetDescField(hard, 1, SQL_DESC_TYPE, &type, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ(SQL_DATETIME, type);
+  retcode = SQLSetDescField(hard, 1, SQL_DESC_CONCISE_TYPE,
+      (SQLPOINTER)SQL_C_SLONG, 0);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLSetDescField");
+
+  retcode = SQLExecute(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecute");
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  EXPECT_EQ(10, id);
+  EXPECT_EQ((SQLLEN)sizeof(id), idInd);
+  retcode = SQLCloseCursor(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLCloseCursor");
+
+  // with a separate length buffer the indicator is zero for a value
+  retcode = SQLSetDescField(hard, 1, SQL_DESC_OCTET_LENGTH_PTR, &idLen, 0);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard, 1, SQL_SUCCESS, retcode,
+      "SQLSetDescField");
+  retcode = SQLExecute(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecute");
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  EXPECT_EQ(10, id);
+  EXPECT_EQ((SQLLEN)sizeof(id), idLen);
+  EXPECT_EQ(0, idInd);
+  // IRD after execute is a fresh snapshot of the result set
+  retcode = SQLGetDescField(hdesc, 1, SQL_DESC_NAME, name, sizeof(name),
+      &nameLen);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hdesc, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_STREQ("ID", (const char*)name);
+  retcode = SQLCloseCursor(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLCloseCursor");
+
+  /* --- SQLCopyDesc ----------------------------------------------- */
+  retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt2);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle");
+  // IRD has no records before a statement is prepared or executed
+  retcode = SQLGetStmtAttr(hstmt2, SQL_ATTR_IMP_ROW_DESC, &hdesc, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLGetStmtAttr");
+  retcode = SQLGetDescField(hdesc, 0, SQL_DESC_COUNT, &count, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hdesc, 1, SQL_SUCCESS, retcode,
+      "SQLGetDescField");
+  EXPECT_EQ(0, count);
+  retcode = SQLGetStmtAttr(hstmt2, SQL_ATTR_APP_ROW_DESC, &hard2, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLGetStmtAttr");
+  retcode = SQLCopyDesc(hard, hard2);
+  DIAGRECCHECK(SQL_HANDLE_DESC, hard2, 1, SQL_SUCCESS, retcode,
+      "SQLCopyDesc");
+  id = 0;
+  retcode = SQLExecDirect(hstmt2, (SQLCHAR*)"SELECT ID FROM " DESC_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLFetch(hstmt2);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLFetch");
+  EXPECT_EQ(10, id);
+  retcode = SQLFreeHandle(SQL_HANDLE_STMT, hstmt2);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE " DESC_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  //free sql handles
+  FREE_SQLHANDLES
+}
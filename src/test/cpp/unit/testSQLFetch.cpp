@@ -35,6 +35,10 @@
 
 #include "TestHelper.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 //*-------------------------------------------------------------------------
 #define TESTNAME "SQLFetch"
 #define TABLE "TABFETCH"
@@ -129,3 +133,234 @@ TEST(SQLFetch, BasicChecks) {
   //free sql handles (stmt, dbc, env)
   FREE_SQLHANDLES
 }
+
+// driver specific statement attribute for read-ahead of forward-only cursors
+#define SQL_ATTR_READ_AHEAD_ROWS 50201
+
+#define READ_AHEAD_TABLE "TABFETCH_READAHEAD"
+#define READ_AHEAD_ROWS  5000
+#define READ_AHEAD_ARRAY 64
+
+TEST(SQLFetch, ReadAhead) {
+  DECLARE_SQLHANDLES
+
+  SQLHSTMT hstmt2 = SQL_NULL_HSTMT;
+  SQLINTEGER id, idLen;
+  SQLINTEGER ids[READ_AHEAD_ARRAY];
+  SQLLEN idLens[READ_AHEAD_ARRAY];
+  SQLULEN numFetched = 0;
+  SQLULEN readAhead = 0;
+  int expected;
+
+  //init sql handles (stmt, dbc, env)
+  INIT_SQLHANDLES
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE " READ_AHEAD_TABLE
+      " (ID INT NOT NULL PRIMARY KEY)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  retcode = SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO " READ_AHEAD_TABLE
+      " VALUES (?)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLPrepare");
+  retcode = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+      SQL_INTEGER, 0, 0, &id, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  for (id = 1; id <= READ_AHEAD_ROWS; id++) {
+    retcode = SQLExecute(hstmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLExecute");
+  }
+  retcode = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  // disabled by default
+  retcode = SQLGetStmtAttr(hstmt, SQL_ATTR_READ_AHEAD_ROWS, &readAhead, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLGetStmtAttr");
+  EXPECT_EQ(0U, readAhead);
+
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_READ_AHEAD_ROWS, (SQLPOINTER)200,
+      0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  retcode = SQLGetStmtAttr(hstmt, SQL_ATTR_READ_AHEAD_ROWS, &readAhead, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLGetStmtAttr");
+  EXPECT_EQ(200U, readAhead);
+
+  retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt2);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HSTMT)");
+
+  // single row fetches with the other statement used in between
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT ID FROM " READ_AHEAD_TABLE
+      " ORDER BY ID", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLBindCol(hstmt, 1, SQL_C_LONG, &id, sizeof(id), nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLBindCol");
+  expected = 0;
+  while ((retcode = SQLFetch(hstmt)) != SQL_NO_DATA) {
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+    ASSERT_EQ(++expected, id);
+    if ((expected % 1000) == 0) {
+      retcode = SQLExecDirect(hstmt2, (SQLCHAR*)"SELECT COUNT(*) FROM "
+          READ_AHEAD_TABLE, SQL_NTS);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+          "SQLExecDirect");
+      retcode = SQLFetch(hstmt2);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+          "SQLFetch");
+      retcode = SQLGetData(hstmt2, 1, SQL_C_LONG, &idLen, 0, nullptr);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+          "SQLGetData");
+      EXPECT_EQ(READ_AHEAD_ROWS, idLen);
+      retcode = SQLFreeStmt(hstmt2, SQL_CLOSE);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+          "SQLFreeStmt");
+
+      // SQLGetData should still see the current row
+      idLen = 0;
+      retcode = SQLGetData(hstmt, 1, SQL_C_LONG, &idLen, 0, nullptr);
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLGetData");
+      EXPECT_EQ(expected, idLen);
+    }
+  }
+  EXPECT_EQ(READ_AHEAD_ROWS, expected);
+  retcode = SQLFreeStmt(hstmt, SQL_UNBIND);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  // rowset fetches with column-wise binding
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE,
+      (SQLPOINTER)READ_AHEAD_ARRAY, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &numFetched, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT ID FROM " READ_AHEAD_TABLE
+      " ORDER BY ID", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, sizeof(SQLINTEGER), idLens);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLBindCol");
+  expected = 0;
+  while ((retcode = SQLFetch(hstmt)) != SQL_NO_DATA) {
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+    ASSERT_LE(numFetched, (SQLULEN)READ_AHEAD_ARRAY);
+    for (SQLULEN i = 0; i < numFetched; i++) {
+      ASSERT_EQ(++expected, ids[i]);
+    }
+  }
+  EXPECT_EQ(READ_AHEAD_ROWS, expected);
+  retcode = SQLFreeStmt(hstmt, SQL_UNBIND);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  retcode = SQLFreeHandle(SQL_HANDLE_STMT, hstmt2);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt2, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HSTMT)");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE " READ_AHEAD_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  /* ---------------------------------------------------------------------har- */
+  //free sql handles (stmt, dbc, env)
+  FREE_SQLHANDLES
+}
+
+#define CONCURRENT_TABLE   "TABFETCH_CONCURRENT"
+#define CONCURRENT_ROWS    2000
+#define CONCURRENT_THREADS 8
+
+TEST(SQLFetch, ConcurrentStatements) {
+  DECLARE_SQLHANDLES
+
+  SQLINTEGER id;
+  SQLUSMALLINT maxActivities = 1;
+
+  //init sql handles (stmt, dbc, env)
+  INIT_SQLHANDLES
+
+  // statements are multiplexed over the connection without any limit
+  retcode = SQLGetInfo(hdbc, SQL_MAX_CONCURRENT_ACTIVITIES, &maxActivities,
+      sizeof(maxActivities), nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode, "SQLGetInfo");
+  EXPECT_EQ(0, maxActivities);
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE " CONCURRENT_TABLE
+      " (ID INT NOT NULL PRIMARY KEY)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO " CONCURRENT_TABLE
+      " VALUES (?)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLPrepare");
+  retcode = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+      SQL_INTEGER, 0, 0, &id, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  for (id = 1; id <= CONCURRENT_ROWS; id++) {
+    retcode = SQLExecute(hstmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLExecute");
+  }
+  retcode = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  // each thread uses its own statements on the shared connection, half of
+  // them reading ahead so that background reads are interleaved too
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < CONCURRENT_THREADS; t++) {
+    threads.emplace_back([hdbc, t, &failures]() {
+      for (int n = 0; n < 5; n++) {
+        SQLHSTMT stmt = SQL_NULL_HSTMT;
+        if (!SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &stmt))) {
+          failures++;
+          return;
+        }
+        if ((t % 2) == 1) {
+          SQLSetStmtAttr(stmt, SQL_ATTR_READ_AHEAD_ROWS, (SQLPOINTER)100, 0);
+        }
+        SQLINTEGER rowId = 0;
+        int expected = 0;
+        if (SQL_SUCCEEDED(SQLExecDirect(stmt, (SQLCHAR*)"SELECT ID FROM "
+            CONCURRENT_TABLE " ORDER BY ID", SQL_NTS)) &&
+            SQL_SUCCEEDED(SQLBindCol(stmt, 1, SQL_C_LONG, &rowId,
+                sizeof(rowId), nullptr))) {
+          SQLRETURN rc;
+          while ((rc = SQLFetch(stmt)) != SQL_NO_DATA) {
+            if (!SQL_SUCCEEDED(rc) || rowId != ++expected) {
+              failures++;
+              break;
+            }
+          }
+        }
+        if (expected != CONCURRENT_ROWS) {
+          failures++;
+        }
+        SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+      }
+    });
+  }
+  for (auto& thr : threads) {
+    thr.join();
+  }
+  EXPECT_EQ(0, failures.load());
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE " CONCURRENT_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  //free sql handles (stmt, dbc, env)
+  FREE_SQLHANDLES
+}
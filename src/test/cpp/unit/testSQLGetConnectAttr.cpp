@@ -165,13 +165,8 @@ TEST(SQLGetConnectAttr, Test1) {
 
   retcode = ::SQLGetConnectAttr(hdbc, SQL_ATTR_ASYNC_ENABLE, &attribute, 0,
       nullptr);
-#if defined(TEST_DIRECT) || defined(_WINDOWS)
-  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_ERROR, retcode,
-      "SQLGetConnectAttr");
-#else
   DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
       "SQLGetConnectAttr");
-#endif
 
   // NOT supported attributes
   retcode = ::SQLGetConnectAttr(hdbc, SQL_ATTR_AUTO_IPD, &attribute, 0,
@@ -270,3 +270,190 @@ TEST(SQLGetData, CheckGetData2) {
   //free sql handles (stmt, dbc, env)
   FREE_SQLHANDLES
 }
+
+#define PIECE_TABLE "GETDATA_PIECES"
+#define PIECE_VALUE_LEN 100000
+#define PIECE_SIZE 1000
+
+TEST(SQLGetData, Piecewise) {
+  DECLARE_SQLHANDLES
+
+  std::string value;
+  std::string result;
+  SQLCHAR buffer[PIECE_SIZE];
+  SQLWCHAR wbuffer[PIECE_SIZE];
+  SQLINTEGER id = 0;
+  SQLLEN valueLen, len = 0;
+  int numPieces;
+
+  //init sql handles (stmt, dbc, env)
+  INIT_SQLHANDLES
+
+  for (int i = 0; value.size() < PIECE_VALUE_LEN; i++) {
+    value.append("{\"key\": ").append(std::to_string(i)).append("}, ");
+  }
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE " PIECE_TABLE
+      " (ID INT, DOC CLOB)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  retcode = SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO " PIECE_TABLE
+      " VALUES (?, ?)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLPrepare");
+  valueLen = value.size();
+  retcode = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+      SQL_INTEGER, 0, 0, &id, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  retcode = SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR,
+      SQL_LONGVARCHAR, value.size(), 0, (SQLPOINTER)value.c_str(),
+      value.size(), &valueLen);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  retcode = SQLExecute(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLExecute");
+  retcode = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT ID, DOC FROM "
+      PIECE_TABLE, SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+
+  // fixed size values are only returned by the first call
+  retcode = SQLGetData(hstmt, 1, SQL_C_LONG, &id, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLGetData");
+  retcode = SQLGetData(hstmt, 1, SQL_C_LONG, &id, 0, nullptr);
+  EXPECT_EQ(SQL_NO_DATA, retcode);
+
+  // read the CLOB in pieces till SQL_NO_DATA
+  numPieces = 0;
+  while ((retcode = SQLGetData(hstmt, 2, SQL_C_CHAR, buffer, PIECE_SIZE,
+      &len)) != SQL_NO_DATA) {
+    if (retcode == SQL_SUCCESS_WITH_INFO) {
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS_WITH_INFO, retcode,
+          "SQLGetData");
+      ASSERT_EQ(value.size() - result.size(), (size_t)len);
+    } else {
+      DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+          "SQLGetData");
+    }
+    result.append((const char*)buffer);
+    numPieces++;
+  }
+  EXPECT_EQ(value, result);
+  EXPECT_EQ((value.size() + PIECE_SIZE - 2) / (PIECE_SIZE - 1),
+      (size_t)numPieces);
+
+  // reading it again as SQL_C_WCHAR starts over
+  result.clear();
+  while ((retcode = SQLGetData(hstmt, 2, SQL_C_WCHAR, wbuffer,
+      sizeof(wbuffer), &len)) != SQL_NO_DATA) {
+    ASSERT_TRUE(retcode == SQL_SUCCESS || retcode == SQL_SUCCESS_WITH_INFO);
+    for (SQLWCHAR* w = wbuffer; *w; w++) {
+      result.push_back((char)*w);
+    }
+  }
+  EXPECT_EQ(value, result);
+
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE " PIECE_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  /* ---------------------------------------------------------------------har- */
+  //free sql handles (stmt, dbc, env)
+  FREE_SQLHANDLES
+}
+
+#define TEXT_TABLE "GETDATA_TEXT"
+
+TEST(SQLGetData, NumericAndTemporalAsText) {
+  DECLARE_SQLHANDLES
+
+  SQLCHAR buffer[MAX_NAME_LEN];
+  SQLWCHAR wbuffer[MAX_NAME_LEN];
+  SQLLEN len = 0;
+  // expected text for the columns of the row inserted below
+  const char* expected[] = { "-42", "9007199254740993", "1234.5", "0.1",
+      "2019-07-04", "23:05:09", "2019-07-04 23:05:09.12" };
+  const int numColumns = sizeof(expected) / sizeof(expected[0]);
+
+  //init sql handles (stmt, dbc, env)
+  INIT_SQLHANDLES
+
+  SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE IF EXISTS " TEXT_TABLE,
+      SQL_NTS);
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE " TEXT_TABLE
+      " (I INT, B BIGINT, D DOUBLE, R REAL, DT DATE, T TIME, TS TIMESTAMP)",
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"INSERT INTO " TEXT_TABLE
+      " VALUES (-42, 9007199254740993, 1234.5, 0.1, '2019-07-04',"
+      " '23:05:09', '2019-07-04 23:05:09.12')", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"INSERT INTO " TEXT_TABLE
+      " VALUES (NULL, NULL, NULL, NULL, NULL, NULL, NULL)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM " TEXT_TABLE
+      " ORDER BY I NULLS LAST", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  for (int i = 0; i < numColumns; i++) {
+    retcode = SQLGetData(hstmt, i + 1, SQL_C_CHAR, buffer, sizeof(buffer),
+        &len);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLGetData");
+    EXPECT_STREQ(expected[i], (const char*)buffer);
+    EXPECT_EQ((SQLLEN)::strlen(expected[i]), len);
+
+    retcode = SQLGetData(hstmt, i + 1, SQL_C_WCHAR, wbuffer, sizeof(wbuffer),
+        &len);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLGetData");
+    std::string wresult;
+    for (SQLWCHAR* w = wbuffer; *w; w++) {
+      wresult.push_back((char)*w);
+    }
+    EXPECT_EQ(std::string(expected[i]), wresult);
+    EXPECT_EQ((SQLLEN)(::strlen(expected[i]) * sizeof(SQLWCHAR)), len);
+  }
+
+  // truncation into a small buffer
+  retcode = SQLGetData(hstmt, 2, SQL_C_CHAR, buffer, 5, &len);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS_WITH_INFO, retcode,
+      "SQLGetData");
+  EXPECT_STREQ("9007", (const char*)buffer);
+
+  // nulls
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  for (int i = 0; i < numColumns; i++) {
+    retcode = SQLGetData(hstmt, i + 1, SQL_C_CHAR, buffer, sizeof(buffer),
+        &len);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLGetData");
+    EXPECT_EQ(SQL_NULL_DATA, len);
+  }
+
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE " TEXT_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  /* ---------------------------------------------------------------------har- */
+  //free sql handles (stmt, dbc, env)
+  FREE_SQLHANDLES
+}
@@ -35,6 +35,10 @@
 
 #include "TestHelper.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 //*-------------------------------------------------------------------------
 #define TESTNAME "SQLGetDiagRec"
 
@@ -127,3 +131,59 @@ TEST(SQLGetDiagRec, CheckGetDiagRec) {
   //free sql handles (stmt, dbc, env)
   FREE_SQLHANDLES
 }
+
+TEST(SQLGetDiagRec, ConcurrentReads) {
+  DECLARE_SQLHANDLES
+
+  //init sql handles (stmt, dbc, env)
+  INIT_SQLHANDLES
+
+  // each thread reads the records of errors on its own statement
+  // while the others keep replacing theirs
+  const int numThreads = 8;
+  std::vector<SQLHSTMT> stmts(numThreads);
+  for (int i = 0; i < numThreads; i++) {
+    retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &stmts[i]);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLAllocHandle (HSTMT)");
+  }
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; i++) {
+    threads.emplace_back([&stmts, &failures, i]() {
+      SQLHSTMT stmt = stmts[i];
+      for (int n = 0; n < 20; n++) {
+        if (SQLExecDirect(stmt, (SQLCHAR*)"SELECT * FROM NO_SUCH_TABLE",
+            SQL_NTS) != SQL_ERROR) {
+          failures++;
+          continue;
+        }
+        for (int r = 0; r < 10; r++) {
+          SQLCHAR state[6];
+          SQLINTEGER nativeError;
+          SQLCHAR message[MAX_NAME_LEN];
+          SQLSMALLINT textLength;
+          SQLRETURN rc = SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, state,
+              &nativeError, message, MAX_NAME_LEN, &textLength);
+          if (!SQL_SUCCEEDED(rc) || state[0] != '4' || state[1] != '2' ||
+              textLength <= 0) {
+            failures++;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thr : threads) {
+    thr.join();
+  }
+  EXPECT_EQ(0, failures.load());
+
+  for (int i = 0; i < numThreads; i++) {
+    retcode = SQLFreeHandle(SQL_HANDLE_STMT, stmts[i]);
+    DIAGRECCHECK(SQL_HANDLE_STMT, stmts[i], 1, SQL_SUCCESS, retcode,
+        "SQLFreeHandle (HSTMT)");
+  }
+
+  //free sql handles (stmt, dbc, env)
+  FREE_SQLHANDLES
+}
@@ -2834,3 +2834,63 @@ TEST(SQLGetInfo, TestOthers) {
   //free sql handles (stmt, dbc, env)
   FREE_SQLHANDLES
 }
+
+TEST(SQLGetInfo, Prewarm) {
+  DECLARE_SQLHANDLES
+
+  retcode = SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HENV)");
+  retcode = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3, 0);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLSetEnvAttr (HENV)");
+  retcode = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HDBC)");
+
+  std::string connStr(SNAPPYCONNSTRING);
+  connStr.append(";PrewarmInfo=1");
+  retcode = SQLDriverConnect(hdbc, nullptr, (SQLCHAR*)connStr.c_str(),
+      SQL_NTS, nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDriverConnect");
+
+  // results read on demand, from background and from the shared table
+  // should all be the same
+  SQLUINTEGER firstBitmask = 0;
+  for (int i = 0; i < 3; i++) {
+    SQLCHAR dbmsName[MAX_NAME_LEN];
+    SQLSMALLINT len = 0;
+    retcode = SQLGetInfo(hdbc, SQL_DBMS_NAME, dbmsName, MAX_NAME_LEN, &len);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLGetInfo (SQL_DBMS_NAME)");
+    EXPECT_STREQ("SnappyData", (const char*)dbmsName);
+    EXPECT_EQ(10, len);
+
+    SQLUINTEGER bitmask = 0;
+    retcode = SQLGetInfo(hdbc, SQL_STATIC_CURSOR_ATTRIBUTES2, &bitmask,
+        sizeof(bitmask), nullptr);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLGetInfo (SQL_STATIC_CURSOR_ATTRIBUTES2)");
+    if (i == 0) {
+      firstBitmask = bitmask;
+    }
+    EXPECT_EQ(firstBitmask, bitmask);
+
+    // truncation should still be reported for cached strings
+    retcode = SQLGetInfo(hdbc, SQL_DBMS_NAME, dbmsName, 4, &len);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS_WITH_INFO, retcode,
+        "SQLGetInfo (SQL_DBMS_NAME)");
+    EXPECT_EQ(10, len);
+  }
+
+  retcode = SQLDisconnect(hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDisconnect");
+  retcode = SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HDBC)");
+  retcode = SQLFreeHandle(SQL_HANDLE_ENV, henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HENV)");
+}
@@ -98,3 +98,75 @@ TEST(SQLPrepare, PrepareInsert) {
   //free sql handles (stmt, dbc, env)
   FREE_SQLHANDLES
 }
+
+// driver specific connection attributes for the statement cache
+#define SQL_ATTR_STMT_CACHE_HITS 50101
+#define SQL_ATTR_STMT_CACHE_MISSES 50102
+
+TEST(SQLPrepare, StatementCache) {
+  DECLARE_SQLHANDLES
+
+  retcode = SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HENV)");
+  retcode = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3, 0);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLSetEnvAttr (HENV)");
+  retcode = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HDBC)");
+
+  std::string connStr(SNAPPYCONNSTRING);
+  connStr.append(";StatementCacheSize=4");
+  retcode = SQLDriverConnect(hdbc, nullptr, (SQLCHAR*)connStr.c_str(),
+      SQL_NTS, nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDriverConnect");
+
+  // allocate, prepare, execute and free in a loop which should reuse
+  // the cached prepared statement after the first iteration
+  for (int i = 0; i < 3; i++) {
+    retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLAllocHandle (HSTMT)");
+
+    retcode = SQLPrepare(hstmt, (SQLCHAR*)"SELECT 1 FROM SYSIBM.SYSDUMMY1",
+        SQL_NTS);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLPrepare");
+
+    retcode = SQLExecute(hstmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLExecute");
+
+    retcode = SQLFetch(hstmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLFetch");
+
+    retcode = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLFreeHandle (HSTMT)");
+  }
+
+  SQLUBIGINT hits = 0, misses = 0;
+  retcode = SQLGetConnectAttr(hdbc, SQL_ATTR_STMT_CACHE_HITS, &hits, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLGetConnectAttr");
+  retcode = SQLGetConnectAttr(hdbc, SQL_ATTR_STMT_CACHE_MISSES, &misses, 0,
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLGetConnectAttr");
+  EXPECT_EQ(2U, hits);
+  EXPECT_EQ(1U, misses);
+
+  retcode = SQLDisconnect(hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDisconnect");
+  retcode = SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HDBC)");
+  retcode = SQLFreeHandle(SQL_HANDLE_ENV, henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HENV)");
+}
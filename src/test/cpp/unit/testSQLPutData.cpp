@@ -219,3 +219,136 @@ TEST(SQLPutData, BasicCheck) {
   //free sql handles (stmt, dbc, env)
   FREE_SQLHANDLES
 }
+
+#define LARGE_TABLE "SPUTDATA_LARGE"
+#define LARGE_PIECE_SIZE 1000
+#define LARGE_NUM_PIECES 200
+
+TEST(SQLPutData, LargeChunked) {
+  DECLARE_SQLHANDLES
+
+  std::string value;
+  std::string result(LARGE_PIECE_SIZE * LARGE_NUM_PIECES + 1, '\0');
+  SQLWCHAR wresult[16];
+  SQLLEN cbValue = SQL_DATA_AT_EXEC;
+  SQLLEN len = 0;
+  PTR pToken = nullptr;
+  // "a", U+1F600 as a surrogate pair, "b"
+  const SQLWCHAR wvalue[] = { 'a', 0xD83D, 0xDE00, 'b' };
+
+  retcode = SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HENV)");
+  retcode = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3, 0);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLSetEnvAttr (HENV)");
+  retcode = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HDBC)");
+
+  // use a small spill size so that the value goes to a temporary file
+  std::string connStr(SNAPPYCONNSTRING);
+  connStr.append(";PutDataSpillSize=1000");
+  retcode = SQLDriverConnect(hdbc, nullptr, (SQLCHAR*)connStr.c_str(),
+      SQL_NTS, nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDriverConnect");
+  retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HSTMT)");
+
+  SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE IF EXISTS " LARGE_TABLE,
+      SQL_NTS);
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE " LARGE_TABLE
+      " (DOC CLOB, NAME VARCHAR(20))", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  retcode = SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO " LARGE_TABLE
+      " VALUES (?, ?)", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLPrepare");
+  retcode = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR,
+      SQL_LONGVARCHAR, result.size(), 0, (SQLPOINTER)PARAM1, 0, &cbValue);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+  retcode = SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_WCHAR,
+      SQL_WVARCHAR, 20, 0, (SQLPOINTER)PARAM2, 0, &cbValue);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLBindParameter");
+
+  retcode = SQLExecute(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_NEED_DATA, retcode,
+      "SQLExecute");
+
+  // first parameter is sent in many pieces
+  retcode = SQLParamData(hstmt, &pToken);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_NEED_DATA, retcode,
+      "SQLParamData");
+  ASSERT_EQ((PTR)PARAM1, pToken);
+  for (int i = 0; i < LARGE_NUM_PIECES; i++) {
+    std::string piece(LARGE_PIECE_SIZE, (char)('a' + (i % 26)));
+    value.append(piece);
+    retcode = SQLPutData(hstmt, (SQLPOINTER)piece.data(), piece.size());
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+        "SQLPutData");
+  }
+
+  // second parameter has a surrogate pair split across two pieces
+  retcode = SQLParamData(hstmt, &pToken);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_NEED_DATA, retcode,
+      "SQLParamData");
+  ASSERT_EQ((PTR)PARAM2, pToken);
+  retcode = SQLPutData(hstmt, (SQLPOINTER)wvalue, 2 * sizeof(SQLWCHAR));
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLPutData");
+  retcode = SQLPutData(hstmt, (SQLPOINTER)(wvalue + 2),
+      2 * sizeof(SQLWCHAR));
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLPutData");
+
+  retcode = SQLParamData(hstmt, &pToken);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLParamData");
+  retcode = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT DOC, NAME FROM "
+      LARGE_TABLE, SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLFetch(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+
+  retcode = SQLGetData(hstmt, 1, SQL_C_CHAR, &result[0], result.size(),
+      &len);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLGetData");
+  ASSERT_EQ((SQLLEN)value.size(), len);
+  ASSERT_EQ(value, result.substr(0, len));
+
+  retcode = SQLGetData(hstmt, 2, SQL_C_WCHAR, wresult, sizeof(wresult), &len);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLGetData");
+  ASSERT_EQ((SQLLEN)sizeof(wvalue), len);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(wvalue[i], wresult[i]);
+  }
+
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE " LARGE_TABLE,
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  retcode = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HSTMT)");
+  retcode = SQLDisconnect(hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDisconnect");
+  retcode = SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HDBC)");
+  retcode = SQLFreeHandle(SQL_HANDLE_ENV, henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HENV)");
+}
@@ -262,3 +262,62 @@ TEST(SQLSetEnvAttr, Test2) {
   //free sql handles (stmt, dbc, env)
   FREE_SQLHANDLES
 }
+
+TEST(SQLSetEnvAttr, ConnectionPooling) {
+  DECLARE_SQLHANDLES
+
+  retcode = SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HENV)");
+  retcode = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3, 0);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLSetEnvAttr (SQL_ATTR_ODBC_VERSION)");
+  retcode = SQLSetEnvAttr(henv, SQL_ATTR_CONNECTION_POOLING,
+      (SQLPOINTER)SQL_CP_ONE_PER_HENV, 0);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLSetEnvAttr (SQL_ATTR_CONNECTION_POOLING)");
+  retcode = SQLSetEnvAttr(henv, SQL_ATTR_CP_MATCH,
+      (SQLPOINTER)SQL_CP_RELAXED_MATCH, 0);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLSetEnvAttr (SQL_ATTR_CP_MATCH)");
+
+  // connect and disconnect repeatedly; later connections should reuse the
+  // pooled connection with session state reset
+  for (int i = 0; i < 3; i++) {
+    retcode = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLAllocHandle (HDBC)");
+
+    retcode = SQLDriverConnect(hdbc, nullptr,
+        (SQLCHAR*)SNAPPYCONNSTRING.c_str(), SQL_NTS, nullptr, 0, nullptr,
+        SQL_DRIVER_NOPROMPT);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLDriverConnect");
+
+    SQLUINTEGER autoCommit = SQL_AUTOCOMMIT_OFF;
+    retcode = SQLGetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, &autoCommit, 0,
+        nullptr);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLGetConnectAttr (SQL_ATTR_AUTOCOMMIT)");
+    EXPECT_EQ(SQL_AUTOCOMMIT_ON, autoCommit);
+    // change the session state which should be reset for next iteration
+    retcode = SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT,
+        (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLSetConnectAttr (SQL_ATTR_AUTOCOMMIT)");
+    retcode = SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLEndTran");
+
+    retcode = SQLDisconnect(hdbc);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLDisconnect");
+    retcode = SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+    DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+        "SQLFreeHandle (HDBC)");
+  }
+
+  retcode = SQLFreeHandle(SQL_HANDLE_ENV, henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HENV)");
+}
@@ -36,6 +36,9 @@
 #include "TestHelper.h"
 #include <string.h>
 
+#include <chrono>
+#include <thread>
+
 //*-------------------------------------------------------------------------
 #define TESTNAME "SQLSetStmtAttr"
 #define TABLE ""
@@ -130,7 +133,11 @@ TEST(SQLSetStmtAttr, CheckSetAttrs) {
       "Value = 'SQL_ASYNC_ENABLE_ON'");
   retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE,
       (SQLPOINTER)SQL_ASYNC_ENABLE_ON, strLengthPtr);
-  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_ERROR, retcode,
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE,
+      (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, strLengthPtr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
       "SQLSetStmtAttr");
 
   /* *** 4. SQL_ATTR_CONCURRENCY (ODBC 2.0) */
@@ -656,3 +663,113 @@ TEST(SQLSetStmtAttr, DISABLED_QueryTimeout) {
   //free sql handles
   FREE_SQLHANDLES
 }
+
+/** invoke the given ODBC call until it stops returning SQL_STILL_EXECUTING */
+#define POLL_ASYNC(retcode, call) \
+  while ((retcode = (call)) == SQL_STILL_EXECUTING) { \
+    std::this_thread::sleep_for(std::chrono::milliseconds(1)); \
+  }
+
+TEST(SQLSetStmtAttr, AsyncExecution) {
+  DECLARE_SQLHANDLES
+
+  //initialize the sql handles
+  INIT_SQLHANDLES
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE IF EXISTS SQLASYNC1",
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE SQLASYNC1("
+      "ID INTEGER, NAME VARCHAR(80))", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  SQLUINTEGER asyncMode = 0;
+  retcode = SQLGetInfo(hdbc, SQL_ASYNC_MODE, &asyncMode, sizeof(asyncMode),
+      nullptr);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode, "SQLGetInfo");
+  EXPECT_EQ(SQL_AM_STATEMENT, asyncMode);
+
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE,
+      (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+
+  /* --- async insert and select ---------------------------------- */
+  POLL_ASYNC(retcode, SQLExecDirect(hstmt, (SQLCHAR*)"INSERT INTO SQLASYNC1 "
+      "SELECT ID, 'NAME_' || ID FROM RANGE(100)", SQL_NTS));
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  SQLCHAR* selectStmt = (SQLCHAR*)"SELECT ID, NAME FROM SQLASYNC1 ORDER BY ID";
+  retcode = SQLExecDirect(hstmt, selectStmt, SQL_NTS);
+  EXPECT_EQ(SQL_STILL_EXECUTING, retcode)
+      << "first asynchronous call should return SQL_STILL_EXECUTING";
+  POLL_ASYNC(retcode, SQLExecDirect(hstmt, selectStmt, SQL_NTS));
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  SQLINTEGER id = 0;
+  SQLCHAR name[MAX_NAME_LEN];
+  retcode = SQLBindCol(hstmt, 1, SQL_C_LONG, &id, 0, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLBindCol");
+  retcode = SQLBindCol(hstmt, 2, SQL_C_CHAR, name, MAX_NAME_LEN, nullptr);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLBindCol");
+  int numRows = 0;
+  while (true) {
+    POLL_ASYNC(retcode, SQLFetch(hstmt));
+    if (retcode == SQL_NO_DATA) break;
+    DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+    if (!SQL_SUCCEEDED(retcode)) break;
+    EXPECT_EQ(numRows, id);
+    EXPECT_EQ("NAME_" + std::to_string(numRows), std::string((char*)name));
+    numRows++;
+  }
+  EXPECT_EQ(100, numRows);
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+  retcode = SQLFreeStmt(hstmt, SQL_UNBIND);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  /* --- async catalog call --------------------------------------- */
+  POLL_ASYNC(retcode, SQLTables(hstmt, nullptr, 0, nullptr, 0,
+      (SQLCHAR*)"SQLASYNC1", SQL_NTS, nullptr, 0));
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLTables");
+  POLL_ASYNC(retcode, SQLFetch(hstmt));
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFetch");
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  /* --- cancel an operation in progress -------------------------- */
+  SQLCHAR* longStmt = (SQLCHAR*)"SELECT COUNT(*) FROM SQLASYNC1 T1, "
+      "SQLASYNC1 T2, SQLASYNC1 T3, SQLASYNC1 T4";
+  retcode = SQLExecDirect(hstmt, longStmt, SQL_NTS);
+  EXPECT_EQ(SQL_STILL_EXECUTING, retcode)
+      << "first asynchronous call should return SQL_STILL_EXECUTING";
+  retcode = SQLCancel(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLCancel");
+  POLL_ASYNC(retcode, SQLExecDirect(hstmt, longStmt, SQL_NTS));
+  EXPECT_EQ(SQL_ERROR, retcode) << "canceled call should fail";
+  SQLCHAR cancelState[6] = { 0 };
+  SQLINTEGER nativeError = 0;
+  SQLSMALLINT msgLen = 0;
+  retcode = SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, cancelState,
+      &nativeError, nullptr, 0, &msgLen);
+  EXPECT_TRUE(SQL_SUCCEEDED(retcode));
+  EXPECT_STREQ("HY008", (const char*)cancelState);
+  retcode = SQLFreeStmt(hstmt, SQL_CLOSE);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLFreeStmt");
+
+  retcode = SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE,
+      (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLSetStmtAttr");
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE SQLASYNC1", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+
+  //free sql handles
+  FREE_SQLHANDLES
+}
@@ -432,3 +432,73 @@ TEST(SQLTables, Test3) {
   printf("Running for all nulls\n");
   testTables(0, 0, 0, L"TABLE,VIEW,SYSTEM TABLE", true);
 }
+
+/** count the rows returned by SQLTables for the given table name */
+static int countTables(SQLHSTMT hstmt, const char* table) {
+  SQLRETURN retcode = SQLTables(hstmt, nullptr, 0, nullptr, 0,
+      (SQLCHAR*)table, SQL_NTS, nullptr, 0);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode, "SQLTables");
+  int numRows = 0;
+  while ((retcode = SQLFetch(hstmt)) == SQL_SUCCESS) {
+    numRows++;
+  }
+  EXPECT_EQ(SQL_NO_DATA, retcode);
+  retcode = SQLCloseCursor(hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLCloseCursor");
+  return numRows;
+}
+
+TEST(SQLTables, CatalogCache) {
+  DECLARE_SQLHANDLES
+
+  retcode = SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HENV)");
+  retcode = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3, 0);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLSetEnvAttr (HENV)");
+  retcode = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HDBC)");
+
+  std::string connStr(SNAPPYCONNSTRING);
+  connStr.append(";CatalogCacheTTL=300");
+  retcode = SQLDriverConnect(hdbc, nullptr, (SQLCHAR*)connStr.c_str(),
+      SQL_NTS, nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDriverConnect");
+  retcode = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLAllocHandle (HSTMT)");
+
+  SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE IF EXISTS CATCACHE", SQL_NTS);
+  EXPECT_EQ(0, countTables(hstmt, "CATCACHE"));
+
+  // DDL on the connection should drop the cached result
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE CATCACHE (id int)",
+      SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  EXPECT_EQ(1, countTables(hstmt, "CATCACHE"));
+  // served from the cache
+  EXPECT_EQ(1, countTables(hstmt, "CATCACHE"));
+
+  retcode = SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE CATCACHE", SQL_NTS);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLExecDirect");
+  EXPECT_EQ(0, countTables(hstmt, "CATCACHE"));
+
+  retcode = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+  DIAGRECCHECK(SQL_HANDLE_STMT, hstmt, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HSTMT)");
+  retcode = SQLDisconnect(hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLDisconnect");
+  retcode = SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+  DIAGRECCHECK(SQL_HANDLE_DBC, hdbc, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HDBC)");
+  retcode = SQLFreeHandle(SQL_HANDLE_ENV, henv);
+  DIAGRECCHECK(SQL_HANDLE_ENV, henv, 1, SQL_SUCCESS, retcode,
+      "SQLFreeHandle (HENV)");
+}